@@ -0,0 +1,278 @@
+#include "audioanalysis.h"
+#include "showpackage.h"
+#include "silencescan.h"
+
+#include <QAtomicInt>
+#include <QAudioBuffer>
+#include <QAudioDecoder>
+#include <QEventLoop>
+#include <QScopedPointer>
+#include <QThread>
+#include <QThreadPool>
+#include <QUrl>
+#include <QVector>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <numeric>
+
+static const int kEnvelopeBlock = 64;   // frames per envelope value
+
+namespace {
+
+/* ============================================================
+ * STREAMING ANALYSER – one decoded buffer at a time
+ * ============================================================ */
+class Analyzer
+{
+public:
+    explicit Analyzer(float silenceThreshold) : m_threshold(silenceThreshold) {}
+
+    void add(const QAudioBuffer &buf)
+    {
+        const QAudioFormat fmt = buf.format();
+        const int channels = fmt.channelCount();
+        const int frames = int(buf.frameCount());
+        if (channels <= 0 || frames <= 0)
+            return;
+
+        if (m_channels == 0)
+        {
+            m_channels = channels;
+            m_sampleRate = fmt.sampleRate();
+        }
+
+        toFloat(buf, channels, frames);
+        const float *src = m_scratch.constData();
+
+        // Sound bounds on the interleaved samples: the start once,
+        // the end again for every buffer that has sound in it
+        if (m_threshold > 0.0f)
+        {
+            const qsizetype n = qsizetype(frames) * channels;
+            if (m_firstLoud < 0)
+            {
+                const qsizetype i = SilenceScan::firstAbove(src, n, m_threshold);
+                if (i >= 0)
+                    m_firstLoud = m_frames + i / channels;
+            }
+            if (m_firstLoud >= 0)
+            {
+                const qsizetype i = SilenceScan::lastAbove(src, n, m_threshold);
+                if (i >= 0)
+                    m_lastLoud = m_frames + i / channels;
+            }
+        }
+
+        m_loudness.add(src, frames, channels, m_sampleRate);
+
+        // Fold into the envelope: max |sample| over all channels
+        for (int f = 0; f < frames; ++f)
+        {
+            const float *frame = src + qsizetype(f) * channels;
+            for (int c = 0; c < channels; ++c)
+                m_blockPeak = qMax(m_blockPeak, qAbs(frame[c]));
+
+            if (++m_blockFill == kEnvelopeBlock)
+                flushBlock();
+        }
+        m_frames += frames;
+    }
+
+    AudioAnalysis::Result finish()
+    {
+        if (m_blockFill > 0)
+            flushBlock();
+
+        AudioAnalysis::Result r;
+        r.ok = m_frames > 0;
+        r.frames = m_frames;
+        r.channels = m_channels;
+        r.sampleRate = m_sampleRate;
+        r.durationMs = m_sampleRate > 0 ? m_frames * 1000 / m_sampleRate : 0;
+        r.loudness = m_loudness.finish();
+
+        // Max of block maxima = max over the same samples. The
+        // loudness goes with the envelope into the peak cache
+        auto peaks = QSharedPointer<WaveformPeaks>::create(
+            *WaveformPeaks::build(m_envelope, r.durationMs));
+        peaks->loudness = r.loudness;
+        r.peaks = peaks;
+
+        if (m_firstLoud >= 0 && m_sampleRate > 0)
+        {
+            r.soundStartMs = m_firstLoud * 1000 / m_sampleRate;
+            // Round up, so the last loud sample is inside the cue
+            r.soundEndMs = qMin(r.durationMs,
+                                ((m_lastLoud + 1) * 1000 + m_sampleRate - 1) / m_sampleRate);
+        }
+        return r;
+    }
+
+private:
+    void flushBlock()
+    {
+        m_envelope.append(m_blockPeak);
+        m_blockPeak = 0.0f;
+        m_blockFill = 0;
+    }
+
+    // Interleaved float copy of any PCM buffer the decoder hands out
+    void toFloat(const QAudioBuffer &buf, int channels, int frames)
+    {
+        const qsizetype n = qsizetype(frames) * channels;
+        m_scratch.resize(n);
+        float *dst = m_scratch.data();
+
+        switch (buf.format().sampleFormat())
+        {
+        case QAudioFormat::Float: {
+            const float *p = buf.constData<float>();
+            std::copy(p, p + n, dst);
+            break;
+        }
+        case QAudioFormat::Int16: {
+            const qint16 *p = buf.constData<qint16>();
+            for (qsizetype i = 0; i < n; ++i)
+                dst[i] = p[i] / 32768.f;
+            break;
+        }
+        case QAudioFormat::Int32: {
+            const qint32 *p = buf.constData<qint32>();
+            for (qsizetype i = 0; i < n; ++i)
+                dst[i] = p[i] / 2147483648.f;
+            break;
+        }
+        case QAudioFormat::UInt8: {
+            const quint8 *p = buf.constData<quint8>();
+            for (qsizetype i = 0; i < n; ++i)
+                dst[i] = (int(p[i]) - 128) / 128.f;
+            break;
+        }
+        default:
+            std::fill(dst, dst + n, 0.0f);
+            break;
+        }
+    }
+
+    QVector<float> m_scratch;
+    QVector<float> m_envelope;
+    Loudness::Meter m_loudness;
+    float m_blockPeak = 0.0f;
+    int m_blockFill = 0;
+    float m_threshold;
+    qint64 m_firstLoud = -1;    // frame indices
+    qint64 m_lastLoud = -1;
+    int m_channels = 0;
+    int m_sampleRate = 0;
+    qint64 m_frames = 0;
+};
+
+} // namespace
+
+/* ============================================================
+ * WORKER POOL
+ * ============================================================ */
+QThreadPool *AudioAnalysis::threadPool()
+{
+    // Decoding is CPU work: one thread per core, below the GUI and
+    // the audio threads, and off the global pool the jobs run on
+    static QThreadPool *pool = [] {
+        auto *p = new QThreadPool;
+        p->setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+        p->setThreadPriority(QThread::LowPriority);
+        return p;
+    }();
+    return pool;
+}
+
+/* ============================================================
+ * ANALYSE ONE FILE (blocking, worker thread)
+ * ============================================================ */
+AudioAnalysis::Result AudioAnalysis::analyzeFile(const QString &path,
+                                                 float silenceThreshold,
+                                                 const std::function<bool()> &canceled)
+{
+    Analyzer analyzer(silenceThreshold);
+    QString error;
+    bool stopped = false;
+
+    // Outlives the decoder reading from it
+    QScopedPointer<QIODevice> entry;
+    QEventLoop loop;
+    QAudioDecoder decoder;
+    if (ShowPackage::isEntryPath(path))
+    {
+        entry.reset(ShowPackage::openEntryPath(path));
+        if (!entry)
+        {
+            Result r;
+            r.error = QObject::tr("Not found in the show package");
+            return r;
+        }
+        decoder.setSourceDevice(entry.data());
+    }
+    else
+    {
+        decoder.setSource(QUrl::fromLocalFile(path));
+    }
+
+    QObject::connect(&decoder, &QAudioDecoder::bufferReady, &loop, [&]() {
+        if (canceled && canceled())
+        {
+            stopped = true;
+            decoder.stop();
+            loop.quit();
+            return;
+        }
+        analyzer.add(decoder.read());
+    });
+    QObject::connect(&decoder, &QAudioDecoder::finished, &loop, &QEventLoop::quit);
+    QObject::connect(&decoder, qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), &loop,
+                     [&](QAudioDecoder::Error) {
+                         error = decoder.errorString();
+                         loop.quit();
+                     });
+
+    decoder.start();
+    if (decoder.error() == QAudioDecoder::NoError)
+        loop.exec();
+    else
+        error = decoder.errorString();
+
+    Result r = analyzer.finish();
+    if (stopped)
+        r.ok = false;
+    if (!error.isEmpty())
+    {
+        r.ok = false;
+        r.error = error;
+    }
+    return r;
+}
+
+/* ============================================================
+ * ANALYSE MANY FILES (background job)
+ * ============================================================ */
+void AudioAnalysis::analyzeFiles(QPromise<Result> &promise, const QStringList &paths)
+{
+    promise.setProgressRange(0, 1000);
+    const int total = int(paths.size());
+    if (total == 0)
+        return;
+
+    QVector<int> order(total);
+    std::iota(order.begin(), order.end(), 0);
+    QAtomicInt done = 0;
+    auto canceled = [&promise]() { return promise.isCanceled(); };
+
+    QtConcurrent::blockingMap(threadPool(), order, [&](int i) {
+        if (promise.isCanceled())
+            return;
+
+        promise.addResult(analyzeFile(paths[i], 0.0f, canceled), i);
+
+        const int n = done.fetchAndAddRelaxed(1) + 1;
+        promise.setProgressValueAndText(int(qint64(n) * 1000 / total),
+                                        QObject::tr("Measured %1 of %2…").arg(n).arg(total));
+    });
+}
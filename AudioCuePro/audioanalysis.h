@@ -0,0 +1,71 @@
+#ifndef AUDIOANALYSIS_H
+#define AUDIOANALYSIS_H
+
+#include <QPromise>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+#include "loudness.h"
+#include "waveformpeaks.h"
+
+class QThreadPool;
+
+/*
+============================================================
+ AudioAnalysis
+------------------------------------------------------------
+ - Decodes one audio file on the calling (worker) thread and
+   measures it in a single streaming pass:
+     duration, sample rate, channels
+     waveform peaks (the same envelope WaveformView builds)
+     where the sound starts and ends (SilenceScan), for
+     trimming leading / trailing silence
+     EBU R128 loudness (Loudness), also attached to the
+     peaks so it travels with the peak cache
+ - Never holds the decoded file: every buffer is folded
+   into a 64-frame peak envelope and dropped, so a pool of
+   workers can analyse long files side by side
+ - Blocking: runs a local event loop around QAudioDecoder,
+   so call it from a pool thread, never the GUI thread.
+   threadPool() is the one to use: a thread per core at
+   low priority, so playback is never starved
+ - Takes plain files and show package entry paths
+============================================================
+*/
+
+namespace AudioAnalysis
+{
+    struct Result {
+        bool ok = false;
+        QString error;
+        qint64 durationMs = 0;
+        int sampleRate = 0;
+        int channels = 0;
+        qint64 frames = 0;
+        WaveformPeaksPtr peaks;
+
+        // First / last instant above the silence threshold;
+        // -1 if everything is below it (or no threshold given)
+        qint64 soundStartMs = -1;
+        qint64 soundEndMs = -1;
+
+        Loudness::Stats loudness;
+    };
+
+    QThreadPool *threadPool();
+
+    // silenceThreshold: linear amplitude (see SilenceScan::thresholdFromDb),
+    // 0 = do not look for silence.
+    // Return true from `canceled` to stop decoding early (ok = false)
+    Result analyzeFile(const QString &path,
+                       float silenceThreshold = 0.0f,
+                       const std::function<bool()> &canceled = {});
+
+    // Background job over many files (Analyze Loudness): result i
+    // belongs to paths[i] and is reported as soon as it is ready,
+    // in any order. Progress range is 0..1000
+    void analyzeFiles(QPromise<Result> &promise, const QStringList &paths);
+}
+
+#endif // AUDIOANALYSIS_H
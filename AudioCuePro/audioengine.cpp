@@ -0,0 +1,981 @@
+#include "audioengine.h"
+#include "engineoutput.h"
+#include "frameticker.h"
+#include "latencyprobe.h"
+
+#include <QAudioBuffer>
+#include <QAudioDevice>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMediaDevices>
+#include <QMutexLocker>
+#include <QtMath>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+static const int kBlock = AudioEngine::kBlockFrames;
+static const int kRingMs = 1000;            // per voice
+static const int kPrimeMs = 30;             // queued before a voice starts
+static const int kRampMs = 8;               // PANIC and stop / seek fades
+// Drift: the player delivers on its own clock, the device plays on
+// another. Once the ring level has settled, its offset from there
+// trims the resampling step (proportionally, at most 1000 ppm)
+static const double kFillSmoothingMs = 500.0;
+static const double kFillSettleMs = 2000.0;
+static const double kDriftDeadbandMs = 20.0;  // before a bypassed voice starts resampling
+static const double kDriftGain = 0.01;        // step trim per second of offset
+static const double kDriftMaxTrim = 0.001;
+static const float kCpuSmoothing = 0.05f;
+
+namespace {
+
+// Any layout down to stereo: L/R as they are, centre and
+// surrounds (5.1: L R C LFE Ls Rs) folded in at -3 dB, LFE dropped
+template <typename T>
+void toStereo(const T *samples, int frames, int channels, float scale, float *out)
+{
+    // Unsigned 8-bit is offset binary
+    const float offset = std::is_same<T, quint8>::value ? 128.0f : 0.0f;
+    const float fold = 0.7071f;
+
+    for (int f = 0; f < frames; ++f)
+    {
+        const T *frame = samples + qsizetype(f) * channels;
+        const auto at = [&](int c) { return (float(frame[c]) - offset) * scale; };
+        float l, r;
+        if (channels == 1)
+        {
+            l = r = at(0);
+        }
+        else
+        {
+            l = at(0);
+            r = at(1);
+            if (channels >= 3)
+            {
+                l += fold * at(2);
+                r += fold * at(2);
+            }
+            if (channels >= 6)
+            {
+                l += fold * at(4);
+                r += fold * at(5);
+            }
+        }
+        out[2 * f] = l;
+        out[2 * f + 1] = r;
+    }
+}
+
+} // namespace
+
+/* ============================================================
+ * VOICE – delivery thread side
+ * ============================================================ */
+AudioEngine::Voice::Voice(AudioEngine *engine, int sampleRate)
+    : m_engine(engine),
+      m_sampleRate(sampleRate),
+      m_capacity(qint64(sampleRate) * kRingMs / 1000),
+      m_primeFrames(qint64(sampleRate) * kPrimeMs / 1000)
+{
+    m_ring.fill(0.0f, 2 * m_capacity);
+    m_block.fill(0.0f, 2 * kBlock);
+}
+
+AudioEngine::Feed::Feed(Voice *voice)
+    : m_voice(voice)
+{
+    m_voice->m_feeds.fetch_add(1, std::memory_order_relaxed);
+}
+
+AudioEngine::Feed::Feed(const Feed &other)
+    : m_voice(other.m_voice)
+{
+    m_voice->m_feeds.fetch_add(1, std::memory_order_relaxed);
+}
+
+AudioEngine::Feed::~Feed()
+{
+    m_voice->m_feeds.fetch_sub(1, std::memory_order_release);
+}
+
+void AudioEngine::Voice::push(const QAudioBuffer &buffer)
+{
+    const QAudioFormat fmt = buffer.format();
+    const int channels = fmt.channelCount();
+    const int frames = int(buffer.frameCount());
+    if (channels <= 0 || frames <= 0 || fmt.sampleRate() <= 0)
+        return;
+    LatencyProbe::mark(LatencyProbe::FirstBuffer);
+
+    if (m_resetInput.exchange(false, std::memory_order_acquire))
+    {
+        m_resampler.reset();
+        m_resampling = false;
+        m_fillSeen = 0.0;
+        m_fillRef = -1.0;
+    }
+
+    if (m_stereo.size() < 2 * frames)
+        m_stereo.resize(2 * frames);
+    float *stereo = m_stereo.data();
+
+    switch (fmt.sampleFormat())
+    {
+    case QAudioFormat::Float:
+        toStereo(buffer.constData<float>(), frames, channels, 1.0f, stereo);
+        break;
+    case QAudioFormat::Int16:
+        toStereo(buffer.constData<qint16>(), frames, channels, 1.0f / 32768.f, stereo);
+        break;
+    case QAudioFormat::Int32:
+        toStereo(buffer.constData<qint32>(), frames, channels, 1.0f / 2147483648.f, stereo);
+        break;
+    case QAudioFormat::UInt8:
+        toStereo(buffer.constData<quint8>(), frames, channels, 1.0f / 128.f, stereo);
+        break;
+    default:
+        return;
+    }
+
+    const double trim = driftTrim(double(frames) * m_sampleRate / fmt.sampleRate());
+    const double step = fmt.sampleRate() * m_rate.load(std::memory_order_relaxed) / m_sampleRate * trim;
+    if (!m_resampling && step == 1.0)
+    {
+        write(stereo, frames);
+        return;
+    }
+
+    // Once resampling, stay with it until the stream starts over:
+    // dropping out of the filter would skip its delay
+    m_resampling = true;
+    m_resampler.setQuality(m_engine->resamplerQuality());
+    const int capacity = Resampler::outputFrames(frames, step);
+    if (m_resampled.size() < 2 * capacity)
+        m_resampled.resize(2 * capacity);
+    write(m_resampled.constData(),
+          m_resampler.process(stereo, frames, step, m_resampled.data(), capacity));
+}
+
+// Step multiplier that holds the ring at the level it settled to.
+// `frames` is what this push adds, in engine frames
+double AudioEngine::Voice::driftTrim(double frames)
+{
+    // Offline, or fed on the virtual clock it plays at: one clock,
+    // nothing to drift
+    if (m_engine->m_offline || m_engine->hasVirtualClock())
+        return 1.0;
+
+    // Sampled just before each write, so the phase is always the same
+    const double queued = double(queuedFrames());
+    const double alpha = qMin(1.0, frames / (m_sampleRate * kFillSmoothingMs / 1000.0));
+    m_fill = m_fillSeen > 0.0 ? m_fill + alpha * (queued - m_fill) : queued;
+    m_fillSeen += frames;
+    if (m_fillRef < 0.0)
+    {
+        if (m_fillSeen >= m_sampleRate * kFillSettleMs / 1000.0)
+            m_fillRef = m_fill;
+        return 1.0;
+    }
+
+    // Fuller than it settled: the player is ahead, consume faster
+    const double offsetS = (m_fill - m_fillRef) / m_sampleRate;
+    if (!m_resampling && std::fabs(offsetS) * 1000.0 < kDriftDeadbandMs)
+        return 1.0;
+    return 1.0 + qBound(-kDriftMaxTrim, kDriftGain * offsetS, kDriftMaxTrim);
+}
+
+void AudioEngine::Voice::write(const float *stereo, int frames)
+{
+    const qint64 written = m_written.load(std::memory_order_relaxed);
+    const qint64 free = m_capacity - (written - m_read.load(std::memory_order_acquire));
+    // The player runs at its own clock; if it ever gets a full
+    // second ahead despite the drift trim, the newest audio is what
+    // has to give, and stats() reports it
+    if (frames > free)
+    {
+        m_engine->m_droppedFrames.fetch_add(frames - qMax<qint64>(0, free), std::memory_order_relaxed);
+        frames = int(qMax<qint64>(0, free));
+    }
+    if (frames <= 0)
+        return;
+
+    const qint64 at = written % m_capacity;
+    const qint64 first = qMin<qint64>(frames, m_capacity - at);
+    std::memcpy(m_ring.data() + 2 * at, stereo, sizeof(float) * 2 * first);
+    if (first < frames)
+        std::memcpy(m_ring.data(), stereo + 2 * first, sizeof(float) * 2 * (frames - first));
+    m_written.store(written + frames, std::memory_order_release);
+}
+
+void AudioEngine::Voice::flush()
+{
+    // Everything written so far goes; what the player delivers
+    // from now on (after the seek) is kept
+    m_flushTo.store(m_written.load(std::memory_order_acquire), std::memory_order_release);
+    m_resetInput.store(true, std::memory_order_release);
+}
+
+/* ============================================================
+ * VOICE – render thread side
+ * ============================================================ */
+// Fills m_block with up to `frames` frames, gain, fades and
+// ducking applied; returns how many (0: the voice is silent)
+int AudioEngine::Voice::pull(int frames, quint64 released, int rampFrames,
+                             const float *duckGains, float *duckKey)
+{
+    qint64 read = m_read.load(std::memory_order_relaxed);
+
+    // Released by PANIC: the bus has already been ramped down.
+    // Stay silent (dropping whatever the player still delivers)
+    // until the cue is started again
+    if (m_armedEpoch.load(std::memory_order_acquire) < released)
+    {
+        m_flushTo.store(-1, std::memory_order_relaxed);
+        m_read.store(m_written.load(std::memory_order_acquire), std::memory_order_release);
+        m_primed = false;
+        m_drained = false;
+        m_fadeLeft = 0;
+        m_gain = 0.0f;
+        return 0;
+    }
+
+    // Stop, pause or seek: what is queued fades out over the ramp
+    // instead of being cut, then is skipped up to the flush point
+    const qint64 flushTo = m_flushTo.exchange(-1, std::memory_order_acq_rel);
+    if (flushTo >= 0)
+    {
+        m_drained = false;
+        if (m_primed)
+        {
+            m_fadeEnd = flushTo;
+            if (m_fadeLeft == 0)
+                m_fadeLeft = m_fadeLength = qMax(1, rampFrames);
+        }
+        else
+        {
+            read = qMax(read, flushTo);
+            m_read.store(read, std::memory_order_release);
+        }
+    }
+
+    qint64 available = m_written.load(std::memory_order_acquire) - read;
+    if (m_fadeLeft > 0)
+        available = qMin(available, m_fadeEnd - read);
+    if (!m_primed)
+    {
+        if (available < m_primeFrames)
+            return 0;
+        // Nothing was sounding: start at the target instead of
+        // ramping from the gain the voice last stopped with. After
+        // a drain that no stop or seek explains, this is a gap
+        if (m_drained)
+            m_engine->m_reprimes.fetch_add(1, std::memory_order_relaxed);
+        m_drained = false;
+        m_primed = true;
+        m_gain = m_targetGain.load(std::memory_order_relaxed);
+    }
+
+    int n = int(qMin<qint64>(frames, available));
+    if (m_fadeLeft > 0)
+        n = qMin(n, m_fadeLeft);
+    if (n <= 0)
+    {
+        // Drained: end of the cue, the player fell behind, or a
+        // fade ran out of queued audio. Either way, wait for a
+        // fresh prime before sounding again
+        if (m_fadeLeft > 0)
+        {
+            m_read.store(qMax(read, m_fadeEnd), std::memory_order_release);
+            m_fadeLeft = 0;
+        }
+        else if (m_primed)
+        {
+            m_drained = true;
+        }
+        m_primed = false;
+        return 0;
+    }
+
+    float *block = m_block.data();
+    const qint64 at = read % m_capacity;
+    const qint64 first = qMin<qint64>(n, m_capacity - at);
+    std::memcpy(block, m_ring.constData() + 2 * at, sizeof(float) * 2 * first);
+    if (first < n)
+        std::memcpy(block + 2 * first, m_ring.constData(), sizeof(float) * 2 * (n - first));
+    read += n;
+
+    // Gain ramps across the block from where the last one ended
+    const float target = m_targetGain.load(std::memory_order_relaxed);
+    const float step = (target - m_gain) / n;
+    float g = m_gain;
+    for (int f = 0; f < n; ++f)
+    {
+        g += step;
+        float gf = g;
+        if (m_fadeLeft > 0)
+            gf *= float(m_fadeLeft - f - 1) / m_fadeLength;
+        block[2 * f] *= gf;
+        block[2 * f + 1] *= gf;
+        if (duckKey)
+            duckKey[f] = qMax(duckKey[f], qMax(std::fabs(block[2 * f]), std::fabs(block[2 * f + 1])));
+        if (duckGains)
+        {
+            block[2 * f] *= duckGains[f];
+            block[2 * f + 1] *= duckGains[f];
+        }
+    }
+    m_gain = target;
+
+    if (m_fadeLeft > 0)
+    {
+        m_fadeLeft -= n;
+        if (m_fadeLeft == 0)
+        {
+            read = qMax(read, m_fadeEnd);
+            m_primed = false;
+        }
+    }
+    m_read.store(read, std::memory_order_release);
+
+    m_meter.process(block, n, 2, m_sampleRate);
+    return n;
+}
+
+void AudioEngine::Voice::setDucking(DuckRole role, int bus)
+{
+    m_duck.store(int(role) << 8 | qBound(0, bus, kDuckBuses - 1), std::memory_order_relaxed);
+}
+
+AudioEngine::DuckRole AudioEngine::Voice::duckRole() const
+{
+    return DuckRole(m_duck.load(std::memory_order_relaxed) >> 8);
+}
+
+int AudioEngine::Voice::duckBus() const
+{
+    return m_duck.load(std::memory_order_relaxed) & 0xff;
+}
+
+void AudioEngine::Voice::arm()
+{
+    m_armedEpoch.store(m_engine->m_panicRequested.load(std::memory_order_acquire),
+                       std::memory_order_release);
+}
+
+qint64 AudioEngine::Voice::queuedFrames() const
+{
+    return m_written.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+}
+
+qint64 AudioEngine::Voice::playedFrames() const
+{
+    return m_read.load(std::memory_order_acquire);
+}
+
+/* ============================================================
+ * ENGINE
+ * ============================================================ */
+AudioEngine *AudioEngine::instance()
+{
+    static AudioEngine *s_instance = nullptr;
+    if (!s_instance)
+        s_instance = new AudioEngine(QCoreApplication::instance());
+    return s_instance;
+}
+
+AudioEngine::AudioEngine(QObject *parent)
+    : QObject(parent)
+{
+    // The rate is fixed for the session: voices resample to it,
+    // and every output device is opened at it
+    const QByteArray backend = qgetenv("ACP_AUDIO_OUTPUT");
+    const QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (backend == "null" || backend == "virtual")
+    {
+        m_headless = true;
+        if (backend == "virtual")
+        {
+            m_headlessClock = NullAudioSink::Clock::Manual;
+            FrameTicker::instance()->setVirtualTime(true);
+        }
+    }
+    else if (device.isNull())
+    {
+        qWarning() << "AudioEngine: no audio output device, playing into the null output";
+        m_headless = true;
+    }
+    else if (device.preferredFormat().sampleRate() > 0)
+    {
+        m_sampleRate = device.preferredFormat().sampleRate();
+    }
+    setupBuses();
+    setRouting(defaultRouting());
+}
+
+AudioEngine::AudioEngine(int sampleRate, QObject *parent)
+    : QObject(parent),
+      m_sampleRate(sampleRate),
+      m_offline(true)
+{
+    setupBuses();
+    m_routing = defaultRouting();
+    m_busCount = m_routing.size();
+    m_configured.store(true, std::memory_order_release);
+}
+
+void AudioEngine::setupBuses()
+{
+    m_rampFrames = m_sampleRate * kRampMs / 1000;
+    for (Bus &bus : m_buses)
+    {
+        bus.limiter.setup(m_sampleRate);
+        bus.mix.fill(0.0f, 2 * kBlock);
+    }
+    m_panicGains.fill(0.0f, kBlock);
+    m_duckKeys.fill(0.0f, kDuckBuses * kBlock);
+    m_duckGains.fill(1.0f, kDuckBuses * kBlock);
+}
+
+AudioEngine::~AudioEngine()
+{
+    stopOutputs();
+    qDeleteAll(m_voices);
+    for (const Retired &r : std::as_const(m_retired))
+        delete r.voice;
+}
+
+/* ============================================================
+ * ROUTING – GUI thread
+ * ============================================================ */
+AudioEngine::Routing AudioEngine::defaultRouting()
+{
+    BusConfig main;
+    main.name = QStringLiteral("Main");
+    return { main };
+}
+
+QStringList AudioEngine::busNames() const
+{
+    QStringList names;
+    for (const BusConfig &bus : m_routing)
+        names << bus.name;
+    return names;
+}
+
+void AudioEngine::stopOutputs()
+{
+    // Nothing renders once the primary is gone, so it goes first:
+    // the followers' send blocks are written from its thread
+    m_configured.store(false, std::memory_order_release);
+    qDeleteAll(m_outputs);
+    m_outputs.clear();
+    m_running.store(false, std::memory_order_release);
+    for (Bus &bus : m_buses)
+        bus.output = nullptr;
+}
+
+void AudioEngine::setRouting(const Routing &routing)
+{
+    if (m_offline)
+        return;
+    stopOutputs();
+    m_routing = routing.isEmpty() ? defaultRouting() : routing.mid(0, kMaxBuses);
+    m_busCount = m_routing.size();
+
+    // Headless: one null output, as wide as the highest channel
+    // pair, carries every bus
+    if (m_headless)
+    {
+        int width = 2;
+        for (const BusConfig &config : std::as_const(m_routing))
+            width = qMax(width, qMax(0, config.firstChannel) + 2);
+        m_outputs.append(new EngineOutput(this, width, m_sampleRate, m_headlessClock));
+    }
+
+    // One output per device, in order of first use, as wide as
+    // its highest channel pair; bus 0's device is the clock
+    const QList<QAudioDevice> available = QMediaDevices::audioOutputs();
+    QList<QAudioDevice> devices;
+    QVector<int> widths;
+    int deviceOf[kMaxBuses];
+    for (int b = 0; b < m_busCount; ++b)
+    {
+        const BusConfig &config = m_routing[b];
+        QAudioDevice device = QMediaDevices::defaultAudioOutput();
+        for (const QAudioDevice &d : available)
+        {
+            if (!config.deviceId.isEmpty() && d.id() == config.deviceId)
+                device = d;
+        }
+        deviceOf[b] = m_headless ? 0 : -1;
+        if (m_headless || device.isNull())
+            continue;
+        if (!config.deviceId.isEmpty() && device.id() != config.deviceId)
+            qWarning() << "AudioEngine: bus" << config.name << "falls back to" << device.description();
+
+        int i = 0;
+        while (i < devices.size() && devices[i].id() != device.id())
+            ++i;
+        if (i == devices.size())
+        {
+            devices.append(device);
+            widths.append(2);
+        }
+        widths[i] = qMax(widths[i], qMax(0, config.firstChannel) + 2);
+        deviceOf[b] = i;
+    }
+
+    for (int i = 0; i < devices.size(); ++i)
+    {
+        const int channels = qMin(widths[i], qMax(2, devices[i].maximumChannelCount()));
+        m_outputs.append(new EngineOutput(this, devices[i], channels, m_sampleRate, i == 0));
+    }
+
+    for (int b = 0; b < kMaxBuses; ++b)
+    {
+        Bus &bus = m_buses[b];
+        bus.limiter.reset();
+        bus.sounding = false;
+        if (b >= m_busCount)
+            continue;
+        const BusConfig &config = m_routing[b];
+        bus.output = deviceOf[b] >= 0 ? m_outputs[deviceOf[b]] : nullptr;
+        bus.firstChannel = qMax(0, config.firstChannel);
+        if (bus.output && bus.firstChannel + 2 > bus.output->channels())
+        {
+            qWarning() << "AudioEngine: bus" << config.name << "wants channels"
+                       << bus.firstChannel + 1 << "-" << bus.firstChannel + 2
+                       << "of" << bus.output->description() << "; using 1-2";
+            bus.firstChannel = 0;
+        }
+        bus.gain.store(float(qPow(10.0, config.gainDb / 20.0)), std::memory_order_relaxed);
+        bus.muted.store(config.muted, std::memory_order_relaxed);
+        bus.appliedGain = config.muted ? 0.0f : bus.gain.load(std::memory_order_relaxed);
+    }
+
+    m_running.store(!m_outputs.isEmpty() && m_outputs.first()->isRunning(),
+                    std::memory_order_release);
+    m_configured.store(true, std::memory_order_release);
+    emit routingChanged();
+}
+
+/* ============================================================
+ * VIRTUAL CLOCK – GUI thread
+ * ============================================================ */
+void AudioEngine::advanceClock(qint64 frames)
+{
+    NullAudioSink *sink = m_outputs.isEmpty() ? nullptr : m_outputs.first()->nullSink();
+    if (!sink || sink->clock() != NullAudioSink::Clock::Manual)
+        return;
+
+    // Ticker time follows the samples, so a fade tick sees the
+    // position the audio has reached (to the ms, once a frame).
+    // The players feed their voices before each step and look at
+    // what was played after it, so nothing waits on a decoder's
+    // or a player's clock
+    FrameTicker *ticker = FrameTicker::instance();
+    const qint64 step = qMax<qint64>(1, qint64(m_sampleRate) * ticker->frameIntervalMs() / 1000);
+    while (frames > 0)
+    {
+        const qint64 n = qMin(frames, step);
+        emit aboutToAdvanceClock(n);
+        sink->advance(n);
+        frames -= n;
+        ticker->setVirtualNow(sink->framesPlayed() * 1000 / m_sampleRate);
+        emit clockAdvanced();
+    }
+}
+
+qint64 AudioEngine::clockFrames() const
+{
+    NullAudioSink *sink = m_outputs.isEmpty() ? nullptr : m_outputs.first()->nullSink();
+    return sink ? sink->framesPlayed() : -1;
+}
+
+void AudioEngine::setBusGain(int bus, float gainDb)
+{
+    if (bus < 0 || bus >= m_busCount)
+        return;
+    m_routing[bus].gainDb = gainDb;
+    m_buses[bus].gain.store(float(qPow(10.0, gainDb / 20.0)), std::memory_order_relaxed);
+}
+
+void AudioEngine::setBusMuted(int bus, bool muted)
+{
+    if (bus < 0 || bus >= m_busCount)
+        return;
+    m_routing[bus].muted = muted;
+    m_buses[bus].muted.store(muted, std::memory_order_relaxed);
+}
+
+/* ============================================================
+ * VOICES – GUI thread
+ * ============================================================ */
+AudioEngine::Voice *AudioEngine::createVoice()
+{
+    purgeRetired();
+    Voice *voice = new Voice(this, m_sampleRate);
+    QMutexLocker lock(&m_voicesMutex);
+    m_voices.append(voice);
+    m_pending = m_voices;
+    ++m_generation;
+    m_voicesChanged.store(true, std::memory_order_release);
+    return voice;
+}
+
+void AudioEngine::removeVoice(Voice *voice)
+{
+    if (!voice)
+        return;
+
+    {
+        QMutexLocker lock(&m_voicesMutex);
+        m_voices.removeOne(voice);
+        m_pending = m_voices;
+        m_retired.append({ voice, ++m_generation });
+        m_voicesChanged.store(true, std::memory_order_release);
+    }
+    purgeRetired();
+}
+
+// A removed voice is deleted once render() has picked up a list
+// without it (or straight away when nothing renders) and the last
+// Feed into it is gone; until then it waits for the next purge
+void AudioEngine::purgeRetired()
+{
+    QMutexLocker lock(&m_voicesMutex);
+    const bool running = m_running.load(std::memory_order_acquire);
+    const quint64 adopted = m_adopted.load(std::memory_order_acquire);
+    for (int i = m_retired.size() - 1; i >= 0; --i)
+    {
+        const Voice *voice = m_retired[i].voice;
+        if (voice->m_feeds.load(std::memory_order_acquire) > 0)
+            continue;
+        if (!running || m_retired[i].generation <= adopted)
+        {
+            delete m_retired[i].voice;
+            m_retired.removeAt(i);
+        }
+    }
+}
+
+// Any thread, no locks: the render thread picks it up at its
+// next block, whatever the GUI is doing
+void AudioEngine::panic()
+{
+    m_panicRequested.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void AudioEngine::setLimiter(float ceilingDb, float releaseMs)
+{
+    for (Bus &bus : m_buses)
+    {
+        bus.limiter.setCeilingDb(ceilingDb);
+        bus.limiter.setReleaseMs(releaseMs);
+    }
+}
+
+void AudioEngine::setResamplerQuality(Resampler::Quality quality)
+{
+    m_resamplerQuality.store(int(quality), std::memory_order_relaxed);
+}
+
+Resampler::Quality AudioEngine::resamplerQuality() const
+{
+    return Resampler::Quality(m_resamplerQuality.load(std::memory_order_relaxed));
+}
+
+void AudioEngine::setDucking(float attackMs, float releaseMs, float depthDb, float thresholdDb)
+{
+    m_duckAttackMs.store(attackMs, std::memory_order_relaxed);
+    m_duckReleaseMs.store(releaseMs, std::memory_order_relaxed);
+    m_duckDepthDb.store(depthDb, std::memory_order_relaxed);
+    m_duckThresholdDb.store(thresholdDb, std::memory_order_relaxed);
+}
+
+AudioEngine::Stats AudioEngine::stats() const
+{
+    Stats s;
+    s.running = m_running.load(std::memory_order_acquire);
+    s.sampleRate = m_sampleRate;
+    s.primeMs = kPrimeMs;
+    s.limiterMs = 1000.0 * m_buses[0].limiter.latencyFrames() / m_sampleRate;
+    // Per output: a follower adds what waits in its ring (40 ms and
+    // more as its clock drifts behind). PANIC is seen at the next
+    // block and then takes the device's own buffer and the ramp
+    const double blockMs = 1000.0 * kBlock / m_sampleRate;
+    s.latencyMs = s.primeMs + s.limiterMs;
+    s.panicMs = blockMs + kRampMs;
+    for (const EngineOutput *output : m_outputs)
+    {
+        const double latencyMs = s.primeMs + s.limiterMs + output->queuedMs() + output->bufferMs();
+        const double panicMs = blockMs + output->bufferMs() + kRampMs;
+        s.outputs << QStringLiteral("%1: %2 channels, %3, %4 ms buffer, latency %5 ms, PANIC %6 ms%7")
+                         .arg(output->description())
+                         .arg(output->channels())
+                         .arg(output->sampleFormat())
+                         .arg(output->bufferMs(), 0, 'f', 1)
+                         .arg(latencyMs, 0, 'f', 1)
+                         .arg(panicMs, 0, 'f', 1)
+                         .arg(output->isRunning() ? QString() : QStringLiteral(" (not running)"));
+        s.underruns += output->underruns();
+        s.latencyMs = qMax(s.latencyMs, latencyMs);
+        s.panicMs = qMax(s.panicMs, panicMs);
+    }
+    if (!m_outputs.isEmpty())
+    {
+        s.sampleFormat = m_outputs.first()->sampleFormat();
+        s.bufferMs = m_outputs.first()->bufferMs();
+    }
+    s.cpuPercent = 100.0 * m_cpu.load(std::memory_order_relaxed);
+    s.cpuPeakPercent = 100.0 * m_cpuPeak.exchange(0.0f, std::memory_order_relaxed);
+    s.gainReductionDb = m_buses[0].limiter.gainReductionDb();
+    s.droppedMs = 1000.0 * m_droppedFrames.load(std::memory_order_relaxed) / m_sampleRate;
+    s.reprimes = m_reprimes.load(std::memory_order_relaxed);
+    {
+        QMutexLocker lock(&m_voicesMutex);
+        s.voices = m_voices.size();
+    }
+    return s;
+}
+
+/* ============================================================
+ * DUCKING – render thread, one gain per frame
+ * ============================================================ */
+void AudioEngine::duck(DuckBus &bus, const float *key, float *gains, int frames)
+{
+    const double rate = m_sampleRate;
+    const auto coefficient = [rate](float ms) {
+        return float(1.0 - std::exp(-1000.0 / (qMax(1.0f, ms) * rate)));
+    };
+    const float attack = coefficient(m_duckAttackMs.load(std::memory_order_relaxed));
+    const float release = coefficient(m_duckReleaseMs.load(std::memory_order_relaxed));
+    const float depth = float(qPow(10.0, qMin(0.0f, m_duckDepthDb.load(std::memory_order_relaxed)) / 20.0));
+    const float threshold = float(qPow(10.0, m_duckThresholdDb.load(std::memory_order_relaxed) / 20.0));
+    // The key follows peaks at once and lets go over ~50 ms, so
+    // the gaps between waveform peaks (and syllables) do not count
+    const float keyDecay = float(std::exp(-1000.0 / (50.0 * rate)));
+
+    float env = bus.envelope, g = bus.gain;
+    for (int f = 0; f < frames; ++f)
+    {
+        env = key[f] > env ? key[f] : env * keyDecay;
+        const float target = env > threshold ? depth : 1.0f;
+        g += (target - g) * (target < g ? attack : release);
+        gains[f] = g;
+    }
+
+    // Settled back at unity with a silent key: the bus goes idle
+    bus.envelope = env > threshold * 1e-3f ? env : 0.0f;
+    bus.gain = g > 0.9999f && bus.envelope <= 0.0f ? 1.0f : g;
+}
+
+/* ============================================================
+ * RENDER – primary output thread
+ * ============================================================ */
+void AudioEngine::routeVoice(const Voice *voice, int frames)
+{
+    const quint32 mask = voice->m_buses.load(std::memory_order_relaxed);
+    const float *block = voice->m_block.constData();
+    for (int b = 0; b < m_busCount; ++b)
+    {
+        if (!(mask & (1u << b)))
+            continue;
+        Bus &bus = m_buses[b];
+        float *mix = bus.mix.data();
+        for (int i = 0; i < 2 * frames; ++i)
+            mix[i] += block[i];
+        bus.sounding = true;
+    }
+}
+
+// Gain, limiter, PANIC ramp and meter, then onto its channel pair
+void AudioEngine::finishBus(Bus &bus, float *out, int channels, int frames, const float *panicGains)
+{
+    float *mix = bus.mix.data();
+
+    const float target = bus.muted.load(std::memory_order_relaxed)
+        ? 0.0f : bus.gain.load(std::memory_order_relaxed);
+    if (target != 1.0f || bus.appliedGain != 1.0f)
+    {
+        const float step = (target - bus.appliedGain) / frames;
+        float g = bus.appliedGain;
+        for (int f = 0; f < frames; ++f)
+        {
+            g += step;
+            mix[2 * f] *= g;
+            mix[2 * f + 1] *= g;
+        }
+        bus.appliedGain = target;
+    }
+
+    bus.limiter.process(mix, frames);
+
+    // After the limiter, so its look-ahead adds no delay
+    if (panicGains)
+    {
+        for (int f = 0; f < frames; ++f)
+        {
+            mix[2 * f] *= panicGains[f];
+            mix[2 * f + 1] *= panicGains[f];
+        }
+    }
+    // Silence is not metered, so an idle bus reads as idle (and
+    // its display can rest)
+    if (bus.sounding)
+        bus.meter.process(mix, frames, 2, m_sampleRate);
+
+    // Offline, every bus lands on the stereo mixdown
+    if (!bus.output && !m_offline)
+        return;
+    float *dest = out;
+    int width = channels;
+    if (bus.output && !bus.output->isPrimary())
+    {
+        dest = bus.output->sendBlock();
+        width = bus.output->channels();
+    }
+    const int first = bus.output ? bus.firstChannel : 0;
+    if (first + 2 > width)
+        return;
+    dest += first;
+    for (int f = 0; f < frames; ++f)
+    {
+        dest[f * width] += mix[2 * f];
+        dest[f * width + 1] += mix[2 * f + 1];
+    }
+}
+
+void AudioEngine::render(float *out, int frames, int channels)
+{
+    std::memset(out, 0, sizeof(float) * frames * channels);
+    // setRouting() at work: the primary may already pull before the
+    // buses are assigned
+    if (!m_configured.load(std::memory_order_acquire))
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Pick up added / removed voices; never wait for the GUI. A
+    // swap, so the old list is released by the GUI's next edit
+    // and never freed here
+    if (m_voicesChanged.load(std::memory_order_acquire) && m_voicesMutex.tryLock())
+    {
+        m_live.swap(m_pending);
+        m_adopted.store(m_generation, std::memory_order_release);
+        m_voicesChanged.store(false, std::memory_order_relaxed);
+        m_voicesMutex.unlock();
+    }
+
+    // PANIC: ramp every bus down from this block on. A second
+    // request during the ramp just releases the voices armed since
+    const quint64 panic = m_panicRequested.load(std::memory_order_acquire);
+    if (panic != m_panicSeen)
+    {
+        m_panicSeen = panic;
+        if (m_panicLeft == 0)
+        {
+            m_panicLeft = m_rampFrames;
+            // Followers still hold up to a ring of audio from before
+            for (int i = 1; i < m_outputs.size(); ++i)
+                m_outputs[i]->cut(m_rampFrames);
+        }
+    }
+
+    for (int done = 0; done < frames; done += kBlock)
+    {
+        const int n = qMin(kBlock, frames - done);
+        for (int b = 0; b < m_busCount; ++b)
+        {
+            std::memset(m_buses[b].mix.data(), 0, sizeof(float) * 2 * n);
+            m_buses[b].sounding = false;
+        }
+        for (int i = 1; i < m_outputs.size(); ++i)
+            m_outputs[i]->clearSend(n);
+
+        // Everything but the ducked voices, collecting the duckers'
+        // level per bus on the way
+        float *keys = m_duckKeys.data();
+        std::memset(keys, 0, sizeof(float) * kDuckBuses * kBlock);
+        bool keyed[kDuckBuses] = {};
+        bool anyDucked = false;
+        for (Voice *voice : std::as_const(m_live))
+        {
+            const DuckRole role = voice->duckRole();
+            if (role == DuckRole::Ducked)
+            {
+                anyDucked = true;
+                continue;
+            }
+            float *key = nullptr;
+            if (role == DuckRole::Ducker)
+            {
+                key = keys + voice->duckBus() * kBlock;
+                keyed[voice->duckBus()] = true;
+            }
+            if (const int got = voice->pull(n, m_released, m_rampFrames, nullptr, key))
+                routeVoice(voice, got);
+        }
+
+        // Then the ducked voices, under their bus's gain curve
+        if (anyDucked)
+        {
+            const float *gains[kDuckBuses] = {};
+            for (int b = 0; b < kDuckBuses; ++b)
+            {
+                if (!keyed[b] && m_duckBuses[b].idle())
+                    continue;
+                float *g = m_duckGains.data() + b * kBlock;
+                duck(m_duckBuses[b], keys + b * kBlock, g, n);
+                gains[b] = g;
+            }
+            for (Voice *voice : std::as_const(m_live))
+            {
+                if (voice->duckRole() != DuckRole::Ducked)
+                    continue;
+                if (const int got = voice->pull(n, m_released, m_rampFrames,
+                                                gains[voice->duckBus()], nullptr))
+                    routeVoice(voice, got);
+            }
+        }
+
+        // One PANIC curve for every bus
+        const float *panicGains = nullptr;
+        if (m_panicLeft > 0)
+        {
+            float *g = m_panicGains.data();
+            for (int f = 0; f < n; ++f)
+                g[f] = float(qMax(0, m_panicLeft - f - 1)) / m_rampFrames;
+            panicGains = g;
+        }
+
+        for (int b = 0; b < m_busCount; ++b)
+            finishBus(m_buses[b], out + qsizetype(done) * channels, channels, n, panicGains);
+        for (int i = 1; i < m_outputs.size(); ++i)
+            m_outputs[i]->send(n);
+
+        if (m_panicLeft > 0)
+        {
+            m_panicLeft = qMax(0, m_panicLeft - n);
+            if (m_panicLeft == 0)
+            {
+                // Down: release the voices, and forget the audio
+                // still in the limiters' delay lines
+                m_released = m_panicSeen;
+                for (int b = 0; b < m_busCount; ++b)
+                    m_buses[b].limiter.reset();
+            }
+        }
+    }
+
+    const double audioNs = 1e9 * frames / m_sampleRate;
+    const float load = float(timer.nsecsElapsed() / audioNs);
+    const float cpu = m_cpu.load(std::memory_order_relaxed);
+    m_cpu.store(cpu + (load - cpu) * kCpuSmoothing, std::memory_order_relaxed);
+    if (load > m_cpuPeak.load(std::memory_order_relaxed))
+        m_cpuPeak.store(load, std::memory_order_relaxed);
+}
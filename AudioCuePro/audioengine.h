@@ -0,0 +1,339 @@
+#ifndef AUDIOENGINE_H
+#define AUDIOENGINE_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+
+#include "brickwalllimiter.h"
+#include "levelmeter.h"
+#include "nullaudiosink.h"
+#include "resampler.h"
+
+class QAudioBuffer;
+class EngineOutput;
+
+/*
+============================================================
+ AudioEngine
+------------------------------------------------------------
+ - The mixer. Every cue's player hands its decoded buffers to
+   a Voice (QAudioBufferOutput, no QAudioOutput of its own);
+   the engine mixes the voices into buses and the buses into
+   the channels of one or more audio devices
+ - Routing matrix: voice -> buses (a bit mask, any number),
+   bus -> one device and channel pair. Each bus has its own
+   gain, mute, brickwall limiter and meter, and is mixed once
+   per block however many cues feed it. Bus 0 is "Main"
+ - Each device is an EngineOutput with its own sink thread;
+   the first one's pulls drive render(), the others are fed
+   through rings (see EngineOutput)
+ - render() neither locks nor allocates: voices are lock-free
+   single-producer / single-consumer rings, and the voice list
+   is picked up with a tryLock() snapshot
+ - Voice gain is applied in the mix with a per-block ramp, so
+   fader moves and fades are click-free and may exceed unity:
+   the limiter, not a per-player clamp, keeps the sum legal
+ - Levels are measured where the audio actually is: each
+   voice after its gain, each bus after its limiter
+ - Ducking is part of the mix: duckers are mixed first and
+   their peak level keys one gain curve per duck bus, applied
+   frame by frame to the ducked voices of the same block
+ - panic() is lock-free and needs nothing from the GUI thread:
+   the next rendered block ramps every bus to silence (8 ms)
+   and releases every voice; follower outputs fade out what
+   their rings still hold over the same ramp. Stop, pause and seek fade the
+   queued audio of one voice over the same ramp
+ - Offline: an engine built with a sample rate opens no
+   device; its owner calls render() as fast as it likes and
+   gets every bus mixed down to stereo (ShowRender)
+ - Headless: ACP_AUDIO_OUTPUT=null plays into a NullAudioSink
+   paced by wall time (also what happens when there is no
+   output device); =virtual gives it a manual clock, and
+   nothing moves until advanceClock(), which steps
+   FrameTicker's time with the samples: fades and other
+   ticker driven logic follow the sample clock in whole ms,
+   one display frame at a time. Cues play through a
+   VirtualPlayer there, fed before each step from a decoder
+   instead of QMediaPlayer, so loops and the end of a cue
+   follow the samples too (--benchmark virtual-fade and
+   virtual-show check fades, loops and GOs)
+ - Float at the default device's preferred rate, fixed for
+   the session; every device is opened at that rate. Each
+   voice converts its media to it with a polyphase Resampler,
+   which also plays the cue's speed / pitch (varispeed) and
+   trims the step by up to 1000 ppm to hold the voice's ring
+   level against drift between the player's clock and the
+   device's. Latency, render load, audio dropped from a
+   full ring and re-primes after running dry are reported
+   through stats()
+============================================================
+*/
+
+class AudioEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Ducking: a Ducker voice's level lowers every Ducked voice on
+    // the same bus (announcement over background music)
+    enum class DuckRole { None, Ducker, Ducked };
+    static constexpr int kDuckBuses = 4;
+
+    static constexpr int kBlockFrames = 512;    // frames mixed per pass
+    static constexpr int kMaxBuses = 8;
+
+    // One output bus: where it plays and at what level. An empty
+    // device id is the system default output
+    struct BusConfig {
+        QString name;
+        QByteArray deviceId;
+        int firstChannel = 0;           // left; right is the next one
+        float gainDb = 0.0f;
+        bool muted = false;
+    };
+    using Routing = QVector<BusConfig>;
+    static Routing defaultRouting();
+
+    class Feed;
+    class Voice
+    {
+    public:
+        // Delivery thread (the player's buffer output)
+        void push(const QAudioBuffer &buffer);
+
+        // Any thread
+        void setGain(float gain) { m_targetGain.store(gain, std::memory_order_relaxed); }
+        // Varispeed: the player delivers `rate` seconds of media per
+        // second (QMediaPlayer::setPlaybackRate), the voice plays it
+        // back in real time, pitch following speed
+        void setRate(double rate) { m_rate.store(rate, std::memory_order_relaxed); }
+        void flush();                   // fade out what is queued (stop, seek)
+        void arm();                     // before playing: not released by an earlier PANIC
+        void setDucking(DuckRole role, int bus);
+        void setBuses(quint32 mask) { m_buses.store(mask, std::memory_order_relaxed); }
+        const LevelMeter &meter() const { return m_meter; }
+        qint64 queuedFrames() const;    // pushed, not yet mixed
+        qint64 playedFrames() const;    // mixed (or skipped by a flush) since the voice was made
+
+    private:
+        friend class AudioEngine;
+        friend class Feed;
+        Voice(AudioEngine *engine, int sampleRate);
+        Voice(const Voice &) = delete;
+        Voice &operator=(const Voice &) = delete;
+
+        double driftTrim(double frames);
+        void write(const float *stereo, int frames);
+        int pull(int frames, quint64 released, int rampFrames,
+                 const float *duckGains, float *duckKey);
+        DuckRole duckRole() const;
+        int duckBus() const;
+
+        AudioEngine *const m_engine;
+        const int m_sampleRate;
+        const qint64 m_capacity;        // frames
+        const qint64 m_primeFrames;
+        QVector<float> m_ring;          // stereo, m_capacity frames
+        std::atomic<qint64> m_written { 0 };
+        std::atomic<qint64> m_read { 0 };
+        std::atomic<qint64> m_flushTo { -1 };
+        std::atomic<bool> m_resetInput { false };
+        std::atomic<float> m_targetGain { 1.0f };
+        std::atomic<quint64> m_armedEpoch { 0 };
+        std::atomic<int> m_duck { 0 };  // role << 8 | bus
+        std::atomic<quint32> m_buses { 1 };
+        std::atomic<double> m_rate { 1.0 };
+        std::atomic<int> m_feeds { 0 };  // live Feed copies
+
+        // Delivery thread: conversion to stereo float, then to the
+        // engine rate and speed. Bypassed while both match, until
+        // the stream starts over
+        QVector<float> m_stereo;
+        QVector<float> m_resampled;
+        Resampler m_resampler;
+        bool m_resampling = false;
+        double m_fill = 0.0;            // ring level, smoothed (frames)
+        double m_fillSeen = 0.0;        // frames pushed since the stream started
+        double m_fillRef = -1.0;        // settled level; -1 until then
+
+        // Render thread
+        QVector<float> m_block;         // what pull() produced, after gain
+        float m_gain = 1.0f;
+        bool m_primed = false;
+        bool m_drained = false;         // ran dry mid-stream
+        int m_fadeLeft = 0;             // flush fade in progress
+        int m_fadeLength = 1;
+        qint64 m_fadeEnd = 0;
+        LevelMeter m_meter;
+    };
+
+    // What the delivery thread pushes through. A removed voice is
+    // not deleted while a copy is alive: Qt keeps a slot's functor
+    // until its last call has returned, so a functor holding a Feed
+    // can never push into a freed voice, whatever disconnect() raced
+    class Feed
+    {
+    public:
+        explicit Feed(Voice *voice);
+        Feed(const Feed &other);
+        Feed &operator=(const Feed &) = delete;
+        ~Feed();
+
+        void push(const QAudioBuffer &buffer) const { m_voice->push(buffer); }
+
+    private:
+        Voice *const m_voice;
+    };
+
+    struct Stats {
+        bool running = false;
+        int sampleRate = 0;
+        QString sampleFormat;
+        QStringList outputs;            // one line per device, with its latency and PANIC time
+        double bufferMs = 0.0;          // primary sink buffer
+        double primeMs = 0.0;           // a voice waits for this much before it sounds
+        double limiterMs = 0.0;         // look-ahead
+        double latencyMs = 0.0;         // all three, plus a follower's ring: the slowest output
+        double panicMs = 0.0;           // worst case from panic() to silence, on any output
+        double cpuPercent = 0.0;        // render time / audio time, smoothed
+        double cpuPeakPercent = 0.0;    // worst block since the last stats()
+        float gainReductionDb = 0.0f;
+        int voices = 0;
+        int underruns = 0;
+        double droppedMs = 0.0;         // newest audio lost to a full voice ring
+        int reprimes = 0;               // a voice ran dry mid-stream and waited to re-prime
+    };
+
+    static AudioEngine *instance();
+    // Offline engine (no devices, render() mixes down to stereo)
+    explicit AudioEngine(int sampleRate, QObject *parent = nullptr);
+    ~AudioEngine() override;
+
+    Voice *createVoice();
+    void removeVoice(Voice *voice);
+
+    // Every voice to silence within stats().panicMs, with a short
+    // ramp instead of a click. Voices stay silent until arm()ed
+    void panic();
+
+    void setLimiter(float ceilingDb, float releaseMs);
+    void setDucking(float attackMs, float releaseMs, float depthDb, float thresholdDb);
+    void setResamplerQuality(Resampler::Quality quality);
+    Resampler::Quality resamplerQuality() const;
+
+    // GUI thread. setRouting() restarts the devices (a short gap)
+    // and emits routingChanged(); gain and mute are live
+    void setRouting(const Routing &routing);
+    const Routing &routing() const { return m_routing; }
+    QStringList busNames() const;
+    void setBusGain(int bus, float gainDb);
+    void setBusMuted(int bus, bool muted);
+
+    const LevelMeter &busMeter(int bus) const { return m_buses[qBound(0, bus, kMaxBuses - 1)].meter; }
+    const LevelMeter &masterMeter() const { return busMeter(0); }
+    Stats stats() const;
+    int sampleRate() const { return m_sampleRate; }
+
+    // Virtual clock (ACP_AUDIO_OUTPUT=virtual), GUI thread: render
+    // `frames` frames now, running FrameTicker once per display
+    // frame of them. Does nothing on any other output
+    void advanceClock(qint64 frames);
+    bool hasVirtualClock() const { return m_headlessClock == NullAudioSink::Clock::Manual; }
+    // Frames played by a null output (the virtual sample clock);
+    // -1 on a real device
+    qint64 clockFrames() const;
+
+    // Primary output thread: mix `frames` frames of every bus,
+    // write the primary device's `channels` into `out`, queue the
+    // other devices' share
+    void render(float *out, int frames, int channels);
+
+signals:
+    void routingChanged();
+    // advanceClock(), per display frame: before the engine renders
+    // the next `frames` (feed the voices now) and after it has,
+    // with FrameTicker's time already moved
+    void aboutToAdvanceClock(qint64 frames);
+    void clockAdvanced();
+
+private:
+    explicit AudioEngine(QObject *parent = nullptr);
+
+    // One duck bus: the key's envelope against the threshold sets
+    // the target, the gain follows with attack / release, per frame
+    struct DuckBus {
+        float envelope = 0.0f;
+        float gain = 1.0f;
+        bool idle() const { return gain >= 1.0f && envelope <= 0.0f; }
+    };
+    void duck(DuckBus &bus, const float *key, float *gains, int frames);
+
+    struct Bus {
+        EngineOutput *output = nullptr; // none: mixed and metered only
+        int firstChannel = 0;
+        std::atomic<float> gain { 1.0f };
+        std::atomic<bool> muted { false };
+        float appliedGain = 1.0f;       // render thread, ramps to gain
+        bool sounding = false;          // fed this block
+        BrickwallLimiter limiter;
+        LevelMeter meter;
+        QVector<float> mix;             // stereo, one block
+    };
+
+    void setupBuses();
+    void stopOutputs();
+    void purgeRetired();
+    void routeVoice(const Voice *voice, int frames);
+    void finishBus(Bus &bus, float *out, int channels, int frames, const float *panicGains);
+
+    int m_sampleRate = 48000;
+    bool m_offline = false;
+    bool m_headless = false;            // a NullAudioSink instead of devices
+    NullAudioSink::Clock m_headlessClock = NullAudioSink::Clock::Realtime;
+    std::atomic<bool> m_running { false };
+    std::atomic<quint64> m_panicRequested { 0 };
+
+    // Routing: rebuilt by setRouting() while no output renders;
+    // m_configured publishes it to the render thread
+    Routing m_routing;
+    QVector<EngineOutput *> m_outputs;  // [0] is the primary
+    Bus m_buses[kMaxBuses];
+    int m_busCount = 0;
+    std::atomic<bool> m_configured { false };
+
+    // Voice list: edited on the GUI thread, picked up by render()
+    struct Retired { Voice *voice; quint64 generation; };
+    mutable QMutex m_voicesMutex;
+    QVector<Voice *> m_voices;
+    QVector<Voice *> m_pending;         // swapped with m_live by render()
+    QVector<Retired> m_retired;
+    quint64 m_generation = 0;
+    std::atomic<bool> m_voicesChanged { false };
+    std::atomic<quint64> m_adopted { 0 };
+
+    // Render thread
+    QVector<Voice *> m_live;
+    QVector<float> m_panicGains;
+    DuckBus m_duckBuses[kDuckBuses];
+    QVector<float> m_duckKeys;          // kDuckBuses x block, max |L,R| of the duckers
+    QVector<float> m_duckGains;
+    std::atomic<float> m_duckAttackMs { 20.0f };
+    std::atomic<float> m_duckReleaseMs { 600.0f };
+    std::atomic<float> m_duckDepthDb { -15.0f };
+    std::atomic<float> m_duckThresholdDb { -40.0f };
+    std::atomic<int> m_resamplerQuality { int(Resampler::Quality::Standard) };
+    int m_rampFrames = 0;
+    quint64 m_panicSeen = 0;
+    quint64 m_released = 0;             // voices armed before this are silent
+    int m_panicLeft = 0;                // frames of the PANIC ramp to go
+    std::atomic<qint64> m_droppedFrames { 0 };
+    std::atomic<int> m_reprimes { 0 };
+    std::atomic<float> m_cpu { 0.0f };
+    mutable std::atomic<float> m_cpuPeak { 0.0f };
+};
+
+#endif // AUDIOENGINE_H
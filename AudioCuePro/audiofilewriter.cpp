@@ -0,0 +1,443 @@
+#include "audiofilewriter.h"
+
+#include <QFileInfo>
+#include <QObject>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+
+static const int kFlacBlock = 4096;         // frames per FLAC frame
+static const int kFlacMaxOrder = 4;         // fixed predictors 0..4
+static const int kFlacMaxPartitionOrder = 8;
+static const int kBits = 24;
+static const qint32 kFullScale = (1 << (kBits - 1)) - 1;
+
+namespace {
+
+/* ============================================================
+ * BITS – MSB first, as FLAC stores everything
+ * ============================================================ */
+class BitWriter
+{
+public:
+    explicit BitWriter(QByteArray &out) : m_out(out) {}
+
+    void put(quint32 value, int bits)
+    {
+        m_acc = (m_acc << bits) | (quint64(value) & ((quint64(1) << bits) - 1));
+        m_bits += bits;
+        while (m_bits >= 8)
+        {
+            m_bits -= 8;
+            m_out.append(char(m_acc >> m_bits));
+        }
+    }
+    void putSigned(qint32 value, int bits) { put(quint32(value), bits); }
+
+    // q zeros, then a one
+    void putUnary(quint32 q)
+    {
+        for (; q >= 32; q -= 32)
+            put(0, 32);
+        put(1, int(q) + 1);
+    }
+
+    void align()
+    {
+        if (m_bits > 0)
+            put(0, 8 - m_bits);
+    }
+
+private:
+    QByteArray &m_out;
+    quint64 m_acc = 0;
+    int m_bits = 0;                     // pending in m_acc, < 8 between calls
+};
+
+quint8 crc8(const char *data, qsizetype size)
+{
+    quint8 crc = 0;
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc ^= quint8(data[i]);
+        for (int b = 0; b < 8; ++b)
+            crc = crc & 0x80 ? quint8((crc << 1) ^ 0x07) : quint8(crc << 1);
+    }
+    return crc;
+}
+
+quint16 crc16(const char *data, qsizetype size)
+{
+    quint16 crc = 0;
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        crc ^= quint16(quint8(data[i])) << 8;
+        for (int b = 0; b < 8; ++b)
+            crc = crc & 0x8000 ? quint16((crc << 1) ^ 0x8005) : quint16(crc << 1);
+    }
+    return crc;
+}
+
+// Frame numbers are coded like UTF-8 (up to 36 bits)
+void putUtf8(BitWriter &bits, quint64 value)
+{
+    if (value < 0x80)
+    {
+        bits.put(quint32(value), 8);
+        return;
+    }
+    int bytes = 2;
+    while (bytes < 7 && value >= (quint64(1) << (5 * bytes + 1)))
+        ++bytes;
+    const quint32 lead = bytes == 7 ? 0xfe : (0xff00 >> bytes) & 0xff;
+    bits.put(lead | quint32(value >> (6 * (bytes - 1))), 8);
+    for (int i = bytes - 2; i >= 0; --i)
+        bits.put(0x80 | quint32((value >> (6 * i)) & 0x3f), 8);
+}
+
+/* ============================================================
+ * FLAC SUBFRAME – fixed predictor, partitioned Rice residual
+ * ============================================================ */
+struct Rice {
+    int partitionOrder = 0;
+    int params[1 << kFlacMaxPartitionOrder] = {};
+    qint64 bits = 0;
+};
+
+inline qint32 toInt24(float v)
+{
+    return qint32(std::lrint(qBound(-1.0f, v, 1.0f) * kFullScale));
+}
+
+inline quint32 zigzag(qint32 v)
+{
+    return (quint32(v) << 1) ^ quint32(v >> 31);
+}
+
+// Cheapest parameter for one partition: m values summing to sum
+int riceParam(const quint32 *u, int m, qint64 *bitsOut)
+{
+    qint64 sum = 0;
+    for (int i = 0; i < m; ++i)
+        sum += u[i];
+    int guess = 0;
+    while (guess < 30 && (qint64(m) << (guess + 1)) < sum)
+        ++guess;
+
+    int best = guess;
+    qint64 bestBits = -1;
+    for (int k = qMax(0, guess - 1); k <= qMin(30, guess + 1); ++k)
+    {
+        qint64 bits = qint64(m) * (k + 1);
+        for (int i = 0; i < m; ++i)
+            bits += u[i] >> k;
+        if (bestBits < 0 || bits < bestBits)
+        {
+            bestBits = bits;
+            best = k;
+        }
+    }
+    *bitsOut = qMax<qint64>(0, bestBits);
+    return best;
+}
+
+Rice planRice(const quint32 *u, int blockSize, int order)
+{
+    Rice best;
+    best.bits = -1;
+    for (int p = 0; p <= kFlacMaxPartitionOrder; ++p)
+    {
+        if (blockSize % (1 << p) != 0 || (blockSize >> p) <= order)
+            break;
+        Rice r;
+        r.partitionOrder = p;
+        r.bits = 2 + 4;
+        const int partition = blockSize >> p;
+        int at = 0;
+        for (int i = 0; i < (1 << p); ++i)
+        {
+            const int m = partition - (i == 0 ? order : 0);
+            qint64 bits = 0;
+            r.params[i] = riceParam(u + at, m, &bits);
+            r.bits += 5 + bits;
+            at += m;
+        }
+        if (best.bits < 0 || r.bits < best.bits)
+            best = r;
+    }
+    return best;
+}
+
+void fixedResidual(const qint32 *x, int n, int order, quint32 *u)
+{
+    for (int i = order; i < n; ++i)
+    {
+        qint64 e = 0;
+        switch (order)
+        {
+        case 0: e = x[i]; break;
+        case 1: e = qint64(x[i]) - x[i - 1]; break;
+        case 2: e = qint64(x[i]) - 2 * qint64(x[i - 1]) + x[i - 2]; break;
+        case 3: e = qint64(x[i]) - 3 * qint64(x[i - 1]) + 3 * qint64(x[i - 2]) - x[i - 3]; break;
+        default:
+            e = qint64(x[i]) - 4 * qint64(x[i - 1]) + 6 * qint64(x[i - 2])
+                - 4 * qint64(x[i - 3]) + x[i - 4];
+            break;
+        }
+        u[i - order] = zigzag(qint32(e));
+    }
+}
+
+void encodeSubframe(BitWriter &bits, const qint32 *x, int n)
+{
+    bool constant = true;
+    for (int i = 1; i < n && constant; ++i)
+        constant = x[i] == x[0];
+    if (constant)
+    {
+        bits.put(0, 1 + 6 + 1);         // CONSTANT
+        bits.putSigned(x[0], kBits);
+        return;
+    }
+
+    // Cheapest fixed order; verbatim if nothing beats it
+    QVector<quint32> u(n), bestU;
+    int bestOrder = -1;
+    Rice bestRice;
+    qint64 bestBits = qint64(n) * kBits;
+    for (int order = 0; order <= qMin(kFlacMaxOrder, n - 1); ++order)
+    {
+        fixedResidual(x, n, order, u.data());
+        const Rice rice = planRice(u.constData(), n, order);
+        if (rice.bits < 0)
+            continue;
+        const qint64 total = qint64(order) * kBits + rice.bits;
+        if (total < bestBits)
+        {
+            bestBits = total;
+            bestOrder = order;
+            bestRice = rice;
+            bestU = u;
+        }
+    }
+
+    if (bestOrder < 0)
+    {
+        bits.put(0, 1);
+        bits.put(0x01, 6);              // VERBATIM
+        bits.put(0, 1);
+        for (int i = 0; i < n; ++i)
+            bits.putSigned(x[i], kBits);
+        return;
+    }
+
+    bits.put(0, 1);
+    bits.put(0x08 | bestOrder, 6);      // FIXED, order
+    bits.put(0, 1);
+    for (int i = 0; i < bestOrder; ++i)
+        bits.putSigned(x[i], kBits);
+
+    bits.put(1, 2);                     // RICE2: 5-bit parameters
+    bits.put(quint32(bestRice.partitionOrder), 4);
+    const int partition = n >> bestRice.partitionOrder;
+    int at = 0;
+    for (int p = 0; p < (1 << bestRice.partitionOrder); ++p)
+    {
+        const int k = bestRice.params[p];
+        const int m = partition - (p == 0 ? bestOrder : 0);
+        bits.put(quint32(k), 5);
+        for (int i = 0; i < m; ++i)
+        {
+            const quint32 v = bestU[at + i];
+            bits.putUnary(v >> k);
+            if (k > 0)
+                bits.put(v & ((1u << k) - 1), k);
+        }
+        at += m;
+    }
+}
+
+} // namespace
+
+/* ============================================================
+ * WRITER
+ * ============================================================ */
+AudioFileWriter::Format AudioFileWriter::formatForPath(const QString &path)
+{
+    return QFileInfo(path).suffix().compare(QLatin1String("flac"), Qt::CaseInsensitive) == 0
+        ? Format::Flac : Format::Wav;
+}
+
+bool AudioFileWriter::fail(const QString &error)
+{
+    m_error = error;
+    m_file.cancelWriting();
+    return false;
+}
+
+bool AudioFileWriter::open(const QString &path, int sampleRate, int channels)
+{
+    m_format = formatForPath(path);
+    m_sampleRate = sampleRate;
+    m_channels = channels;
+    m_frames = 0;
+    m_flacFrameNumber = 0;
+    m_pending.clear();
+    m_error.clear();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly))
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+    return m_format == Format::Flac ? writeFlacHeader() : writeWavHeader();
+}
+
+// Sizes are filled in by close()
+bool AudioFileWriter::writeWavHeader()
+{
+    QByteArray h;
+    const auto u32 = [&h](quint32 v) { char b[4]; qToLittleEndian(v, b); h.append(b, 4); };
+    const auto u16 = [&h](quint16 v) { char b[2]; qToLittleEndian(v, b); h.append(b, 2); };
+    const int blockAlign = m_channels * kBits / 8;
+    h.append("RIFF");
+    u32(0);
+    h.append("WAVEfmt ");
+    u32(16);
+    u16(1);                             // PCM
+    u16(quint16(m_channels));
+    u32(quint32(m_sampleRate));
+    u32(quint32(m_sampleRate * blockAlign));
+    u16(quint16(blockAlign));
+    u16(kBits);
+    h.append("data");
+    u32(0);
+    return m_file.write(h) == h.size() || fail(m_file.errorString());
+}
+
+// STREAMINFO is rewritten by close() once the length is known
+bool AudioFileWriter::writeFlacHeader()
+{
+    QByteArray h("fLaC");
+    BitWriter bits(h);
+    bits.put(1, 1);                     // last metadata block
+    bits.put(0, 7);                     // STREAMINFO
+    bits.put(34, 24);
+    bits.put(kFlacBlock, 16);
+    bits.put(kFlacBlock, 16);
+    bits.put(0, 24);                    // frame sizes: unknown
+    bits.put(0, 24);
+    bits.put(quint32(m_sampleRate), 20);
+    bits.put(quint32(m_channels - 1), 3);
+    bits.put(kBits - 1, 5);
+    bits.put(quint32(quint64(m_frames) >> 32), 4);
+    bits.put(quint32(m_frames), 32);
+    for (int i = 0; i < 4; ++i)         // MD5: not computed
+        bits.put(0, 32);
+    return m_file.write(h) == h.size() || fail(m_file.errorString());
+}
+
+bool AudioFileWriter::write(const float *samples, qint64 frames)
+{
+    const qint64 count = frames * m_channels;
+    if (m_format == Format::Wav)
+    {
+        m_scratch.resize(count * 3);
+        char *out = m_scratch.data();
+        for (qint64 i = 0; i < count; ++i)
+        {
+            const qint32 v = toInt24(samples[i]);
+            out[3 * i]     = char(v);
+            out[3 * i + 1] = char(v >> 8);
+            out[3 * i + 2] = char(v >> 16);
+        }
+        if (m_file.write(m_scratch) != m_scratch.size())
+            return fail(m_file.errorString());
+        m_frames += frames;
+        return true;
+    }
+
+    const qsizetype start = m_pending.size();
+    m_pending.resize(start + count);
+    for (qint64 i = 0; i < count; ++i)
+        m_pending[start + i] = toInt24(samples[i]);
+    m_frames += frames;
+
+    const qsizetype blockSamples = qsizetype(kFlacBlock) * m_channels;
+    qsizetype done = 0;
+    for (; m_pending.size() - done >= blockSamples; done += blockSamples)
+    {
+        if (!encodeFlacBlock(m_pending.constData() + done, kFlacBlock))
+            return false;
+    }
+    m_pending.remove(0, done);
+    return true;
+}
+
+bool AudioFileWriter::encodeFlacBlock(const qint32 *samples, int frames)
+{
+    QByteArray frame;
+    frame.reserve(frames * m_channels * 3 + 64);
+    BitWriter bits(frame);
+
+    bits.put(0x3ffe, 14);               // sync
+    bits.put(0, 1);
+    bits.put(0, 1);                     // fixed block size
+    bits.put(7, 4);                     // block size: 16 bits at the end of the header
+    bits.put(0, 4);                     // sample rate: from STREAMINFO
+    bits.put(quint32(m_channels - 1), 4);  // independent channels
+    bits.put(6, 3);                     // 24 bits per sample
+    bits.put(0, 1);
+    putUtf8(bits, quint64(m_flacFrameNumber++));
+    bits.put(quint32(frames - 1), 16);
+    bits.put(crc8(frame.constData(), frame.size()), 8);
+
+    QVector<qint32> channel(frames);
+    for (int c = 0; c < m_channels; ++c)
+    {
+        for (int f = 0; f < frames; ++f)
+            channel[f] = samples[f * m_channels + c];
+        encodeSubframe(bits, channel.constData(), frames);
+    }
+    bits.align();
+    bits.put(crc16(frame.constData(), frame.size()), 16);
+
+    return m_file.write(frame) == frame.size() || fail(m_file.errorString());
+}
+
+bool AudioFileWriter::close()
+{
+    if (!m_error.isEmpty())
+        return false;
+
+    if (m_format == Format::Flac)
+    {
+        if (!m_pending.isEmpty()
+            && !encodeFlacBlock(m_pending.constData(), int(m_pending.size() / m_channels)))
+            return false;
+        m_pending.clear();
+        if (!m_file.seek(0) || !writeFlacHeader())
+            return fail(m_file.errorString());
+    }
+    else
+    {
+        const qint64 dataBytes = m_frames * m_channels * kBits / 8;
+        if (dataBytes > 0xffffffffLL - 36)
+            return fail(QObject::tr("Too long for a WAV file (4 GB); render to .flac instead"));
+        char b[4];
+        qToLittleEndian(quint32(36 + dataBytes), b);
+        if (!m_file.seek(4) || m_file.write(b, 4) != 4)
+            return fail(m_file.errorString());
+        qToLittleEndian(quint32(dataBytes), b);
+        if (!m_file.seek(40) || m_file.write(b, 4) != 4)
+            return fail(m_file.errorString());
+    }
+
+    if (!m_file.commit())
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef AUDIOFILEWRITER_H
+#define AUDIOFILEWRITER_H
+
+#include <QByteArray>
+#include <QSaveFile>
+#include <QString>
+#include <QVector>
+
+/*
+============================================================
+ AudioFileWriter
+------------------------------------------------------------
+ - Writes interleaved float audio to a 24-bit file:
+     .wav    RIFF / PCM (up to 4 GB, about four hours of
+             48 kHz stereo)
+     .flac   FLAC, no size limit: fixed predictors (order
+             0-4, the cheapest per channel and block) and
+             partitioned Rice coding, 4096-frame blocks
+ - Samples are clamped to full scale and rounded; there is
+   no dither, 24 bits leave the noise floor below anything
+   a show can hear
+ - Goes through QSaveFile: until close() succeeds the old
+   file (if any) is untouched, and a failed or abandoned
+   render leaves nothing behind
+============================================================
+*/
+
+class AudioFileWriter
+{
+public:
+    enum class Format { Wav, Flac };
+
+    // By suffix: .flac is FLAC, anything else WAV
+    static Format formatForPath(const QString &path);
+
+    bool open(const QString &path, int sampleRate, int channels);
+    bool write(const float *samples, qint64 frames);
+    bool close();
+
+    QString errorString() const { return m_error; }
+    qint64 framesWritten() const { return m_frames; }
+
+private:
+    bool writeWavHeader();
+    bool writeFlacHeader();
+    bool encodeFlacBlock(const qint32 *samples, int frames);
+    bool fail(const QString &error);
+
+    QSaveFile m_file;
+    Format m_format = Format::Wav;
+    int m_sampleRate = 0;
+    int m_channels = 0;
+    qint64 m_frames = 0;
+    qint64 m_flacFrameNumber = 0;
+    QVector<qint32> m_pending;          // FLAC: samples waiting for a full block
+    QByteArray m_scratch;
+    QString m_error;
+};
+
+#endif // AUDIOFILEWRITER_H
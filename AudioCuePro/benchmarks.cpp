@@ -0,0 +1,957 @@
+#include "benchmarks.h"
+#include "audioengine.h"
+#include "brickwalllimiter.h"
+#include "frameticker.h"
+#include "latencyprobe.h"
+#include "levelmeter.h"
+#include "mainwindow.h"
+#include "resampler.h"
+#include "showfile.h"
+#include "silencescan.h"
+#include "trackwidget.h"
+#include "virtualplayer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QKeyEvent>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+#include <QtEndian>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+static const int kRuns = 15;
+
+namespace {
+
+QTextStream &out()
+{
+    static QTextStream s(stdout);
+    return s;
+}
+
+// Median wall time of `runs` calls, in milliseconds
+double medianMs(int runs, const std::function<void()> &fn)
+{
+    QVector<double> times;
+    times.reserve(runs);
+    for (int i = 0; i < runs; ++i)
+    {
+        QElapsedTimer t;
+        t.start();
+        fn();
+        times.append(t.nsecsElapsed() / 1.0e6);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile f(path);
+    return f.open(QIODevice::WriteOnly) && f.write(data) == data.size();
+}
+
+/* ============================================================
+ * show-load
+ * ============================================================ */
+int showLoad(const QStringList &args)
+{
+    if (args.isEmpty())
+    {
+        out() << "usage: --benchmark show-load <show.acp.json|show.acps>\n";
+        return 2;
+    }
+
+    QString error;
+    const QJsonObject root = ShowFile::readRoot(args.first(), &error);
+    if (root.isEmpty())
+    {
+        out() << "cannot read " << args.first() << ": " << error << "\n";
+        return 1;
+    }
+
+    // Same show in both formats, side by side
+    QTemporaryDir dir;
+    const QString jsonPath = dir.filePath(QStringLiteral("show.acp.json"));
+    const QString binPath  = dir.filePath(QStringLiteral("show.acps"));
+    if (!writeFile(jsonPath, QJsonDocument(root).toJson())
+        || !writeFile(binPath, ShowFile::encode(root)))
+    {
+        out() << "cannot write temporary files\n";
+        return 1;
+    }
+
+    int cues = 0;
+    const QJsonArray scenes = root["scenes"].toArray();
+    for (const QJsonValue &sv : scenes)
+        cues += sv.toObject()["tracks"].toArray().size();
+
+    out() << "show-load: " << scenes.size() << " scenes, " << cues << " cues, "
+          << "median of " << kRuns << " runs\n";
+    out() << "  json   size " << QFile(jsonPath).size() << " bytes\n";
+    out() << "  binary size " << QFile(binPath).size() << " bytes\n";
+
+    // JSON has no index: the first cue is only available once the
+    // whole document has been parsed
+    int sink = 0;
+    const double jsonAll = medianMs(kRuns, [&]() {
+        QFile f(jsonPath);
+        f.open(QIODevice::ReadOnly);
+        const QJsonObject r = QJsonDocument::fromJson(f.readAll()).object();
+        for (const QJsonValue &sv : r["scenes"].toArray())
+            for (const QJsonValue &tv : sv.toObject()["tracks"].toArray())
+                sink += tv.toObject().size();
+    });
+
+    const double binHeader = medianMs(kRuns, [&]() {
+        ShowFile::Reader reader;
+        reader.open(binPath);
+        sink += reader.sceneCount();
+    });
+
+    const double binFirst = medianMs(kRuns, [&]() {
+        ShowFile::Reader reader;
+        reader.open(binPath);
+        if (reader.sceneCount() > 0)
+            for (const QJsonObject &cue : reader.readScene(0))
+                sink += cue.size();
+    });
+
+    const double binAll = medianMs(kRuns, [&]() {
+        ShowFile::Reader reader;
+        reader.open(binPath);
+        for (int i = 0; i < reader.sceneCount(); ++i)
+            for (const QJsonObject &cue : reader.readScene(i))
+                sink += cue.size();
+    });
+
+    out() << QString("  json   whole show    %1 ms\n").arg(jsonAll, 0, 'f', 3);
+    out() << QString("  binary header+index  %1 ms\n").arg(binHeader, 0, 'f', 3);
+    out() << QString("  binary first scene   %1 ms\n").arg(binFirst, 0, 'f', 3);
+    out() << QString("  binary whole show    %1 ms\n").arg(binAll, 0, 'f', 3);
+    out() << "  (parse only; creating the cue widgets is not included)\n";
+    out() << QString("  [%1]\n").arg(sink != 0 ? "ok" : "empty");
+    return 0;
+}
+
+/* ============================================================
+ * show-save
+ * ============================================================ */
+int showSave(const QStringList &args)
+{
+    if (args.isEmpty())
+    {
+        out() << "usage: --benchmark show-save <show.acp.json|show.acps>\n";
+        return 2;
+    }
+
+    QString error;
+    const QJsonObject root = ShowFile::readRoot(args.first(), &error);
+    if (root.isEmpty())
+    {
+        out() << "cannot read " << args.first() << ": " << error << "\n";
+        return 1;
+    }
+
+    // The GUI thread only snapshots the cues; encoding and the
+    // atomic commit run on a worker and should stay well under a
+    // second however large the show
+    const double budgetMs = 500.0;
+
+    QTemporaryDir dir;
+    out() << "show-save: median of " << kRuns << " runs (encode on the calling thread,"
+          << " commit = QSaveFile write + sync + rename)\n";
+
+    bool failed = false;
+    bool over = false;
+    for (const QString &name : { QStringLiteral("show.acp.json"), QStringLiteral("show.acps") })
+    {
+        const QString path = dir.filePath(name);
+        qint64 bytes = 0;
+        bool ok = true;
+
+        // Encode alone, then the whole save: commit is the difference
+        const double encodeMs = medianMs(kRuns, [&]() {
+            bytes = (ShowFile::isBinaryPath(path) ? ShowFile::encode(root)
+                                                  : QJsonDocument(root).toJson()).size();
+        });
+        const double saveMs = medianMs(kRuns, [&]() {
+            ok = ShowFile::save(path, root).ok && ok;
+        });
+
+        out() << QString("  %1 %2 bytes  encode %3 ms  commit %4 ms%5\n")
+                     .arg(name, -14).arg(bytes)
+                     .arg(encodeMs, 0, 'f', 2)
+                     .arg(qMax(0.0, saveMs - encodeMs), 0, 'f', 2)
+                     .arg(ok ? "" : "  (write failed)");
+        failed = failed || !ok;
+        over = over || qMax(encodeMs, saveMs) > budgetMs;
+    }
+    out() << QString("  [%1: budget %2 ms per save]\n")
+                 .arg(failed ? "FAILED" : over ? "OVER" : "ok").arg(budgetMs, 0, 'f', 0);
+    return failed || over ? 1 : 0;
+}
+
+/* ============================================================
+ * silence-scan
+ * ============================================================ */
+int silenceScan(const QStringList &args)
+{
+    // One minute of stereo 48 kHz: 50 s of near-silence (-80 dBFS),
+    // 5 s of sound, 5 s of near-silence – a typical untrimmed SFX
+    // stretched out so the timings are measurable
+    const int rate = 48000, channels = 2;
+    const qsizetype frames = qsizetype(rate) * 60;
+    QVector<float> pcm(frames * channels);
+    for (qsizetype f = 0; f < frames; ++f)
+    {
+        const bool loud = f >= 50 * rate && f < 55 * rate;
+        const float v = loud ? 0.5f * float((f % 100) - 50) / 50.0f
+                             : ((f & 1) ? 1.0e-4f : -1.0e-4f);
+        pcm[f * channels] = v;
+        pcm[f * channels + 1] = -v;
+    }
+
+    const float threshold = SilenceScan::thresholdFromDb(args.value(0, "-60").toDouble());
+    const float *p = pcm.constData();
+    const qsizetype n = pcm.size();
+    qsizetype sink = 0;
+
+    const double scalarFirst = medianMs(kRuns, [&]() { sink += SilenceScan::firstAboveScalar(p, n, threshold); });
+    const double scalarLast  = medianMs(kRuns, [&]() { sink += SilenceScan::lastAboveScalar(p, n, threshold); });
+    const double simdFirst   = medianMs(kRuns, [&]() { sink += SilenceScan::firstAbove(p, n, threshold); });
+    const double simdLast    = medianMs(kRuns, [&]() { sink += SilenceScan::lastAbove(p, n, threshold); });
+
+    const bool same = SilenceScan::firstAbove(p, n, threshold) == SilenceScan::firstAboveScalar(p, n, threshold)
+                   && SilenceScan::lastAbove(p, n, threshold) == SilenceScan::lastAboveScalar(p, n, threshold);
+
+    out() << "silence-scan: 60 s stereo 48 kHz, 50 s leading / 5 s trailing silence, "
+          << "median of " << kRuns << " runs\n";
+    out() << QString("  scalar  first %1 ms  last %2 ms\n").arg(scalarFirst, 0, 'f', 3).arg(scalarLast, 0, 'f', 3);
+    out() << QString("  vector  first %1 ms  last %2 ms\n").arg(simdFirst, 0, 'f', 3).arg(simdLast, 0, 'f', 3);
+    out() << QString("  speed-up %1x\n").arg((scalarFirst + scalarLast) / qMax(1e-6, simdFirst + simdLast), 0, 'f', 1);
+    const bool ok = same && sink != 0;
+    out() << QString("  [%1]\n").arg(ok ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
+
+/* ============================================================
+ * meter-overhead
+ * ============================================================ */
+int meterOverhead(const QStringList &)
+{
+    // One voice: a minute of stereo 48 kHz in 1024-frame buffers,
+    // the way the player hands them to the cue's LevelMeter
+    const int rate = 48000, channels = 2, bufferFrames = 1024;
+    const int seconds = 60;
+    QVector<float> buffer(bufferFrames * channels);
+
+    LevelMeter meter;
+    qint64 frame = 0;
+    QElapsedTimer timer;
+    qint64 spentNs = 0;
+    for (int done = 0; done < rate * seconds; done += bufferFrames)
+    {
+        // -20 dBFS 1 kHz tone; generated outside the timed section
+        for (int f = 0; f < bufferFrames; ++f, ++frame)
+        {
+            const float v = 0.1f * float(std::sin(2.0 * M_PI * 1000.0 * frame / rate));
+            buffer[f * channels] = buffer[f * channels + 1] = v;
+        }
+        timer.start();
+        meter.process(buffer.constData(), bufferFrames, channels, rate);
+        spentNs += timer.nsecsElapsed();
+    }
+
+    const double load = spentNs / (seconds * 1e9) * 100.0;
+    const LevelMeter::Reading r = meter.reading();
+    out() << "meter-overhead: " << seconds << " s stereo 48 kHz through one LevelMeter\n";
+    out() << QString("  %1 ms  = %2 % of one core per playing cue\n")
+                 .arg(spentNs / 1e6, 0, 'f', 1).arg(load, 0, 'f', 3);
+    out() << QString("  -20 dBFS tone reads peak %1 dBFS, RMS %2 dBFS, %3 LUFS\n")
+                 .arg(20.0 * std::log10(r.peak), 0, 'f', 1)
+                 .arg(20.0 * std::log10(r.rms), 0, 'f', 1)
+                 .arg(r.shortTermLufs, 0, 'f', 1);
+    out() << QString("  [%1: budget 1 %]\n").arg(load < 1.0 ? "ok" : "OVER");
+    return load < 1.0 ? 0 : 1;
+}
+
+/* ============================================================
+ * limiter
+ * ============================================================ */
+int limiter(const QStringList &args)
+{
+    // Two cues overlapping on the master bus, each pushed to the
+    // gain slider's 2x: the sum peaks near +9 dBFS
+    bool ok = false;
+    const float ceilingDb = args.value(0).toFloat(&ok);
+    const int rate = 48000, blockFrames = 512;
+    const int seconds = 60;
+    QVector<float> block(2 * blockFrames);
+
+    BrickwallLimiter lim;
+    lim.setup(rate);
+    lim.setCeilingDb(ok ? qMin(0.0f, ceilingDb) : BrickwallLimiter::kDefaultCeilingDb);
+    const float ceiling = float(qPow(10.0, lim.ceilingDb() / 20.0));
+
+    qint64 frame = 0;
+    QElapsedTimer timer;
+    qint64 spentNs = 0;
+    float inputPeak = 0.0f, outputPeak = 0.0f, deepestDb = 0.0f;
+    for (int done = 0; done < rate * seconds; done += blockFrames)
+    {
+        // Generated and summed outside the timed section: the mix
+        // itself is one add per sample
+        for (int f = 0; f < blockFrames; ++f, ++frame)
+        {
+            const double t = double(frame) / rate;
+            const float a = 2.0f * 0.7f * float(std::sin(2.0 * M_PI * 220.0 * t));
+            // Second cue comes in every other 4 s with a sharp attack
+            const float b = (frame / (4 * rate)) % 2
+                ? 2.0f * 0.7f * float(std::sin(2.0 * M_PI * 331.0 * t)) : 0.0f;
+            block[2 * f] = a + b;
+            block[2 * f + 1] = a - 0.5f * b;
+            inputPeak = qMax(inputPeak, qMax(qAbs(block[2 * f]), qAbs(block[2 * f + 1])));
+        }
+        timer.start();
+        lim.process(block.data(), blockFrames);
+        spentNs += timer.nsecsElapsed();
+        for (float v : std::as_const(block))
+            outputPeak = qMax(outputPeak, qAbs(v));
+        deepestDb = qMax(deepestDb, lim.gainReductionDb());
+    }
+
+    const double load = spentNs / (seconds * 1e9) * 100.0;
+    const bool held = outputPeak <= ceiling;
+    out() << "limiter: " << seconds << " s stereo 48 kHz, two overlapping cues at 2x gain, "
+          << blockFrames << "-frame blocks\n";
+    out() << QString("  %1 ms  = %2 % of one core\n")
+                 .arg(spentNs / 1e6, 0, 'f', 1).arg(load, 0, 'f', 3);
+    out() << QString("  latency %1 ms (%2 frames look-ahead)\n")
+                 .arg(1000.0 * lim.latencyFrames() / rate, 0, 'f', 2).arg(lim.latencyFrames());
+    out() << QString("  input peak %1 dBFS, output peak %2 dBFS, ceiling %3 dBFS, deepest reduction %4 dB\n")
+                 .arg(20.0 * std::log10(inputPeak), 0, 'f', 2)
+                 .arg(20.0 * std::log10(outputPeak), 0, 'f', 2)
+                 .arg(lim.ceilingDb(), 0, 'f', 2)
+                 .arg(deepestDb, 0, 'f', 1);
+    out() << QString("  [%1]\n").arg(held ? "ok" : "OVER CEILING");
+    return held ? 0 : 1;
+}
+
+/* ============================================================
+ * resampler
+ * ============================================================ */
+int resampler(const QStringList &args)
+{
+    // The conversions a show actually needs, at each quality: CPU
+    // as the channels one core keeps up with, the measured stopband
+    // (a 30 kHz tone taken from 96 to 48 kHz must vanish) and the
+    // top of the passband (18 kHz must come through within 0.5 dB)
+    QVector<Resampler::Quality> qualities = { Resampler::Quality::Fast,
+                                              Resampler::Quality::Standard,
+                                              Resampler::Quality::High };
+    if (!args.isEmpty())
+    {
+        qualities.clear();
+        for (Resampler::Quality q : { Resampler::Quality::Fast, Resampler::Quality::Standard,
+                                      Resampler::Quality::High })
+            if (Resampler::qualityName(q).compare(args.value(0), Qt::CaseInsensitive) == 0)
+                qualities << q;
+        if (qualities.isEmpty())
+        {
+            out() << "usage: --benchmark resampler [fast|standard|high]\n";
+            return 2;
+        }
+    }
+
+    struct Case { const char *name; int inRate; double speed; double toneHz; };
+    const Case cases[] = {
+        { "44.1 -> 48 kHz", 44100, 1.0, 1000.0 },
+        { "44.1 -> 48 kHz, 18 kHz", 44100, 1.0, 18000.0 },
+        { "44.1 -> 48 kHz, 20 kHz", 44100, 1.0, 20000.0 },
+        { "96 -> 48 kHz", 96000, 1.0, 30000.0 },
+        { "96 -> 48 kHz, 18 kHz", 96000, 1.0, 18000.0 },
+        { "48 kHz at 1.5x speed", 48000, 1.5, 1000.0 },
+        { "44.1 kHz at 0.5x speed", 44100, 0.5, 1000.0 },
+    };
+    const int outRate = 48000, seconds = 20, blockFrames = 1024;
+
+    bool droops = false;
+    out() << "resampler: " << seconds << " s stereo per case, output " << outRate / 1000
+          << " kHz, " << blockFrames << "-frame input blocks\n";
+    for (Resampler::Quality quality : std::as_const(qualities))
+    {
+        out() << Resampler::qualityName(quality) << "\n";
+        for (const Case &c : cases)
+        {
+            const int frames = c.inRate * seconds;
+            QVector<float> in(2 * frames);
+            for (int f = 0; f < frames; ++f)
+                in[2 * f] = in[2 * f + 1] = 0.5f * float(std::sin(2.0 * M_PI * c.toneHz * f / c.inRate));
+
+            const double step = c.inRate * c.speed / outRate;
+            QVector<float> result(2 * (Resampler::outputFrames(frames, step) + blockFrames));
+            int produced = 0;
+            const double ms = medianMs(5, [&]() {
+                Resampler r(quality);
+                produced = 0;
+                for (int done = 0; done < frames; done += blockFrames)
+                {
+                    const int n = qMin(blockFrames, frames - done);
+                    produced += r.process(in.constData() + 2 * done, n, step,
+                                          result.data() + 2 * produced,
+                                          Resampler::outputFrames(n, step));
+                }
+            });
+
+            // RMS away from the start and end, where the filter
+            // settles; a sampled peak would miss the crest near Nyquist
+            double energy = 0.0;
+            const int from = produced / 4, to = 3 * produced / 4;
+            for (int f = from; f < to; ++f)
+                energy += double(result[2 * f]) * result[2 * f];
+            const double rms = std::sqrt(energy / qMax(1, to - from));
+            const double db = 20.0 * std::log10(rms * M_SQRT2 / 0.5 + 1e-12);
+
+            const double audioMs = 1000.0 * produced / outRate;
+            QString level = QString("tone %1 dB").arg(db, 0, 'f', 2);
+            if (c.toneHz * c.speed > outRate / 2)
+                level = QString("stopband %1 dB").arg(db, 0, 'f', 1);
+            else if (c.toneHz >= 10000.0)
+            {
+                level = QString("passband %1 dB").arg(db, 0, 'f', 2);
+                if (c.toneHz <= 18000.0 && db < -0.5)
+                {
+                    level += "  [droops]";
+                    droops = true;
+                }
+            }
+            out() << QString("  %1: %2 ms for %3 s = %4 channels per core in real time, %5\n")
+                         .arg(QLatin1String(c.name), -24)
+                         .arg(ms, 0, 'f', 1)
+                         .arg(audioMs / 1000.0, 0, 'f', 1)
+                         .arg(2 * qRound(audioMs / ms))
+                         .arg(level);
+        }
+    }
+    return droops ? 1 : 0;
+}
+
+/* ============================================================
+ * GENERATED SHOWS – go-latency, virtual-fade, virtual-show
+ * ============================================================ */
+// 16-bit stereo WAV of a cosine: loud from the very first sample,
+// so the first non-zero sample out is the cue's first sample
+QByteArray toneWav(int rate, int frames, double hz)
+{
+    QByteArray wav;
+    const auto u32 = [&wav](quint32 v) { char b[4]; qToLittleEndian(v, b); wav.append(b, 4); };
+    const auto u16 = [&wav](quint16 v) { char b[2]; qToLittleEndian(v, b); wav.append(b, 2); };
+    wav.append("RIFF");
+    u32(quint32(36 + 4 * frames));
+    wav.append("WAVEfmt ");
+    u32(16);
+    u16(1);
+    u16(2);
+    u32(quint32(rate));
+    u32(quint32(4 * rate));
+    u16(4);
+    u16(16);
+    wav.append("data");
+    u32(quint32(4 * frames));
+    for (int f = 0; f < frames; ++f)
+    {
+        const qint16 v = qint16(16000.0 * std::cos(2.0 * M_PI * hz * f / rate));
+        u16(quint16(v));
+        u16(quint16(v));
+    }
+    return wav;
+}
+
+// One scene "GO" of `cues` tone cues on the keys a-z, `seconds`
+// long, each fading out over `fadeOut` when stopped; `adjust` may
+// change any cue's settings. The show's path, or empty if it could
+// not be written
+QString writeToneShow(const QTemporaryDir &dir, int cues, double seconds, double fadeOut,
+                      const std::function<void(int cue, QJsonObject &settings)> &adjust = {})
+{
+    const int rate = 48000;
+    QJsonArray tracks;
+    for (int i = 0; i < cues; ++i)
+    {
+        const QString file = QStringLiteral("cue%1.wav").arg(i + 1);
+        if (!writeFile(dir.filePath(file), toneWav(rate, int(seconds * rate), 220.0 + 20.0 * i)))
+            return QString();
+        QJsonObject cue;
+        cue["filename"] = file;
+        cue["hotkey"] = QString(QChar('a' + i));
+        cue["start"] = 0.0;
+        cue["end"] = seconds;
+        cue["fadeIn"] = 0.0;
+        cue["fadeOut"] = fadeOut;
+        cue["loopMode"] = "none";
+        cue["loopCount"] = 1;
+        cue["gain"] = 1.0;
+        cue["speed"] = 1.0;
+        cue["pitch"] = 0.0;
+        if (adjust)
+            adjust(i, cue);
+        tracks.append(cue);
+    }
+    QJsonObject scene;
+    scene["name"] = "GO";
+    scene["tracks"] = tracks;
+    QJsonObject root;
+    root["audioFolder"] = dir.path();
+    root["scenes"] = QJsonArray { scene };
+    const QString showPath = dir.filePath(QStringLiteral("go.acp.json"));
+    return writeFile(showPath, QJsonDocument(root).toJson()) ? showPath : QString();
+}
+
+// As File > Load, until the first scene is armed (30 s at most)
+bool loadGeneratedShow(MainWindow &window, const QString &showPath)
+{
+    QEventLoop loop;
+    bool ready = false;
+    QObject::connect(&window, &MainWindow::showReady, &loop, [&]() { ready = true; loop.quit(); });
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+    window.loadShow(showPath);
+    loop.exec();
+    return ready;
+}
+
+/* ============================================================
+ * go-latency
+ * ============================================================ */
+// Nearest rank; `sorted` ascending and not empty
+double percentile(const QVector<double> &sorted, double p)
+{
+    const int rank = qBound(1, int(std::ceil(p / 100.0 * sorted.size())), int(sorted.size()));
+    return sorted[rank - 1];
+}
+
+int goLatency(const QStringList &args)
+{
+    bool ok = true;
+    const int fires = args.isEmpty() ? 100 : args.first().toInt(&ok);
+    if (!ok || fires < 1)
+    {
+        out() << "usage: --benchmark go-latency [GOs]\n";
+        return 2;
+    }
+
+    // The null output unless a device is asked for; the virtual
+    // clock would never move on its own
+    const QByteArray backend = qgetenv("ACP_AUDIO_OUTPUT");
+    if (backend == "virtual")
+    {
+        out() << "go-latency needs a running clock: ACP_AUDIO_OUTPUT=null or a device\n";
+        return 2;
+    }
+    if (backend.isEmpty())
+        qputenv("ACP_AUDIO_OUTPUT", "null");
+    // Scratch settings and autosave, never the user's
+    QStandardPaths::setTestModeEnabled(true);
+
+    // One scene of short cues on the keys a-z, played in turn
+    QTemporaryDir dir;
+    const int cues = qMin(fires, 26);
+    const QString showPath = writeToneShow(dir, cues, 2.0, 0.0);
+    if (showPath.isEmpty())
+    {
+        out() << "cannot write temporary files\n";
+        return 1;
+    }
+
+    MainWindow window;
+    if (!loadGeneratedShow(window, showPath))
+    {
+        out() << "the generated show did not load\n";
+        return 1;
+    }
+
+    const auto runEvents = [](int ms) {
+        QElapsedTimer t;
+        t.start();
+        while (t.elapsed() < ms)
+        {
+            QCoreApplication::processEvents();
+            QThread::usleep(100);
+        }
+    };
+    runEvents(500);                     // let the engine settle
+
+    // Each GO starts from silence: the key, then the same key again
+    // to stop the cue and a pause for the output to fall silent
+    QVector<double> stageMs[LatencyProbe::StageCount];
+    int missed = 0;
+    for (int i = 0; i < fires; ++i)
+    {
+        const int cue = i % cues;
+        QKeyEvent press(QEvent::KeyPress, Qt::Key_A + cue, Qt::NoModifier, QString(QChar('a' + cue)));
+
+        LatencyProbe::arm();
+        QCoreApplication::sendEvent(&window, &press);
+        QElapsedTimer wait;
+        wait.start();
+        while (LatencyProbe::waiting(LatencyProbe::FirstSample) && wait.elapsed() < 2000)
+        {
+            QCoreApplication::processEvents();
+            QThread::usleep(100);
+        }
+        LatencyProbe::disarm();
+
+        for (int s = LatencyProbe::Hotkey; s < LatencyProbe::StageCount; ++s)
+        {
+            const qint64 ns = LatencyProbe::elapsedNs(LatencyProbe::Stage(s));
+            if (ns >= 0)
+                stageMs[s].append(ns / 1.0e6);
+        }
+        if (LatencyProbe::elapsedNs(LatencyProbe::FirstSample) < 0)
+            ++missed;
+
+        QKeyEvent stop(QEvent::KeyPress, Qt::Key_A + cue, Qt::NoModifier, QString(QChar('a' + cue)));
+        QCoreApplication::sendEvent(&window, &stop);
+        runEvents(150);
+    }
+    window.close();
+
+    const AudioEngine::Stats stats = AudioEngine::instance()->stats();
+    out() << "go-latency: " << fires << " GOs over " << cues << " cues, "
+          << stats.outputs.value(0) << "\n";
+    out() << QString("  %1 %2 %3 %4   (ms after the key press)\n")
+                 .arg("stage", -14).arg("p50", 8).arg("p99", 8).arg("max", 8);
+    for (int s = LatencyProbe::Hotkey; s < LatencyProbe::StageCount; ++s)
+    {
+        QVector<double> &v = stageMs[s];
+        const QString name = LatencyProbe::stageName(LatencyProbe::Stage(s));
+        if (v.isEmpty())
+        {
+            out() << QString("  %1 never reached\n").arg(name, -14);
+            continue;
+        }
+        std::sort(v.begin(), v.end());
+        out() << QString("  %1 %2 %3 %4\n")
+                     .arg(name, -14)
+                     .arg(percentile(v, 50.0), 8, 'f', 2)
+                     .arg(percentile(v, 99.0), 8, 'f', 2)
+                     .arg(v.last(), 8, 'f', 2);
+    }
+    out() << QString("  first sample is when it leaves the engine; the sink adds %1 ms"
+                     " of buffer before it is heard\n").arg(stats.bufferMs, 0, 'f', 1);
+    if (missed > 0)
+        out() << "  [" << missed << " GO(s) made no sound within 2 s]\n";
+    return missed > 0 ? 1 : 0;
+}
+
+/* ============================================================
+ * virtual-fade
+ * ============================================================ */
+int virtualFade(const QStringList &args)
+{
+    bool ok = true;
+    const int fadeMs = args.isEmpty() ? 500 : args.first().toInt(&ok);
+    if (!ok || fadeMs < 1)
+    {
+        out() << "usage: --benchmark virtual-fade [fade ms]\n";
+        return 2;
+    }
+
+    const QByteArray backend = qgetenv("ACP_AUDIO_OUTPUT");
+    if (!backend.isEmpty() && backend != "virtual")
+    {
+        out() << "virtual-fade runs on the virtual clock: leave ACP_AUDIO_OUTPUT unset or virtual\n";
+        return 2;
+    }
+    qputenv("ACP_AUDIO_OUTPUT", "virtual");
+    QStandardPaths::setTestModeEnabled(true);
+
+    QTemporaryDir dir;
+    const QString showPath = writeToneShow(dir, 1, 10.0, fadeMs / 1000.0);
+    if (showPath.isEmpty())
+    {
+        out() << "cannot write temporary files\n";
+        return 1;
+    }
+    MainWindow window;
+    if (!loadGeneratedShow(window, showPath))
+    {
+        out() << "the generated show did not load\n";
+        return 1;
+    }
+    TrackWidget *cue = window.findChild<TrackWidget *>();
+    if (!cue)
+    {
+        out() << "the generated show has no cue\n";
+        return 1;
+    }
+
+    AudioEngine *engine = AudioEngine::instance();
+    FrameTicker *ticker = FrameTicker::instance();
+    const int rate = engine->sampleRate();
+    const int frameMs = ticker->frameIntervalMs();
+    const qint64 step = qint64(rate) * frameMs / 1000;
+    qint64 finishedAt = -1;
+    QObject::connect(cue, &TrackWidget::fadeOutFinished, cue, [&]() { finishedAt = ticker->now(); });
+
+    // GO, and a second of it: the cue plays on the sample clock too
+    QKeyEvent go(QEvent::KeyPress, Qt::Key_A, Qt::NoModifier, QStringLiteral("a"));
+    QCoreApplication::sendEvent(&window, &go);
+    float peak = 0.0f;
+    for (qint64 played = 0; played < rate; played += step)
+    {
+        engine->advanceClock(step);
+        QCoreApplication::processEvents();
+        peak = qMax(peak, engine->masterMeter().reading().peak);
+    }
+    if (!(peak > 0.1f))
+    {
+        out() << "virtual-fade: the cue was never heard on the virtual clock\n";
+        return 1;
+    }
+
+    // Stop with its fade, then run the clock flat out: the fade
+    // has to follow the samples, whatever the wall clock does
+    const qint64 fadeFrom = ticker->now();
+    const qint64 fadeFromFrames = engine->clockFrames();
+    QKeyEvent stop(QEvent::KeyPress, Qt::Key_A, Qt::NoModifier, QStringLiteral("a"));
+    QCoreApplication::sendEvent(&window, &stop);
+    QElapsedTimer wall;
+    wall.start();
+    const qint64 limit = qint64(fadeMs + 1000) * rate / 1000;
+    while (finishedAt < 0 && engine->clockFrames() - fadeFromFrames < limit)
+    {
+        engine->advanceClock(step);
+        QCoreApplication::processEvents();
+    }
+    const qint64 wallMs = wall.elapsed();
+    window.close();
+
+    out() << "virtual-fade: " << fadeMs << " ms fade out on " << engine->stats().outputs.value(0) << "\n";
+    if (finishedAt < 0)
+    {
+        out() << "  [the fade never finished]\n";
+        return 1;
+    }
+    const qint64 tookMs = finishedAt - fadeFrom;
+    // The ticker sees the clock once per display frame
+    const bool onTime = tookMs >= fadeMs && tookMs <= fadeMs + frameMs;
+    out() << QString("  finished after %1 ms of sample clock (%2 frames), %3 ms of wall time;"
+                     " expected %4-%5 ms\n")
+                 .arg(tookMs)
+                 .arg(engine->clockFrames() - fadeFromFrames)
+                 .arg(wallMs)
+                 .arg(fadeMs)
+                 .arg(fadeMs + frameMs);
+    if (!onTime)
+        out() << "  [off the sample clock]\n";
+    return onTime ? 0 : 1;
+}
+
+/* ============================================================
+ * virtual-show
+ * ============================================================ */
+// What a cue did, in clock frames (AudioEngine::clockFrames())
+struct CueTrace {
+    VirtualPlayer *player = nullptr;
+    QVector<qint64> passEnds;           // as passEnded() came
+    qint64 finished = -1;               // first fadeOutFinished()
+};
+
+int virtualShow(const QStringList &)
+{
+    const QByteArray backend = qgetenv("ACP_AUDIO_OUTPUT");
+    if (!backend.isEmpty() && backend != "virtual")
+    {
+        out() << "virtual-show runs on the virtual clock: leave ACP_AUDIO_OUTPUT unset or virtual\n";
+        return 2;
+    }
+    qputenv("ACP_AUDIO_OUTPUT", "virtual");
+    QStandardPaths::setTestModeEnabled(true);
+
+    // a: 1 s region played three times; b: 1 s endless loop with a
+    // 500 ms fade out; c: 1 s once
+    const double passSeconds = 1.0;
+    const double fadeSeconds = 0.5;
+    QTemporaryDir dir;
+    const QString showPath = writeToneShow(dir, 3, 10.0, 0.0, [&](int cue, QJsonObject &settings) {
+        settings["end"] = passSeconds;
+        if (cue == 0)
+        {
+            settings["loopMode"] = "count";
+            settings["loopCount"] = 3;
+        }
+        else if (cue == 1)
+        {
+            settings["loopMode"] = "infinite";
+            settings["fadeOut"] = fadeSeconds;
+        }
+    });
+    if (showPath.isEmpty())
+    {
+        out() << "cannot write temporary files\n";
+        return 1;
+    }
+    MainWindow window;
+    if (!loadGeneratedShow(window, showPath))
+    {
+        out() << "the generated show did not load\n";
+        return 1;
+    }
+
+    AudioEngine *engine = AudioEngine::instance();
+    const int rate = engine->sampleRate();
+    const qint64 step = qint64(rate) * FrameTicker::instance()->frameIntervalMs() / 1000;
+    const qint64 pass = std::llround(passSeconds * rate);
+    const qint64 fade = std::llround(fadeSeconds * rate);
+
+    CueTrace traces[3];
+    TrackWidget *cues[3] = {};
+    for (TrackWidget *tw : window.findChildren<TrackWidget *>())
+    {
+        const int i = tw->assignedKey().isEmpty() ? -1 : tw->assignedKey().at(0).unicode() - 'a';
+        if (i >= 0 && i < 3)
+            cues[i] = tw;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        traces[i].player = cues[i] ? cues[i]->findChild<VirtualPlayer *>() : nullptr;
+        if (!traces[i].player)
+        {
+            out() << "virtual-show: the generated cues do not play on the virtual clock\n";
+            return 1;
+        }
+        QObject::connect(traces[i].player, &VirtualPlayer::passEnded, cues[i], [&, i]() {
+            traces[i].passEnds.append(engine->clockFrames());
+        });
+        QObject::connect(cues[i], &TrackWidget::fadeOutFinished, cues[i], [&, i]() {
+            if (traces[i].finished < 0)
+                traces[i].finished = engine->clockFrames();
+        });
+    }
+
+    const auto press = [&](int cue) {
+        QKeyEvent key(QEvent::KeyPress, Qt::Key_A + cue, Qt::NoModifier, QString(QChar('a' + cue)));
+        QCoreApplication::sendEvent(&window, &key);
+        return engine->clockFrames();
+    };
+    // Flat out, one display frame per step
+    const auto runUntil = [&](const std::function<bool()> &done, qint64 frames) {
+        const qint64 limit = engine->clockFrames() + frames;
+        while (!done() && engine->clockFrames() < limit)
+        {
+            engine->advanceClock(step);
+            QCoreApplication::processEvents();
+        }
+    };
+
+    const AudioEngine::Stats before = engine->stats();
+    QElapsedTimer wall;
+    wall.start();
+    const qint64 origin = engine->clockFrames();
+
+    // a plays its passes and ends by itself; b loops until the GO
+    // for c, half way through its third pass, fades it out
+    const qint64 goA = press(0);
+    runUntil([&]() { return traces[0].finished >= 0; }, 5 * pass);
+    const qint64 goB = press(1);
+    runUntil([&]() { return traces[1].passEnds.size() >= 2; }, 4 * pass);
+    runUntil([]() { return false; }, pass / 2);
+    const qint64 goC = press(2);
+    runUntil([&]() { return traces[2].finished >= 0; }, fade + 3 * pass);
+
+    const qint64 wallMs = wall.elapsed();
+    const qint64 showFrames = engine->clockFrames() - origin;
+    const AudioEngine::Stats after = engine->stats();
+    window.close();
+
+    out() << "virtual-show: count loop, endless loop faded out by a GO, next cue, on "
+          << after.outputs.value(0) << "\n";
+    out() << QString("  %1 ms of show in %2 ms of wall time\n")
+                 .arg(showFrames * 1000 / rate).arg(wallMs);
+
+    // Each event is seen after the display frame it happened in; a
+    // start within the block it was due in; fades follow the ticker
+    // in whole ms
+    const qint64 msFrames = rate / 1000;
+    bool ok = true;
+    const auto check = [&](const QString &what, qint64 at, qint64 expected, qint64 slack) {
+        const bool hit = at >= expected && at <= expected + slack;
+        ok = ok && hit;
+        const auto ms = [&](qint64 frames) { return (frames - origin) * 1000.0 / rate; };
+        out() << QString("  %1 %2 ms, expected %3-%4 ms  [%5]\n")
+                     .arg(what, -18)
+                     .arg(at < 0 ? QStringLiteral("never") : QString::number(ms(at), 'f', 1), 9)
+                     .arg(ms(expected), 0, 'f', 1)
+                     .arg(ms(expected + slack), 0, 'f', 1)
+                     .arg(hit ? "ok" : "MISMATCH");
+    };
+    const auto passEnd = [&](int cue, int k) { return traces[cue].passEnds.value(k - 1, -1); };
+
+    const qint64 firstA = traces[0].player->firstSampleFrame();
+    const qint64 firstB = traces[1].player->firstSampleFrame();
+    const qint64 firstC = traces[2].player->firstSampleFrame();
+    check("a starts", firstA, goA, AudioEngine::kBlockFrames);
+    for (int k = 1; k <= 3; ++k)
+        check(QString("a pass %1 ends").arg(k), passEnd(0, k), firstA + k * pass, step);
+    check("a ends", traces[0].finished, firstA + 3 * pass, step);
+    check("b starts", firstB, goB, AudioEngine::kBlockFrames);
+    for (int k = 1; k <= 2; ++k)
+        check(QString("b pass %1 ends").arg(k), passEnd(1, k), firstB + k * pass, step);
+    check("b faded out", traces[1].finished, goC + fade, step + msFrames);
+    check("c starts", firstC, goC + fade, step + msFrames + AudioEngine::kBlockFrames);
+    check("c ends", traces[2].finished, firstC + pass, step);
+
+    // Loops and starts are seamless: no voice ran dry or lost audio
+    const int reprimes = after.reprimes - before.reprimes;
+    const int underruns = after.underruns - before.underruns;
+    const double droppedMs = after.droppedMs - before.droppedMs;
+    const bool seamless = reprimes == 0 && underruns == 0 && droppedMs <= 0.0;
+    ok = ok && seamless;
+    out() << QString("  re-primes %1, underruns %2, dropped %3 ms  [%4]\n")
+                 .arg(reprimes).arg(underruns).arg(droppedMs, 0, 'f', 1)
+                 .arg(seamless ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int Benchmarks::run(const QStringList &args)
+{
+    const QString name = args.value(0);
+    const QStringList rest = args.mid(1);
+
+    if (name == QLatin1String("show-load"))
+        return showLoad(rest);
+    if (name == QLatin1String("show-save"))
+        return showSave(rest);
+    if (name == QLatin1String("silence-scan"))
+        return silenceScan(rest);
+    if (name == QLatin1String("meter-overhead"))
+        return meterOverhead(rest);
+    if (name == QLatin1String("limiter"))
+        return limiter(rest);
+    if (name == QLatin1String("resampler"))
+        return resampler(rest);
+    if (name == QLatin1String("go-latency"))
+        return goLatency(rest);
+    if (name == QLatin1String("virtual-fade"))
+        return virtualFade(rest);
+    if (name == QLatin1String("virtual-show"))
+        return virtualShow(rest);
+
+    out() << "available benchmarks: show-load, show-save, silence-scan, meter-overhead, limiter, resampler,"
+             " go-latency, virtual-fade, virtual-show\n";
+    return 2;
+}
@@ -0,0 +1,58 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <QStringList>
+
+/*
+============================================================
+ Benchmarks
+------------------------------------------------------------
+ - Headless measurements, run from the command line:
+     AudioCuePro --benchmark <name> [args...]
+ - Results go to stdout as plain text, one line per figure,
+   so runs are easy to diff and paste into reviews
+ - Available:
+     show-load <show>   parse time of a show in JSON and in
+                        the binary format (header, first
+                        scene, whole show)
+     show-save <show>   encode + atomic commit time of the
+                        same show in both formats (budget:
+                        500 ms per save)
+     silence-scan [dB]  import silence trim: vector scan vs
+                        the scalar loop on one minute of PCM
+     meter-overhead     CPU share of one cue's level meter
+                        (budget: under 1 % of a core)
+     limiter [dB]       master bus limiter on two hot,
+                        overlapping cues: CPU share,
+                        latency, output peak vs ceiling
+     resampler [quality]
+                        media rate and varispeed conversion
+                        per quality: stereo voices per core
+                        in real time, measured stopband and
+                        passband (18 / 20 kHz)
+     go-latency [GOs]   key press to first sample out, through
+                        the hotkey path of a generated show:
+                        p50 / p99 / max per stage (null
+                        output unless ACP_AUDIO_OUTPUT names
+                        a device backend)
+     virtual-fade [ms]  a cue stopped with its fade out on the
+                        virtual clock (ACP_AUDIO_OUTPUT=virtual),
+                        run flat out: the fade must end after
+                        its length of sample clock, within a
+                        display frame, however fast the wall
+     virtual-show       a count loop, an endless loop faded
+                        out by a GO and the cue after it, on
+                        the virtual clock: every start, pass
+                        end, fade and transition must land on
+                        its sample position (within a display
+                        frame), with no voice running dry
+============================================================
+*/
+
+namespace Benchmarks
+{
+    // args: everything after "--benchmark". Returns the exit code.
+    int run(const QStringList &args);
+}
+
+#endif // BENCHMARKS_H
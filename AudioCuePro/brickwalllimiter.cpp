@@ -0,0 +1,244 @@
+#include "brickwalllimiter.h"
+
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ACP_LIMITER_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define ACP_LIMITER_NEON
+#endif
+
+static const int kChunk = 512;              // frames per inner pass
+static const float kSilence = 1e-9f;        // below this a frame needs no gain
+
+namespace {
+
+/* ============================================================
+ * DETECTOR – gain each frame needs: min(1, ceiling / max|L,R|)
+ * ============================================================ */
+void requiredGainScalar(const float *stereo, float *out, int frames, float ceiling)
+{
+    for (int f = 0; f < frames; ++f)
+    {
+        const float peak = qMax(std::fabs(stereo[2 * f]), std::fabs(stereo[2 * f + 1]));
+        out[f] = peak > ceiling ? ceiling / peak : 1.0f;
+    }
+}
+
+// Gain stage: both channels of frame f times gains[f], then the
+// ceiling as a hard stop against rounding
+void applyGainScalar(float *stereo, const float *gains, int frames, float ceiling)
+{
+    for (int f = 0; f < frames; ++f)
+    {
+        stereo[2 * f]     = qBound(-ceiling, stereo[2 * f] * gains[f], ceiling);
+        stereo[2 * f + 1] = qBound(-ceiling, stereo[2 * f + 1] * gains[f], ceiling);
+    }
+}
+
+#if defined(ACP_LIMITER_SSE2)
+
+void requiredGain(const float *stereo, float *out, int frames, float ceiling)
+{
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 ceil = _mm_set1_ps(ceiling);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 floor = _mm_set1_ps(kSilence);
+    int f = 0;
+    for (; f + 4 <= frames; f += 4)
+    {
+        const __m128 a = _mm_and_ps(_mm_loadu_ps(stereo + 2 * f), absMask);      // L0 R0 L1 R1
+        const __m128 b = _mm_and_ps(_mm_loadu_ps(stereo + 2 * f + 4), absMask);  // L2 R2 L3 R3
+        const __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 peak = _mm_max_ps(_mm_max_ps(left, right), floor);
+        _mm_storeu_ps(out + f, _mm_min_ps(one, _mm_div_ps(ceil, peak)));
+    }
+    requiredGainScalar(stereo + 2 * f, out + f, frames - f, ceiling);
+}
+
+void applyGain(float *stereo, const float *gains, int frames, float ceiling)
+{
+    const __m128 hi = _mm_set1_ps(ceiling);
+    const __m128 lo = _mm_set1_ps(-ceiling);
+    int f = 0;
+    for (; f + 4 <= frames; f += 4)
+    {
+        const __m128 g = _mm_loadu_ps(gains + f);
+        const __m128 g01 = _mm_unpacklo_ps(g, g);                                // g0 g0 g1 g1
+        const __m128 g23 = _mm_unpackhi_ps(g, g);
+        float *p = stereo + 2 * f;
+        _mm_storeu_ps(p,     _mm_max_ps(lo, _mm_min_ps(hi, _mm_mul_ps(_mm_loadu_ps(p), g01))));
+        _mm_storeu_ps(p + 4, _mm_max_ps(lo, _mm_min_ps(hi, _mm_mul_ps(_mm_loadu_ps(p + 4), g23))));
+    }
+    applyGainScalar(stereo + 2 * f, gains + f, frames - f, ceiling);
+}
+
+#elif defined(ACP_LIMITER_NEON)
+
+void requiredGain(const float *stereo, float *out, int frames, float ceiling)
+{
+    const float32x4_t ceil = vdupq_n_f32(ceiling);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t floor = vdupq_n_f32(kSilence);
+    int f = 0;
+    for (; f + 4 <= frames; f += 4)
+    {
+        const float32x4x2_t lr = vld2q_f32(stereo + 2 * f);
+        const float32x4_t peak = vmaxq_f32(vmaxq_f32(vabsq_f32(lr.val[0]), vabsq_f32(lr.val[1])), floor);
+        // Reciprocal estimate plus two Newton steps: well inside
+        // the final clamp's tolerance
+        float32x4_t inv = vrecpeq_f32(peak);
+        inv = vmulq_f32(inv, vrecpsq_f32(peak, inv));
+        inv = vmulq_f32(inv, vrecpsq_f32(peak, inv));
+        vst1q_f32(out + f, vminq_f32(one, vmulq_f32(ceil, inv)));
+    }
+    requiredGainScalar(stereo + 2 * f, out + f, frames - f, ceiling);
+}
+
+void applyGain(float *stereo, const float *gains, int frames, float ceiling)
+{
+    const float32x4_t hi = vdupq_n_f32(ceiling);
+    const float32x4_t lo = vdupq_n_f32(-ceiling);
+    int f = 0;
+    for (; f + 4 <= frames; f += 4)
+    {
+        const float32x4_t g = vld1q_f32(gains + f);
+        float32x4x2_t lr = vld2q_f32(stereo + 2 * f);
+        lr.val[0] = vmaxq_f32(lo, vminq_f32(hi, vmulq_f32(lr.val[0], g)));
+        lr.val[1] = vmaxq_f32(lo, vminq_f32(hi, vmulq_f32(lr.val[1], g)));
+        vst2q_f32(stereo + 2 * f, lr);
+    }
+    applyGainScalar(stereo + 2 * f, gains + f, frames - f, ceiling);
+}
+
+#else
+
+void requiredGain(const float *stereo, float *out, int frames, float ceiling)
+{
+    requiredGainScalar(stereo, out, frames, ceiling);
+}
+
+void applyGain(float *stereo, const float *gains, int frames, float ceiling)
+{
+    applyGainScalar(stereo, gains, frames, ceiling);
+}
+
+#endif
+
+} // namespace
+
+/* ============================================================
+ * SETUP
+ * ============================================================ */
+void BrickwallLimiter::setup(int sampleRate, float lookaheadMs)
+{
+    m_sampleRate = sampleRate;
+    m_lookahead = qMax(1, int(std::lround(lookaheadMs * sampleRate / 1000.0f)));
+
+    m_delay.resize(2 * (m_lookahead + kChunk));
+    m_required.resize(kChunk);
+    m_gains.resize(kChunk);
+    m_minValues.resize(m_lookahead + 2);
+    m_minFrames.resize(m_lookahead + 2);
+    m_box.resize(m_lookahead);
+    reset();
+}
+
+void BrickwallLimiter::reset()
+{
+    std::fill(m_delay.begin(), m_delay.end(), 0.0f);
+    std::fill(m_gains.begin(), m_gains.end(), 1.0f);
+    m_minHead = m_minTail = 0;
+    m_frame = 0;
+
+    std::fill(m_box.begin(), m_box.end(), 1.0f);
+    m_boxPos = 0;
+    m_boxSum = m_lookahead;
+
+    m_gain = 1.0f;
+    m_reductionDb.store(0.0f, std::memory_order_relaxed);
+}
+
+/* ============================================================
+ * PROCESS – render thread
+ * ============================================================ */
+void BrickwallLimiter::process(float *stereo, int frames)
+{
+    if (m_lookahead <= 0 || frames <= 0)
+        return;
+
+    const float ceiling = float(qPow(10.0, qMin(0.0f, ceilingDb()) / 20.0));
+    const double releaseFrames = qMax(1.0, double(releaseMs()) * m_sampleRate / 1000.0);
+    const float releaseCoef = float(1.0 - std::exp(-1.0 / releaseFrames));
+
+    float deepest = 1.0f;
+    for (int done = 0; done < frames; done += kChunk)
+    {
+        const int n = qMin(kChunk, frames - done);
+        processChunk(stereo + 2 * done, n, ceiling, releaseCoef);
+        for (int i = 0; i < n; ++i)
+            deepest = qMin(deepest, m_gains[i]);
+    }
+    m_reductionDb.store(deepest < 1.0f ? float(-20.0 * std::log10(double(deepest))) : 0.0f,
+                        std::memory_order_relaxed);
+}
+
+void BrickwallLimiter::processChunk(float *stereo, int frames, float ceiling, float releaseCoef)
+{
+    const int L = m_lookahead;
+    const int capacity = m_minValues.size();
+    float *delay = m_delay.data();
+    float *required = m_required.data();
+    float *gains = m_gains.data();
+
+    // New input goes behind the L frames still waiting
+    std::memcpy(delay + 2 * L, stereo, sizeof(float) * 2 * frames);
+    requiredGain(stereo, required, frames, ceiling);
+
+    for (int i = 0; i < frames; ++i, ++m_frame)
+    {
+        // Minimum of the required gain over the last L + 1 frames
+        const float r = required[i];
+        while (m_minTail != m_minHead
+               && m_minValues[(m_minTail - 1 + capacity) % capacity] >= r)
+            m_minTail = (m_minTail - 1 + capacity) % capacity;
+        m_minValues[m_minTail] = r;
+        m_minFrames[m_minTail] = m_frame;
+        m_minTail = (m_minTail + 1) % capacity;
+        while (m_minFrames[m_minHead] < m_frame - L)
+            m_minHead = (m_minHead + 1) % capacity;
+        const float held = m_minValues[m_minHead];
+
+        // Box filter over L frames: a ramp that reaches the held
+        // value exactly when the peak leaves the delay line
+        m_boxSum += double(held) - m_box[m_boxPos];
+        m_box[m_boxPos] = held;
+        if (++m_boxPos == L)
+        {
+            // Re-add from scratch once per pass so rounding never drifts
+            m_boxPos = 0;
+            m_boxSum = 0.0;
+            for (float v : std::as_const(m_box))
+                m_boxSum += v;
+        }
+        const float attack = qMin(1.0f, float(m_boxSum / L));
+
+        // Down at once, back up with the release time constant
+        if (attack < m_gain)
+            m_gain = attack;
+        else
+            m_gain += (attack - m_gain) * releaseCoef;
+        gains[i] = m_gain;
+    }
+
+    // Oldest frames leave the delay line with their gain
+    std::memcpy(stereo, delay, sizeof(float) * 2 * frames);
+    std::memmove(delay, delay + 2 * frames, sizeof(float) * 2 * L);
+    applyGain(stereo, gains, frames, ceiling);
+}
@@ -0,0 +1,81 @@
+#ifndef BRICKWALLLIMITER_H
+#define BRICKWALLLIMITER_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+/*
+============================================================
+ BrickwallLimiter
+------------------------------------------------------------
+ - Look-ahead peak limiter for the master bus (stereo,
+   interleaved float), run by AudioEngine after the mix
+ - Per frame: the gain that keeps the louder channel at the
+   ceiling, held at its minimum over the look-ahead window,
+   smoothed by a box filter of the same length (the attack),
+   then released exponentially. The audio is delayed by the
+   window, so every peak meets a gain that is already down:
+   nothing leaves above the ceiling
+ - The detector and the gain stage are vectorised (SSE2 /
+   NEON, scalar fallback); the min-hold and release are a
+   few scalar operations per frame
+ - Ceiling and release can be changed from any thread
+   (atomics, picked up at the next block); the look-ahead is
+   fixed at setup() and is the limiter's latency
+============================================================
+*/
+
+class BrickwallLimiter
+{
+public:
+    static constexpr float kDefaultCeilingDb = -1.0f;
+    static constexpr float kDefaultReleaseMs = 150.0f;
+    static constexpr float kDefaultLookaheadMs = 5.0f;
+
+    void setup(int sampleRate, float lookaheadMs = kDefaultLookaheadMs);
+    // Empty the delay line, gain back to unity; no allocation
+    void reset();
+
+    void setCeilingDb(float db) { m_ceilingDb.store(db, std::memory_order_relaxed); }
+    void setReleaseMs(float ms) { m_releaseMs.store(ms, std::memory_order_relaxed); }
+    float ceilingDb() const { return m_ceilingDb.load(std::memory_order_relaxed); }
+    float releaseMs() const { return m_releaseMs.load(std::memory_order_relaxed); }
+
+    // In place; `frames` stereo frames
+    void process(float *stereo, int frames);
+
+    int latencyFrames() const { return m_lookahead; }
+    // Deepest gain reduction of the last block (dB, >= 0)
+    float gainReductionDb() const { return m_reductionDb.load(std::memory_order_relaxed); }
+
+private:
+    void processChunk(float *stereo, int frames, float ceiling, float releaseCoef);
+
+    int m_sampleRate = 0;
+    int m_lookahead = 0;              // frames
+
+    // Delay line: m_lookahead frames of history, then the chunk
+    QVector<float> m_delay;
+    QVector<float> m_required;        // per frame of the chunk
+    QVector<float> m_gains;
+
+    // Sliding minimum (monotonic queue) over lookahead + 1 frames
+    QVector<float> m_minValues;
+    QVector<qint64> m_minFrames;
+    int m_minHead = 0, m_minTail = 0;
+    qint64 m_frame = 0;
+
+    // Box filter over lookahead frames
+    QVector<float> m_box;
+    int m_boxPos = 0;
+    double m_boxSum = 0.0;
+
+    float m_gain = 1.0f;              // after release
+
+    std::atomic<float> m_ceilingDb { kDefaultCeilingDb };
+    std::atomic<float> m_releaseMs { kDefaultReleaseMs };
+    std::atomic<float> m_reductionDb { 0.0f };
+};
+
+#endif // BRICKWALLLIMITER_H
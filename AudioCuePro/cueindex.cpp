@@ -0,0 +1,78 @@
+#include "cueindex.h"
+
+#include <atomic>
+
+static std::atomic<quint64> s_nextCueId{1};
+
+/* ============================================================
+ * ID ALLOCATION
+ * ============================================================ */
+quint64 CueIndex::allocateId()
+{
+    return s_nextCueId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CueIndex::reserveId(quint64 id)
+{
+    quint64 next = s_nextCueId.load(std::memory_order_relaxed);
+    while (next <= id &&
+           !s_nextCueId.compare_exchange_weak(next, id + 1, std::memory_order_relaxed))
+    {
+    }
+}
+
+/* ============================================================
+ * LOOKUP
+ * ============================================================ */
+int CueIndex::lowerBound(quint64 id) const
+{
+    int lo = 0;
+    int hi = m_entries.size();
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (m_entries[mid].id < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+TrackWidget *CueIndex::find(quint64 id) const
+{
+    const int i = lowerBound(id);
+    if (i < m_entries.size() && m_entries[i].id == id)
+        return m_entries[i].cue;
+    return nullptr;
+}
+
+/* ============================================================
+ * INSERT / REMOVE
+ * ============================================================ */
+bool CueIndex::insert(quint64 id, TrackWidget *cue)
+{
+    if (id == 0 || !cue)
+        return false;
+
+    // Common case: newest ID goes to the end
+    if (m_entries.isEmpty() || m_entries.last().id < id)
+    {
+        m_entries.append({id, cue});
+        return true;
+    }
+
+    const int i = lowerBound(id);
+    if (i < m_entries.size() && m_entries[i].id == id)
+        return m_entries[i].cue == cue;
+
+    m_entries.insert(i, {id, cue});
+    return true;
+}
+
+void CueIndex::remove(quint64 id)
+{
+    const int i = lowerBound(id);
+    if (i < m_entries.size() && m_entries[i].id == id)
+        m_entries.removeAt(i);
+}
@@ -0,0 +1,50 @@
+#ifndef CUEINDEX_H
+#define CUEINDEX_H
+
+#include <QVector>
+#include <QtGlobal>
+
+class TrackWidget;
+
+/*
+============================================================
+ CueIndex
+------------------------------------------------------------
+ - Stable 64-bit cue IDs (never reused within a session,
+   persisted in the show file)
+ - Flat ID → cue lookup: one sorted array, binary search.
+   IDs are handed out in increasing order, so inserts are
+   almost always appends
+ - Trees, combos and drag data carry IDs and resolve them
+   here instead of casting pointers
+============================================================
+*/
+
+class CueIndex
+{
+public:
+    // 0 is never a valid ID
+    static quint64 allocateId();
+    // Keep future IDs above one that was loaded from disk
+    static void reserveId(quint64 id);
+
+    bool insert(quint64 id, TrackWidget *cue);   // false if id is taken
+    void remove(quint64 id);
+    TrackWidget *find(quint64 id) const;
+    bool contains(quint64 id) const { return find(id) != nullptr; }
+
+    int size() const { return m_entries.size(); }
+    void clear() { m_entries.clear(); }
+
+private:
+    struct Entry {
+        quint64 id;
+        TrackWidget *cue;
+    };
+
+    int lowerBound(quint64 id) const;
+
+    QVector<Entry> m_entries;   // sorted by id
+};
+
+#endif // CUEINDEX_H
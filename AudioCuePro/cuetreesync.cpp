@@ -0,0 +1,82 @@
+#include "cuetreesync.h"
+
+#include <QTreeWidget>
+#include <QTreeWidgetItem>
+
+quint64 CueTreeSync::idOf(const QTreeWidgetItem *item)
+{
+    return item ? item->data(0, Qt::UserRole).toULongLong() : 0;
+}
+
+/* ============================================================
+ * SYNC ONE PARENT
+ * ============================================================ */
+void CueTreeSync::syncChildren(QTreeWidgetItem *parent,
+                               const QVector<Row> &rows,
+                               ItemMap &items,
+                               const std::function<QTreeWidgetItem*()> &makeItem)
+{
+    if (!parent)
+        return;
+
+    for (int pos = 0; pos < rows.size(); ++pos)
+    {
+        const Row &row = rows[pos];
+
+        QTreeWidgetItem *item = items.value(row.id, nullptr);
+        if (!item)
+        {
+            item = makeItem();
+            item->setData(0, Qt::UserRole, QVariant::fromValue<quint64>(row.id));
+            items.insert(row.id, item);
+        }
+
+        if (parent->child(pos) != item)
+        {
+            if (QTreeWidgetItem *oldParent = item->parent())
+                oldParent->takeChild(oldParent->indexOfChild(item));
+            parent->insertChild(pos, item);
+        }
+
+        if (item->text(0) != row.label)
+            item->setText(0, row.label);
+    }
+
+    // Anything left over moved to another parent or was deleted
+    while (parent->childCount() > rows.size())
+        parent->takeChild(rows.size());
+}
+
+void CueTreeSync::dropDetached(ItemMap &items)
+{
+    for (auto it = items.begin(); it != items.end(); )
+    {
+        if (!it.value()->parent())
+        {
+            delete it.value();
+            it = items.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void CueTreeSync::reindex(const QTreeWidget *tree, ItemMap &items)
+{
+    items.clear();
+    if (!tree)
+        return;
+
+    for (int i = 0; i < tree->topLevelItemCount(); ++i)
+    {
+        QTreeWidgetItem *sceneItem = tree->topLevelItem(i);
+        for (int c = 0; c < sceneItem->childCount(); ++c)
+        {
+            QTreeWidgetItem *child = sceneItem->child(c);
+            if (const quint64 id = idOf(child))
+                items.insert(id, child);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef CUETREESYNC_H
+#define CUETREESYNC_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+class QTreeWidget;
+class QTreeWidgetItem;
+
+/*
+============================================================
+ CueTreeSync
+------------------------------------------------------------
+ - Keeps scene → cue trees in step with the data model by
+   cue ID instead of clearing and rebuilding them
+ - Existing rows are moved, relabelled or dropped; only new
+   cues get new items
+ - Rows carry the cue ID in Qt::UserRole
+============================================================
+*/
+
+namespace CueTreeSync
+{
+    struct Row {
+        quint64 id = 0;
+        QString label;
+    };
+
+    using ItemMap = QHash<quint64, QTreeWidgetItem*>;
+
+    quint64 idOf(const QTreeWidgetItem *item);
+
+    // Make `parent`'s children match `rows`. Items are taken from
+    // `items` (wherever they currently sit); `makeItem` creates rows
+    // for new cues. Children not in `rows` are detached, not deleted,
+    // so a later parent can adopt them — finish with dropDetached().
+    void syncChildren(QTreeWidgetItem *parent,
+                      const QVector<Row> &rows,
+                      ItemMap &items,
+                      const std::function<QTreeWidgetItem*()> &makeItem);
+
+    // Delete items that no parent adopted (their cue is gone)
+    void dropDetached(ItemMap &items);
+
+    // Rebuild the ID → item map from the tree, e.g. after the
+    // view's own drag & drop moved items around
+    void reindex(const QTreeWidget *tree, ItemMap &items);
+}
+
+#endif // CUETREESYNC_H
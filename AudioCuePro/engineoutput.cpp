@@ -0,0 +1,326 @@
+#include "engineoutput.h"
+#include "audioengine.h"
+#include "latencyprobe.h"
+
+#include <QAudioSink>
+#include <QDebug>
+#include <QIODevice>
+#include <cstring>
+
+static const int kBufferMs = 20;            // sink buffer
+static const int kFollowerRingMs = 250;
+static const int kFollowerPrimeMs = 40;     // a follower's margin against drift
+
+namespace {
+
+/* ============================================================
+ * RENDER DEVICE – what the sink pulls from
+ * ============================================================ */
+class RenderDevice : public QIODevice
+{
+public:
+    explicit RenderDevice(EngineOutput *output) : m_output(output) {}
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        // Endless: silence when nothing plays
+        return QIODevice::bytesAvailable() + (qint64(1) << 20);
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override { return m_output->read(data, maxSize); }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    EngineOutput *m_output;
+};
+
+} // namespace
+
+EngineOutput::EngineOutput(AudioEngine *engine, const QAudioDevice &device,
+                           int channels, int sampleRate, bool primary)
+    : m_engine(engine),
+      m_device(device),
+      m_channels(channels),
+      m_sampleRate(sampleRate),
+      m_primary(primary)
+{
+    m_block.fill(0.0f, AudioEngine::kBlockFrames * channels);
+    m_send.fill(0.0f, AudioEngine::kBlockFrames * channels);
+    if (!primary)
+    {
+        m_capacity = qint64(sampleRate) * kFollowerRingMs / 1000;
+        m_primeFrames = qint64(sampleRate) * kFollowerPrimeMs / 1000;
+        m_ring.fill(0.0f, m_capacity * channels);
+    }
+    launch();
+}
+
+EngineOutput::EngineOutput(AudioEngine *engine, int channels, int sampleRate,
+                           NullAudioSink::Clock clock)
+    : m_engine(engine),
+      m_channels(channels),
+      m_sampleRate(sampleRate),
+      m_primary(true),
+      m_headless(true),
+      m_nullClock(clock)
+{
+    m_block.fill(0.0f, AudioEngine::kBlockFrames * channels);
+    m_send.fill(0.0f, AudioEngine::kBlockFrames * channels);
+    launch();
+}
+
+void EngineOutput::launch()
+{
+    m_thread.setObjectName(QStringLiteral("AudioOutput ") + description());
+    m_thread.start(QThread::TimeCriticalPriority);
+    m_context = new QObject;
+    m_context->moveToThread(&m_thread);
+    QMetaObject::invokeMethod(m_context, [this] { start(); }, Qt::BlockingQueuedConnection);
+}
+
+EngineOutput::~EngineOutput()
+{
+    QMetaObject::invokeMethod(m_context, [this] { stop(); }, Qt::BlockingQueuedConnection);
+    m_context->deleteLater();
+    m_thread.quit();
+    m_thread.wait();
+}
+
+QString EngineOutput::description() const
+{
+    if (!m_headless)
+        return m_device.description();
+    return m_nullClock == NullAudioSink::Clock::Manual
+        ? QStringLiteral("Null output (virtual clock)") : QStringLiteral("Null output");
+}
+
+QString EngineOutput::sampleFormat() const
+{
+    return m_format.sampleFormat() == QAudioFormat::Float
+        ? QStringLiteral("32-bit float") : QStringLiteral("16-bit");
+}
+
+/* ============================================================
+ * START / STOP – output thread
+ * ============================================================ */
+void EngineOutput::start()
+{
+    QAudioFormat format;
+    format.setSampleRate(m_sampleRate);
+    format.setChannelCount(m_channels);
+    format.setSampleFormat(QAudioFormat::Float);
+
+    m_io = new RenderDevice(this);
+    m_io->open(QIODevice::ReadOnly);
+
+    if (m_headless)
+    {
+        m_format = format;
+        m_nullSink = new NullAudioSink(m_io, format, m_nullClock);
+        m_nullSink->start();
+        m_bufferMs.store(m_nullSink->bufferMs(), std::memory_order_relaxed);
+        m_running.store(true, std::memory_order_release);
+        return;
+    }
+
+    if (!m_device.isFormatSupported(format))
+        format.setSampleFormat(QAudioFormat::Int16);
+    if (!m_device.isFormatSupported(format))
+        qWarning() << "EngineOutput:" << m_device.description()
+                   << "does not list" << m_sampleRate << "Hz," << m_channels << "channels; trying anyway";
+    m_format = format;
+
+    m_sink = new QAudioSink(m_device, format);
+    m_sink->setBufferSize(format.bytesForDuration(qint64(kBufferMs) * 1000));
+    QObject::connect(m_sink, &QAudioSink::stateChanged, m_context, [this](QAudio::State) {
+        if (m_sink->error() == QAudio::UnderrunError)
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+    });
+    m_sink->start(m_io);
+    // What the backend actually granted, not what was asked for
+    m_bufferMs.store(format.durationForBytes(m_sink->bufferSize()) / 1000.0,
+                     std::memory_order_relaxed);
+
+    m_running.store(m_sink->error() == QAudio::NoError, std::memory_order_release);
+    if (!isRunning())
+        qWarning() << "EngineOutput: could not start" << m_device.description();
+}
+
+void EngineOutput::stop()
+{
+    m_running.store(false, std::memory_order_release);
+    if (m_sink)
+        m_sink->stop();
+    delete m_sink;
+    m_sink = nullptr;
+    if (m_nullSink)
+        m_nullSink->stop();
+    delete m_nullSink;
+    m_nullSink = nullptr;
+    delete m_io;
+    m_io = nullptr;
+}
+
+/* ============================================================
+ * PULL – output thread
+ * ============================================================ */
+qint64 EngineOutput::read(char *data, qint64 maxSize)
+{
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    const bool isFloat = m_format.sampleFormat() == QAudioFormat::Float;
+    const qint64 frames = maxSize / bytesPerFrame;
+
+    for (qint64 done = 0; done < frames; done += AudioEngine::kBlockFrames)
+    {
+        const int n = int(qMin<qint64>(AudioEngine::kBlockFrames, frames - done));
+        float *block = m_block.data();
+        if (m_primary)
+        {
+            m_engine->render(block, n, m_channels);
+            if (LatencyProbe::waiting(LatencyProbe::FirstSample))
+                probeFirstSample(block, n);
+        }
+        else
+        {
+            pull(block, n);
+        }
+
+        char *out = data + done * bytesPerFrame;
+        const int samples = n * m_channels;
+        if (isFloat)
+        {
+            std::memcpy(out, block, sizeof(float) * samples);
+        }
+        else
+        {
+            qint16 pcm[1024];
+            for (int i = 0; i < samples; i += 1024)
+            {
+                const int m = qMin(1024, samples - i);
+                for (int k = 0; k < m; ++k)
+                    pcm[k] = qint16(qBound(-32768, qRound(block[i + k] * 32767.0f), 32767));
+                std::memcpy(out + sizeof(qint16) * i, pcm, sizeof(qint16) * m);
+            }
+        }
+    }
+    return frames * bytesPerFrame;
+}
+
+// go-latency benchmark: the first sound of a GO, to the frame
+void EngineOutput::probeFirstSample(const float *block, int frames) const
+{
+    for (int f = 0; f < frames; ++f)
+    {
+        for (int c = 0; c < m_channels; ++c)
+        {
+            if (block[f * m_channels + c] != 0.0f)
+            {
+                LatencyProbe::mark(LatencyProbe::FirstSample, qint64(f) * 1000000000 / m_sampleRate);
+                return;
+            }
+        }
+    }
+}
+
+/* ============================================================
+ * FOLLOWER RING
+ * ============================================================ */
+void EngineOutput::clearSend(int frames)
+{
+    std::memset(m_send.data(), 0, sizeof(float) * frames * m_channels);
+}
+
+void EngineOutput::cut(int rampFrames)
+{
+    m_cutRamp.store(qMax(1, rampFrames), std::memory_order_relaxed);
+    m_cutAt.store(m_written.load(std::memory_order_relaxed) + rampFrames, std::memory_order_release);
+}
+
+double EngineOutput::queuedMs() const
+{
+    if (m_primary)
+        return 0.0;
+    const qint64 queued = m_written.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+    return 1000.0 * qMax<qint64>(0, queued) / m_sampleRate;
+}
+
+void EngineOutput::send(int frames)
+{
+    const qint64 written = m_written.load(std::memory_order_relaxed);
+    const qint64 free = m_capacity - (written - m_read.load(std::memory_order_acquire));
+    // This device's clock is slower than the primary's: it has
+    // fallen a whole ring behind, and the newest audio has to give
+    frames = int(qMin<qint64>(frames, free));
+    if (frames <= 0)
+        return;
+
+    const qint64 at = written % m_capacity;
+    const qint64 first = qMin<qint64>(frames, m_capacity - at);
+    std::memcpy(m_ring.data() + at * m_channels, m_send.constData(),
+                sizeof(float) * first * m_channels);
+    if (first < frames)
+        std::memcpy(m_ring.data(), m_send.constData() + first * m_channels,
+                    sizeof(float) * (frames - first) * m_channels);
+    m_written.store(written + frames, std::memory_order_release);
+}
+
+int EngineOutput::pull(float *out, int frames)
+{
+    const qint64 cut = m_cutAt.load(std::memory_order_acquire);
+    if (cut != m_cutSeen)
+    {
+        m_cutSeen = cut;
+        m_cutLength = m_cutRamp.load(std::memory_order_relaxed);
+        m_cutFade = m_cutLength;
+    }
+
+    const qint64 read = m_read.load(std::memory_order_relaxed);
+    const qint64 available = m_written.load(std::memory_order_acquire) - read;
+    if (!m_primed && available >= m_primeFrames)
+        m_primed = true;
+
+    const int n = m_primed ? int(qMin<qint64>(frames, available)) : 0;
+    if (n > 0)
+    {
+        const qint64 at = read % m_capacity;
+        const qint64 first = qMin<qint64>(n, m_capacity - at);
+        std::memcpy(out, m_ring.constData() + at * m_channels, sizeof(float) * first * m_channels);
+        if (first < n)
+            std::memcpy(out + first * m_channels, m_ring.constData(),
+                        sizeof(float) * (n - first) * m_channels);
+        m_read.store(read + n, std::memory_order_release);
+    }
+
+    // PANIC: the queue fades out, and what is left of it before the
+    // cut is skipped, not played
+    if (n > 0 && (m_cutFade > 0 || read < m_cutSeen))
+    {
+        for (int f = 0; f < n; ++f)
+        {
+            float g = 0.0f;
+            if (m_cutFade > 0)
+                g = float(--m_cutFade) / m_cutLength;
+            else if (read + f >= m_cutSeen)
+                g = 1.0f;
+            for (int c = 0; c < m_channels; ++c)
+                out[f * m_channels + c] *= g;
+        }
+        if (m_cutFade == 0)
+        {
+            const qint64 skipTo = qMin(m_cutSeen, m_written.load(std::memory_order_acquire));
+            if (skipTo > read + n)
+                m_read.store(skipTo, std::memory_order_release);
+        }
+    }
+
+    if (n < frames)
+    {
+        // Ran dry (this clock is faster, or the primary stalled):
+        // silence, and build the margin up again
+        std::memset(out + n * m_channels, 0, sizeof(float) * (frames - n) * m_channels);
+        m_primed = false;
+    }
+    return n;
+}
@@ -0,0 +1,117 @@
+#ifndef ENGINEOUTPUT_H
+#define ENGINEOUTPUT_H
+
+#include <QAudioDevice>
+#include <QAudioFormat>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+
+#include "nullaudiosink.h"
+
+class AudioEngine;
+class QAudioSink;
+class QIODevice;
+
+/*
+============================================================
+ EngineOutput
+------------------------------------------------------------
+ - One physical audio device of the AudioEngine, with its own
+   QAudioSink pulled from its own thread (time-critical)
+ - The primary output (the one carrying the first bus) is the
+   engine's clock: its pulls run AudioEngine::render(), which
+   mixes every bus once and writes each bus into the channels
+   of the output it is routed to
+ - Every other output is a follower: render() hands it its
+   share through a lock-free ring, and its own sink drains the
+   ring at the device's pace. Clocks of separate devices drift,
+   so a follower re-primes when it runs dry and drops the
+   newest audio when it gets too far behind. On a PANIC it
+   fades out what it has queued rather than play it, so its
+   PANIC time is its own buffer, not the ring's
+ - Interleaved float, `channels` wide, at the engine rate;
+   16-bit if the device will not take float
+ - Without a device (headless) a NullAudioSink pulls instead;
+   it is always the primary, and its sample count is the
+   engine's clock
+============================================================
+*/
+
+class EngineOutput
+{
+public:
+    EngineOutput(AudioEngine *engine, const QAudioDevice &device,
+                 int channels, int sampleRate, bool primary);
+    // Headless: no device, a NullAudioSink with `clock` pulls
+    EngineOutput(AudioEngine *engine, int channels, int sampleRate, NullAudioSink::Clock clock);
+    ~EngineOutput();
+    EngineOutput(const EngineOutput &) = delete;
+    EngineOutput &operator=(const EngineOutput &) = delete;
+
+    bool isPrimary() const { return m_primary; }
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+    int channels() const { return m_channels; }
+    QString description() const;
+    QString sampleFormat() const;
+    double bufferMs() const { return m_bufferMs.load(std::memory_order_relaxed); }
+    int underruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    double queuedMs() const;            // follower ring fill; 0 for the primary
+    NullAudioSink *nullSink() const { return m_nullSink; }
+
+    // Followers, from the primary's render thread: a block to mix
+    // into (zeroed by clearSend()), then queued with send()
+    float *sendBlock() { return m_send.data(); }
+    void clearSend(int frames);
+    void send(int frames);
+    // PANIC seen: fade the queued audio out over `rampFrames`, then
+    // skip to where the engine's own ramp (from the next send()) is
+    // down
+    void cut(int rampFrames);
+
+    // Device thread (the sink's pull)
+    qint64 read(char *data, qint64 maxSize);
+
+private:
+    void launch();
+    void start();
+    void stop();
+    int pull(float *out, int frames);
+    void probeFirstSample(const float *block, int frames) const;
+
+    AudioEngine *m_engine;
+    const QAudioDevice m_device;
+    const int m_channels;
+    const int m_sampleRate;
+    const bool m_primary;
+    const bool m_headless = false;
+    const NullAudioSink::Clock m_nullClock = NullAudioSink::Clock::Realtime;
+
+    QThread m_thread;
+    QObject *m_context = nullptr;       // lives on m_thread
+    QAudioSink *m_sink = nullptr;
+    NullAudioSink *m_nullSink = nullptr;
+    QIODevice *m_io = nullptr;
+    QAudioFormat m_format;
+    std::atomic<bool> m_running { false };
+    std::atomic<int> m_underruns { 0 };
+    std::atomic<double> m_bufferMs { 0.0 };
+
+    QVector<float> m_block;             // device thread: one block
+    QVector<float> m_send;              // render thread: one block
+
+    // Follower ring (primary render thread in, device thread out)
+    QVector<float> m_ring;
+    qint64 m_capacity = 0;              // frames
+    qint64 m_primeFrames = 0;
+    std::atomic<qint64> m_written { 0 };
+    std::atomic<qint64> m_read { 0 };
+    bool m_primed = false;
+    std::atomic<qint64> m_cutAt { -1 };     // ring position the PANIC skips to
+    std::atomic<int> m_cutRamp { 1 };
+    qint64 m_cutSeen = -1;                  // device thread
+    int m_cutFade = 0;
+    int m_cutLength = 1;
+};
+
+#endif // ENGINEOUTPUT_H
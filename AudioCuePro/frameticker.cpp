@@ -0,0 +1,222 @@
+#include "frameticker.h"
+
+#include <QWidget>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QtMath>
+
+/* ============================================================
+ * SINGLETON
+ * ============================================================ */
+FrameTicker *FrameTicker::instance()
+{
+    // Parented to the application so it dies with the event loop
+    static QPointer<FrameTicker> s_instance;
+    if (!s_instance)
+        s_instance = new FrameTicker(QCoreApplication::instance());
+    return s_instance;
+}
+
+/* ============================================================
+ * CONSTRUCTOR
+ * ============================================================ */
+FrameTicker::FrameTicker(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+
+    // Match the primary display refresh rate (16 ms at 60 Hz).
+    // Clamp so a 240 Hz panel or a bogus 0 Hz report stays sane.
+    double hz = 60.0;
+    if (QScreen *screen = QGuiApplication::primaryScreen())
+    {
+        if (screen->refreshRate() > 1.0)
+            hz = screen->refreshRate();
+    }
+
+    m_frameIntervalMs = qBound(8, qRound(1000.0 / hz), 33);
+
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(m_frameIntervalMs);
+    connect(&m_timer, &QTimer::timeout, this, &FrameTicker::onTick);
+}
+
+/* ============================================================
+ * SUBSCRIBE / UNSUBSCRIBE
+ * ============================================================ */
+int FrameTicker::subscribe(QObject *owner, Callback cb, Mode mode, int intervalMs)
+{
+    if (!owner || !cb)
+        return 0;
+
+    Subscription s;
+    s.id = m_nextId++;
+    s.owner = owner;
+    s.widget = qobject_cast<QWidget*>(owner);
+    s.cb = std::move(cb);
+    s.mode = mode;
+    s.intervalMs = qMax(0, intervalMs);
+    s.lastRunMs = now();
+
+    m_subs.append(std::move(s));
+    updateTimerState();
+    return m_subs.last().id;
+}
+
+void FrameTicker::unsubscribe(int id)
+{
+    if (id == 0)
+        return;
+
+    for (Subscription &s : m_subs)
+    {
+        if (s.id == id && !s.removed)
+        {
+            // Never destroy the callback here: we may be inside it.
+            s.removed = true;
+            break;
+        }
+    }
+
+    if (!m_inTick)
+    {
+        compact();
+        updateTimerState();
+    }
+}
+
+bool FrameTicker::isSubscribed(int id) const
+{
+    if (id == 0)
+        return false;
+
+    for (const Subscription &s : m_subs)
+    {
+        if (s.id == id)
+            return !s.removed && s.owner;
+    }
+    return false;
+}
+
+int FrameTicker::subscriberCount() const
+{
+    int n = 0;
+    for (const Subscription &s : m_subs)
+    {
+        if (!s.removed && s.owner)
+            ++n;
+    }
+    return n;
+}
+
+/* ============================================================
+ * VIRTUAL TIME
+ * ============================================================ */
+void FrameTicker::setVirtualTime(bool on)
+{
+    if (on == m_virtual)
+        return;
+    // Starts from the real clock, so subscriptions keep their place
+    m_virtualStart = now();
+    m_virtualNow = m_virtualStart;
+    m_virtual = on;
+    updateTimerState();
+}
+
+void FrameTicker::setVirtualNow(qint64 ms)
+{
+    if (!m_virtual || m_virtualStart + ms <= m_virtualNow)
+        return;
+    m_virtualNow = m_virtualStart + ms;
+    onTick();
+}
+
+/* ============================================================
+ * ONE BATCHED PASS PER FRAME
+ * ============================================================ */
+void FrameTicker::onTick()
+{
+    const qint64 t = now();
+
+    // Accept a tick up to half a timer period early, so timer jitter
+    // does not push an interval subscription out by a whole period.
+    const int slack = m_timer.interval() / 2;
+
+    m_inTick = true;
+
+    // Subscriptions added during this pass run from the next frame on
+    const int count = m_subs.size();
+    for (int i = 0; i < count; ++i)
+    {
+        Subscription &s = m_subs[i];
+        if (s.removed)
+            continue;
+
+        if (!s.owner)
+        {
+            s.removed = true;
+            continue;
+        }
+
+        if (s.intervalMs > 0 && t - s.lastRunMs < s.intervalMs - slack)
+            continue;
+
+        if (s.mode == WhenVisible && s.widget)
+        {
+            if (!s.widget->isVisible() || s.widget->window()->isMinimized())
+                continue;   // lastRunMs stays put, delta accumulates
+        }
+
+        qint64 delta = t - s.lastRunMs;
+
+        // Interval tickers advance in fixed steps so a 1 s clock does
+        // not drift by a frame per second; resync if we fell far behind.
+        if (s.intervalMs > 0 && delta < 2 * s.intervalMs)
+            s.lastRunMs += s.intervalMs;
+        else
+            s.lastRunMs = t;
+
+        // Copy: the callback may subscribe and reallocate m_subs
+        Callback cb = s.cb;
+        cb(t, delta);
+    }
+
+    m_inTick = false;
+
+    compact();
+    updateTimerState();
+}
+
+void FrameTicker::compact()
+{
+    for (int i = m_subs.size() - 1; i >= 0; --i)
+    {
+        if (m_subs[i].removed || !m_subs[i].owner)
+            m_subs.removeAt(i);
+    }
+}
+
+void FrameTicker::updateTimerState()
+{
+    if (m_subs.isEmpty() || m_virtual)
+    {
+        m_timer.stop();
+        return;
+    }
+
+    // Run at frame rate only if someone needs every frame; an idle
+    // window with just the 1 s clock wakes up once per second.
+    int interval = 0;
+    for (const Subscription &s : m_subs)
+    {
+        const int want = (s.intervalMs > 0) ? s.intervalMs : m_frameIntervalMs;
+        interval = (interval == 0) ? want : qMin(interval, want);
+    }
+    interval = qMax(interval, m_frameIntervalMs);
+
+    if (m_timer.interval() != interval)
+        m_timer.setInterval(interval);   // restarts an active timer
+
+    if (!m_timer.isActive())
+        m_timer.start();
+}
@@ -0,0 +1,96 @@
+#ifndef FRAMETICKER_H
+#define FRAMETICKER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QPointer>
+#include <functional>
+
+class QWidget;
+
+/*
+============================================================
+ FrameTicker
+------------------------------------------------------------
+ - One display-rate timer shared by the whole application
+ - Widgets subscribe a callback instead of owning QTimers
+ - All subscribers run in one batched pass per frame
+ - WhenVisible subscribers are skipped while their widget
+   (or its window) is hidden or minimized
+ - Optional per-subscription interval for slow tickers
+   (clock, polling) that still share the same wakeup
+ - The timer only runs while somebody is subscribed
+ - Virtual time (headless runs, see AudioEngine::advanceClock):
+   the timer stops and the clock only moves, one pass at a
+   time, when the owner of the time sets it
+============================================================
+*/
+
+class FrameTicker : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Mode {
+        WhenVisible,   // display work: labels, playheads, blinking
+        Always         // state that must advance off-screen (fades, clocks)
+    };
+
+    // nowMs  = ticker clock (monotonic, ms since ticker creation)
+    // deltaMs = time since this subscription last ran
+    using Callback = std::function<void(qint64 nowMs, qint64 deltaMs)>;
+
+    static FrameTicker *instance();
+
+    // Returns a non-zero handle. The subscription is dropped
+    // automatically when the owner is destroyed.
+    int subscribe(QObject *owner, Callback cb,
+                  Mode mode = WhenVisible, int intervalMs = 0);
+    void unsubscribe(int id);
+    bool isSubscribed(int id) const;
+
+    qint64 now() const { return m_virtual ? m_virtualNow : m_clock.elapsed(); }
+
+    // Virtual time: now() stands still until setVirtualNow()
+    // moves it (ms since virtual time was switched on) and runs
+    // one pass
+    void setVirtualTime(bool on);
+    bool isVirtualTime() const { return m_virtual; }
+    void setVirtualNow(qint64 ms);
+    int frameIntervalMs() const { return m_frameIntervalMs; }
+    int subscriberCount() const;
+
+private slots:
+    void onTick();
+
+private:
+    explicit FrameTicker(QObject *parent = nullptr);
+
+    struct Subscription {
+        int id = 0;
+        QPointer<QObject> owner;
+        QWidget *widget = nullptr;   // owner as QWidget, if it is one
+        Callback cb;
+        Mode mode = WhenVisible;
+        int intervalMs = 0;
+        qint64 lastRunMs = 0;
+        bool removed = false;
+    };
+
+    void compact();
+    void updateTimerState();
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    int m_frameIntervalMs = 16;
+    QVector<Subscription> m_subs;
+    int m_nextId = 1;
+    bool m_inTick = false;
+    bool m_virtual = false;
+    qint64 m_virtualStart = 0;
+    qint64 m_virtualNow = 0;
+};
+
+#endif // FRAMETICKER_H
@@ -0,0 +1,67 @@
+#include "latencyprobe.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+std::atomic<bool> s_armed { false };
+std::atomic<qint64> s_at[LatencyProbe::StageCount];
+
+qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+QString LatencyProbe::stageName(Stage stage)
+{
+    switch (stage)
+    {
+    case KeyPress:    return QStringLiteral("key press");
+    case Hotkey:      return QStringLiteral("hotkey");
+    case PlayRequest: return QStringLiteral("play request");
+    case PlayFromUI:  return QStringLiteral("play from UI");
+    case PlayIssued:  return QStringLiteral("play issued");
+    case FirstBuffer: return QStringLiteral("first buffer");
+    case FirstSample: return QStringLiteral("first sample");
+    case StageCount:  break;
+    }
+    return QString();
+}
+
+void LatencyProbe::arm()
+{
+    s_armed.store(false, std::memory_order_release);
+    for (std::atomic<qint64> &at : s_at)
+        at.store(0, std::memory_order_relaxed);
+    s_at[KeyPress].store(nowNs(), std::memory_order_relaxed);
+    s_armed.store(true, std::memory_order_release);
+}
+
+void LatencyProbe::disarm()
+{
+    s_armed.store(false, std::memory_order_release);
+}
+
+bool LatencyProbe::waiting(Stage stage)
+{
+    return s_armed.load(std::memory_order_relaxed)
+        && s_at[stage].load(std::memory_order_acquire) == 0;
+}
+
+void LatencyProbe::mark(Stage stage, qint64 offsetNs)
+{
+    if (!s_armed.load(std::memory_order_relaxed))
+        return;
+    qint64 expected = 0;
+    s_at[stage].compare_exchange_strong(expected, nowNs() + offsetNs, std::memory_order_acq_rel);
+}
+
+qint64 LatencyProbe::elapsedNs(Stage stage)
+{
+    const qint64 at = s_at[stage].load(std::memory_order_acquire);
+    return at == 0 ? -1 : at - s_at[KeyPress].load(std::memory_order_acquire);
+}
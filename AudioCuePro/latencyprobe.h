@@ -0,0 +1,58 @@
+#ifndef LATENCYPROBE_H
+#define LATENCYPROBE_H
+
+#include <QString>
+#include <QtGlobal>
+
+/*
+============================================================
+ LatencyProbe
+------------------------------------------------------------
+ - Timestamps one GO on its way from the key to the first
+   sample that leaves the engine, for the go-latency
+   benchmark:
+     KeyPress      arm(): the benchmark sends the key
+     Hotkey        MainWindow::handleHotkey
+     PlayRequest   MainWindow::onTrackPlayRequested
+     PlayFromUI    TrackWidget::playFromUI
+     PlayIssued    playFromUI done, the player told to play
+     FirstBuffer   first decoded buffer pushed into a voice
+     FirstSample   first non-zero sample handed to the sink
+                   (to the frame: the block's time plus the
+                   sample's offset in it)
+ - Each stage keeps the first time it is reached after
+   arm(). Disarmed, mark() is one relaxed atomic load, so
+   the hooks stay in the playback path for good
+ - Lock-free: FirstBuffer and FirstSample are marked from
+   the delivery and output threads
+============================================================
+*/
+
+namespace LatencyProbe
+{
+    enum Stage {
+        KeyPress,
+        Hotkey,
+        PlayRequest,
+        PlayFromUI,
+        PlayIssued,
+        FirstBuffer,
+        FirstSample,
+        StageCount
+    };
+
+    QString stageName(Stage stage);
+
+    // Forget the last run and start a new one at KeyPress
+    void arm();
+    void disarm();
+
+    // Armed and `stage` not reached yet
+    bool waiting(Stage stage);
+    void mark(Stage stage, qint64 offsetNs = 0);
+
+    // Since KeyPress; -1 if not reached
+    qint64 elapsedNs(Stage stage);
+}
+
+#endif // LATENCYPROBE_H
@@ -0,0 +1,176 @@
+#include "levelmeter.h"
+
+#include <QAudioBuffer>
+#include <QtMath>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+static const int kRing = 300;          // 10 ms sub-blocks: 3 s
+static const int kPeakBlocks = 5;      // 50 ms
+static const int kRmsBlocks = 30;      // 300 ms
+static const qint64 kStaleMs = 150;    // no buffers for this long = silent
+static const qint64 kRestartMs = 500;  // ... and this long = start over
+static const float kFloorLufs = -70.0f;
+
+namespace {
+
+qint64 nowMs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+/* ============================================================
+ * SETUP (first buffer, or the format changed)
+ * ============================================================ */
+void LevelMeter::setup(int channels, int sampleRate)
+{
+    m_channels = channels;
+    m_sampleRate = sampleRate;
+    m_subFrames = qMax(1, sampleRate / 100);
+    m_kWeighting.design(sampleRate);
+
+    m_filters.fill(Loudness::KWeighting::State(), channels);
+    m_weights.resize(channels);
+    for (int c = 0; c < channels; ++c)
+        m_weights[c] = Loudness::channelWeight(c, channels);
+
+    m_peakRing.fill(0.0f, kRing);
+    m_squareRing.fill(0.0, kRing);
+    m_weightedRing.fill(0.0, kRing);
+    m_ringPos = 0;
+    m_subFill = 0;
+    m_subSquares = m_subWeighted = 0.0;
+    m_subPeak = 0.0f;
+}
+
+/* ============================================================
+ * PROCESS – render thread
+ * ============================================================ */
+void LevelMeter::process(const QAudioBuffer &buffer)
+{
+    const QAudioFormat fmt = buffer.format();
+    const int channels = fmt.channelCount();
+    const int frames = int(buffer.frameCount());
+    if (channels <= 0 || frames <= 0 || fmt.sampleRate() <= 0)
+        return;
+
+    if (channels != m_channels || fmt.sampleRate() != m_sampleRate)
+        setup(channels, fmt.sampleRate());
+
+    switch (fmt.sampleFormat())
+    {
+    case QAudioFormat::Float:
+        processFrames(buffer.constData<float>(), frames, channels, 1.0f);
+        break;
+    case QAudioFormat::Int16:
+        processFrames(buffer.constData<qint16>(), frames, channels, 1.0f / 32768.f);
+        break;
+    case QAudioFormat::Int32:
+        processFrames(buffer.constData<qint32>(), frames, channels, 1.0f / 2147483648.f);
+        break;
+    case QAudioFormat::UInt8:
+        processFrames(buffer.constData<quint8>(), frames, channels, 1.0f / 128.f);
+        break;
+    default:
+        break;
+    }
+}
+
+void LevelMeter::process(const float *interleaved, int frames, int channels, int sampleRate)
+{
+    if (channels <= 0 || frames <= 0 || sampleRate <= 0)
+        return;
+    if (channels != m_channels || sampleRate != m_sampleRate)
+        setup(channels, sampleRate);
+    processFrames(interleaved, frames, channels, 1.0f);
+}
+
+template <typename T>
+void LevelMeter::processFrames(const T *samples, int frames, int channels, float scale)
+{
+    // Back after a stop or a pause: the windows hold old audio
+    const qint64 last = m_publishedMs.load(std::memory_order_relaxed);
+    if (last >= 0 && nowMs() - last > kRestartMs)
+        setup(channels, m_sampleRate);
+
+    // Unsigned 8-bit is offset binary
+    const float offset = std::is_same<T, quint8>::value ? 128.0f : 0.0f;
+
+    for (int f = 0; f < frames; ++f)
+    {
+        const T *frame = samples + qsizetype(f) * channels;
+        for (int c = 0; c < channels; ++c)
+        {
+            const float x = (float(frame[c]) - offset) * scale;
+            m_subPeak = qMax(m_subPeak, qAbs(x));
+            m_subSquares += double(x) * x;
+            if (m_weights[c] != 0.0)
+            {
+                const float k = m_kWeighting.tick(m_filters[c], x);
+                m_subWeighted += m_weights[c] * k * k;
+            }
+        }
+
+        if (++m_subFill == m_subFrames)
+        {
+            m_peakRing[m_ringPos] = m_subPeak;
+            m_squareRing[m_ringPos] = m_subSquares;
+            m_weightedRing[m_ringPos] = m_subWeighted;
+            m_ringPos = (m_ringPos + 1) % kRing;
+            m_subFill = 0;
+            m_subPeak = 0.0f;
+            m_subSquares = m_subWeighted = 0.0;
+            publish();
+        }
+    }
+}
+
+/* ============================================================
+ * PUBLISH – every 10 ms of audio
+ * ============================================================ */
+void LevelMeter::publish()
+{
+    float peak = 0.0f;
+    double squares = 0.0, weighted = 0.0;
+    for (int i = 1; i <= kRing; ++i)
+    {
+        const int at = (m_ringPos - i + kRing) % kRing;
+        if (i <= kPeakBlocks)
+            peak = qMax(peak, m_peakRing[at]);
+        if (i <= kRmsBlocks)
+            squares += m_squareRing[at];
+        weighted += m_weightedRing[at];
+    }
+
+    const double rms = std::sqrt(squares / (double(kRmsBlocks) * m_subFrames * m_channels));
+    const double meanWeighted = weighted / (double(kRing) * m_subFrames);
+    const float lufs = meanWeighted > 0.0
+        ? qMax(kFloorLufs, float(-0.691 + 10.0 * std::log10(meanWeighted)))
+        : kFloorLufs;
+
+    m_peak.store(peak, std::memory_order_relaxed);
+    m_rms.store(float(rms), std::memory_order_relaxed);
+    m_lufs.store(lufs, std::memory_order_relaxed);
+    m_publishedMs.store(nowMs(), std::memory_order_release);
+}
+
+/* ============================================================
+ * READ – any thread
+ * ============================================================ */
+LevelMeter::Reading LevelMeter::reading() const
+{
+    Reading r;
+    const qint64 at = m_publishedMs.load(std::memory_order_acquire);
+    if (at < 0 || nowMs() - at > kStaleMs)
+        return r;
+
+    r.active = true;
+    r.peak = m_peak.load(std::memory_order_relaxed);
+    r.rms = m_rms.load(std::memory_order_relaxed);
+    r.shortTermLufs = m_lufs.load(std::memory_order_relaxed);
+    return r;
+}
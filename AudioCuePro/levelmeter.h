@@ -0,0 +1,80 @@
+#ifndef LEVELMETER_H
+#define LEVELMETER_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+#include "loudness.h"
+
+class QAudioBuffer;
+
+/*
+============================================================
+ LevelMeter
+------------------------------------------------------------
+ - Live level of one signal: peak, RMS (300 ms) and
+   short-term loudness (3 s, K-weighted, LUFS)
+ - process() runs on the audio engine's render thread (one
+   meter per voice, after its gain, and one for the master
+   bus, after the limiter); it does not lock or allocate, and
+   publishes through relaxed atomics every 10 ms
+ - reading() may be called from any thread (display ticks);
+   a meter that has not published for a while reads as
+   silent, so stopped or paused cues fall to the floor
+============================================================
+*/
+
+class LevelMeter
+{
+public:
+    struct Reading {
+        bool active = false;       // published recently
+        float peak = 0.0f;         // linear, max over the last 50 ms
+        float rms = 0.0f;          // linear, 300 ms window
+        float shortTermLufs = -70.0f;
+    };
+
+    LevelMeter() = default;
+    LevelMeter(const LevelMeter &) = delete;
+    LevelMeter &operator=(const LevelMeter &) = delete;
+
+    // Render thread
+    void process(const QAudioBuffer &buffer);
+    void process(const float *interleaved, int frames, int channels, int sampleRate);
+
+    // Any thread
+    Reading reading() const;
+
+private:
+    void setup(int channels, int sampleRate);
+    void publish();
+    template <typename T>
+    void processFrames(const T *samples, int frames, int channels, float scale);
+
+    // Render thread only
+    Loudness::KWeighting m_kWeighting;
+    QVector<Loudness::KWeighting::State> m_filters;
+    QVector<double> m_weights;
+    int m_channels = 0;
+    int m_sampleRate = 0;
+    int m_subFrames = 0;          // 10 ms
+    int m_subFill = 0;
+    double m_subSquares = 0.0;    // Σx² over all channels
+    double m_subWeighted = 0.0;   // Σ w·k(x)²
+    float m_subPeak = 0.0f;
+
+    // Rings of 10 ms sub-blocks: 5 peaks, 30 RMS, 300 loudness
+    QVector<float> m_peakRing;
+    QVector<double> m_squareRing;
+    QVector<double> m_weightedRing;
+    int m_ringPos = 0;
+
+    // Published
+    std::atomic<float> m_peak { 0.0f };
+    std::atomic<float> m_rms { 0.0f };
+    std::atomic<float> m_lufs { -70.0f };
+    std::atomic<qint64> m_publishedMs { -1 };
+};
+
+#endif // LEVELMETER_H
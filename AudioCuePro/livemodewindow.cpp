@@ -1,5 +1,8 @@
 #include "livemodewindow.h"
 #include "trackwidget.h"      // <-- IMPORTANT
+#include "livemonitorview.h"
+#include "cuetreesync.h"
+#include "meterbar.h"
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
 #include <QWidget>
@@ -131,9 +134,8 @@ void LiveModeWindow::buildUi()
         if (!item || !item->parent())
             return; // ignore double-click on a scene header
 
-        quintptr ptrVal = item->data(0, Qt::UserRole).toULongLong();
-        TrackWidget *tw = reinterpret_cast<TrackWidget*>(ptrVal);
-        if (!tw)
+        const quint64 cueId = CueTreeSync::idOf(item);
+        if (!cueId)
             return;
 
         // Ensure correct scene is active
@@ -142,7 +144,7 @@ void LiveModeWindow::buildUi()
         if (idx >= 0)
             emit sceneActivated(idx);
 
-        emit trackActivated(tw);
+        emit trackActivated(cueId);
     });
 
     // Watch for drag/drop completion via event filter
@@ -292,30 +294,21 @@ root->addWidget(centerPanel, 2);
     masterSlider->setRange(0, 100);
     masterSlider->setValue(100);
 
+    masterMeter = new MeterBar(masterRow);
+    masterMeter->setFixedHeight(16);
+
     masterRowLayout->addWidget(masterLbl);
     masterRowLayout->addWidget(masterSlider, 1);
+    masterRowLayout->addWidget(masterMeter, 1);
     rightLayout->addWidget(masterRow);
 
     // Forward changes to MainWindow
     connect(masterSlider, &QSlider::valueChanged,
             this, &LiveModeWindow::masterVolumeChanged);
 
-    // --- Host for current cue editor (non-Spotify) ---
-    monitorHost = new QWidget(rightPanel);
-    monitorHost->setObjectName("monitorHost");	
-    monitorHostLayout = new QVBoxLayout(monitorHost);
-    monitorHostLayout->setContentsMargins(0, 8, 0, 0);
-    monitorHostLayout->setSpacing(8);
-
-    QLabel *placeholder = new QLabel(
-                tr("No cue selected.\nSelect a cue in the live tree or use the dropdown."),
-                monitorHost);
-    placeholder->setAlignment(Qt::AlignCenter);
-    placeholder->setWordWrap(true);
-    placeholder->setObjectName("monitorPlaceholder");
-    monitorHostLayout->addWidget(placeholder, 1);
-
-    rightLayout->addWidget(monitorHost, 1);
+    // --- Read-only view of the current cue ---
+    monitorView = new LiveMonitorView(rightPanel);
+    rightLayout->addWidget(monitorView, 1);
 
     root->addWidget(rightPanel, 2);
 
@@ -331,6 +324,8 @@ root->addWidget(centerPanel, 2);
             this,        &LiveModeWindow::pauseRequested);
     connect(stopButton, &QPushButton::clicked,
             this,       &LiveModeWindow::stopRequested);
+    connect(panicButton, &QPushButton::pressed,
+            this,        &LiveModeWindow::panicPressed);
     connect(panicButton, &QPushButton::clicked,
             this,        &LiveModeWindow::panicRequested);
 connect(cueCombo,
@@ -340,19 +335,19 @@ connect(cueCombo,
             if (cueComboUpdating)
                 return;
 
-            TrackWidget *tw = nullptr;
+            quint64 cueId = 0;
 
-            // index 0 = "Current cue" (tw stays nullptr)
+            // index 0 = "Current cue" (cueId stays 0)
             if (index > 0)
             {
                 int listIndex = index - 1;
-                if (listIndex < 0 || listIndex >= cueTrackList.size())
+                if (listIndex < 0 || listIndex >= cueComboIds.size())
                     return;
-                tw = cueTrackList.at(listIndex);
+                cueId = cueComboIds.at(listIndex);
             }
 
-            // nullptr means "use current cue / clear manual selection"
-            emit cueSelectionChanged(tw);
+            // 0 means "use current cue / clear manual selection"
+            emit cueSelectionChanged(cueId);
 
             // After selecting any cue, always snap back to "Current cue"
             cueComboUpdating = true;
@@ -480,82 +475,113 @@ void LiveModeWindow::applyDarkStyle()
 
 void LiveModeWindow::setSceneTree(const QList<SceneEntry> &scenes, int currentSceneIndex)
 {
-    Q_UNUSED(currentSceneIndex);
-
     m_syncingTree = true;
-    trackItemMap.clear();
-    sceneTree->clear();
 
-    // --- rebuild cue dropdown ---
-    cueComboUpdating = true;
-    cueTrackList.clear();
-    if (cueCombo)
+    // Scene rows by index; a scene row that goes away hands its
+    // cue rows back (detached) before it is deleted.
+    while (sceneTree->topLevelItemCount() > scenes.size())
     {
-        cueCombo->clear();
-        // index 0 = "Current cue" → means "don't override, use normal next cue"
-        cueCombo->addItem(tr("Current cue"));
+        QTreeWidgetItem *sceneItem =
+            sceneTree->takeTopLevelItem(sceneTree->topLevelItemCount() - 1);
+        sceneItem->takeChildren();
+        delete sceneItem;
     }
 
-    for (int i = 0; i < scenes.size(); ++i)
+    while (sceneTree->topLevelItemCount() < scenes.size())
     {
-        const SceneEntry &se = scenes[i];
-
         auto *sceneItem = new QTreeWidgetItem(sceneTree);
-        sceneItem->setText(0, se.name);
 
         Qt::ItemFlags sflags = sceneItem->flags();
         sflags |= Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDropEnabled;
         sflags &= ~Qt::ItemIsDragEnabled;
         sceneItem->setFlags(sflags);
+        sceneItem->setExpanded(true);
+    }
 
-        if (i == currentSceneIndex)
-        {
-            sceneItem->setBackground(0, QBrush(QColor("#2ecc71")));
-            sceneItem->setForeground(0, QBrush(QColor("#000000")));
-        }
+    auto makeCueItem = []() {
+        auto *child = new QTreeWidgetItem();
+        child->setForeground(0, QBrush(QColor("#dddddd")));
 
-        for (const auto &pair : se.tracks)
-        {
-            TrackWidget *tw = pair.first;
-            const QString &label = pair.second;
+        Qt::ItemFlags cflags = child->flags();
+        cflags |= Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+        cflags &= ~Qt::ItemIsDropEnabled;
+        child->setFlags(cflags);
+        return child;
+    };
 
-            auto *child = new QTreeWidgetItem(sceneItem);
-            child->setText(0, label);
-            child->setForeground(0, QBrush(QColor("#dddddd")));
+    QVector<quint64> comboIds;
+    QStringList comboTexts;
 
-            Qt::ItemFlags cflags = child->flags();
-            cflags |= Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
-            cflags &= ~Qt::ItemIsDropEnabled;
-            child->setFlags(cflags);
+    for (int i = 0; i < scenes.size(); ++i)
+    {
+        const SceneEntry &se = scenes[i];
 
-            // add to dropdown (index = cueTrackList.size() + 1 because 0 is "Current cue")
-            cueTrackList.append(tw);
-            if (cueCombo)
-            {
-                QString comboText = se.name.isEmpty()
-                        ? label
-                        : QStringLiteral("%1 – %2").arg(se.name, label);
-                cueCombo->addItem(comboText);
-            }
+        QTreeWidgetItem *sceneItem = sceneTree->topLevelItem(i);
+        if (sceneItem->text(0) != se.name)
+            sceneItem->setText(0, se.name);
+
+        QVector<CueTreeSync::Row> rows;
+        rows.reserve(se.tracks.size());
 
-            child->setData(0, Qt::UserRole,
-                           QVariant::fromValue<quintptr>(
-                               reinterpret_cast<quintptr>(tw)));
-            trackItemMap.insert(tw, child);
+        for (const auto &pair : se.tracks)
+        {
+            const QString &label = pair.second;
+            rows.append({pair.first, label});
+
+            // dropdown entry (index = comboIds.size() + 1 because 0 is "Current cue")
+            comboIds.append(pair.first);
+            comboTexts.append(se.name.isEmpty()
+                                  ? label
+                                  : QStringLiteral("%1 – %2").arg(se.name, label));
         }
+
+        CueTreeSync::syncChildren(sceneItem, rows, trackItemMap, makeCueItem);
     }
 
-    sceneTree->expandAll();
+    CueTreeSync::dropDetached(trackItemMap);
+    setCurrentScene(currentSceneIndex);
 
-    if (cueCombo)
+    // --- cue dropdown: only rebuilt when its entries changed ---
+    if (cueCombo && (comboIds != cueComboIds || comboTexts != cueComboTexts))
     {
-        cueCombo->setEnabled(!cueTrackList.isEmpty());
+        cueComboUpdating = true;
+
+        cueCombo->clear();
+        // index 0 = "Current cue" → means "don't override, use normal next cue"
+        cueCombo->addItem(tr("Current cue"));
+        cueCombo->addItems(comboTexts);
+        cueCombo->setEnabled(!comboIds.isEmpty());
         cueCombo->setCurrentIndex(0);      // "Current cue" selected by default
+
+        cueComboUpdating = false;
     }
+    cueComboIds = comboIds;
+    cueComboTexts = comboTexts;
 
-    cueComboUpdating = false;
     m_syncingTree = false;
 }
+
+void LiveModeWindow::setCurrentScene(int currentSceneIndex)
+{
+    if (!sceneTree)
+        return;
+
+    for (int i = 0; i < sceneTree->topLevelItemCount(); ++i)
+    {
+        QTreeWidgetItem *sceneItem = sceneTree->topLevelItem(i);
+        if (i == currentSceneIndex)
+        {
+            sceneItem->setBackground(0, QBrush(QColor("#2ecc71")));
+            sceneItem->setForeground(0, QBrush(QColor("#000000")));
+        }
+        else
+        {
+            sceneItem->setBackground(0, QBrush());
+            sceneItem->setForeground(0, QBrush());
+        }
+    }
+}
+
 QList<LiveModeWindow::SceneEntry> LiveModeWindow::exportedSceneOrder() const
 {
     QList<SceneEntry> result;
@@ -580,12 +606,9 @@ QList<LiveModeWindow::SceneEntry> LiveModeWindow::exportedSceneOrder() const
             if (!child)
                 continue;
 
-            quintptr ptrVal = child->data(0, Qt::UserRole).value<quintptr>();
-            TrackWidget *tw = reinterpret_cast<TrackWidget*>(ptrVal);
-            QString label = child->text(0);
-
-            if (tw)
-                se.tracks.append(qMakePair(tw, label));
+            const quint64 cueId = CueTreeSync::idOf(child);
+            if (cueId)
+                se.tracks.append(qMakePair(cueId, child->text(0)));
         }
 
         result.append(se);
@@ -594,42 +617,52 @@ QList<LiveModeWindow::SceneEntry> LiveModeWindow::exportedSceneOrder() const
     return result;
 }
 
-void LiveModeWindow::setCurrentCueDisplay(const QString &title,
-                                          const QString &statusText,
-                                          const QString &bigTime,
-                                          const QString &smallTime)
+void LiveModeWindow::applyLabel(QLabel *label, QString &shown, const QString &text)
 {
-    currentTitleLabel->setText(title.isEmpty() ? tr("—") : title);
-    currentStatusLabel->setText(statusText);
-    currentBigTimeLabel->setText(bigTime.isEmpty() ? tr("--:--") : bigTime);
-    currentSmallTimeLabel->setText(smallTime);
+    if (m_hasShownState && shown == text)
+        return;
+
+    shown = text;
+    if (label)
+        label->setText(text);
 }
 
-void LiveModeWindow::setNextCueDisplay(const QString &title,
-                                       const QString &hotkeyLabel,
-                                       const QString &notesText)
+void LiveModeWindow::applyViewState(const ViewState &in)
 {
-    nextTitleLabel->setText(title.isEmpty() ? tr("—") : title);
-    nextHotkeyLabel->setText(hotkeyLabel);
-
-    if (nextNotesLabel)
+    // Normalize first so placeholders compare equal to themselves
+    ViewState st = in;
+    if (st.currentTitle.isEmpty())
+        st.currentTitle = tr("—");
+    if (st.bigTime.isEmpty())
+        st.bigTime = tr("--:--");
+    if (st.nextTitle.isEmpty())
+        st.nextTitle = tr("—");
+    st.nextNotes = st.nextNotes.trimmed();
+
+    applyLabel(currentTitleLabel,     m_shownState.currentTitle, st.currentTitle);
+    applyLabel(currentStatusLabel,    m_shownState.status,       st.status);
+    applyLabel(currentBigTimeLabel,   m_shownState.bigTime,      st.bigTime);
+    applyLabel(currentSmallTimeLabel, m_shownState.smallTime,    st.smallTime);
+    applyLabel(nextTitleLabel,        m_shownState.nextTitle,    st.nextTitle);
+    applyLabel(nextHotkeyLabel,       m_shownState.nextHotkey,   st.nextHotkey);
+
+    const bool notesChanged = !m_hasShownState || m_shownState.nextNotes != st.nextNotes;
+    applyLabel(nextNotesLabel,        m_shownState.nextNotes,    st.nextNotes);
+    if (notesChanged && nextNotesLabel)
+        nextNotesLabel->setVisible(!st.nextNotes.isEmpty());
+
+    if (!m_hasShownState || m_shownState.monitorTrack != st.monitorTrack)
     {
-        if (notesText.trimmed().isEmpty())
-        {
-            nextNotesLabel->clear();
-            nextNotesLabel->setVisible(false);
-        }
-        else
-        {
-            nextNotesLabel->setText(notesText);
-            nextNotesLabel->setVisible(true);
-        }
+        showMonitoringForTrack(st.monitorTrack);
+        m_shownState.monitorTrack = st.monitorTrack;
     }
+
+    m_hasShownState = true;
 }
 
-void LiveModeWindow::setTrackState(TrackWidget *tw, const QString &state)
+void LiveModeWindow::setTrackState(quint64 cueId, const QString &state)
 {
-    QTreeWidgetItem *item = trackItemMap.value(tw, nullptr);
+    QTreeWidgetItem *item = trackItemMap.value(cueId, nullptr);
     if (!item)
         return;
 
@@ -664,10 +697,14 @@ bool LiveModeWindow::eventFilter(QObject *obj, QEvent *event)
     {
         if (!m_syncingTree)
         {
-            // Defer the signal so it runs AFTER the internal drop handling
+            // Defer the signal so it runs AFTER the internal drop handling;
+            // the view moved rows itself, so re-read the ID → row map first
             QMetaObject::invokeMethod(
                 this,
-                [this]() { emit treeOrderChanged(); },
+                [this]() {
+                    CueTreeSync::reindex(sceneTree, trackItemMap);
+                    emit treeOrderChanged();
+                },
                 Qt::QueuedConnection);
         }
         // Let QTreeWidget handle the drop normally
@@ -676,99 +713,12 @@ bool LiveModeWindow::eventFilter(QObject *obj, QEvent *event)
 
     return QMainWindow::eventFilter(obj, event);
 }
-void LiveModeWindow::clearMonitoringTrack()
-{
-    if (!embeddedTrack)
-        return;
-
-    if (monitorHostLayout)
-        monitorHostLayout->removeWidget(embeddedTrack);
-
-    if (embeddedTrackOldParent)
-    {
-        QLayout *oldLayout = embeddedTrackOldParent->layout();
-        if (auto box = qobject_cast<QBoxLayout*>(oldLayout))
-        {
-            if (embeddedTrackOldIndex >= 0)
-                box->insertWidget(embeddedTrackOldIndex, embeddedTrack);
-            else
-                box->addWidget(embeddedTrack);
-        }
-        else if (oldLayout)
-        {
-            oldLayout->addWidget(embeddedTrack);
-        }
-
-        embeddedTrack->setParent(embeddedTrackOldParent);
-    }
-
-    embeddedTrack = nullptr;
-    embeddedTrackOldParent = nullptr;
-    embeddedTrackOldIndex = -1;
-}
-
 void LiveModeWindow::showMonitoringForTrack(TrackWidget *tw)
 {
-    if (embeddedTrack == tw)
-        return;
-
-    // restore previous track (if any)
-    clearMonitoringTrack();
-
-    // remove old placeholder text
-    if (monitorHostLayout)
-    {
-        for (int i = monitorHostLayout->count() - 1; i >= 0; --i)
-        {
-            QWidget *w = monitorHostLayout->itemAt(i)->widget();
-            if (w && w->objectName() == "monitorPlaceholder")
-            {
-                monitorHostLayout->removeWidget(w);
-                w->deleteLater();
-            }
-        }
-    }
-
-    // If nothing or Spotify → show info message
-    if (!tw || tw->isSpotify())
-    {
-        if (monitorHostLayout)
-        {
-            QLabel *info = new QLabel(
-                tw && tw->isSpotify()
-                    ? tr("Spotify cue – waveform / fades / loop options are\ncontrolled from Spotify.")
-                    : tr("No cue selected."),
-                monitorHost);
-            info->setAlignment(Qt::AlignCenter);
-            info->setWordWrap(true);
-            info->setObjectName("monitorPlaceholder");
-            monitorHostLayout->addWidget(info, 1);
-        }
-        return;
-    }
-
-    // Non-Spotify: embed full TrackWidget so we get
-    // loop options, waveform, start/end, fades, and gain.
-    embeddedTrack = tw;
-    embeddedTrackOldParent = tw->parentWidget();
-    embeddedTrackOldIndex = -1;
-
-    if (embeddedTrackOldParent)
-    {
-        if (auto oldLayout = qobject_cast<QBoxLayout*>(embeddedTrackOldParent->layout()))
-        {
-            embeddedTrackOldIndex = oldLayout->indexOf(tw);
-            oldLayout->removeWidget(tw);
-        }
-        else if (embeddedTrackOldParent->layout())
-        {
-            embeddedTrackOldParent->layout()->removeWidget(tw);
-        }
-    }
-
-    tw->setParent(monitorHost);
-    if (monitorHostLayout)
-        monitorHostLayout->addWidget(tw);
+    // The TrackWidget stays in the main window; the monitor
+    // only reads from it, so this is a single repaint.
+    if (monitorView)
+        monitorView->setTrack(tw);
 }
 
 void LiveModeWindow::setMasterVolumeUi(int value)
@@ -780,3 +730,9 @@ void LiveModeWindow::setMasterVolumeUi(int value)
     masterSlider->setValue(value);
 }
 
+void LiveModeWindow::setMasterLevel(const LevelMeter::Reading &reading, qint64 nowMs)
+{
+    if (masterMeter)
+        masterMeter->setReading(reading, nowMs);
+}
+
@@ -3,8 +3,12 @@
 
 #include <QMainWindow>
 #include <QHash>
+#include <QVector>
+#include <QStringList>
 #include <QKeyEvent>   // <--- add this
 
+#include "levelmeter.h"
+
 class QTreeWidget;
 class QTreeWidgetItem;
 class QLabel;
@@ -13,6 +17,8 @@ class QComboBox;      // NEW
 class QSlider;      // <--- add
 class QVBoxLayout;      // <-- ADD THIS
 class TrackWidget;
+class LiveMonitorView;
+class MeterBar;
 
 // Dark-stage live view inspired by the mockup image.
 class LiveModeWindow : public QMainWindow
@@ -24,40 +30,48 @@ public:
     // Scene + cue tree (same structure as normal mode)
     struct SceneEntry {
         QString name;
-        QList<QPair<TrackWidget*, QString>> tracks; // (pointer, label)
+        QList<QPair<quint64, QString>> tracks; // (cue ID, label)
     };
 
     // Export current order from the live tree (after drag & drop)
     // NEW: API used by MainWindow
     void setSceneTree(const QList<SceneEntry> &scenes, int currentSceneIndex);
+    // Re-highlight the active scene without rebuilding the tree
+    void setCurrentScene(int currentSceneIndex);
     QList<SceneEntry> exportedSceneOrder() const;
 
-    // Center "current cue" card
-    void setCurrentCueDisplay(const QString &title,
-                              const QString &statusText,
-                              const QString &bigTime,
-                              const QString &smallTime);
+    // Everything the center cards show. MainWindow builds one per
+    // update; applyViewState() compares it with the last one and only
+    // touches the labels whose text actually changed.
+    struct ViewState {
+        QString currentTitle;
+        QString status;
+        QString bigTime;
+        QString smallTime;
+        QString nextTitle;
+        QString nextHotkey;
+        QString nextNotes;
+        TrackWidget *monitorTrack = nullptr;
+    };
 
-    // Next cue box
-    void setNextCueDisplay(const QString &title,
-                           const QString &hotkeyLabel,
-                           const QString &notesText);
+    void applyViewState(const ViewState &state);
 
     // Color track in the live tree
-    void setTrackState(TrackWidget *tw, const QString &state); // "playing", "paused", "stopped"
+    void setTrackState(quint64 cueId, const QString &state); // "playing", "paused", "stopped"
 
 signals:
     void goRequested();          // big PLAY NEXT button
     void resumeRequested();      // new: resume currently paused track
     void pauseRequested();       // live Pause
     void stopRequested();        // live Stop
-    void panicRequested();       // live PANIC
+    void panicPressed();         // live PANIC, on the press: the sound
+    void panicRequested();       // live PANIC, on the click: the cues
     void sceneActivated(int index); // user clicked a scene in the tree
     void exitRequested();        // Exit Live Mode
    // Emitted after the user has reordered/moved tracks in the live tree
    void treeOrderChanged();
-       void trackActivated(TrackWidget *tw);
-    void cueSelectionChanged(TrackWidget *tw); // NEW: dropdown cue changed
+       void trackActivated(quint64 cueId);
+    void cueSelectionChanged(quint64 cueId); // NEW: dropdown cue changed (0 = none)
 
     // NEW: global master volume coming from live monitor
     void masterVolumeChanged(int value);
@@ -81,6 +95,11 @@ private:
     QLabel *nextHotkeyLabel = nullptr;
     QLabel *nextNotesLabel = nullptr;
 
+    // Last applied view state (normalized)
+    ViewState m_shownState;
+    bool m_hasShownState = false;
+    void applyLabel(QLabel *label, QString &shown, const QString &text);
+
     QPushButton *goButton = nullptr;
     QPushButton *playButton = nullptr;   // NEW
     QPushButton *pauseButton = nullptr;
@@ -89,31 +108,29 @@ private:
     QPushButton *exitButton = nullptr;
 	
 	QComboBox *cueCombo = nullptr;         // NEW: cue dropdown
-    QList<TrackWidget*> cueTrackList;      // NEW: index → TrackWidget*
+    QVector<quint64> cueComboIds;          // combo index - 1 → cue ID
+    QStringList cueComboTexts;             // last texts, to skip rebuilds
     bool cueComboUpdating = false;         // NEW: guard against recursion
 
-    // Map TrackWidget* → QTreeWidgetItem* in live tree
-    QHash<TrackWidget*, QTreeWidgetItem*> trackItemMap;
+    // Cue ID → QTreeWidgetItem* in live tree
+    QHash<quint64, QTreeWidgetItem*> trackItemMap;
 	    bool m_syncingTree = false;
 		
     // --- NEW: Live monitor UI ---
-    QWidget *monitorHost = nullptr;        // container on the right
-    QVBoxLayout *monitorHostLayout = nullptr;
+    LiveMonitorView *monitorView = nullptr; // read-only view of current cue
     QSlider *masterSlider = nullptr;       // live Master gain
-
-    // embedded TrackWidget for non-Spotify cues
-    TrackWidget *embeddedTrack = nullptr;
-    QWidget *embeddedTrackOldParent = nullptr;
-    int embeddedTrackOldIndex = -1;
+    MeterBar *masterMeter = nullptr;       // master bus level
 
 public:
-    // NEW: show / clear current cue editor in Live Monitor
+    // Show the current cue in the Live Monitor (nullptr = none)
     void showMonitoringForTrack(TrackWidget *tw);
-    void clearMonitoringTrack();
 
     // NEW: keep Master slider in sync with main window
     void setMasterVolumeUi(int value);
 
+    // Master bus level, fed from MainWindow's meter tick
+    void setMasterLevel(const LevelMeter::Reading &reading, qint64 nowMs);
+
 };
 
 #endif // LIVEMODEWINDOW_H
@@ -0,0 +1,302 @@
+#include "livemonitorview.h"
+#include "trackwidget.h"
+#include "frameticker.h"
+
+#include <QPainter>
+#include <QRegion>
+#include <QResizeEvent>
+#include <QtMath>
+
+static const int kMargin     = 8;
+static const int kTitleH     = 26;
+static const int kStatusH    = 20;
+static const int kWaveH      = 90;
+static const int kParamLineH = 18;
+
+static QString fmtMs(qint64 ms)
+{
+    if (ms < 0) ms = 0;
+    return QString("%1:%2.%3")
+        .arg(ms/60000,2,10,QChar('0'))
+        .arg((ms/1000)%60,2,10,QChar('0'))
+        .arg(ms%1000,3,10,QChar('0'));
+}
+
+// Remaining time at display resolution: tenths change ten times a
+// second, milliseconds would change on every frame
+static QString fmtTenths(qint64 ms)
+{
+    if (ms < 0) ms = 0;
+    return QString("%1:%2.%3")
+        .arg(ms/60000,2,10,QChar('0'))
+        .arg((ms/1000)%60,2,10,QChar('0'))
+        .arg((ms/100)%10);
+}
+
+/* ============================================================
+ * CONSTRUCTOR
+ * ============================================================ */
+LiveMonitorView::LiveMonitorView(QWidget *parent)
+    : QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumHeight(kMargin * 2 + kTitleH + kStatusH + kWaveH + kParamLineH * 3);
+
+    // Hidden Live window → no polling at all
+    m_tickId = FrameTicker::instance()->subscribe(
+        this, [this](qint64, qint64) { refresh(); },
+        FrameTicker::WhenVisible);
+}
+
+QSize LiveMonitorView::sizeHint() const
+{
+    return QSize(320, minimumHeight() + 40);
+}
+
+/* ============================================================
+ * SNAPSHOT
+ * ============================================================ */
+bool LiveMonitorView::Snapshot::operator==(const Snapshot &o) const
+{
+    return playheadX == o.playheadX
+        && startMs == o.startMs
+        && endMs == o.endMs
+        && spotify == o.spotify
+        && peaks == o.peaks
+        && timeText == o.timeText
+        && status == o.status
+        && title == o.title
+        && params == o.params;
+}
+
+LiveMonitorView::Snapshot LiveMonitorView::takeSnapshot() const
+{
+    Snapshot s;
+    TrackWidget *tw = m_track;
+    if (!tw)
+        return s;
+
+    s.title   = tw->displayName();
+    s.spotify = tw->isSpotify();
+
+    if (tw->isPlaying())
+        s.status = tr("PLAYING");
+    else if (tw->isPaused())
+        s.status = tr("PAUSED");
+    else
+        s.status = tr("STOPPED");
+
+    const qint64 posMs = qint64(tw->currentPositionSeconds() * 1000.0);
+    s.startMs = qint64(tw->startSeconds() * 1000.0);
+    s.endMs   = qint64(tw->endSeconds() * 1000.0);
+
+    if (s.endMs > s.startMs)
+        s.timeText = tr("Remaining: %1").arg(fmtTenths(s.endMs - qMax(posMs, s.startMs)));
+    else
+        s.timeText = tr("Remaining: --:--.-");
+
+    if (s.spotify)
+        return s;
+
+    QString loop = tw->loopModeText();
+    if (loop == QLatin1String("count"))
+        loop += QString(" (%1)").arg(tw->loopCount());
+
+    s.params = tr("Start %1   End %2\nFade in %3 s   Fade out %4 s\nLoop: %5   Gain %6   Speed %7x")
+                   .arg(fmtMs(s.startMs), fmtMs(s.endMs))
+                   .arg(tw->fadeInSeconds(), 0, 'f', 2)
+                   .arg(tw->fadeOutSeconds(), 0, 'f', 2)
+                   .arg(loop)
+                   .arg(tw->gain(), 0, 'f', 2)
+                   .arg(tw->speed(), 0, 'f', 2);
+
+    s.peaks = tw->peakData();
+
+    // Playhead quantized to pixels: sub-pixel motion is not a repaint
+    if (s.peaks && s.peaks->durationMs > 0)
+    {
+        const QRect r = waveRect();
+        const double f = qBound(0.0, double(posMs) / double(s.peaks->durationMs), 1.0);
+        s.playheadX = r.left() + int(f * r.width());
+    }
+
+    return s;
+}
+
+/* ============================================================
+ * TRACK + PER-FRAME REFRESH
+ * ============================================================ */
+void LiveMonitorView::setTrack(TrackWidget *tw)
+{
+    if (m_track == tw)
+        return;
+
+    m_track = tw;
+    refresh();
+}
+
+void LiveMonitorView::refresh()
+{
+    Snapshot s = takeSnapshot();
+    if (s == m_shown)
+        return;
+
+    // While a cue simply plays, only the playhead and the remaining
+    // time move: the waveform strip and the status line
+    const bool onlyPlayhead = s.spotify == m_shown.spotify
+                           && s.peaks == m_shown.peaks
+                           && s.startMs == m_shown.startMs
+                           && s.endMs == m_shown.endMs
+                           && s.title == m_shown.title
+                           && s.status == m_shown.status
+                           && s.params == m_shown.params;
+
+    m_shown = s;
+
+    if (onlyPlayhead)
+        update(QRegion(waveRect().adjusted(-1, 0, 1, 0)) + statusRect());
+    else
+        update();
+}
+
+/* ============================================================
+ * GEOMETRY + WAVEFORM CACHE
+ * ============================================================ */
+QRect LiveMonitorView::waveRect() const
+{
+    return QRect(kMargin, kMargin + kTitleH + kStatusH,
+                 qMax(0, width() - 2 * kMargin), kWaveH);
+}
+
+QRect LiveMonitorView::statusRect() const
+{
+    return QRect(kMargin, kMargin + kTitleH,
+                 qMax(0, width() - 2 * kMargin), kStatusH);
+}
+
+void LiveMonitorView::rebuildColumns()
+{
+    m_columnsPeaks = m_shown.peaks;
+    m_columns = m_columnsPeaks ? m_columnsPeaks->resampled(waveRect().width())
+                               : QVector<float>();
+}
+
+void LiveMonitorView::resizeEvent(QResizeEvent *ev)
+{
+    QWidget::resizeEvent(ev);
+    m_columnsPeaks.reset();   // force resample at the new width
+    m_shown = takeSnapshot();
+}
+
+/* ============================================================
+ * PAINT
+ * ============================================================ */
+void LiveMonitorView::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), QColor("#111111"));
+
+    if (!m_track)
+    {
+        p.setPen(QColor("#888888"));
+        p.drawText(rect(), Qt::AlignCenter | Qt::TextWordWrap,
+                   tr("No cue selected.\nSelect a cue in the live tree or use the dropdown."));
+        return;
+    }
+
+    const Snapshot &s = m_shown;
+
+    // Title + status line
+    QFont titleFont = font();
+    titleFont.setPointSizeF(titleFont.pointSizeF() * 1.3);
+    titleFont.setBold(true);
+    p.setFont(titleFont);
+    p.setPen(QColor("#ffffff"));
+    p.drawText(QRect(kMargin, kMargin, width() - 2 * kMargin, kTitleH),
+               Qt::AlignLeft | Qt::AlignVCenter,
+               p.fontMetrics().elidedText(s.title, Qt::ElideRight, width() - 2 * kMargin));
+
+    p.setFont(font());
+    QColor statusColor("#dddddd");
+    if (m_track->isPlaying())
+        statusColor = QColor("#2ecc71");
+    else if (m_track->isPaused())
+        statusColor = QColor("#ff9800");
+
+    const QRect sr = statusRect();
+    p.setPen(statusColor);
+    p.drawText(sr, Qt::AlignLeft | Qt::AlignVCenter, s.status);
+    p.setPen(QColor("#dddddd"));
+    p.drawText(sr, Qt::AlignRight | Qt::AlignVCenter, s.timeText);
+
+    const QRect wr = waveRect();
+
+    if (s.spotify)
+    {
+        p.setPen(QColor("#888888"));
+        p.drawText(wr.adjusted(0, 0, 0, kParamLineH * 3), Qt::AlignCenter | Qt::TextWordWrap,
+                   tr("Spotify cue – waveform / fades / loop options are\ncontrolled from Spotify."));
+        return;
+    }
+
+    // Waveform
+    p.fillRect(wr, QColor("#1b1b1b"));
+
+    if (m_columnsPeaks != s.peaks || m_columns.size() != wr.width())
+        rebuildColumns();
+
+    const qint64 durMs = s.peaks ? s.peaks->durationMs : 0;
+    auto xForMs = [&](qint64 ms) {
+        if (durMs <= 0) return wr.left();
+        return wr.left() + int(qBound(0.0, double(ms) / double(durMs), 1.0) * wr.width());
+    };
+
+    if (durMs > 0 && s.endMs > s.startMs)
+    {
+        const int x0 = xForMs(s.startMs);
+        const int x1 = xForMs(s.endMs);
+        p.fillRect(QRect(x0, wr.top(), x1 - x0, wr.height()), QColor(50, 80, 120, 90));
+    }
+
+    if (!m_columns.isEmpty())
+    {
+        const int mid = wr.center().y();
+        const int half = wr.height() / 2;
+        const int played = s.playheadX;
+
+        for (int i = 0; i < m_columns.size(); ++i)
+        {
+            const int x = wr.left() + i;
+            const int h = int(m_columns[i] * half);
+            p.setPen(x <= played ? QColor("#4fc3f7") : QColor("#6c7a89"));
+            p.drawLine(x, mid - h, x, mid + h);
+        }
+    }
+    else
+    {
+        p.setPen(QColor("#666666"));
+        p.drawText(wr, Qt::AlignCenter, tr("Loading waveform…"));
+    }
+
+    if (durMs > 0)
+    {
+        p.setPen(QPen(QColor("#2ecc71"), 2));
+        p.drawLine(xForMs(s.startMs), wr.top(), xForMs(s.startMs), wr.bottom());
+        if (s.endMs > s.startMs)
+        {
+            p.setPen(QPen(QColor("#e74c3c"), 2));
+            p.drawLine(xForMs(s.endMs), wr.top(), xForMs(s.endMs), wr.bottom());
+        }
+    }
+
+    if (s.playheadX >= 0)
+    {
+        p.setPen(QPen(QColor("#ffffff"), 1));
+        p.drawLine(s.playheadX, wr.top(), s.playheadX, wr.bottom());
+    }
+
+    // Parameters
+    p.setPen(QColor("#aaaaaa"));
+    p.drawText(QRect(kMargin, wr.bottom() + 6, width() - 2 * kMargin, kParamLineH * 3),
+               Qt::AlignLeft | Qt::AlignTop, s.params);
+}
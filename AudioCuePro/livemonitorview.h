@@ -0,0 +1,77 @@
+#ifndef LIVEMONITORVIEW_H
+#define LIVEMONITORVIEW_H
+
+#include <QWidget>
+#include <QPointer>
+#include <QVector>
+
+#include "waveformpeaks.h"
+
+class TrackWidget;
+
+/*
+============================================================
+ LiveMonitorView
+------------------------------------------------------------
+ - Read-only view of one cue for the Live Mode monitor
+ - Painted directly (no child widgets, no stylesheet), so
+   switching cues is a single repaint and the real
+   TrackWidget never leaves the main window
+ - Waveform comes from the cue's shared WaveformPeaks
+ - Polls the cue on the shared frame ticker and repaints
+   only when something visible actually changed; a playing
+   cue only invalidates the waveform strip and the status
+   line (remaining time in tenths of a second)
+============================================================
+*/
+
+class LiveMonitorView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LiveMonitorView(QWidget *parent = nullptr);
+
+    void setTrack(TrackWidget *tw);
+    TrackWidget *track() const { return m_track; }
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *) override;
+    void resizeEvent(QResizeEvent *) override;
+
+private:
+    // Everything that ends up on screen, compared per frame
+    struct Snapshot {
+        QString title;
+        QString status;
+        QString timeText;
+        QString params;
+        WaveformPeaksPtr peaks;
+        qint64 startMs = 0;
+        qint64 endMs = 0;
+        int playheadX = -1;
+        bool spotify = false;
+
+        bool operator==(const Snapshot &o) const;
+        bool operator!=(const Snapshot &o) const { return !(*this == o); }
+    };
+
+    Snapshot takeSnapshot() const;
+    void refresh();
+    QRect waveRect() const;
+    QRect statusRect() const;
+    void rebuildColumns();
+
+    QPointer<TrackWidget> m_track;
+    Snapshot m_shown;
+
+    // Peaks resampled to the current waveform width
+    QVector<float> m_columns;
+    WaveformPeaksPtr m_columnsPeaks;
+
+    int m_tickId = 0;
+};
+
+#endif // LIVEMONITORVIEW_H
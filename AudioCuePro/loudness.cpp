@@ -0,0 +1,458 @@
+#include "loudness.h"
+
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ACP_LOUDNESS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define ACP_LOUDNESS_NEON
+#endif
+
+static const double kAbsoluteGateLufs = -70.0;
+static const double kIntegratedGateLu = -10.0;    // BS.1770-4
+static const double kRangeGateLu      = -20.0;    // EBU Tech 3342
+static const int kTruePeakTaps = 12;              // per phase, 4 phases
+static const int kHistory = kTruePeakTaps - 1;
+
+namespace {
+
+double energyToLufs(double z)
+{
+    return -0.691 + 10.0 * std::log10(z);
+}
+
+double lufsToEnergy(double lufs)
+{
+    return qPow(10.0, (lufs + 0.691) / 10.0);
+}
+
+/* ============================================================
+ * TRUE-PEAK INTERPOLATOR – 48-tap windowed sinc, 4 phases
+ * coefficients()[t][p] = h[4t + p], so one input sample times
+ * one row gives its share of all four interpolated outputs
+ * ============================================================ */
+struct TruePeakFir {
+    alignas(16) float c[kTruePeakTaps][4];
+
+    TruePeakFir()
+    {
+        const int n = kTruePeakTaps * 4;
+        const double centre = (n - 1) / 2.0;
+        double h[kTruePeakTaps * 4];
+        for (int k = 0; k < n; ++k)
+        {
+            const double x = (k - centre) / 4.0;
+            const double sinc = qFuzzyIsNull(x) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            const double window = 0.42 - 0.5 * std::cos(2 * M_PI * k / (n - 1))
+                                       + 0.08 * std::cos(4 * M_PI * k / (n - 1));
+            h[k] = sinc * window;
+        }
+        // Unity gain per phase, so a full-scale DC reads 0 dBTP
+        for (int p = 0; p < 4; ++p)
+        {
+            double sum = 0.0;
+            for (int t = 0; t < kTruePeakTaps; ++t)
+                sum += h[4 * t + p];
+            for (int t = 0; t < kTruePeakTaps; ++t)
+                c[t][p] = float(h[4 * t + p] / sum);
+        }
+    }
+};
+
+const TruePeakFir &truePeakFir()
+{
+    static const TruePeakFir fir;
+    return fir;
+}
+
+/* ============================================================
+ * KERNELS – Σx² of a block, and the largest |interpolated|
+ * sample. `in` holds kHistory samples before the n new ones.
+ * ============================================================ */
+double sumOfSquaresScalar(const float *p, qsizetype n)
+{
+    double sum = 0.0;
+    for (qsizetype i = 0; i < n; ++i)
+        sum += double(p[i]) * p[i];
+    return sum;
+}
+
+float truePeakScalar(const float *in, qsizetype n)
+{
+    const TruePeakFir &fir = truePeakFir();
+    float peak = 0.0f;
+    for (qsizetype i = 0; i < n; ++i)
+    {
+        float y[4] = {};
+        for (int t = 0; t < kTruePeakTaps; ++t)
+        {
+            const float x = in[i + kHistory - t];
+            for (int p = 0; p < 4; ++p)
+                y[p] += x * fir.c[t][p];
+        }
+        for (float v : y)
+            peak = qMax(peak, qAbs(v));
+    }
+    return peak;
+}
+
+#if defined(ACP_LOUDNESS_SSE2)
+
+double sumOfSquares(const float *p, qsizetype n)
+{
+    // Float lanes for speed, folded into double every 4096
+    // samples so a 100 ms block does not lose precision
+    double sum = 0.0;
+    qsizetype i = 0;
+    while (i + 8 <= n)
+    {
+        __m128 a = _mm_setzero_ps(), b = _mm_setzero_ps();
+        const qsizetype end = qMin(n, i + 4096) & ~qsizetype(7);
+        for (; i < end; i += 8)
+        {
+            const __m128 x = _mm_loadu_ps(p + i);
+            const __m128 y = _mm_loadu_ps(p + i + 4);
+            a = _mm_add_ps(a, _mm_mul_ps(x, x));
+            b = _mm_add_ps(b, _mm_mul_ps(y, y));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, _mm_add_ps(a, b));
+        sum += double(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+    return sum + sumOfSquaresScalar(p + i, n - i);
+}
+
+float truePeak(const float *in, qsizetype n)
+{
+    const TruePeakFir &fir = truePeakFir();
+    __m128 c[kTruePeakTaps];
+    for (int t = 0; t < kTruePeakTaps; ++t)
+        c[t] = _mm_load_ps(fir.c[t]);
+
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 peak = _mm_setzero_ps();
+    for (qsizetype i = 0; i < n; ++i)
+    {
+        const float *x = in + i + kHistory;
+        __m128 y = _mm_mul_ps(_mm_set1_ps(x[0]), c[0]);
+        for (int t = 1; t < kTruePeakTaps; ++t)
+            y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(x[-t]), c[t]));
+        peak = _mm_max_ps(peak, _mm_and_ps(y, absMask));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, peak);
+    return qMax(qMax(lanes[0], lanes[1]), qMax(lanes[2], lanes[3]));
+}
+
+#elif defined(ACP_LOUDNESS_NEON)
+
+double sumOfSquares(const float *p, qsizetype n)
+{
+    double sum = 0.0;
+    qsizetype i = 0;
+    while (i + 8 <= n)
+    {
+        float32x4_t a = vdupq_n_f32(0.0f), b = vdupq_n_f32(0.0f);
+        const qsizetype end = qMin(n, i + 4096) & ~qsizetype(7);
+        for (; i < end; i += 8)
+        {
+            const float32x4_t x = vld1q_f32(p + i);
+            const float32x4_t y = vld1q_f32(p + i + 4);
+            a = vmlaq_f32(a, x, x);
+            b = vmlaq_f32(b, y, y);
+        }
+        sum += vaddvq_f32(vaddq_f32(a, b));
+    }
+    return sum + sumOfSquaresScalar(p + i, n - i);
+}
+
+float truePeak(const float *in, qsizetype n)
+{
+    const TruePeakFir &fir = truePeakFir();
+    float32x4_t c[kTruePeakTaps];
+    for (int t = 0; t < kTruePeakTaps; ++t)
+        c[t] = vld1q_f32(fir.c[t]);
+
+    float32x4_t peak = vdupq_n_f32(0.0f);
+    for (qsizetype i = 0; i < n; ++i)
+    {
+        const float *x = in + i + kHistory;
+        float32x4_t y = vmulq_n_f32(c[0], x[0]);
+        for (int t = 1; t < kTruePeakTaps; ++t)
+            y = vmlaq_n_f32(y, c[t], x[-t]);
+        peak = vmaxq_f32(peak, vabsq_f32(y));
+    }
+    return vmaxvq_f32(peak);
+}
+
+#else
+
+double sumOfSquares(const float *p, qsizetype n)
+{
+    return sumOfSquaresScalar(p, n);
+}
+
+float truePeak(const float *in, qsizetype n)
+{
+    return truePeakScalar(in, n);
+}
+
+#endif
+
+} // namespace
+
+/* ============================================================
+ * STATS
+ * ============================================================ */
+QJsonObject Loudness::Stats::toJson() const
+{
+    QJsonObject obj;
+    obj["i"] = integratedLufs;
+    obj["lra"] = rangeLu;
+    obj["tp"] = truePeakDbtp;
+    return obj;
+}
+
+Loudness::Stats Loudness::Stats::fromJson(const QJsonObject &obj)
+{
+    Stats s;
+    if (!obj.contains("i"))
+        return s;
+    s.valid = true;
+    s.integratedLufs = obj["i"].toDouble();
+    s.rangeLu = obj["lra"].toDouble();
+    s.truePeakDbtp = obj["tp"].toDouble();
+    return s;
+}
+
+double Loudness::normalizationGain(const Stats &stats, double targetLufs, double ceilingDbtp)
+{
+    if (!stats.valid)
+        return 1.0;
+
+    double gainDb = targetLufs - stats.integratedLufs;
+    if (stats.truePeakDbtp + gainDb > ceilingDbtp)
+        gainDb = ceilingDbtp - stats.truePeakDbtp;
+    return qPow(10.0, gainDb / 20.0);
+}
+
+/* ============================================================
+ * K-WEIGHTING – design for any sample rate (BS.1770)
+ * ============================================================ */
+void Loudness::KWeighting::design(int sampleRate)
+{
+    // Stage 1: high shelf, +4 dB above ~1.7 kHz (head effects)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = std::tan(M_PI * f0 / sampleRate);
+        const double vh = qPow(10.0, gainDb / 20.0);
+        const double vb = qPow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        m_shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        m_shelf.b1 = 2.0 * (k * k - vh) / a0;
+        m_shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        m_shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        m_shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+    // Stage 2: RLB high pass at ~38 Hz
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = std::tan(M_PI * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+        m_highPass.b0 = 1.0;
+        m_highPass.b1 = -2.0;
+        m_highPass.b2 = 1.0;
+        m_highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        m_highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+}
+
+double Loudness::channelWeight(int channel, int channels)
+{
+    if (channels == 6)
+        return channel == 3 ? 0.0 : (channel >= 4 ? 1.41 : 1.0);
+    if (channels == 5)
+        return channel >= 3 ? 1.41 : 1.0;
+    return 1.0;
+}
+
+/* ============================================================
+ * METER – setup on the first buffer
+ * ============================================================ */
+void Loudness::Meter::setup(int channels, int sampleRate)
+{
+    m_sampleRate = sampleRate;
+    m_subBlockFrames = qMax(1, sampleRate / 10);
+    m_kWeighting.design(sampleRate);
+
+    m_channels.resize(channels);
+    for (int c = 0; c < channels; ++c)
+    {
+        Channel &ch = m_channels[c];
+        ch.history.fill(0.0f, kHistory);
+        ch.weight = channelWeight(c, channels);
+    }
+}
+
+/* ============================================================
+ * METER – one buffer
+ * ============================================================ */
+void Loudness::Meter::add(const float *samples, int frames, int channels, int sampleRate)
+{
+    if (frames <= 0 || channels <= 0 || sampleRate <= 0)
+        return;
+    if (m_channels.isEmpty())
+        setup(channels, sampleRate);
+    if (channels != m_channels.size())
+        return;
+
+    // The buffer split at 100 ms boundaries; every channel adds
+    // its weighted energy per piece
+    QVector<int> pieces;
+    QVector<double> pieceEnergy;
+    for (int done = 0, fill = m_subFill; done < frames; )
+    {
+        const int len = qMin(frames - done, m_subBlockFrames - fill);
+        pieces << len;
+        done += len;
+        fill = (fill + len) % m_subBlockFrames;
+    }
+    pieceEnergy.fill(0.0, pieces.size());
+
+    m_in.resize(kHistory + frames);
+    m_weighted.resize(frames);
+
+    for (int c = 0; c < channels; ++c)
+    {
+        Channel &ch = m_channels[c];
+
+        // De-interleave behind the previous buffer's last samples
+        float *in = m_in.data();
+        std::copy(ch.history.cbegin(), ch.history.cend(), in);
+        for (int f = 0; f < frames; ++f)
+            in[kHistory + f] = samples[qsizetype(f) * channels + c];
+        std::copy(in + frames, in + frames + kHistory, ch.history.begin());
+
+        ch.truePeak = qMax(ch.truePeak, truePeak(in, frames));
+
+        if (ch.weight == 0.0)
+            continue;
+
+        float *out = m_weighted.data();
+        KWeighting::State st = ch.filter;
+        for (int f = 0; f < frames; ++f)
+            out[f] = m_kWeighting.tick(st, in[kHistory + f]);
+        ch.filter = st;
+
+        int at = 0;
+        for (int p = 0; p < pieces.size(); ++p)
+        {
+            pieceEnergy[p] += ch.weight * sumOfSquares(out + at, pieces[p]);
+            at += pieces[p];
+        }
+    }
+
+    for (int p = 0; p < pieces.size(); ++p)
+    {
+        m_subEnergy += pieceEnergy[p];
+        m_subFill += pieces[p];
+        if (m_subFill == m_subBlockFrames)
+            flushSubBlock();
+    }
+}
+
+void Loudness::Meter::flushSubBlock()
+{
+    m_subBlocks.append(m_subEnergy / m_subBlockFrames);
+    m_subEnergy = 0.0;
+    m_subFill = 0;
+}
+
+/* ============================================================
+ * METER – gating
+ * ============================================================ */
+Loudness::Stats Loudness::Meter::finish() const
+{
+    Stats s;
+    if (m_channels.isEmpty())
+        return s;
+
+    float peak = 0.0f;
+    for (const Channel &ch : m_channels)
+        peak = qMax(peak, ch.truePeak);
+    s.truePeakDbtp = 20.0 * std::log10(qMax(peak, 1e-9f));
+
+    const QVector<double> &sub = m_subBlocks;
+    const double absGate = lufsToEnergy(kAbsoluteGateLufs);
+
+    // Gating blocks: 400 ms, 75 % overlap = four 100 ms sub-blocks.
+    // Shorter than one block (a click, a door slam): the whole file
+    // is the block
+    QVector<double> blocks;
+    for (int i = 3; i < sub.size(); ++i)
+        blocks << (sub[i] + sub[i - 1] + sub[i - 2] + sub[i - 3]) / 4.0;
+    if (blocks.isEmpty())
+    {
+        double energy = m_subEnergy;
+        for (double z : sub)
+            energy += z * m_subBlockFrames;
+        const qint64 frames = qint64(sub.size()) * m_subBlockFrames + m_subFill;
+        if (frames > 0)
+            blocks << energy / frames;
+    }
+
+    // Integrated: absolute gate, then 10 LU below the gated mean
+    auto gatedMean = [](const QVector<double> &z, double gate, int *count) {
+        double sum = 0.0;
+        int n = 0;
+        for (double v : z)
+            if (v > gate) { sum += v; ++n; }
+        if (count)
+            *count = n;
+        return n > 0 ? sum / n : 0.0;
+    };
+
+    int n = 0;
+    const double absMean = gatedMean(blocks, absGate, &n);
+    if (n == 0)
+        return s;   // silence: nothing to normalise
+    const double relGate = qMax(absGate, absMean * qPow(10.0, kIntegratedGateLu / 10.0));
+    s.integratedLufs = energyToLufs(gatedMean(blocks, relGate, nullptr));
+    s.valid = true;
+
+    // Range: 3 s short-term windows at 10 Hz, gated at -70 LUFS
+    // and 20 LU below their mean, 10th to 95th percentile
+    QVector<double> shortTerm;
+    double window = 0.0;
+    for (int i = 0; i < sub.size(); ++i)
+    {
+        window += sub[i];
+        if (i >= 30)
+            window -= sub[i - 30];
+        if (i >= 29)
+            shortTerm << window / 30.0;
+    }
+    const double stMean = gatedMean(shortTerm, absGate, &n);
+    if (n > 0)
+    {
+        const double stGate = qMax(absGate, stMean * qPow(10.0, kRangeGateLu / 10.0));
+        QVector<double> levels;
+        for (double z : shortTerm)
+            if (z > stGate)
+                levels << energyToLufs(z);
+        if (levels.size() > 1)
+        {
+            std::sort(levels.begin(), levels.end());
+            const int last = int(levels.size()) - 1;
+            s.rangeLu = levels[qRound(last * 0.95)] - levels[qRound(last * 0.10)];
+        }
+    }
+    return s;
+}
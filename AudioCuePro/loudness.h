@@ -0,0 +1,113 @@
+#ifndef LOUDNESS_H
+#define LOUDNESS_H
+
+#include <QJsonObject>
+#include <QVector>
+#include <QtGlobal>
+
+/*
+============================================================
+ Loudness
+------------------------------------------------------------
+ - EBU R128 / ITU-R BS.1770 measurement of one file, fed
+   one decoded buffer at a time (AudioAnalysis):
+     integrated loudness (LUFS, gated)
+     loudness range (LU, EBU Tech 3342)
+     true peak (dBTP, 4× oversampled)
+ - K-weighting is the BS.1770 pre-filter pair (high shelf +
+   high pass) as biquads, designed for the file's rate
+ - Block energy and the true-peak interpolator are
+   vectorised (SSE2 / NEON, scalar fallback), like
+   SilenceScan
+ - Keeps 100 ms sub-block energies only (36 000 values for
+   an hour), so long files stream through in constant
+   memory; the 400 ms / 3 s windows are built from them
+============================================================
+*/
+
+namespace Loudness
+{
+    struct Stats {
+        bool valid = false;
+        double integratedLufs = 0.0;
+        double rangeLu = 0.0;
+        double truePeakDbtp = 0.0;
+
+        // Cue JSON form: { "i": LUFS, "lra": LU, "tp": dBTP }
+        QJsonObject toJson() const;
+        static Stats fromJson(const QJsonObject &obj);
+    };
+
+    // BS.1770 K-weighting pre-filter for one sample rate: high shelf
+    // then high pass, transposed direct form II. Shared by the file
+    // meter below and the live LevelMeter; State is one channel
+    class KWeighting
+    {
+    public:
+        struct State { double s1 = 0, s2 = 0, h1 = 0, h2 = 0; };
+
+        void design(int sampleRate);
+
+        float tick(State &st, float in) const
+        {
+            const double x = in;
+            const double y = m_shelf.b0 * x + st.s1;
+            st.s1 = m_shelf.b1 * x - m_shelf.a1 * y + st.s2;
+            st.s2 = m_shelf.b2 * x - m_shelf.a2 * y;
+            const double z = m_highPass.b0 * y + st.h1;
+            st.h1 = m_highPass.b1 * y - m_highPass.a1 * z + st.h2;
+            st.h2 = m_highPass.b2 * y - m_highPass.a2 * z;
+            return float(z);
+        }
+
+    private:
+        struct Biquad {
+            double b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+        };
+        Biquad m_shelf, m_highPass;
+    };
+
+    // BS.1770 channel weight: surrounds 1.41, LFE 0, others 1
+    // (5.0 = L R C Ls Rs, 5.1 = L R C LFE Ls Rs)
+    double channelWeight(int channel, int channels);
+
+    // Gain (linear) that brings `stats` to `targetLufs`, held back
+    // so the true peak stays at or below `ceilingDbtp`. 1.0 if the
+    // file has not been measured.
+    double normalizationGain(const Stats &stats, double targetLufs, double ceilingDbtp = -1.0);
+
+    class Meter
+    {
+    public:
+        Meter() = default;
+
+        // Interleaved float frames; the format is taken from the
+        // first call, later buffers must match it
+        void add(const float *samples, int frames, int channels, int sampleRate);
+        Stats finish() const;
+
+    private:
+        struct Channel {
+            double weight = 1.0;               // BS.1770 channel weight (0 = LFE)
+            KWeighting::State filter;
+            QVector<float> history;            // last input samples, true-peak FIR
+            float truePeak = 0.0f;
+        };
+
+        void setup(int channels, int sampleRate);
+        void flushSubBlock();
+
+        KWeighting m_kWeighting;
+        QVector<Channel> m_channels;
+        int m_sampleRate = 0;
+        int m_subBlockFrames = 0;      // 100 ms
+        int m_subFill = 0;
+        double m_subEnergy = 0.0;      // weighted Σx² of the current sub-block
+        QVector<double> m_subBlocks;   // mean square per 100 ms
+
+        QVector<float> m_in;           // one channel, history + buffer
+        QVector<float> m_weighted;     // one channel, K-weighted
+    };
+}
+
+#endif // LOUDNESS_H
@@ -3,11 +3,24 @@
 #include <QStandardPaths>
 #include <QDir>
 #include "mainwindow.h"
+#include "benchmarks.h"
+#include "showrender.h"
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // Headless measurements: AudioCuePro --benchmark <name> [args]
+    const QStringList args = app.arguments();
+    const int benchmarkArg = args.indexOf(QStringLiteral("--benchmark"));
+    if (benchmarkArg >= 0)
+        return Benchmarks::run(args.mid(benchmarkArg + 1));
+
+    // Offline show render: AudioCuePro --render <show> <out.wav|.flac>
+    const int renderArg = args.indexOf(QStringLiteral("--render"));
+    if (renderArg >= 0)
+        return ShowRender::run(args.mid(renderArg + 1));
+
     QApplication::setStyle(QStyleFactory::create("Fusion"));
 
     QString style = R"(
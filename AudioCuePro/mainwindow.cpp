@@ -26,14 +26,42 @@
 #include <QBrush>        // NEW
 #include <QVariant>
 #include <QInputDialog>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QFormLayout>
 #include <QStringList>
 #include "mainwindow.h"
 #include "livemodewindow.h"
+#include "frameticker.h"
+#include "mediastore.h"
+#include "showjournal.h"
+#include "showpackage.h"
+#include "silencescan.h"
+#include "meterbar.h"
+#include "audioengine.h"
+#include "routingdialog.h"
+#include "latencyprobe.h"
+#include <QProgressDialog>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QMessageBox>
 #include <QProcessEnvironment>
 #include <QMenuBar>
 #include <QMenu>
 #include <QAction>
+#include <QActionGroup>
+#include <QTime>
+
+// Import-time silence trim: below this level counts as silence
+static const double kDefaultSilenceThresholdDb = -60.0;
+// Loudness normalisation target (EBU R128 broadcast level)
+static const double kDefaultTargetLufs = -23.0;
+// Ducking: speech over music, music comes back after a pause
+static const double kDefaultDuckThresholdDb = -40.0;
+static const double kDefaultDuckDepthDb = -15.0;
+static const double kDefaultDuckAttackMs = 20.0;
+static const double kDefaultDuckReleaseMs = 600.0;
 
 
 
@@ -158,8 +186,12 @@ MainWindow::MainWindow(QWidget *parent)
     masterSlider->setValue(100);
     masterSlider->setFixedWidth(140);
 
+    masterMeter = new MeterBar;
+    masterMeter->setFixedSize(160, 14);
+
     topButtons->addWidget(lblMaster);
     topButtons->addWidget(masterSlider);
+    topButtons->addWidget(masterMeter);
     topButtons->addSpacing(10);
 
     topButtons->addWidget(btnPanic);
@@ -184,6 +216,7 @@ MainWindow::MainWindow(QWidget *parent)
     connect(btnDeleteAll,   &QPushButton::clicked, this, &MainWindow::onDeleteAll);
     connect(btnCollapseAll, &QPushButton::clicked, this, &MainWindow::onCollapseAll);
     connect(btnExpandAll,   &QPushButton::clicked, this, &MainWindow::onExpandAll);
+    connect(btnPanic,       &QPushButton::pressed, AudioEngine::instance(), &AudioEngine::panic);
     connect(btnPanic,       &QPushButton::clicked, this, &MainWindow::onPanicClicked);
     connect(masterSlider,   &QSlider::valueChanged, this, &MainWindow::onMasterVolumeChanged);
     connect(btnAddSpotify,  &QPushButton::clicked, this, &MainWindow::onAddSpotifyTrack);
@@ -285,13 +318,13 @@ MainWindow::MainWindow(QWidget *parent)
         int idx = sceneList->row(item);
         if (idx >= 0 && idx < scenes.size())
             scenes[idx].name = item->text();
+        markJournalLayout();
     });
 	
-    // NEW: clock + timer updates
-    uiTimer = new QTimer(this);
-    uiTimer->setInterval(1000);
-    connect(uiTimer, &QTimer::timeout, this, &MainWindow::onUiTick);
-    uiTimer->start();
+    // Clock + timer updates share the application frame ticker
+    uiTickId = FrameTicker::instance()->subscribe(this, [this](qint64, qint64) {
+        onUiTick();
+    }, FrameTicker::Always, 1000);
 
     connect(timerStartStopButton, &QPushButton::clicked,
             this, &MainWindow::onTimerStartStop);
@@ -382,26 +415,17 @@ MainWindow::MainWindow(QWidget *parent)
 
     rightLayout->addWidget(emptyState, 1);
 
-    // Scroll area for track list
-    scrollArea = new QScrollArea(this);
-    scrollArea->setWidgetResizable(true);
-
-    QWidget *container = new QWidget(this);
-    trackListLayout = new QVBoxLayout(container);
-    trackListLayout->setSpacing(10);
-    trackListLayout->setContentsMargins(0, 0, 0, 0);
-    trackListLayout->addStretch(); // stretch at bottom
-
-    scrollArea->setWidget(container);
+    // Track list: one scroll page per scene (created in syncScenePages)
+    sceneStack = new QStackedWidget(this);
 
-    // Drop indicator line inside the scroll container (hidden by default)
-    dropIndicator = new QFrame(container);
+    // Drop indicator line; moved into the visible scene page on drag
+    dropIndicator = new QFrame(sceneStack);
     dropIndicator->setFrameShape(QFrame::HLine);
     dropIndicator->setFrameShadow(QFrame::Plain);
     dropIndicator->setStyleSheet("QFrame { background: #ff8800; max-height: 2px; }");
     dropIndicator->hide();
 
-    rightLayout->addWidget(scrollArea, 1);
+    rightLayout->addWidget(sceneStack, 1);
 
     // Put the left (scenes + SFX search) and right (tracks) panes in a splitter
     // so the user can resize them.
@@ -445,19 +469,8 @@ m_spotifyAuth->setClientId("7e9997c47b094a138dcb965e40c5d63c");
 	}
 
 
-	spotifyPollTimer = new QTimer(this);
-	spotifyPollTimer->setInterval(1000);
-	connect(spotifyPollTimer, &QTimer::timeout, this, [this]() {
-		// If we don't have a client, just stop polling.
-		if (!m_spotifyClient) {
-			stopSpotifyPolling();
-			return;
-		}
-
-		// Just ask Spotify what is currently playing; we'll map the URI back
-		// to the correct TrackWidget in onSpotifyPlaybackState().
-		m_spotifyClient->fetchCurrentPlayback();
-	});
+	// Spotify polling subscribes to the frame ticker on demand,
+	// see startSpotifyPolling().
 
 
     // connect auth manager signals
@@ -480,6 +493,128 @@ m_spotifyAuth->setClientId("7e9997c47b094a138dcb965e40c5d63c");
     // Settings / Login menu item
     QMenu *settingsMenu = menuBar()->addMenu(tr("&Settings"));
     QAction *spotifyLoginAction = settingsMenu->addAction(tr("Spotify Login..."));
+    QAction *verifyStoreAction = settingsMenu->addAction(tr("Verify Media Store..."));
+    connect(verifyStoreAction, &QAction::triggered, this, &MainWindow::verifyMediaStore);
+    QAction *relinkAction = settingsMenu->addAction(tr("Relink Missing Media..."));
+    connect(relinkAction, &QAction::triggered, this, &MainWindow::relinkMissingMedia);
+
+    // Import: start/end markers where the sound is
+    settingsMenu->addSeparator();
+    QAction *trimAction = settingsMenu->addAction(tr("Trim Silence on Import"));
+    trimAction->setCheckable(true);
+    trimAction->setChecked(settings.value("import/trimSilence", true).toBool());
+    connect(trimAction, &QAction::toggled, this, [this](bool on) {
+        settings.setValue("import/trimSilence", on);
+    });
+    QAction *thresholdAction = settingsMenu->addAction(tr("Silence Threshold..."));
+    connect(thresholdAction, &QAction::triggered, this, [this]() {
+        bool ok = false;
+        const double db = QInputDialog::getDouble(
+            this, tr("Silence Threshold"),
+            tr("Treat audio below this level as silence (dBFS):"),
+            settings.value("import/silenceThresholdDb", kDefaultSilenceThresholdDb).toDouble(),
+            -96.0, -20.0, 1, &ok);
+        if (ok)
+            settings.setValue("import/silenceThresholdDb", db);
+    });
+
+    // Playback: every cue brought to one loudness by a fixed gain
+    settingsMenu->addSeparator();
+    QAction *normalizeAction = settingsMenu->addAction(tr("Normalize Loudness"));
+    normalizeAction->setCheckable(true);
+    normalizeAction->setChecked(settings.value("playback/normalize", false).toBool());
+    connect(normalizeAction, &QAction::toggled, this, [this](bool on) {
+        settings.setValue("playback/normalize", on);
+        for (Scene &s : scenes)
+            for (TrackWidget *tw : s.tracks)
+                applyLoudnessNormalization(tw);
+        // Cues never measured stay at their gain until they are
+        if (on)
+            analyzeLoudness(true);
+    });
+    QAction *targetAction = settingsMenu->addAction(tr("Loudness Target..."));
+    connect(targetAction, &QAction::triggered, this, [this]() {
+        bool ok = false;
+        const double lufs = QInputDialog::getDouble(
+            this, tr("Loudness Target"),
+            tr("Normalize cues to this integrated loudness (LUFS):"),
+            settings.value("playback/targetLufs", kDefaultTargetLufs).toDouble(),
+            -40.0, -6.0, 1, &ok);
+        if (!ok)
+            return;
+        settings.setValue("playback/targetLufs", lufs);
+        for (Scene &s : scenes)
+            for (TrackWidget *tw : s.tracks)
+                applyLoudnessNormalization(tw);
+    });
+    QAction *analyzeAction = settingsMenu->addAction(tr("Analyze Loudness..."));
+    connect(analyzeAction, &QAction::triggered, this, [this]() { analyzeLoudness(false); });
+    QAction *renderAction = settingsMenu->addAction(tr("Render Show to File..."));
+    connect(renderAction, &QAction::triggered, this, &MainWindow::renderShowToFile);
+
+    // Master bus: look-ahead limiter after the mix
+    settingsMenu->addSeparator();
+    QAction *ceilingAction = settingsMenu->addAction(tr("Limiter Ceiling..."));
+    connect(ceilingAction, &QAction::triggered, this, [this]() {
+        bool ok = false;
+        const double db = QInputDialog::getDouble(
+            this, tr("Limiter Ceiling"),
+            tr("Highest level the master output may reach (dBFS):"),
+            settings.value("limiter/ceilingDb", BrickwallLimiter::kDefaultCeilingDb).toDouble(),
+            -12.0, 0.0, 1, &ok);
+        if (!ok)
+            return;
+        settings.setValue("limiter/ceilingDb", db);
+        applyLimiterSettings();
+    });
+    QAction *releaseAction = settingsMenu->addAction(tr("Limiter Release..."));
+    connect(releaseAction, &QAction::triggered, this, [this]() {
+        bool ok = false;
+        const int ms = QInputDialog::getInt(
+            this, tr("Limiter Release"),
+            tr("Time the limiter takes to recover after a peak (ms):"),
+            settings.value("limiter/releaseMs", BrickwallLimiter::kDefaultReleaseMs).toInt(),
+            10, 2000, 10, &ok);
+        if (!ok)
+            return;
+        settings.setValue("limiter/releaseMs", ms);
+        applyLimiterSettings();
+    });
+    QAction *engineAction = settingsMenu->addAction(tr("Audio Engine Status..."));
+    connect(engineAction, &QAction::triggered, this, &MainWindow::showAudioEngineStatus);
+    applyLimiterSettings();
+
+    // Ducking: cues marked "Ducks X" lower the cues "Ducked by X"
+    QAction *duckingAction = settingsMenu->addAction(tr("Ducking..."));
+    connect(duckingAction, &QAction::triggered, this, &MainWindow::editDuckingSettings);
+    applyDuckingSettings();
+
+    // Media rate and cue speed conversion in the engine
+    QMenu *qualityMenu = settingsMenu->addMenu(tr("Resampling Quality"));
+    auto *qualityGroup = new QActionGroup(qualityMenu);
+    const QString savedQuality = settings.value("playback/resamplerQuality",
+        Resampler::qualityName(Resampler::Quality::Standard)).toString();
+    for (Resampler::Quality q : { Resampler::Quality::Fast, Resampler::Quality::Standard,
+                                  Resampler::Quality::High })
+    {
+        QAction *action = qualityMenu->addAction(Resampler::qualityName(q));
+        action->setCheckable(true);
+        qualityGroup->addAction(action);
+        connect(action, &QAction::triggered, this, [this, q]() {
+            settings.setValue("playback/resamplerQuality", Resampler::qualityName(q));
+            AudioEngine::instance()->setResamplerQuality(q);
+        });
+        if (Resampler::qualityName(q) == savedQuality)
+        {
+            action->setChecked(true);
+            AudioEngine::instance()->setResamplerQuality(q);
+        }
+    }
+
+    // Buses: which device and channels each one plays on
+    QAction *routingAction = settingsMenu->addAction(tr("Output Routing..."));
+    connect(routingAction, &QAction::triggered, this, &MainWindow::editRouting);
+    loadRouting();
     connect(spotifyLoginAction, &QAction::triggered,
             this, &MainWindow::onSpotifyLogin);
 
@@ -496,7 +631,11 @@ m_spotifyAuth->setClientId("7e9997c47b094a138dcb965e40c5d63c");
 	
     updateSceneHighlighting();   // NEW
     rebuildFragmentTree();       // NEW
+    showCurrentScenePage();
     updateEmptyState();
+
+    // After the window is up: offer crash recovery, then start journaling
+    QTimer::singleShot(0, this, &MainWindow::startJournal);
 }
 
 MainWindow::~MainWindow() {}
@@ -536,8 +675,8 @@ void MainWindow::updateEmptyState()
     bool hasTracks = !currentScene().tracks.isEmpty();
     if (emptyState)
         emptyState->setVisible(!hasTracks);
-    if (scrollArea)
-        scrollArea->setVisible(hasTracks);
+    if (sceneStack)
+        sceneStack->setVisible(hasTracks);
 }
 
 void MainWindow::updateSceneHighlighting()
@@ -573,7 +712,7 @@ void MainWindow::onAddFiles()
 		this,
 		"Add Audio Files",
 		lastOpenedDir,
-		"Audio Files (*.mp3 *.wav *.flac *.ogg *.m4a)"
+		MediaImport::dialogFilter()
 	);
 
 	if (!files.isEmpty()) {
@@ -583,10 +722,7 @@ void MainWindow::onAddFiles()
 	}
 
 
-    for (const QString &file : files)
-        addTrackFromFile(file);
-
-    rebuildTrackList();
+    importFiles(files);
 }
 
 /* ============================================================
@@ -602,7 +738,7 @@ void MainWindow::onDeleteAll()
     }
 
     for (TrackWidget *tw : currentScene().tracks)
-        tw->deleteLater();
+        releaseTrack(tw);
 
     currentScene().tracks.clear();
     rebuildTrackList();
@@ -628,7 +764,9 @@ void MainWindow::onExpandAll()
  * ============================================================ */
 void MainWindow::onPanicClicked()
 {
-    // Stop all tracks in all scenes, immediately
+    // The sound already went on the button's press (pressed ->
+    // AudioEngine::panic): every voice ramps to silence in the next
+    // audio block. Here the cues: players stopped, state and UI reset
     for (Scene &s : scenes)
     {
         for (TrackWidget *tw : s.tracks)
@@ -709,9 +847,13 @@ void MainWindow::onRemoveScene()
 
     // Delete widgets in that scene
     for (TrackWidget *tw : scenes[row].tracks)
-        tw->deleteLater();
+        releaseTrack(tw);
 
     scenes.removeAt(row);
+
+    // Drop its page too, so later scenes keep their own pages
+    if (row < scenePages.size())
+        releaseScenePage(scenePages.takeAt(row));
     delete sceneList->takeItem(row);
 
     if (row >= scenes.size())
@@ -739,9 +881,15 @@ void MainWindow::onSceneSelectionChanged(int row)
 
     currentSceneIndex = row;
     liveNextCueIndexHint = 0;
-    rebuildTrackList();
+
+    // Every scene already has its page: just flip the stack and
+    // recolor the scene rows, no reparenting and no tree rebuild.
+    showCurrentScenePage();
+    updateEmptyState();
     updateSceneHighlighting();
-    rebuildFragmentTree();
+    updateFragmentTreeHighlighting();
+    if (liveModeWindow)
+        liveModeWindow->setCurrentScene(currentSceneIndex);
     updateLiveTimeline();  // keep Live Mode in sync
 }
 
@@ -944,23 +1092,33 @@ TrackWidget* MainWindow::findSpotifyTrackByUri(const QString &uri) const
 
 void MainWindow::startSpotifyPolling()
 {
-    if (!spotifyPollTimer)
-        return;
-
     if (!currentTrack || !currentTrack->isSpotify())
         return;
 
     if (m_spotifyClient)
         m_spotifyClient->fetchCurrentPlayback();
 
-    if (!spotifyPollTimer->isActive())
-        spotifyPollTimer->start();
+    FrameTicker *ticker = FrameTicker::instance();
+    if (ticker->isSubscribed(spotifyPollTickId))
+        return;
+
+    spotifyPollTickId = ticker->subscribe(this, [this](qint64, qint64) {
+        // If we don't have a client, just stop polling.
+        if (!m_spotifyClient) {
+            stopSpotifyPolling();
+            return;
+        }
+
+        // Just ask Spotify what is currently playing; we'll map the URI back
+        // to the correct TrackWidget in onSpotifyPlaybackState().
+        m_spotifyClient->fetchCurrentPlayback();
+    }, FrameTicker::Always, 1000);
 }
 
 void MainWindow::stopSpotifyPolling()
 {
-    if (spotifyPollTimer)
-        spotifyPollTimer->stop();
+    FrameTicker::instance()->unsubscribe(spotifyPollTickId);
+    spotifyPollTickId = 0;
 }
 
 
@@ -969,6 +1127,8 @@ void MainWindow::stopSpotifyPolling()
  * ============================================================ */
 void MainWindow::onTrackPlayRequested(TrackWidget *tw)
 {
+    LatencyProbe::mark(LatencyProbe::PlayRequest);
+
     // No current track -> just play this one
     if (!currentTrack)
     {
@@ -1108,7 +1268,7 @@ void MainWindow::onTrackDeleteRequested(TrackWidget *tw)
         if (idx != -1)
         {
             s.tracks.removeAt(idx);
-            tw->deleteLater();
+            releaseTrack(tw);
             break;
         }
     }
@@ -1124,6 +1284,11 @@ void MainWindow::onTrackDeleteRequested(TrackWidget *tw)
 void MainWindow::closeEvent(QCloseEvent *event)
 {
     // TODO: persist window state / scenes if desired
+
+    // Normal exit: nothing to recover next time
+    if (journal)
+        journal->markClean();
+
     QMainWindow::closeEvent(event);
 }
 
@@ -1131,8 +1296,8 @@ void MainWindow::dragEnterEvent(QDragEnterEvent *event)
 {
     const QMimeData *md = event->mimeData();
 
-    // Internal track drag (by pointer)
-    if (md->hasFormat("application/x-audiocuepro-trackptr"))
+    // Internal track drag (by cue ID)
+    if (md->hasFormat("application/x-audiocuepro-cueid"))
     {
         event->acceptProposedAction();
         return;
@@ -1146,12 +1311,9 @@ void MainWindow::dragEnterEvent(QDragEnterEvent *event)
             if (!url.isLocalFile())
                 continue;
 
-            QString path = url.toLocalFile().toLower();
-            if (path.endsWith(".mp3") ||
-                path.endsWith(".wav") ||
-                path.endsWith(".flac") ||
-                path.endsWith(".ogg") ||
-                path.endsWith(".m4a"))
+            // Audio files, or folders to search for them
+            const QString path = url.toLocalFile();
+            if (MediaImport::isAudioFile(path) || QFileInfo(path).isDir())
             {
                 event->acceptProposedAction();
                 return;
@@ -1169,16 +1331,19 @@ void MainWindow::dragMoveEvent(QDragMoveEvent *event)
 {
     const QMimeData *md = event->mimeData();
 
-    if (md->hasFormat("application/x-audiocuepro-trackptr"))
+    if (md->hasFormat("application/x-audiocuepro-cueid"))
     {
         event->acceptProposedAction();
 
         if (!dropIndicator)
             return;
-        QWidget *container = scrollArea ? scrollArea->widget() : nullptr;
+        QWidget *container = currentTrackContainer();
         if (!container)
             return;
 
+        if (dropIndicator->parentWidget() != container)
+            dropIndicator->setParent(container);
+
         QPoint local = container->mapFrom(this, event->position().toPoint());
         int y = local.y();
         int insertY = -1;
@@ -1239,14 +1404,14 @@ void MainWindow::dropEvent(QDropEvent *event)
     const QMimeData *md = event->mimeData();
 
 
-    // 1. Internal track drag (pointer)
-    if (md->hasFormat("application/x-audiocuepro-trackptr"))
+    // 1. Internal track drag (cue ID)
+    if (md->hasFormat("application/x-audiocuepro-cueid"))
     {
-        QByteArray data = md->data("application/x-audiocuepro-trackptr");
+        QByteArray data = md->data("application/x-audiocuepro-cueid");
         QDataStream ds(&data, QIODevice::ReadOnly);
-        quintptr ptrVal = 0;
-        ds >> ptrVal;
-        TrackWidget *tw = reinterpret_cast<TrackWidget*>(ptrVal);
+        quint64 cueId = 0;
+        ds >> cueId;
+        TrackWidget *tw = cueIndex.find(cueId);
         if (!tw)
             return;
 
@@ -1301,7 +1466,7 @@ void MainWindow::dropEvent(QDropEvent *event)
         else
         {
             // Original behaviour: determine index inside the current scene's track list
-            QWidget *container = scrollArea ? scrollArea->widget() : nullptr;
+            QWidget *container = currentTrackContainer();
             if (!container)
                 return;
 
@@ -1345,145 +1510,345 @@ void MainWindow::dropEvent(QDropEvent *event)
         return;
     }
 
-    // 2. External audio file dropped
+    // 2. External audio files / folders dropped
     if (md->hasUrls())
     {
+        QStringList paths;
         for (const QUrl &url : md->urls())
         {
-            if (!url.isLocalFile())
-                continue;
-
-            QString path = url.toLocalFile();
-            if (!QFile::exists(path))
-                continue;
-
-            addTrackFromFile(path);
+            if (url.isLocalFile())
+                paths << url.toLocalFile();
         }
 
-        rebuildTrackList();
-        rebuildFragmentTree();
+        importFiles(paths);
 
         event->acceptProposedAction();
         return;
     }
 }
 
-void MainWindow::rebuildTrackList()
+/* ============================================================
+ * IMPORT – enumerate, probe and analyse on workers,
+ * cues created batch by batch on the GUI thread
+ * ============================================================ */
+void MainWindow::importFiles(const QStringList &paths)
 {
-    if (!trackListLayout)
+    if (paths.isEmpty())
+        return;
+
+    if (importWatcher)
+    {
+        QMessageBox::information(this, "Add Audio", "Files are still being imported.");
         return;
+    }
 
-    // Remove old items from layout (but do NOT delete TrackWidgets)
-    while (trackListLayout->count() > 0)
+    ensureAtLeastOneScene();
+    importSceneIndex = currentSceneIndex;
+    importUndecodable.clear();
+
+    auto *progress = new QProgressDialog("Looking for audio files…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Add Audio");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    importWatcher = new QFutureWatcher<MediaImport::Item>(this);
+    connect(importWatcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(importWatcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            importWatcher, &QFutureWatcherBase::cancel);
+    connect(importWatcher, &QFutureWatcherBase::resultsReadyAt,
+            this, &MainWindow::onImportBatch);
+
+    connect(importWatcher, &QFutureWatcherBase::finished, this, [this, progress]()
     {
-        QLayoutItem *item = trackListLayout->takeAt(0);
-        if (QWidget *w = item->widget())
+        importWatcher->deleteLater();
+        importWatcher = nullptr;
+        progress->deleteLater();
+
+        if (!importUndecodable.isEmpty())
         {
-            w->hide();
-            w->setParent(nullptr);
+            QMessageBox::warning(this, "Add Audio",
+                                 QString("%1 file(s) could not be decoded:\n\n%2")
+                                     .arg(importUndecodable.size())
+                                     .arg(importUndecodable.mid(0, 20).join('\n')));
         }
-        delete item;
-    }
+    });
 
-    // Re-add the widgets from the current scene
-    QWidget *container = scrollArea ? scrollArea->widget() : nullptr;
+    float silenceThreshold = 0.0f;
+    if (settings.value("import/trimSilence", true).toBool())
+        silenceThreshold = SilenceScan::thresholdFromDb(
+            settings.value("import/silenceThresholdDb", kDefaultSilenceThresholdDb).toDouble());
 
-    for (TrackWidget *tw : currentScene().tracks)
-    {
-        if (!tw)
-            continue;
+    importWatcher->setFuture(QtConcurrent::run(&MediaImport::run, paths, silenceThreshold));
+}
 
-        if (container)
-            tw->setParent(container);
+void MainWindow::onImportBatch(int begin, int end)
+{
+    // The scene may have been removed while the batch was analysed
+    ensureAtLeastOneScene();
+    if (importSceneIndex < 0 || importSceneIndex >= scenes.size())
+        importSceneIndex = currentSceneIndex;
+    Scene &scene = scenes[importSceneIndex];
 
-        tw->show();
-        trackListLayout->addWidget(tw);
+    for (int i = begin; i < end; ++i)
+    {
+        const MediaImport::Item item = importWatcher->resultAt(i);
+
+        // Hand the measured envelope to the cue's WaveformView
+        if (item.analysis.peaks && !item.analysis.peaks->isEmpty())
+            WaveformPeaks::stash(item.path, item.analysis.peaks);
+        if (!item.analysis.ok)
+            importUndecodable << QFileInfo(item.path).fileName();
+
+        TrackWidget *tw = new TrackWidget(item.path, this);
+        // Its WaveformView has taken the envelope; drop whatever it
+        // did not (no view), so the stash never outlives the import
+        WaveformPeaks::takeStashed(item.path);
+        connectTrackSignals(tw);
+        tw->setMasterVolume(masterVolume);
+        tw->applyProbe(item.probe);
+        tw->applySoundBounds(item.analysis.soundStartMs, item.analysis.soundEndMs);
+        if (item.analysis.loudness.valid)
+            tw->setLoudness(item.analysis.loudness);
+        scene.tracks.append(tw);
     }
 
-    // Add bottom stretch
-    trackListLayout->addStretch();
+    // One layout pass per batch, not per cue
+    rebuildTrackList();
+}
+
+void MainWindow::rebuildTrackList()
+{
+    if (!sceneStack)
+        return;
+
+    syncScenePages();
+    showCurrentScenePage();
 
     updateGlobalHotkeys();
     updateEmptyState();
     rebuildFragmentTree();
 }
 
+/* ============================================================
+ * SCENE PAGES – one cached scroll container per scene
+ * ============================================================ */
+MainWindow::ScenePage MainWindow::createScenePage()
+{
+    ScenePage page;
+    page.scroll = new QScrollArea(sceneStack);
+    page.scroll->setWidgetResizable(true);
+
+    page.container = new QWidget(page.scroll);
+    page.layout = new QVBoxLayout(page.container);
+    page.layout->setSpacing(10);
+    page.layout->setContentsMargins(0, 0, 0, 0);
+    page.layout->addStretch(); // stretch at bottom
+
+    page.scroll->setWidget(page.container);
+    return page;
+}
+
+void MainWindow::releaseScenePage(const ScenePage &page)
+{
+    // The drop indicator may live in this page; keep it alive
+    if (dropIndicator && dropIndicator->parentWidget() == page.container)
+    {
+        dropIndicator->hide();
+        dropIndicator->setParent(sceneStack);
+    }
+
+    sceneStack->removeWidget(page.scroll);
+    page.scroll->deleteLater();
+}
+
+void MainWindow::syncScenePages()
+{
+    if (!sceneStack)
+        return;
+
+    // Pages follow scenes by index; extra pages at the end go away
+    while (scenePages.size() > scenes.size())
+        releaseScenePage(scenePages.takeLast());
+    while (scenePages.size() < scenes.size())
+    {
+        ScenePage page = createScenePage();
+        sceneStack->addWidget(page.scroll);
+        scenePages.append(page);
+    }
+
+    // Pass 1: take out widgets that no longer belong on a page
+    // (deleted, or moved to another scene). Unchanged pages are
+    // left completely alone, so nothing relayouts.
+    for (int s = 0; s < scenes.size(); ++s)
+    {
+        QVBoxLayout *layout = scenePages[s].layout;
+        const QVector<TrackWidget*> &tracks = scenes[s].tracks;
+
+        for (int i = layout->count() - 1; i >= 0; --i)
+        {
+            QWidget *w = layout->itemAt(i)->widget();
+            if (!w)
+                continue;   // the bottom stretch
+
+            TrackWidget *tw = qobject_cast<TrackWidget*>(w);
+            if (!tw || !tracks.contains(tw))
+            {
+                layout->removeWidget(w);
+                w->hide();
+            }
+        }
+    }
+
+    // Pass 2: put each scene's widgets in order, touching only
+    // the positions that differ
+    for (int s = 0; s < scenes.size(); ++s)
+    {
+        QVBoxLayout *layout = scenePages[s].layout;
+        const QVector<TrackWidget*> &tracks = scenes[s].tracks;
+
+        int pos = 0;
+        for (TrackWidget *tw : tracks)
+        {
+            if (!tw)
+                continue;
+
+            QLayoutItem *item = layout->itemAt(pos);
+            if (item && item->widget() == tw)
+            {
+                ++pos;
+                continue;
+            }
+
+            if (layout->indexOf(tw) >= 0)
+                layout->removeWidget(tw);
+
+            layout->insertWidget(pos, tw);   // reparents into this page
+            tw->show();
+            ++pos;
+        }
+    }
+}
+
+void MainWindow::showCurrentScenePage()
+{
+    if (!sceneStack)
+        return;
+
+    if (scenePages.size() != scenes.size())
+        syncScenePages();
+
+    if (currentSceneIndex >= 0 && currentSceneIndex < scenePages.size())
+        sceneStack->setCurrentWidget(scenePages[currentSceneIndex].scroll);
+}
+
+QWidget *MainWindow::currentTrackContainer() const
+{
+    if (currentSceneIndex < 0 || currentSceneIndex >= scenePages.size())
+        return nullptr;
+    return scenePages[currentSceneIndex].container;
+}
+
 
 void MainWindow::rebuildFragmentTree()
 {
     if (!fragmentTree)
         return;
 
-    fragmentTree->clear();
-    trackTreeItems.clear();
-
-    // One top-level item per scene
-    for (int i = 0; i < scenes.size(); ++i)
+    // Scene rows follow `scenes` by index. A scene row that goes
+    // away hands its cue rows back (detached) before it is deleted.
+    while (fragmentTree->topLevelItemCount() > scenes.size())
     {
-        const Scene &scene = scenes[i];
+        QTreeWidgetItem *sceneRoot =
+            fragmentTree->takeTopLevelItem(fragmentTree->topLevelItemCount() - 1);
+        sceneRoot->takeChildren();
+        delete sceneRoot;
+    }
 
+    while (fragmentTree->topLevelItemCount() < scenes.size())
+    {
         QTreeWidgetItem *sceneRoot = new QTreeWidgetItem(fragmentTree);
-        sceneRoot->setText(0, scene.name);
 
         // Scene items: selectable + drop targets, but not draggable
         sceneRoot->setFlags(sceneRoot->flags()
                             | Qt::ItemIsEnabled
                             | Qt::ItemIsSelectable
                             | Qt::ItemIsDropEnabled);
+        sceneRoot->setExpanded(true);
+    }
 
-        // Highlight the currently active scene in green
-        if (i == currentSceneIndex)
-        {
-            sceneRoot->setBackground(0, QBrush(QColor("#2ecc71")));
-            sceneRoot->setForeground(0, QBrush(QColor("#000000")));
-        }
+    auto makeCueItem = []() {
+        QTreeWidgetItem *child = new QTreeWidgetItem();
+
+        // Track items: draggable, but not drop targets
+        Qt::ItemFlags flags = child->flags();
+        flags |= Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+        flags &= ~Qt::ItemIsDropEnabled;
+        child->setFlags(flags);
+
+        // Default color; will be changed by onTrackStatePlaying/Paused/Stopped
+        child->setForeground(0, QBrush(QColor("#dddddd")));
+        return child;
+    };
 
-        fragmentTree->addTopLevelItem(sceneRoot);
+    // Move / relabel / drop only the cue rows that changed
+    for (int i = 0; i < scenes.size(); ++i)
+    {
+        const Scene &scene = scenes[i];
+        QTreeWidgetItem *sceneRoot = fragmentTree->topLevelItem(i);
+        if (sceneRoot->text(0) != scene.name)
+            sceneRoot->setText(0, scene.name);
 
-        // Children: the audio fragments of this scene
+        QVector<CueTreeSync::Row> rows;
+        rows.reserve(scene.tracks.size());
         for (TrackWidget *tw : scene.tracks)
         {
             if (!tw) continue;
 
-            QTreeWidgetItem *child = new QTreeWidgetItem(sceneRoot);
-
-            QString label = tw->altName().trimmed();
-            if (label.isEmpty())
-            {
-                QFileInfo fi(tw->audioPath());
-                label = fi.fileName();
-            }
+            QString label = tw->displayName();
             // NEW: append hotkey in brackets, e.g. "Thunder Intro (W)"
             QString hk = tw->assignedKey().trimmed();
             if (!hk.isEmpty())
                 label += QStringLiteral(" (%1)").arg(hk.toUpper());
 
-            child->setText(0, label);
-
-            // Track items: draggable, but not drop targets
-            Qt::ItemFlags flags = child->flags();
-            flags |= Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
-            flags &= ~Qt::ItemIsDropEnabled;
-            child->setFlags(flags);
-
-            // Attach the TrackWidget* so we can rebuild scenes after a drag
-            child->setData(0, Qt::UserRole,
-                           QVariant::fromValue<quintptr>(reinterpret_cast<quintptr>(tw)));
-
-            // Default color; will be changed by onTrackStatePlaying/Paused/Stopped
-            child->setForeground(0, QBrush(QColor("#dddddd")));
-
-            trackTreeItems.insert(tw, child);
+            rows.append({tw->cueId(), label});
         }
+
+        CueTreeSync::syncChildren(sceneRoot, rows, trackTreeItems, makeCueItem);
     }
 
+    CueTreeSync::dropDetached(trackTreeItems);
+    updateFragmentTreeHighlighting();
+    markJournalLayout();   // every structural change ends up here
+
     updateLiveSceneTree();   // NEW
     updateLiveTimeline();  
-
-    fragmentTree->expandAll();
 }
 
+void MainWindow::updateFragmentTreeHighlighting()
+{
+    if (!fragmentTree)
+        return;
 
+    for (int i = 0; i < fragmentTree->topLevelItemCount(); ++i)
+    {
+        QTreeWidgetItem *sceneRoot = fragmentTree->topLevelItem(i);
+        if (i == currentSceneIndex)
+        {
+            sceneRoot->setBackground(0, QBrush(QColor("#2ecc71")));
+            sceneRoot->setForeground(0, QBrush(QColor("#000000")));
+        }
+        else
+        {
+            sceneRoot->setBackground(0, QBrush());
+            sceneRoot->setForeground(0, QBrush());
+        }
+    }
+}
 
 void MainWindow::syncScenesFromFragmentTreePublic()
 {
@@ -1503,6 +1868,9 @@ void MainWindow::syncScenesFromFragmentTree()
         return;
     }
 
+    // The view moved the rows itself; refresh our ID → row map
+    CueTreeSync::reindex(fragmentTree, trackTreeItems);
+
     // Clear existing track lists; they will be rebuilt from the tree
     for (Scene &s : scenes)
         s.tracks.clear();
@@ -1523,8 +1891,7 @@ void MainWindow::syncScenesFromFragmentTree()
             if (!child)
                 continue;
 
-            quintptr ptrVal = child->data(0, Qt::UserRole).value<quintptr>();
-            TrackWidget *tw = reinterpret_cast<TrackWidget*>(ptrVal);
+            TrackWidget *tw = cueIndex.find(CueTreeSync::idOf(child));
             if (tw)
                 scene.tracks.append(tw);
         }
@@ -1544,6 +1911,15 @@ void MainWindow::syncScenesFromFragmentTree()
  * ============================================================ */
 void MainWindow::connectTrackSignals(TrackWidget *tw)
 {
+    // Every cue passes through here once: register its ID. A clash
+    // (e.g. a duplicated entry in a hand-edited show) gets a fresh ID.
+    if (!cueIndex.insert(tw->cueId(), tw))
+    {
+        tw->setCueId(CueIndex::allocateId());
+        cueIndex.insert(tw->cueId(), tw);
+    }
+    applyLoudnessNormalization(tw);
+
     connect(tw, &TrackWidget::playRequested, this, &MainWindow::onTrackPlayRequested);
     connect(tw, &TrackWidget::stopRequested, this, &MainWindow::onTrackStopRequested);
     connect(tw, &TrackWidget::fadeOutFinished, this, &MainWindow::onTrackFadeOutFinished);
@@ -1554,6 +1930,9 @@ void MainWindow::connectTrackSignals(TrackWidget *tw)
     connect(tw, &TrackWidget::statePlaying, this, &MainWindow::onTrackStatePlaying);
     connect(tw, &TrackWidget::statePaused,  this, &MainWindow::onTrackStatePaused);
     connect(tw, &TrackWidget::stateStopped, this, &MainWindow::onTrackStateStopped);
+    connect(tw, &TrackWidget::mediaStateChanged, this, &MainWindow::onTrackMediaStateChanged);
+    connect(tw, &TrackWidget::settingsEdited, this, &MainWindow::markJournalCue);
+    markJournalCue(tw);
     // Watch per-track hotkey edits so we can prevent duplicates and refresh labels
     connect(tw, &TrackWidget::hotkeyEdited,
             this, &MainWindow::onTrackHotkeyEdited);
@@ -1570,6 +1949,20 @@ connect(tw, &TrackWidget::spotifyPlayRequested,
             this, &MainWindow::onSpotifyStopRequested);
 }
 
+void MainWindow::releaseTrack(TrackWidget *tw)
+{
+    if (!tw)
+        return;
+
+    cueIndex.remove(tw->cueId());
+    if (showReadyWaiting.remove(tw->cueId()))
+        checkShowReady();
+    journalDirtyCues.remove(tw->cueId());
+    if (journal)
+        journal->recordCueRemoved(tw->cueId());
+    tw->deleteLater();
+}
+
 void MainWindow::onTrackStatePlaying(TrackWidget *tw)
 {
     // Playing track → green, others default (fragment tree)
@@ -1578,7 +1971,7 @@ void MainWindow::onTrackStatePlaying(TrackWidget *tw)
         QTreeWidgetItem *item = it.value();
         if (!item) continue;
 
-        if (it.key() == tw)
+        if (it.key() == tw->cueId())
             item->setForeground(0, QBrush(QColor("#2ecc71"))); // green
         else
             item->setForeground(0, QBrush(QColor("#dddddd"))); // default
@@ -1601,21 +1994,195 @@ void MainWindow::onTrackStatePlaying(TrackWidget *tw)
 
     // Update Live Mode tree + timeline
     if (liveModeWindow)
-        liveModeWindow->setTrackState(tw, "playing");
+        liveModeWindow->setTrackState(tw->cueId(), "playing");
 
     updateLiveTimeline();
+    startMasterMeter();
+}
+
+/* ============================================================
+ * MASTER METER – display rate while anything is sounding
+ * ============================================================ */
+void MainWindow::startMasterMeter()
+{
+    FrameTicker *ticker = FrameTicker::instance();
+    masterMeterRestMs = 0;
+    if (ticker->isSubscribed(masterMeterTickId))
+        return;
+
+    // Always: the Live window may cover this one
+    masterMeterTickId = ticker->subscribe(this, [this](qint64 now, qint64 delta) {
+        const LevelMeter::Reading r = AudioEngine::instance()->masterMeter().reading();
+        masterMeter->setReading(r, now);
+        if (liveModeWindow && liveModeWindow->isVisible())
+            liveModeWindow->setMasterLevel(r, now);
+
+        // Quiet for a second (and the first buffers have had time
+        // to arrive): stop ticking until the next cue starts
+        masterMeterRestMs = masterMeter->atRest() ? masterMeterRestMs + delta : 0;
+        if (masterMeterRestMs > 1000)
+        {
+            FrameTicker::instance()->unsubscribe(masterMeterTickId);
+            masterMeterTickId = 0;
+        }
+    }, FrameTicker::Always);
+}
+
+/* ============================================================
+ * MASTER BUS – limiter settings, engine report
+ * ============================================================ */
+void MainWindow::applyLimiterSettings()
+{
+    AudioEngine::instance()->setLimiter(
+        float(settings.value("limiter/ceilingDb", BrickwallLimiter::kDefaultCeilingDb).toDouble()),
+        float(settings.value("limiter/releaseMs", BrickwallLimiter::kDefaultReleaseMs).toDouble()));
+}
+
+void MainWindow::applyDuckingSettings()
+{
+    AudioEngine::instance()->setDucking(
+        float(settings.value("ducking/attackMs", kDefaultDuckAttackMs).toDouble()),
+        float(settings.value("ducking/releaseMs", kDefaultDuckReleaseMs).toDouble()),
+        float(settings.value("ducking/depthDb", kDefaultDuckDepthDb).toDouble()),
+        float(settings.value("ducking/thresholdDb", kDefaultDuckThresholdDb).toDouble()));
+}
+
+void MainWindow::editDuckingSettings()
+{
+    QDialog dialog(this);
+    dialog.setWindowTitle(tr("Ducking"));
+    auto *form = new QFormLayout(&dialog);
+
+    const auto spin = [&dialog](double min, double max, int decimals, const QString &suffix, double value) {
+        auto *box = new QDoubleSpinBox(&dialog);
+        box->setRange(min, max);
+        box->setDecimals(decimals);
+        box->setSuffix(suffix);
+        box->setValue(value);
+        return box;
+    };
+    QDoubleSpinBox *threshold = spin(-70.0, 0.0, 1, tr(" dBFS"),
+        settings.value("ducking/thresholdDb", kDefaultDuckThresholdDb).toDouble());
+    QDoubleSpinBox *depth = spin(-60.0, 0.0, 1, tr(" dB"),
+        settings.value("ducking/depthDb", kDefaultDuckDepthDb).toDouble());
+    QDoubleSpinBox *attack = spin(1.0, 2000.0, 0, tr(" ms"),
+        settings.value("ducking/attackMs", kDefaultDuckAttackMs).toDouble());
+    QDoubleSpinBox *release = spin(10.0, 10000.0, 0, tr(" ms"),
+        settings.value("ducking/releaseMs", kDefaultDuckReleaseMs).toDouble());
+
+    form->addRow(tr("Ducker level above:"), threshold);
+    form->addRow(tr("Lowers ducked cues by:"), depth);
+    form->addRow(tr("Attack:"), attack);
+    form->addRow(tr("Release:"), release);
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    form->addRow(buttons);
+
+    if (dialog.exec() != QDialog::Accepted)
+        return;
+
+    settings.setValue("ducking/thresholdDb", threshold->value());
+    settings.setValue("ducking/depthDb", depth->value());
+    settings.setValue("ducking/attackMs", attack->value());
+    settings.setValue("ducking/releaseMs", release->value());
+    applyDuckingSettings();
+}
+
+/* ============================================================
+ * OUTPUT ROUTING – buses to devices, kept in the settings
+ * ============================================================ */
+void MainWindow::loadRouting()
+{
+    AudioEngine::Routing routing;
+    const int count = settings.beginReadArray("routing/buses");
+    for (int i = 0; i < count; ++i)
+    {
+        settings.setArrayIndex(i);
+        AudioEngine::BusConfig bus;
+        bus.name = settings.value("name").toString();
+        bus.deviceId = settings.value("device").toByteArray();
+        bus.firstChannel = settings.value("firstChannel", 0).toInt();
+        bus.gainDb = float(settings.value("gainDb", 0.0).toDouble());
+        bus.muted = settings.value("muted", false).toBool();
+        routing.append(bus);
+    }
+    settings.endArray();
+
+    // Nothing saved: the engine already plays Main on the default
+    // device, no need to reopen it
+    if (!routing.isEmpty())
+        AudioEngine::instance()->setRouting(routing);
+}
+
+void MainWindow::saveRouting()
+{
+    const AudioEngine::Routing &routing = AudioEngine::instance()->routing();
+    settings.beginWriteArray("routing/buses", routing.size());
+    for (int i = 0; i < routing.size(); ++i)
+    {
+        settings.setArrayIndex(i);
+        settings.setValue("name", routing[i].name);
+        settings.setValue("device", routing[i].deviceId);
+        settings.setValue("firstChannel", routing[i].firstChannel);
+        settings.setValue("gainDb", routing[i].gainDb);
+        settings.setValue("muted", routing[i].muted);
+    }
+    settings.endArray();
+}
+
+void MainWindow::editRouting()
+{
+    RoutingDialog dialog(this);
+    if (dialog.exec() != QDialog::Accepted)
+        return;
+    AudioEngine::instance()->setRouting(dialog.routing());
+    saveRouting();
+}
+
+void MainWindow::showAudioEngineStatus()
+{
+    const AudioEngine::Stats st = AudioEngine::instance()->stats();
+    if (!st.running)
+    {
+        QMessageBox::warning(this, tr("Audio Engine"),
+                             tr("No audio output is running. Check the devices in Settings > Output Routing."));
+        return;
+    }
+
+    const QString text = tr(
+        "Engine: %1 Hz, %2\n"
+        "Latency: up to %3 ms (primary sink buffer %4 ms, voice prime %5 ms, limiter look-ahead %6 ms,"
+        " followers add their ring)\n"
+        "PANIC to silence: at most %14 ms on any output\n"
+        "Render load: %7 % average, %8 % peak\n"
+        "Limiter: ceiling %9 dBFS, release %10 ms, gain reduction %11 dB\n"
+        "Voices: %12, underruns: %13, voice audio dropped: %15 ms, voice re-primes: %16")
+        .arg(st.sampleRate).arg(st.sampleFormat)
+        .arg(st.latencyMs, 0, 'f', 1).arg(st.bufferMs, 0, 'f', 1)
+        .arg(st.primeMs, 0, 'f', 0).arg(st.limiterMs, 0, 'f', 1)
+        .arg(st.cpuPercent, 0, 'f', 2).arg(st.cpuPeakPercent, 0, 'f', 2)
+        .arg(settings.value("limiter/ceilingDb", BrickwallLimiter::kDefaultCeilingDb).toDouble(), 0, 'f', 1)
+        .arg(settings.value("limiter/releaseMs", BrickwallLimiter::kDefaultReleaseMs).toInt())
+        .arg(st.gainReductionDb, 0, 'f', 1)
+        .arg(st.voices).arg(st.underruns)
+        .arg(st.panicMs, 0, 'f', 1)
+        .arg(st.droppedMs, 0, 'f', 1).arg(st.reprimes);
+    QMessageBox::information(this, tr("Audio Engine"),
+                             text + tr("\n\nOutputs:\n") + st.outputs.join('\n'));
 }
 
 void MainWindow::onTrackStatePaused(TrackWidget *tw)
 {
     // Paused track → orange in fragment tree
-    QTreeWidgetItem *item = trackTreeItems.value(tw, nullptr);
+    QTreeWidgetItem *item = trackTreeItems.value(tw->cueId(), nullptr);
     if (!item) return;
 
     item->setForeground(0, QBrush(QColor("#ff9800"))); // orange
 
     if (liveModeWindow)
-        liveModeWindow->setTrackState(tw, "paused");
+        liveModeWindow->setTrackState(tw->cueId(), "paused");
 
     updateLiveTimeline();
 }
@@ -1623,13 +2190,13 @@ void MainWindow::onTrackStatePaused(TrackWidget *tw)
 void MainWindow::onTrackStateStopped(TrackWidget *tw)
 {
     // Stopped → default color in fragment tree
-    QTreeWidgetItem *item = trackTreeItems.value(tw, nullptr);
+    QTreeWidgetItem *item = trackTreeItems.value(tw->cueId(), nullptr);
     if (!item) return;
 
     item->setForeground(0, QBrush(QColor("#dddddd")));
 
     if (liveModeWindow)
-        liveModeWindow->setTrackState(tw, "stopped");
+        liveModeWindow->setTrackState(tw->cueId(), "stopped");
 
     updateLiveTimeline();
 }
@@ -1659,8 +2226,8 @@ void MainWindow::onUiTick()
         );
     }
 
-    // Keep Live Mode timeline ticking
-    updateLiveTimeline();
+    // Live Mode timeline has its own (visible-only) subscription,
+    // see ensureLiveModeWindow().
 }
 
 void MainWindow::onTimerStartStop()
@@ -1691,8 +2258,9 @@ void MainWindow::onSaveQueue()
 	QString saveJson = QFileDialog::getSaveFileName(
 		this,
 		"Save Queue",
-		lastOpenedDir + "/set.acp.json",
-		"AudioCuePro Sets (*.acp.json)"
+		lastOpenedDir + "/set.acps",
+		"AudioCuePro Shows (*.acps);;AudioCuePro Show Packages (*.acppkg);;"
+		"AudioCuePro Sets, JSON (*.acp.json)"
 	);
 
 	if (!saveJson.isEmpty()) {
@@ -1704,6 +2272,13 @@ void MainWindow::onSaveQueue()
     if (saveJson.isEmpty())
         return;
 
+    // A package carries its own audio: no media store involved
+    if (ShowPackage::isPackagePath(saveJson))
+    {
+        saveShowPackage(saveJson);
+        return;
+    }
+
     QString audioFolder = promptForAudioCopyFolder();
     if (audioFolder.isEmpty())
         return;
@@ -1716,62 +2291,738 @@ void MainWindow::onSaveQueue()
  * ============================================================ */
 QString MainWindow::promptForAudioCopyFolder()
 {
+    // Default to the last store, so shows end up sharing one
+    QString start = settings.value("mediaStore/lastRoot").toString();
+    if (start.isEmpty())
+        start = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+
     QString dir = QFileDialog::getExistingDirectory(
         this,
-        "Select Folder to Store Audio Copies",
-        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+        "Select Media Store Folder",
+        start
     );
 
     return dir;
 }
 
 /* ============================================================
- * WRITE QUEUE JSON FILE (with scenes)
+ * VERIFY MEDIA STORE (re-hash every object in the background)
  * ============================================================ */
-void MainWindow::saveQueueToJson(const QString &savePath, const QString &audioFolder)
+void MainWindow::verifyMediaStore()
 {
-    QJsonArray scenesArr;
+    // A show opened from a package has no store behind it
+    QString root = lastAudioFolder;
+    if (root.isEmpty() || ShowPackage::isPackagePath(root))
+        root = promptForAudioCopyFolder();
+    if (root.isEmpty())
+        return;
 
-    for (const Scene &s : scenes)
+    auto *progress = new QProgressDialog("Verifying media store…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Verify Media Store");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    auto *watcher = new QFutureWatcher<MediaStore::VerifyResult>(this);
+    connect(watcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(watcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            watcher, &QFutureWatcherBase::cancel);
+
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, progress, root]()
     {
-        QJsonObject sobj;
-        sobj["name"] = s.name;
-
-        QJsonArray tracksArr;
-        for (TrackWidget *tw : s.tracks)
-            tracksArr.append(tw->toJson(audioFolder));
+        watcher->deleteLater();
+        progress->deleteLater();
 
-        sobj["tracks"] = tracksArr;
-        scenesArr.append(sobj);
-    }
+        if (watcher->future().resultCount() == 0)
+            return;
 
-    QJsonObject root;
-    root["audioFolder"] = audioFolder;
-    root["scenes"] = scenesArr;
+        const MediaStore::VerifyResult result = watcher->future().result();
+        if (result.canceled)
+            return;
 
-    QFile f(savePath);
-    if (!f.open(QIODevice::WriteOnly))
-    {
-        QMessageBox::warning(this, "Error", "Cannot write to file.");
-        return;
-    }
+        if (result.corrupt.isEmpty())
+        {
+            QMessageBox::information(this, "Verify Media Store",
+                                     QString("%1 files checked in %2.\nNo problems found.")
+                                         .arg(result.checked).arg(root));
+        }
+        else
+        {
+            QMessageBox::warning(this, "Verify Media Store",
+                                 QString("%1 of %2 files no longer match their content hash:\n\n%3")
+                                     .arg(result.corrupt.size()).arg(result.checked)
+                                     .arg(result.corrupt.join('\n')));
+        }
+    });
 
-    f.write(QJsonDocument(root).toJson());
-    f.close();
+    watcher->setFuture(QtConcurrent::run(&MediaStore::verify, root));
 }
 
 /* ============================================================
- * CLEAR ALL SCENES (used by load)
+ * RELINK MISSING MEDIA (indexed scan of user-chosen folders)
  * ============================================================ */
-void MainWindow::clearAllScenes()
+void MainWindow::relinkMissingMedia()
 {
-    stopCurrentTrackImmediately();
-
-    for (Scene &s : scenes)
+    if (showLoadWatcher)
     {
-        for (TrackWidget *tw : s.tracks)
-            tw->deleteLater();
-        s.tracks.clear();
+        QMessageBox::information(this, "Relink", "Wait for the show to finish loading.");
+        return;
+    }
+
+    QVector<MediaRelink::Wanted> wanted;
+    for (const Scene &s : scenes)
+    {
+        for (TrackWidget *tw : s.tracks)
+        {
+            if (tw->isSpotify())
+                continue;
+            if (MediaProbe::exists(tw->audioPath()) && tw->mediaState() != TrackWidget::MediaState::Failed)
+                continue;
+
+            MediaRelink::Wanted w;
+            w.cueId = tw->cueId();
+            w.fileName = tw->fileName();
+            w.size = tw->recordedSize();
+            // Store objects are named by their content hash
+            if (MediaStore::isObjectPath(lastAudioFolder, tw->audioPath())
+                || ShowPackage::isEntryPath(tw->audioPath()))
+                w.hash = QFileInfo(tw->audioPath()).completeBaseName();
+            wanted.append(w);
+        }
+    }
+
+    if (wanted.isEmpty())
+    {
+        QMessageBox::information(this, "Relink", "No cue is missing its audio.");
+        return;
+    }
+
+    QStringList roots;
+    QString start = QStandardPaths::writableLocation(QStandardPaths::MusicLocation);
+    for (;;)
+    {
+        const QString dir = QFileDialog::getExistingDirectory(
+            this, QString("Search for %1 missing file(s) in").arg(wanted.size()), start);
+        if (dir.isEmpty())
+            break;
+        roots << dir;
+        start = dir;
+
+        if (QMessageBox::question(this, "Relink", "Search another folder as well?")
+            != QMessageBox::Yes)
+            break;
+    }
+    if (roots.isEmpty())
+        return;
+
+    auto *progress = new QProgressDialog("Scanning folders…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Relink Missing Media");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    auto *watcher = new QFutureWatcher<MediaRelink::Result>(this);
+    connect(watcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(watcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            watcher, &QFutureWatcherBase::cancel);
+
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, progress]()
+    {
+        watcher->deleteLater();
+        progress->deleteLater();
+
+        if (watcher->future().resultCount() == 0)
+            return;
+
+        const MediaRelink::Result result = watcher->future().result();
+        if (result.canceled)
+            return;
+
+        // Cues may have been deleted while the scan ran
+        int relinked = 0;
+        for (auto it = result.found.cbegin(); it != result.found.cend(); ++it)
+        {
+            if (TrackWidget *tw = cueIndex.find(it.key()))
+            {
+                tw->relink(it.value());
+                markJournalCue(tw);
+                ++relinked;
+            }
+        }
+
+        QString text = QString("%1 cue(s) relinked (%2 files scanned).")
+                           .arg(relinked).arg(result.scannedFiles);
+        if (!result.byHash.isEmpty())
+            text += QString("\n%1 of them were found under another name by their content.")
+                        .arg(result.byHash.size());
+        if (!result.missing.isEmpty())
+            text += QString("\n%1 cue(s) are still missing their audio.").arg(result.missing.size());
+
+        QMessageBox::information(this, "Relink Missing Media", text);
+    });
+
+    watcher->setFuture(QtConcurrent::run(&MediaRelink::resolve, wanted, roots));
+}
+
+/* ============================================================
+ * LOUDNESS – background R128 measurement + normalisation
+ * ============================================================ */
+void MainWindow::applyLoudnessNormalization(TrackWidget *tw)
+{
+    if (tw && !tw->isSpotify())
+        tw->setNormalization(settings.value("playback/normalize", false).toBool(),
+                             settings.value("playback/targetLufs", kDefaultTargetLufs).toDouble());
+}
+
+void MainWindow::analyzeLoudness(bool quiet)
+{
+    if (loudnessWatcher)
+    {
+        if (!quiet)
+            QMessageBox::information(this, "Analyze Loudness", "Loudness is already being measured.");
+        return;
+    }
+
+    // Cues with audio and no measurement yet; a file shared by
+    // several cues is decoded once
+    loudnessPaths.clear();
+    loudnessCues.clear();
+    loudnessFailed = 0;
+    for (const Scene &s : scenes)
+    {
+        for (TrackWidget *tw : s.tracks)
+        {
+            if (!tw || tw->isSpotify() || tw->loudness().valid
+                || tw->mediaState() == TrackWidget::MediaState::Failed)
+                continue;
+            if (!loudnessCues.contains(tw->audioPath()))
+                loudnessPaths << tw->audioPath();
+            loudnessCues[tw->audioPath()].append(tw->cueId());
+        }
+    }
+
+    if (loudnessPaths.isEmpty())
+    {
+        if (!quiet)
+            QMessageBox::information(this, "Analyze Loudness", "Every cue has been measured.");
+        return;
+    }
+
+    auto *progress = new QProgressDialog("Measuring loudness…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Analyze Loudness");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    loudnessWatcher = new QFutureWatcher<AudioAnalysis::Result>(this);
+    connect(loudnessWatcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(loudnessWatcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            loudnessWatcher, &QFutureWatcherBase::cancel);
+
+    // Applied as each file finishes; a cue deleted meanwhile is
+    // simply not found
+    connect(loudnessWatcher, &QFutureWatcherBase::resultReadyAt, this, [this](int i)
+    {
+        const AudioAnalysis::Result r = loudnessWatcher->resultAt(i);
+        if (!r.ok || !r.loudness.valid)
+        {
+            ++loudnessFailed;
+            return;
+        }
+        for (quint64 id : loudnessCues.value(loudnessPaths.value(i)))
+            if (TrackWidget *tw = cueIndex.find(id))
+                tw->setLoudness(r.loudness);
+    });
+
+    connect(loudnessWatcher, &QFutureWatcherBase::finished, this, [this, progress, quiet]()
+    {
+        const int measured = loudnessWatcher->future().resultCount() - loudnessFailed;
+        loudnessWatcher->deleteLater();
+        loudnessWatcher = nullptr;
+        progress->deleteLater();
+
+        if (loudnessFailed > 0 || !quiet)
+        {
+            QString text = QString("%1 file(s) measured.").arg(measured);
+            if (loudnessFailed > 0)
+                text += QString("\n%1 file(s) could not be decoded or are silent;"
+                                " they play at their own gain.").arg(loudnessFailed);
+            QMessageBox::information(this, "Analyze Loudness", text);
+        }
+    });
+
+    loudnessWatcher->setFuture(QtConcurrent::run(&AudioAnalysis::analyzeFiles, loudnessPaths));
+}
+
+/* ============================================================
+ * RENDER SHOW – offline mixdown to WAV / FLAC
+ * ============================================================ */
+void MainWindow::renderShowToFile()
+{
+    if (renderWatcher)
+    {
+        QMessageBox::information(this, "Render Show", "The show is already being rendered.");
+        return;
+    }
+    if (showLoadWatcher)
+    {
+        QMessageBox::information(this, "Render Show", "Wait for the show to finish loading.");
+        return;
+    }
+
+    const QString path = QFileDialog::getSaveFileName(
+        this, "Render Show to File", lastOpenedDir + "/show.wav",
+        "WAV, 24-bit (*.wav);;FLAC, 24-bit (*.flac)");
+    if (path.isEmpty())
+        return;
+
+    // The show as it is on screen, edits included
+    QVector<ShowRender::Scene> snapshot;
+    for (const Scene &s : scenes)
+    {
+        ShowRender::Scene rs;
+        rs.name = s.name;
+        for (TrackWidget *tw : s.tracks)
+        {
+            QJsonObject cue = tw->toJson();
+            if (!tw->isSpotify())
+                cue["path"] = tw->audioPath();
+            rs.cues.append(cue);
+        }
+        snapshot.append(rs);
+    }
+
+    ShowRender::Options options;
+    options.sampleRate = AudioEngine::instance()->sampleRate();
+    options.normalize = settings.value("playback/normalize", false).toBool();
+    options.targetLufs = settings.value("playback/targetLufs", kDefaultTargetLufs).toDouble();
+    options.limiterCeilingDb =
+        float(settings.value("limiter/ceilingDb", BrickwallLimiter::kDefaultCeilingDb).toDouble());
+    options.limiterReleaseMs =
+        float(settings.value("limiter/releaseMs", BrickwallLimiter::kDefaultReleaseMs).toDouble());
+
+    auto *progress = new QProgressDialog("Rendering the show…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Render Show");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    renderWatcher = new QFutureWatcher<ShowRender::Result>(this);
+    connect(renderWatcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(renderWatcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            renderWatcher, &QFutureWatcherBase::cancel);
+
+    connect(renderWatcher, &QFutureWatcherBase::finished, this, [this, progress, path]()
+    {
+        const QFuture<ShowRender::Result> future = renderWatcher->future();
+        renderWatcher->deleteLater();
+        renderWatcher = nullptr;
+        progress->deleteLater();
+        if (future.resultCount() == 0)
+            return;                     // canceled
+
+        const ShowRender::Result r = future.result();
+        if (!r.ok)
+        {
+            QMessageBox::warning(this, "Render Show", "The show could not be rendered:\n" + r.error);
+            return;
+        }
+
+        const double seconds = double(r.frames) / AudioEngine::instance()->sampleRate();
+        QString text = QString("%1 cue(s), %2 of audio, rendered in %3 s.\n%4")
+                           .arg(r.cues)
+                           .arg(QTime(0, 0).addSecs(int(seconds)).toString("H:mm:ss"))
+                           .arg(r.renderMs / 1000.0, 0, 'f', 1)
+                           .arg(QDir::toNativeSeparators(path));
+        if (!r.warnings.isEmpty())
+            text += "\n\nLeft out or changed:\n" + r.warnings.join('\n');
+        QMessageBox::information(this, "Render Show", text);
+    });
+
+    renderWatcher->setFuture(QtConcurrent::run(&ShowRender::render, snapshot, path, options));
+}
+
+/* ============================================================
+ * WRITE SHOW FILE (with scenes; binary .acps or JSON)
+ * ============================================================ */
+
+void MainWindow::saveQueueToJson(const QString &savePath, const QString &audioFolder)
+{
+    if (mediaStoreWatcher || showWriteWatcher)
+    {
+        QMessageBox::information(this, "Save", "A save is already in progress.");
+        return;
+    }
+
+    // A show still loading would be saved with scenes missing
+    if (showLoadWatcher)
+    {
+        QMessageBox::information(this, "Save", "Wait for the show to finish loading.");
+        return;
+    }
+
+    // Snapshot the cue settings now; the show may keep changing
+    // while the media store ingest and the write run in the background.
+    struct SavedScene {
+        QString name;
+        QVector<QJsonObject> tracks;
+        QStringList sources;    // audio path per track ("" = Spotify)
+    };
+    QVector<SavedScene> snapshot;
+    QStringList sources;
+
+    for (const Scene &s : scenes)
+    {
+        SavedScene ss;
+        ss.name = s.name;
+        for (TrackWidget *tw : s.tracks)
+        {
+            ss.tracks.append(tw->toJson());
+            const QString src = tw->isSpotify() ? QString() : tw->audioPath();
+            ss.sources.append(src);
+            if (!src.isEmpty() && !sources.contains(src))
+                sources.append(src);
+        }
+        snapshot.append(ss);
+    }
+
+    auto *progress = new QProgressDialog("Preparing audio files…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Saving");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    mediaStoreWatcher = new QFutureWatcher<MediaStore::IngestResult>(this);
+    connect(mediaStoreWatcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(mediaStoreWatcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            mediaStoreWatcher, &QFutureWatcherBase::cancel);
+
+    connect(mediaStoreWatcher, &QFutureWatcherBase::finished, this,
+            [this, progress, snapshot, savePath, audioFolder]()
+    {
+        const QFuture<MediaStore::IngestResult> future = mediaStoreWatcher->future();
+        mediaStoreWatcher->deleteLater();
+        mediaStoreWatcher = nullptr;
+
+        if (future.resultCount() == 0 || future.result().canceled)
+        {
+            progress->deleteLater();
+            QMessageBox::information(this, "Save", "Save canceled. The show file was not written.");
+            return;
+        }
+
+        const MediaStore::IngestResult result = future.result();
+
+        // The write itself cannot be interrupted halfway: QSaveFile
+        // either replaces the show or leaves the old one untouched
+        progress->setCancelButton(nullptr);
+        progress->setRange(0, 0);
+        progress->setLabelText("Writing show file…");
+
+        showWriteWatcher = new QFutureWatcher<ShowFile::SaveResult>(this);
+        connect(showWriteWatcher, &QFutureWatcherBase::finished, this,
+                [this, progress, result, audioFolder]()
+        {
+            const ShowFile::SaveResult written = showWriteWatcher->result();
+            showWriteWatcher->deleteLater();
+            showWriteWatcher = nullptr;
+            progress->deleteLater();
+
+            if (!written.ok)
+            {
+                QMessageBox::warning(this, "Error",
+                                     "Cannot write to file. The previous version was kept.\n\n"
+                                     + written.error);
+                return;
+            }
+
+            lastAudioFolder = audioFolder;
+            settings.setValue("mediaStore/lastRoot", audioFolder);
+
+            if (!result.errors.isEmpty())
+            {
+                QMessageBox::warning(this, "Save",
+                                     "The show was saved, but some audio files could not be stored:\n\n"
+                                     + result.errors.join('\n'));
+            }
+        });
+
+        showWriteWatcher->setFuture(QtConcurrent::run(
+            [snapshot, objectNames = result.objectNames, savePath, audioFolder]()
+        {
+
+            QJsonArray scenesArr;
+            for (const SavedScene &ss : snapshot)
+            {
+                QJsonArray tracksArr;
+                for (int i = 0; i < ss.tracks.size(); ++i)
+                {
+                    QJsonObject obj = ss.tracks[i];
+                    const QString object = objectNames.value(ss.sources[i]);
+                    if (!object.isEmpty())
+                    {
+                        obj["media"] = object;
+                        // Lets a relink narrow renamed files down by size
+                        obj["size"] = double(QFileInfo(MediaStore::objectPath(audioFolder, object)).size());
+                    }
+                    tracksArr.append(obj);
+                }
+
+                QJsonObject sobj;
+                sobj["name"] = ss.name;
+                sobj["tracks"] = tracksArr;
+                scenesArr.append(sobj);
+            }
+
+            // audioFolder is the media store root; cues name their audio
+            // by content ("media"), so several shows can share one store
+            QJsonObject root;
+            root["audioFolder"] = audioFolder;
+            root["mediaStore"] = 1;
+            root["scenes"] = scenesArr;
+
+            return ShowFile::save(savePath, root);
+        }));
+    });
+
+    mediaStoreWatcher->setFuture(QtConcurrent::run(&MediaStore::ingest, sources, audioFolder));
+}
+
+/* ============================================================
+ * WRITE SHOW PACKAGE (.acppkg: show, audio and peaks in one file)
+ * ============================================================ */
+void MainWindow::saveShowPackage(const QString &savePath)
+{
+    if (mediaStoreWatcher || showWriteWatcher)
+    {
+        QMessageBox::information(this, "Save", "A save is already in progress.");
+        return;
+    }
+
+    if (showLoadWatcher)
+    {
+        QMessageBox::information(this, "Save", "Wait for the show to finish loading.");
+        return;
+    }
+
+    // Same snapshot as a normal save, plus the peaks already drawn,
+    // so the package opens without decoding anything
+    struct PackedScene {
+        QString name;
+        QVector<QJsonObject> tracks;
+        QStringList sources;    // audio path per track ("" = Spotify)
+    };
+    QVector<PackedScene> snapshot;
+    QStringList sources;
+    QHash<QString, WaveformPeaksPtr> peaks;
+
+    for (const Scene &s : scenes)
+    {
+        PackedScene ps;
+        ps.name = s.name;
+        for (TrackWidget *tw : s.tracks)
+        {
+            ps.tracks.append(tw->toJson());
+            const QString src = tw->isSpotify() ? QString() : tw->audioPath();
+            ps.sources.append(src);
+            if (!src.isEmpty() && !sources.contains(src))
+            {
+                sources.append(src);
+                WaveformPeaksPtr p = tw->peakData();
+                // Envelope decoded for drawing, loudness measured
+                // separately: cache them together
+                if (p && !p->loudness.valid && tw->loudness().valid)
+                {
+                    auto withLoudness = QSharedPointer<WaveformPeaks>::create(*p);
+                    withLoudness->loudness = tw->loudness();
+                    p = withLoudness;
+                }
+                if (p)
+                    peaks.insert(src, p);
+            }
+        }
+        snapshot.append(ps);
+    }
+
+    auto *progress = new QProgressDialog("Packing audio files…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Saving Show Package");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    showWriteWatcher = new QFutureWatcher<ShowFile::SaveResult>(this);
+    connect(showWriteWatcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(showWriteWatcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            showWriteWatcher, &QFutureWatcherBase::cancel);
+
+    connect(showWriteWatcher, &QFutureWatcherBase::finished, this, [this, progress]()
+    {
+        const QFuture<ShowFile::SaveResult> future = showWriteWatcher->future();
+        showWriteWatcher->deleteLater();
+        showWriteWatcher = nullptr;
+        progress->deleteLater();
+
+        // Canceled: the unfinished package was discarded, the old one kept
+        if (future.resultCount() == 0)
+        {
+            QMessageBox::information(this, "Save", "Save canceled. The package was not written.");
+            return;
+        }
+
+        const ShowFile::SaveResult written = future.result();
+
+        if (!written.ok)
+        {
+            QMessageBox::warning(this, "Error",
+                                 "Cannot write the show package. The previous version was kept.\n\n"
+                                 + written.error);
+        }
+        else if (!written.error.isEmpty())
+        {
+            QMessageBox::warning(this, "Save",
+                                 "The package was saved, but some audio files could not be added:\n\n"
+                                 + written.error);
+        }
+    });
+
+    showWriteWatcher->setFuture(QtConcurrent::run(
+        [snapshot, sources, peaks, savePath](QPromise<ShowFile::SaveResult> &promise)
+    {
+        ShowFile::SaveResult result;
+        promise.setProgressRange(0, 1000);
+
+        QElapsedTimer clock;
+        clock.start();
+
+        QHash<QString, qint64> sizes;
+        qint64 totalBytes = 0;
+        for (const QString &src : sources)
+        {
+            const qint64 size = MediaProbe::probe(src).sizeBytes;
+            sizes.insert(src, size);
+            totalBytes += size;
+        }
+        totalBytes = qMax<qint64>(1, totalBytes);
+
+        qint64 doneBytes = 0;
+        int progress = 0;
+        auto advance = [&](qint64 n) {
+            doneBytes += n;
+            progress = int(qMin<qint64>(1000, doneBytes * 1000 / totalBytes));
+            promise.setProgressValue(progress);
+            return !promise.isCanceled();
+        };
+
+        ShowPackage::Writer writer(savePath);
+        if (!writer.open())
+        {
+            result.error = writer.errorString();
+            promise.addResult(result);
+            return;
+        }
+
+        // Audio: copied in and named by content in the same pass
+        QHash<QString, QString> objectNames;
+        QStringList errors;
+        for (const QString &src : sources)
+        {
+            promise.setProgressValueAndText(progress,
+                                            QObject::tr("Packing %1").arg(QFileInfo(src).fileName()));
+
+            const QString object = writer.addAudio(src, advance);
+            if (promise.isCanceled())
+                return;   // the writer discards the partial package
+            if (object.isEmpty())
+            {
+                errors << writer.errorString();
+                continue;
+            }
+            objectNames.insert(src, object);
+
+            const WaveformPeaksPtr p = peaks.value(src);
+            if (p && !p->isEmpty())
+                writer.addData(QStringLiteral("peaks/") + object, ShowPackage::Peaks, p->toBytes());
+        }
+
+        // The show itself; "media" names resolve inside the package
+        QJsonArray scenesArr;
+        for (const PackedScene &ps : snapshot)
+        {
+            QJsonArray tracksArr;
+            for (int i = 0; i < ps.tracks.size(); ++i)
+            {
+                QJsonObject obj = ps.tracks[i];
+                const QString object = objectNames.value(ps.sources[i]);
+                if (!object.isEmpty())
+                {
+                    obj["media"] = object;
+                    obj["size"] = double(sizes.value(ps.sources[i]));
+                }
+                tracksArr.append(obj);
+            }
+
+            QJsonObject sobj;
+            sobj["name"] = ps.name;
+            sobj["tracks"] = tracksArr;
+            scenesArr.append(sobj);
+        }
+
+        QJsonObject root;
+        root["audioFolder"] = QString();
+        root["mediaStore"] = 1;
+        root["scenes"] = scenesArr;
+        writer.addData(ShowPackage::kShowEntry, ShowPackage::Show, ShowFile::encode(root));
+
+        promise.setProgressValueAndText(1000, QObject::tr("Writing package…"));
+        result.encodeMs = clock.restart();
+        result.ok = writer.commit();
+        result.commitMs = clock.elapsed();
+        result.bytes = QFileInfo(savePath).size();
+        result.error = result.ok ? errors.join('\n') : writer.errorString();
+        promise.addResult(result);
+    }));
+}
+
+/* ============================================================
+ * CLEAR ALL SCENES (used by load)
+ * ============================================================ */
+void MainWindow::clearAllScenes()
+{
+    stopCurrentTrackImmediately();
+
+    // Whatever the last load was waiting for is gone now
+    showReadyPending = false;
+    showReadyWaiting.clear();
+
+    for (Scene &s : scenes)
+    {
+        for (TrackWidget *tw : s.tracks)
+            releaseTrack(tw);
+        s.tracks.clear();
     }
 
     scenes.clear();
@@ -1790,7 +3041,7 @@ void MainWindow::onLoadQueue()
 		this,
 		"Load Queue",
 		lastOpenedDir,
-		"AudioCuePro Sets (*.acp.json)"
+		"AudioCuePro Shows (*.acps *.acppkg *.acp.json);;All Files (*)"
 	);
 
 	if (!loadJson.isEmpty()) {
@@ -1802,97 +3053,269 @@ void MainWindow::onLoadQueue()
     if (loadJson.isEmpty())
         return;
 
-    loadQueueFromJson(loadJson);
+    loadShow(loadJson);
 }
 
 /* ============================================================
- * READ QUEUE JSON + RECREATE TRACKWIDGETS (with scenes)
+ * LOAD SHOW – parse + probe on workers, cues built per scene
  * ============================================================ */
-void MainWindow::loadQueueFromJson(const QString &path)
+void MainWindow::loadShow(const QString &path)
 {
-    QFile f(path);
-    if (!f.open(QIODevice::ReadOnly))
+    if (showLoadWatcher)
     {
-        QMessageBox::warning(this, "Error", "Cannot read file.");
+        QMessageBox::information(this, "Load", "A show is already loading.");
         return;
     }
 
-    QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
-    f.close();
+    auto *progress = new QProgressDialog("Reading show…", "Cancel", 0, 1000, this);
+    progress->setWindowTitle("Loading");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    showLoadMissing.clear();
+
+    showLoadWatcher = new QFutureWatcher<ShowLoader::Scene>(this);
+    connect(showLoadWatcher, &QFutureWatcherBase::progressValueChanged,
+            progress, &QProgressDialog::setValue);
+    connect(showLoadWatcher, &QFutureWatcherBase::progressTextChanged,
+            progress, &QProgressDialog::setLabelText);
+    connect(progress, &QProgressDialog::canceled,
+            showLoadWatcher, &QFutureWatcherBase::cancel);
+
+    // Scenes arrive in show order; each one is put on screen as it comes
+    connect(showLoadWatcher, &QFutureWatcherBase::resultReadyAt, this, [this](int i) {
+        onShowSceneLoaded(showLoadWatcher->resultAt(i));
+    });
 
-    QJsonObject root = doc.object();
+    connect(showLoadWatcher, &QFutureWatcherBase::finished, this, [this, progress]()
+    {
+        const bool canceled = showLoadWatcher->isCanceled();
+        const int received = showLoadWatcher->future().resultCount();
+        showLoadWatcher->deleteLater();
+        showLoadWatcher = nullptr;
+        progress->deleteLater();
 
-    QString audioFolder = root["audioFolder"].toString();
-    if (audioFolder.isEmpty())
+        if (canceled && received > 0)
+        {
+            QMessageBox::information(this, "Load",
+                                     QString("Loading was canceled. Only the first %1 scene(s) were loaded.")
+                                         .arg(scenes.size()));
+        }
+
+        if (!showLoadMissing.isEmpty())
+        {
+            QMessageBox::warning(this, "Missing audio",
+                                 QString("%1 audio file(s) could not be found:\n\n%2\n\n"
+                                         "Use Settings > Relink Missing Media... to search for them.")
+                                     .arg(showLoadMissing.size())
+                                     .arg(showLoadMissing.mid(0, 20).join('\n')));
+        }
+    });
+
+    showLoadWatcher->setFuture(QtConcurrent::run(&ShowLoader::load, path));
+}
+
+void MainWindow::onShowSceneLoaded(const ShowLoader::Scene &loaded)
+{
+    if (!loaded.error.isEmpty())
     {
-        QMessageBox::warning(this, "Error", "Invalid set file (no audio folder).");
+        QMessageBox::warning(this, "Error", loaded.error);
         return;
     }
 
-    clearAllScenes();
+    // The current show stays until the new one has a first scene
+    if (loaded.index == 0)
+    {
+        clearAllScenes();
+        lastAudioFolder = loaded.audioFolder;
+    }
 
-    // New format with scenes
-    if (root.contains("scenes"))
+    Scene s;
+    s.name = loaded.name;
+    s.tracks.reserve(loaded.cues.size());
+    for (const ShowLoader::Cue &cue : loaded.cues)
     {
-        QJsonArray scenesArr = root["scenes"].toArray();
-        for (auto sv : scenesArr)
+        TrackWidget *tw = createTrackFromJson(cue.settings, loaded.audioFolder);
+        if (!tw->isSpotify())
         {
-            QJsonObject sobj = sv.toObject();
-            Scene s;
-            s.name = sobj["name"].toString("Scene");
+            tw->applyProbe(cue.probe);
+            if (!cue.probe.exists)
+                showLoadMissing << tw->displayName();
+        }
+        s.tracks.append(tw);
+    }
+    scenes.append(s);
 
-            QJsonArray tracksArr = sobj["tracks"].toArray();
-            for (auto tv : tracksArr)
-            {
-                QJsonObject tobj = tv.toObject();
-                TrackWidget *tw = new TrackWidget(tobj, audioFolder, this);
-                connectTrackSignals(tw);
-                tw->setMasterVolume(masterVolume);
-                if (tw->isSpotify())
-                    requestSpotifyMetadata(tw);
-                s.tracks.append(tw);
-            }
+    auto *item = new QListWidgetItem(s.name, sceneList);
+    item->setFlags(item->flags() | Qt::ItemIsEditable);
 
-            scenes.append(s);
-        }
+    if (loaded.index == 0)
+    {
+        currentSceneIndex = 0;
+        sceneList->setCurrentRow(0);
+        armShowReady(s.tracks);
     }
-    // Backwards compatibility: old format with a flat "tracks" array
-    else if (root.contains("tracks"))
+
+    rebuildTrackList();
+    updateSceneHighlighting();
+}
+
+TrackWidget *MainWindow::createTrackFromJson(const QJsonObject &obj, const QString &audioFolder)
+{
+    TrackWidget *tw = new TrackWidget(obj, audioFolder, this);
+    connectTrackSignals(tw);
+    tw->setMasterVolume(masterVolume);
+    if (tw->isSpotify())
+        requestSpotifyMetadata(tw);
+    return tw;
+}
+
+/* ============================================================
+ * SHOW READY – first scene fully armed
+ * ============================================================ */
+void MainWindow::armShowReady(const QVector<TrackWidget*> &cues)
+{
+    showReadyWaiting.clear();
+    for (TrackWidget *tw : cues)
     {
-        Scene s;
-        s.name = "Scene 1";
-        QJsonArray arr = root["tracks"].toArray();
-        for (auto v : arr)
-        {
-            QJsonObject obj = v.toObject();
-            TrackWidget *tw = new TrackWidget(obj, audioFolder, this);
-            connectTrackSignals(tw);
-            tw->setMasterVolume(masterVolume);
-            if (tw->isSpotify())
-                requestSpotifyMetadata(tw);
-            s.tracks.append(tw);
+        if (tw && tw->mediaState() == TrackWidget::MediaState::Loading)
+            showReadyWaiting.insert(tw->cueId());
+    }
+
+    showReadyPending = true;
+    checkShowReady();
+}
+
+void MainWindow::onTrackMediaStateChanged(TrackWidget *tw)
+{
+    if (!showReadyPending || tw->mediaState() == TrackWidget::MediaState::Loading)
+        return;
+
+    showReadyWaiting.remove(tw->cueId());
+    checkShowReady();
+}
+
+void MainWindow::checkShowReady()
+{
+    if (!showReadyPending || !showReadyWaiting.isEmpty())
+        return;
+
+    showReadyPending = false;
+    emit showReady();
+}
+
+/* ============================================================
+ * AUTOSAVE JOURNAL
+ * ============================================================ */
+QString MainWindow::autosaveDir() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/autosave");
+}
+
+void MainWindow::startJournal()
+{
+    const QString dir = autosaveDir();
+    QString recoveredPath;
+
+    if (ShowJournal::hasRecovery(dir))
+    {
+        QJsonObject root = ShowJournal::recover(dir);
+        // Never saved: cues carry their own paths, any folder will do
+        if (!root.isEmpty() && root["audioFolder"].toString().isEmpty())
+            root["audioFolder"] = dir;
+        if (!root.isEmpty()
+            && QMessageBox::question(this, "Recover Show",
+                                     "AudioCuePro did not shut down cleanly.\n"
+                                     "Restore the show as it was before?")
+                   == QMessageBox::Yes)
+        {
+            // Kept next to the journal until the next recovery
+            recoveredPath = QDir(dir).filePath(QStringLiteral("recovered.acps"));
+            if (!ShowFile::save(recoveredPath, root).ok)
+                recoveredPath.clear();
         }
-        scenes.append(s);
+        ShowJournal::discard(dir);
     }
 
-    // Rebuild scene list UI
-    sceneList->clear();
-    for (const Scene &s : scenes)
+    journal = new ShowJournal(dir, this);
+    markJournalLayout();
+
+    if (!recoveredPath.isEmpty())
+        loadShow(recoveredPath);
+}
+
+void MainWindow::markJournalCue(TrackWidget *tw)
+{
+    if (!tw)
+        return;
+    journalDirtyCues.insert(tw->cueId());
+    scheduleJournalFlush();
+}
+
+void MainWindow::markJournalLayout()
+{
+    journalLayoutDirty = true;
+    scheduleJournalFlush();
+}
+
+void MainWindow::scheduleJournalFlush()
+{
+    // Edits in a burst (dragging a fader) become one record per cue
+    if (journal && !journalTickId)
     {
-        auto *item = new QListWidgetItem(s.name, sceneList);
-        item->setFlags(item->flags() | Qt::ItemIsEditable);
+        journalTickId = FrameTicker::instance()->subscribe(this, [this](qint64, qint64) {
+            flushJournal();
+        }, FrameTicker::Always, 250);
     }
+}
 
-    if (scenes.isEmpty())
-        ensureAtLeastOneScene();
+void MainWindow::flushJournal()
+{
+    FrameTicker::instance()->unsubscribe(journalTickId);
+    journalTickId = 0;
 
-    currentSceneIndex = 0;
-    sceneList->setCurrentRow(0);
-    rebuildTrackList();
-    updateSceneHighlighting();
-    rebuildFragmentTree();
-    updateLiveSceneTree();   // NEW
-    updateLiveTimeline();
+    if (!journal)
+        return;
+
+    for (quint64 id : std::as_const(journalDirtyCues))
+    {
+        TrackWidget *tw = cueIndex.find(id);
+        if (!tw)
+            continue;
+
+        // Unsaved cues may not be in any store yet: keep the file path
+        QJsonObject obj = tw->toJson();
+        if (!tw->isSpotify())
+            obj["path"] = tw->audioPath();
+        journal->recordCue(obj);
+    }
+    journalDirtyCues.clear();
+
+    if (journalLayoutDirty)
+    {
+        QJsonArray scenesArr;
+        for (const Scene &s : scenes)
+        {
+            QJsonArray ids;
+            for (TrackWidget *tw : s.tracks)
+                if (tw)
+                    ids.append(QString::number(tw->cueId()));
+
+            QJsonObject sobj;
+            sobj["name"] = s.name;
+            sobj["cues"] = ids;
+            scenesArr.append(sobj);
+        }
+
+        QJsonObject layout;
+        layout["audioFolder"] = lastAudioFolder;
+        layout["scenes"] = scenesArr;
+        journal->recordLayout(layout);
+        journalLayoutDirty = false;
+    }
 }
 
 /* ============================================================
@@ -1960,6 +3383,7 @@ void MainWindow::onTrackAltNameEdited(TrackWidget *tw)
 
 bool MainWindow::handleHotkey(QKeyEvent *event)
 {
+    LatencyProbe::mark(LatencyProbe::Hotkey);
     if (!event)
         return false;
 
@@ -1984,8 +3408,9 @@ bool MainWindow::handleHotkey(QKeyEvent *event)
 
     return false;
 }
-void MainWindow::onLiveTrackActivated(TrackWidget *tw)
+void MainWindow::onLiveTrackActivated(quint64 cueId)
 {
+    TrackWidget *tw = cueIndex.find(cueId);
     if (!tw)
         return;
 
@@ -2056,10 +3481,11 @@ void MainWindow::onLiveTrackActivated(TrackWidget *tw)
     updateLiveSceneTree();
 }
 
-void MainWindow::onLiveCueSelectionChanged(TrackWidget *tw)
+void MainWindow::onLiveCueSelectionChanged(quint64 cueId)
 {
-    // nullptr means the user chose "Current cue" in the dropdown:
+    // 0 means the user chose "Current cue" in the dropdown:
     // clear any manual override.
+    TrackWidget *tw = cueIndex.find(cueId);
     if (!tw)
     {
         liveSelectedCue = nullptr;
@@ -2223,6 +3649,8 @@ void MainWindow::ensureLiveModeWindow()
             this, &MainWindow::onLivePauseRequested);
     connect(liveModeWindow, &LiveModeWindow::stopRequested,
             this, &MainWindow::onLiveStopRequested);
+    connect(liveModeWindow, &LiveModeWindow::panicPressed,
+            AudioEngine::instance(), &AudioEngine::panic);
     connect(liveModeWindow, &LiveModeWindow::panicRequested,
             this, &MainWindow::onPanicClicked);
     connect(liveModeWindow, &LiveModeWindow::sceneActivated,
@@ -2238,6 +3666,14 @@ void MainWindow::ensureLiveModeWindow()
             this, &MainWindow::onLiveCueSelectionChanged);
 	connect(liveModeWindow, &LiveModeWindow::masterVolumeChanged,
         this, &MainWindow::onMasterVolumeChanged);
+
+    // Keep the timeline card ticking while the Live window is shown;
+    // the ticker skips it automatically when the window is hidden.
+    liveTimelineTickId = FrameTicker::instance()->subscribe(
+        liveModeWindow, [this](qint64, qint64) {
+            updateLiveTimeline();
+        }, FrameTicker::WhenVisible, 100);
+
     updateLiveSceneTree();
     updateLiveTimeline();
 }
@@ -2268,8 +3704,6 @@ void MainWindow::onLiveExitRequested()
     if (!liveModeWindow)
         return;
 
-    // restore embedded TrackWidget from Live monitor back to main UI
-    liveModeWindow->clearMonitoringTrack();
     liveModeWindow->hide();
 }
 
@@ -2294,7 +3728,7 @@ void MainWindow::onLiveTreeOrderChanged()
         s.name = se.name;
         for (const auto &pair : se.tracks)
         {
-            TrackWidget *tw = pair.first;
+            TrackWidget *tw = cueIndex.find(pair.first);
             if (!tw)
                 continue;
             s.tracks.append(tw);
@@ -2363,16 +3797,14 @@ void MainWindow::updateLiveSceneTree()
         {
             if (!tw) continue;
 
-            QString label = tw->altName().trimmed();
-            if (label.isEmpty())
-                label = QFileInfo(tw->audioPath()).fileName();
+            QString label = tw->displayName();
 
             // NEW: append hotkey in brackets, same as fragment tree
             QString hk = tw->assignedKey().trimmed();
             if (!hk.isEmpty())
                 label += QStringLiteral(" (%1)").arg(hk.toUpper());
 
-            entry.tracks.append(qMakePair(tw, label));
+            entry.tracks.append(qMakePair(tw->cueId(), label));
         }
         entries.append(entry);
     }
@@ -2394,13 +3826,23 @@ void MainWindow::updateLiveTimeline()
     if (!liveModeWindow)
         return;
 
-    QString curTitle;
-    QString status;
-    QString bigTime;
-    QString smallTime;
-    QString nextTitle;
-    QString nextHotkey;
-    QString nextNotes;
+    // Build a small view state; LiveModeWindow diffs it against what is
+    // on screen, so an unchanged tick costs no setText at all.
+    LiveModeWindow::ViewState view;
+
+    // Fill the "next cue" fields from a track
+    auto fillNext = [this, &view](TrackWidget *next) {
+        if (!next)
+            return;
+
+        view.nextTitle = next->displayName();
+
+        QString hk = next->assignedKey().trimmed();
+        if (!hk.isEmpty())
+            view.nextHotkey = tr("Hotkey: %1").arg(hk);
+
+        view.nextNotes = next->notesText().trimmed();
+    };
 
     Scene &scene = currentScene();
     int n = scene.tracks.size();
@@ -2413,20 +3855,15 @@ void MainWindow::updateLiveTimeline()
     {
         TrackWidget *tw = scene.tracks[curIdx];
 
-	QString label = tw->altName().trimmed();
-	if (label.isEmpty())
-		label = QFileInfo(tw->audioPath()).fileName();
-
-	curTitle = label;
-
-	// Decide status based on actual playback state
-	if (tw->isPlaying())
-		status = tr("PLAYING");
-	else if (tw->isPaused())
-		status = tr("PAUSED");
-	else
-		status = tr("STOPPED");
+        view.currentTitle = tw->displayName();
 
+        // Decide status based on actual playback state
+        if (tw->isPlaying())
+            view.status = tr("PLAYING");
+        else if (tw->isPaused())
+            view.status = tr("PAUSED");
+        else
+            view.status = tr("STOPPED");
 
         double start = tw->startSeconds();
         double end   = tw->endSeconds();
@@ -2435,25 +3872,13 @@ void MainWindow::updateLiveTimeline()
         double inRegion = qBound(0.0, pos - start, total);
         double remaining = qMax(0.0, total - inRegion);
 
-        bigTime   = fmtTime(remaining);
+        view.bigTime = fmtTime(remaining);
         if (total > 0.0)
-            smallTime = tr("%1 / %2").arg(fmtTime(inRegion)).arg(fmtTime(total));
-        else
-            smallTime = QString();
+            view.smallTime = tr("%1 / %2").arg(fmtTime(inRegion)).arg(fmtTime(total));
 
         if (curIdx + 1 < n)
         {
-            TrackWidget *next = scene.tracks[curIdx + 1];
-            QString nl = next->altName().trimmed();
-            if (nl.isEmpty())
-                nl = QFileInfo(next->audioPath()).fileName();
-            nextTitle = nl;
-
-            QString hk = next->assignedKey().trimmed();
-            if (!hk.isEmpty())
-                nextHotkey = tr("Hotkey: %1").arg(hk);
-
-            nextNotes = next->notesText().trimmed();
+            fillNext(scene.tracks[curIdx + 1]);
             liveNextCueIndexHint = curIdx + 1;
         }
         else
@@ -2464,9 +3889,8 @@ void MainWindow::updateLiveTimeline()
     else
     {
         // No active cue
-        status = tr("READY");
-        bigTime = QStringLiteral("--:--");
-        smallTime.clear();
+        view.status = tr("READY");
+        view.bigTime = QStringLiteral("--:--");
 
         TrackWidget *selected = nullptr;
         if (liveSelectedCue && scene.tracks.contains(liveSelectedCue))
@@ -2476,12 +3900,8 @@ void MainWindow::updateLiveTimeline()
         {
             const int selIdx = scene.tracks.indexOf(selected);
 
-            QString label = selected->altName().trimmed();
-            if (label.isEmpty())
-                label = QFileInfo(selected->audioPath()).fileName();
-
             // Show the selected cue in the "Now playing" field (as READY)
-            curTitle = label;
+            view.currentTitle = selected->displayName();
 
             double start = selected->startSeconds();
             double end   = selected->endSeconds();
@@ -2493,61 +3913,28 @@ void MainWindow::updateLiveTimeline()
                 dur = qMax(0.0, selected->durationSeconds() - start);
 
             if (dur > 0.0)
-                smallTime = tr("from %1 for %2")
-                                .arg(fmtTime(start))
-                                .arg(fmtTime(dur));
+                view.smallTime = tr("from %1 for %2")
+                                     .arg(fmtTime(start))
+                                     .arg(fmtTime(dur));
 
             // "Next cue" is normally the one after the selected one in this scene
             const int nextIdx = (selIdx + 1 < n) ? selIdx + 1 : selIdx;
             liveNextCueIndexHint = nextIdx;
 
             if (n > 0)
-            {
-                TrackWidget *next = scene.tracks[nextIdx];
-                if (next)
-                {
-                    QString nl = next->altName().trimmed();
-                    if (nl.isEmpty())
-                        nl = QFileInfo(next->audioPath()).fileName();
-                    nextTitle = nl;
-
-                    QString hk = next->assignedKey().trimmed();
-                    if (!hk.isEmpty())
-                        nextHotkey = tr("Hotkey: %1").arg(hk);
-
-                    nextNotes = next->notesText().trimmed();
-                }
-            }
+                fillNext(scene.tracks[nextIdx]);
         }
         else
         {
             // No manual selection – keep previous behaviour: show hinted next (or first)
             int idx = (liveNextCueIndexHint >= 0 && liveNextCueIndexHint < n) ? liveNextCueIndexHint : 0;
             if (n > 0)
-            {
-                TrackWidget *next = scene.tracks[idx];
-                QString nl = next->altName().trimmed();
-                if (nl.isEmpty())
-                    nl = QFileInfo(next->audioPath()).fileName();
-
-                nextTitle = nl;
-
-                QString hk = next->assignedKey().trimmed();
-                if (!hk.isEmpty())
-                    nextHotkey = tr("Hotkey: %1").arg(hk);
-
-                nextNotes = next->notesText().trimmed();
-            }
+                fillNext(scene.tracks[idx]);
         }
     }
 
-
-    liveModeWindow->setCurrentCueDisplay(curTitle, status, bigTime, smallTime);
-	liveModeWindow->setNextCueDisplay(nextTitle, nextHotkey, nextNotes);
-
-	if (liveModeWindow)
-		liveModeWindow->showMonitoringForTrack(currentTrack);
-
+    view.monitorTrack = currentTrack;
+    liveModeWindow->applyViewState(view);
 }
 
 void MainWindow::onLiveGoRequested()
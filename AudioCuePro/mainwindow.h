@@ -4,6 +4,7 @@
 #include <QMainWindow>
 #include <QVector>
 #include <QScrollArea>
+#include <QStackedWidget>
 #include <QVBoxLayout>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -21,12 +22,24 @@
 #include "spotifyclient.h"
 #include "spotifyclient.h"
 #include "spotifyauthmanager.h"
+#include "cueindex.h"
+#include "cuetreesync.h"
+#include "mediastore.h"
+#include "showfile.h"
+#include "showloader.h"
+#include "mediarelink.h"
+#include "mediaimport.h"
+#include "showrender.h"
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <QSet>
 
 
 
 class QLabel;
 class QPushButton;
 class LiveModeWindow;
+class ShowJournal;
 
 
 #include "trackwidget.h"
@@ -44,6 +57,15 @@ public:
     // can trigger a tree → scene resync.
     void syncScenesFromFragmentTreePublic();
 
+    // Load a show as File > Load does; showReady() follows once
+    // its first scene is armed
+    void loadShow(const QString &path);
+
+signals:
+    // Every cue of the first scene of a freshly loaded show is armed
+    // (or known to be missing), so GO can start without a load stall
+    void showReady();
+
 protected:
     void closeEvent(QCloseEvent *event) override;
     void dragEnterEvent(QDragEnterEvent *event) override;
@@ -110,8 +132,8 @@ private slots:
     void onLiveSceneActivated(int index);
     void onLiveExitRequested();
 	void onLiveTreeOrderChanged();
-	void onLiveTrackActivated(TrackWidget *tw); // NEW
-    void onLiveCueSelectionChanged(TrackWidget *tw); // NEW
+	void onLiveTrackActivated(quint64 cueId); // NEW
+    void onLiveCueSelectionChanged(quint64 cueId); // NEW
 
     void onSpotifyPlaybackState(const QString &uri,
                                 qint64 positionMs,
@@ -142,15 +164,22 @@ private:
     QTreeWidget *fragmentTree = nullptr;
     SfxLibraryWidget *sfxLibrary = nullptr;
 
-    // Track ↔ tree item linking
-    QHash<TrackWidget*, QTreeWidgetItem*> trackTreeItems;
+    // Cue ID → cue, and cue ID → fragment tree row
+    CueIndex cueIndex;
+    CueTreeSync::ItemMap trackTreeItems;
 
     // Drop indicator line in the track list area
     QFrame *dropIndicator = nullptr;
 
-    // Right side widgets
-    QScrollArea *scrollArea = nullptr;
-    QVBoxLayout *trackListLayout = nullptr;
+    // Right side widgets: one prebuilt page per scene, index-aligned
+    // with `scenes`, so switching scenes only flips the stack.
+    struct ScenePage {
+        QScrollArea *scroll = nullptr;
+        QWidget *container = nullptr;
+        QVBoxLayout *layout = nullptr;
+    };
+    QStackedWidget *sceneStack = nullptr;
+    QVector<ScenePage> scenePages;
     QWidget *emptyState = nullptr;
 
     // Scene system
@@ -159,24 +188,62 @@ private:
 
     // Volume
     QSlider *masterSlider = nullptr;
+    MeterBar *masterMeter = nullptr;    // master bus level (all playing cues)
+    int masterMeterTickId = 0;          // FrameTicker subscription while it moves
+    qint64 masterMeterRestMs = 0;
     double masterVolume = 1.0;
 
     // Playback control
     TrackWidget *currentTrack = nullptr;
     TrackWidget *pendingTrackAfterFade = nullptr;
-    QTimer *spotifyPollTimer = nullptr;
+    int spotifyPollTickId = 0;          // FrameTicker subscription (1 s)
     int liveNextCueIndexHint = 0;
     TrackWidget *liveSelectedCue = nullptr;     // NEW: cue chosen in Live Mode dropdown	
 	TrackWidget *liveLastStoppedTrack = nullptr; // NEW: cue stopped via Live Stop
     // Loading support
     QString lastAudioFolder;
+    // Background show load in progress (null when idle)
+    QFutureWatcher<ShowLoader::Scene> *showLoadWatcher = nullptr;
+    QStringList showLoadMissing;        // audio files the probe did not find
+
+    // Background import (drag & drop, Add Files)
+    QFutureWatcher<MediaImport::Item> *importWatcher = nullptr;
+    int importSceneIndex = 0;           // scene the import was started in
+    QStringList importUndecodable;
+
+    // Background loudness measurement (Analyze Loudness); one job
+    // per audio file, applied to every cue that plays it
+    QFutureWatcher<AudioAnalysis::Result> *loudnessWatcher = nullptr;
+    QStringList loudnessPaths;
+    QHash<QString, QVector<quint64>> loudnessCues;
+    int loudnessFailed = 0;
+
+    // Background offline render of the show (Render Show to File)
+    QFutureWatcher<ShowRender::Result> *renderWatcher = nullptr;
+    // First-scene cues still loading their media; showReady() fires
+    // once this drains
+    QSet<quint64> showReadyWaiting;
+    bool showReadyPending = false;
+
+    // Crash-safe autosave: edits are coalesced here and handed to
+    // the journal's writer thread a few times per second
+    ShowJournal *journal = nullptr;
+    QSet<quint64> journalDirtyCues;
+    bool journalLayoutDirty = false;
+    int journalTickId = 0;              // FrameTicker subscription while edits are pending
+
+    // Background media store ingest of the save in progress (null when idle)
+    QFutureWatcher<MediaStore::IngestResult> *mediaStoreWatcher = nullptr;
+    // Background encode + atomic write that follows the ingest
+    QFutureWatcher<ShowFile::SaveResult> *showWriteWatcher = nullptr;
 
     // Clock + Timer
     QLabel *clockLabel = nullptr;
     QLabel *timerLabel = nullptr;
     QPushButton *timerStartStopButton = nullptr;
     QPushButton *timerResetButton = nullptr;
-    QTimer *uiTimer = nullptr;
+    int uiTickId = 0;                   // FrameTicker subscription (1 s)
+    int liveTimelineTickId = 0;         // FrameTicker subscription (Live Mode)
     bool timerRunning = false;
     int timerSeconds = 0;
 
@@ -184,11 +251,43 @@ private:
     Scene &currentScene();
     void ensureAtLeastOneScene();
     void addTrackFromFile(const QString &path);
+    void importFiles(const QStringList &paths);
+    void onImportBatch(int begin, int end);
     QString promptForAudioCopyFolder();
+    void verifyMediaStore();
+    void relinkMissingMedia();
+    void analyzeLoudness(bool quiet);
+    void renderShowToFile();
+    void startMasterMeter();
+    void applyLimiterSettings();
+    void applyDuckingSettings();
+    void editDuckingSettings();
+    void loadRouting();
+    void saveRouting();
+    void editRouting();
+    void showAudioEngineStatus();
+    void applyLoudnessNormalization(TrackWidget *tw);
     void saveQueueToJson(const QString &savePath, const QString &audioFolder);
-    void loadQueueFromJson(const QString &path);
+    void saveShowPackage(const QString &savePath);
+    void onShowSceneLoaded(const ShowLoader::Scene &loaded);
+    TrackWidget *createTrackFromJson(const QJsonObject &obj, const QString &audioFolder);
+    void armShowReady(const QVector<TrackWidget*> &cues);
+    void onTrackMediaStateChanged(TrackWidget *tw);
+    void checkShowReady();
+    QString autosaveDir() const;
+    void startJournal();
+    void markJournalCue(TrackWidget *tw);
+    void markJournalLayout();
+    void scheduleJournalFlush();
+    void flushJournal();
     void rebuildTrackList();
+    ScenePage createScenePage();
+    void releaseScenePage(const ScenePage &page);
+    void syncScenePages();
+    void showCurrentScenePage();
+    QWidget *currentTrackContainer() const;
     void connectTrackSignals(TrackWidget *tw);
+    void releaseTrack(TrackWidget *tw);
     void stopCurrentTrackImmediately();
     void clearAllScenes();
     void updateEmptyState();
@@ -199,6 +298,7 @@ private:
     void rebuildFragmentTree();
     void syncScenesFromFragmentTree();
     void updateSceneHighlighting();
+    void updateFragmentTreeHighlighting();
     bool isHotkeyUsedElsewhere(const QString &key, TrackWidget *ignore);
     LiveModeWindow *liveModeWindow = nullptr;
 
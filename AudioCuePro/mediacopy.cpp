@@ -0,0 +1,92 @@
+#include "mediacopy.h"
+
+#include <QFile>
+#include <QJsonValue>
+
+static const qint64 kCopyChunk = 4 * 1024 * 1024;
+
+/* ============================================================
+ * COPY
+ * ============================================================ */
+bool MediaCopy::copy(QIODevice *in, const QString &target,
+                     const MediaHash::ChunkCallback &onChunk, qint64 *bytesCopied)
+{
+    const QString partial = target + QStringLiteral(".part");
+    QFile::remove(partial);
+
+    QFile out(partial);
+    bool ok = in && (in->isOpen() || in->open(QIODevice::ReadOnly))
+              && out.open(QIODevice::WriteOnly);
+
+    QByteArray buffer(kCopyChunk, Qt::Uninitialized);
+    while (ok)
+    {
+        const qint64 n = in->read(buffer.data(), buffer.size());
+        if (n < 0) { ok = false; break; }
+        if (n == 0) break;
+        if (out.write(buffer.constData(), n) != n) { ok = false; break; }
+        if (bytesCopied)
+            *bytesCopied += n;
+        if (onChunk && !onChunk(n)) { ok = false; break; }
+    }
+    out.close();
+
+    if (!ok || !QFile::rename(partial, target))
+    {
+        QFile::remove(partial);
+        return false;
+    }
+    return true;
+}
+
+/* ============================================================
+ * SOURCE HASHES
+ * ============================================================ */
+void MediaCopy::SourceHashes::load(const QJsonObject &json)
+{
+    m_entries.clear();
+    for (auto it = json.begin(); it != json.end(); ++it)
+    {
+        const QJsonObject o = it.value().toObject();
+        Entry e;
+        e.stamp.size    = qint64(o["size"].toDouble(-1));
+        e.stamp.mtimeMs = qint64(o["mtime"].toDouble());
+        e.hash          = o["hash"].toString();
+        m_entries.insert(it.key(), e);
+    }
+}
+
+QJsonObject MediaCopy::SourceHashes::toJson() const
+{
+    QJsonObject json;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        QJsonObject o;
+        o["size"]  = double(it.value().stamp.size);
+        o["mtime"] = double(it.value().stamp.mtimeMs);
+        o["hash"]  = it.value().hash;
+        json[it.key()] = o;
+    }
+    return json;
+}
+
+QString MediaCopy::SourceHashes::cached(const QString &path,
+                                        const MediaHash::FileStamp &stamp) const
+{
+    const auto it = m_entries.constFind(path);
+    return it != m_entries.constEnd() && it->stamp == stamp ? it->hash : QString();
+}
+
+QString MediaCopy::SourceHashes::hashOf(const QString &path,
+                                        const MediaHash::FileStamp &stamp,
+                                        const MediaHash::ChunkCallback &onChunk)
+{
+    const QString known = cached(path, stamp);
+    if (!known.isEmpty())
+        return known;
+
+    const QString hash = MediaHash::ofFile(path, onChunk);
+    if (!hash.isEmpty())
+        m_entries.insert(path, Entry{stamp, hash});
+    return hash;
+}
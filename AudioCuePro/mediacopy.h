@@ -0,0 +1,59 @@
+#ifndef MEDIACOPY_H
+#define MEDIACOPY_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+#include "mediahash.h"
+
+class QIODevice;
+
+/*
+============================================================
+ MediaCopy
+------------------------------------------------------------
+ - The incremental copy step under the media store, safe to
+   run on a worker thread
+ - copy() streams a file in large chunks through a ".part"
+   file and a rename, so a cancel or a full disk never
+   leaves a truncated file under the real name
+ - SourceHashes remembers the content hash of every source
+   seen, keyed by size + mtime: a re-save does not read the
+   files that did not change
+============================================================
+*/
+
+namespace MediaCopy
+{
+    // Copy `in` (opened here if it is not open yet) to `target`.
+    // `onChunk` gets the bytes of each chunk written; return false
+    // from it to cancel. `bytesCopied` is advanced as data is written
+    bool copy(QIODevice *in, const QString &target,
+              const MediaHash::ChunkCallback &onChunk, qint64 *bytesCopied);
+
+    class SourceHashes
+    {
+    public:
+        void load(const QJsonObject &json);
+        QJsonObject toJson() const;
+
+        // Known hash of `path` while its stamp still matches, else ""
+        QString cached(const QString &path, const MediaHash::FileStamp &stamp) const;
+
+        // cached(), or hash the file now (through `onChunk`) and
+        // remember it. Empty if the file cannot be read or the
+        // callback canceled
+        QString hashOf(const QString &path, const MediaHash::FileStamp &stamp,
+                       const MediaHash::ChunkCallback &onChunk);
+
+    private:
+        struct Entry {
+            MediaHash::FileStamp stamp;
+            QString hash;
+        };
+        QHash<QString, Entry> m_entries;    // absolute source path → last known hash
+    };
+}
+
+#endif // MEDIACOPY_H
@@ -0,0 +1,46 @@
+#include "mediahash.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimeZone>
+
+static const qint64 kChunkSize = 4 * 1024 * 1024;
+
+QString MediaHash::ofFile(const QString &path, const ChunkCallback &onChunk)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Blake2b_256);
+    QByteArray buffer(kChunkSize, Qt::Uninitialized);
+
+    for (;;)
+    {
+        const qint64 n = f.read(buffer.data(), buffer.size());
+        if (n < 0)
+            return QString();
+        if (n == 0)
+            break;
+
+        hash.addData(QByteArrayView(buffer.constData(), n));
+
+        if (onChunk && !onChunk(n))
+            return QString();
+    }
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+MediaHash::FileStamp MediaHash::stampOf(const QString &path)
+{
+    FileStamp st;
+    QFileInfo fi(path);
+    if (!fi.exists() || !fi.isFile())
+        return st;
+
+    st.size = fi.size();
+    st.mtimeMs = fi.lastModified(QTimeZone::UTC).toMSecsSinceEpoch();
+    return st;
+}
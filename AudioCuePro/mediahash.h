@@ -0,0 +1,40 @@
+#ifndef MEDIAHASH_H
+#define MEDIAHASH_H
+
+#include <QString>
+#include <QtGlobal>
+#include <functional>
+
+/*
+============================================================
+ MediaHash
+------------------------------------------------------------
+ - Content hash of an audio file (BLAKE2b-256, hex)
+ - Streams the file in large chunks; never loads it whole
+ - Optional callback per chunk for progress / cancel
+ - FileStamp is the cheap "did it change?" check
+   (size + mtime) used before paying for a hash
+============================================================
+*/
+
+namespace MediaHash
+{
+    // Return false from the callback to abort (result is then empty)
+    using ChunkCallback = std::function<bool(qint64 bytesRead)>;
+
+    QString ofFile(const QString &path, const ChunkCallback &onChunk = {});
+
+    struct FileStamp {
+        qint64 size = -1;
+        qint64 mtimeMs = 0;
+
+        bool isValid() const { return size >= 0; }
+        bool operator==(const FileStamp &o) const
+        { return size == o.size && mtimeMs == o.mtimeMs; }
+        bool operator!=(const FileStamp &o) const { return !(*this == o); }
+    };
+
+    FileStamp stampOf(const QString &path);
+}
+
+#endif // MEDIAHASH_H
@@ -0,0 +1,120 @@
+#include "mediaimport.h"
+
+#include <QAtomicInt>
+#include <QCollator>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+
+static const int kBatchSize = 32;
+
+namespace {
+
+const QStringList &suffixes()
+{
+    static const QStringList s = { "mp3", "wav", "flac", "ogg", "m4a" };
+    return s;
+}
+
+// Audio files under a dropped folder, in the order a file browser
+// shows them ("2 Door" before "10 Door")
+QStringList audioFilesIn(const QString &dir, const QPromise<MediaImport::Item> &promise)
+{
+    QStringList files;
+    QDirIterator it(dir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext() && !promise.isCanceled())
+    {
+        const QString path = it.next();
+        if (MediaImport::isAudioFile(path))
+            files << path;
+    }
+
+    QCollator collator;
+    collator.setNumericMode(true);
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    std::sort(files.begin(), files.end(), collator);
+    return files;
+}
+
+} // namespace
+
+bool MediaImport::isAudioFile(const QString &path)
+{
+    return suffixes().contains(QFileInfo(path).suffix().toLower());
+}
+
+QString MediaImport::dialogFilter()
+{
+    QStringList globs;
+    for (const QString &s : suffixes())
+        globs << "*." + s;
+    return QObject::tr("Audio Files (%1)").arg(globs.join(' '));
+}
+
+void MediaImport::run(QPromise<Item> &promise, const QStringList &paths, float silenceThreshold)
+{
+    promise.setProgressRange(0, 1000);
+
+    /* ------------------------------------------------------------
+     * ENUMERATE
+     * ------------------------------------------------------------ */
+    promise.setProgressValueAndText(0, QObject::tr("Looking for audio files…"));
+
+    QStringList files;
+    for (const QString &p : paths)
+    {
+        const QFileInfo fi(p);
+        if (fi.isDir())
+            files << audioFilesIn(fi.absoluteFilePath(), promise);
+        else if (fi.isFile() && isAudioFile(p))
+            files << fi.absoluteFilePath();
+    }
+
+    if (promise.isCanceled() || files.isEmpty())
+        return;
+
+    /* ------------------------------------------------------------
+     * PROBE + ANALYSE, batch by batch
+     * ------------------------------------------------------------ */
+    const int total = int(files.size());
+    QAtomicInt done = 0;
+
+    auto canceled = [&promise]() { return promise.isCanceled(); };
+
+    for (int from = 0; from < total && !promise.isCanceled(); from += kBatchSize)
+    {
+        const int to = qMin(total, from + kBatchSize);
+        promise.setProgressValueAndText(20 + int(qint64(done.loadRelaxed()) * 980 / total),
+                                        QObject::tr("Importing %1 of %2…").arg(from + 1).arg(total));
+
+        QVector<Item> batch(to - from);
+        for (int i = from; i < to; ++i)
+            batch[i - from].path = files[i];
+
+        QtConcurrent::blockingMap(AudioAnalysis::threadPool(), batch, [&](Item &item) {
+            if (promise.isCanceled())
+                return;
+
+            item.probe = MediaProbe::probe(item.path);
+            if (item.probe.exists)
+                item.analysis = AudioAnalysis::analyzeFile(item.path, silenceThreshold, canceled);
+
+            // The header may not say (MP3, AAC): the decode did
+            if (item.probe.durationMs < 0 && item.analysis.ok)
+                item.probe.durationMs = item.analysis.durationMs;
+
+            const int n = done.fetchAndAddRelaxed(1) + 1;
+            promise.setProgressValue(20 + int(qint64(n) * 980 / total));
+        });
+
+        // Canceled: the files in flight are done, but the promise
+        // no longer takes results, so this batch goes unreported
+        if (promise.isCanceled())
+            break;
+
+        for (const Item &item : batch)
+            promise.addResult(item);
+    }
+}
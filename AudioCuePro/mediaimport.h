@@ -0,0 +1,48 @@
+#ifndef MEDIAIMPORT_H
+#define MEDIAIMPORT_H
+
+#include <QPromise>
+#include <QString>
+#include <QStringList>
+
+#include "audioanalysis.h"
+#include "mediaprobe.h"
+
+/*
+============================================================
+ MediaImport
+------------------------------------------------------------
+ - Worker side of adding audio files (drag & drop, Add
+   Files), in stages:
+     enumerate – dropped folders are walked for audio files
+     probe     – MediaProbe (exists, size, format)
+     analyse   – AudioAnalysis (decode once: duration,
+                 peaks, sound start / end for silence
+                 trimming, loudness), on its own pool
+ - Files are handled in batches; each batch is reported as
+   consecutive results in input order, so the GUI can build
+   a batch of cues at once while the next batch analyses
+ - Progress range is 0..1000; cancel stops after the files
+   in flight. Their batch is not reported (a canceled
+   QPromise takes no more results); every batch reported
+   before it stays imported
+============================================================
+*/
+
+namespace MediaImport
+{
+    struct Item {
+        QString path;
+        MediaProbe::Result probe;
+        AudioAnalysis::Result analysis;   // ok = false if it could not be decoded
+    };
+
+    // Suffix filter shared by the file dialog and drag & drop
+    bool isAudioFile(const QString &path);
+    QString dialogFilter();
+
+    // silenceThreshold: linear, 0 = no silence trimming
+    void run(QPromise<Item> &promise, const QStringList &paths, float silenceThreshold);
+}
+
+#endif // MEDIAIMPORT_H
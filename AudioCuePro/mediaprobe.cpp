@@ -0,0 +1,130 @@
+#include "mediaprobe.h"
+#include "showpackage.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMimeDatabase>
+#include <QScopedPointer>
+#include <QtEndian>
+
+namespace {
+
+// Walks the RIFF chunks up to "data"; returns -1 if the file is
+// not a plain PCM/float WAVE or the header is damaged.
+qint64 wavDurationMs(QIODevice &f)
+{
+    const QByteArray riff = f.read(12);
+    if (riff.size() != 12 || !riff.startsWith("RIFF") || riff.mid(8, 4) != "WAVE")
+        return -1;
+
+    quint32 byteRate = 0;
+    for (int guard = 0; guard < 64; ++guard)
+    {
+        const QByteArray chunk = f.read(8);
+        if (chunk.size() != 8)
+            return -1;
+
+        const QByteArray id = chunk.left(4);
+        const quint32 size = qFromLittleEndian<quint32>(chunk.constData() + 4);
+
+        if (id == "fmt ")
+        {
+            const QByteArray fmt = f.read(qMin<quint32>(size, 16));
+            if (fmt.size() < 16)
+                return -1;
+            byteRate = qFromLittleEndian<quint32>(fmt.constData() + 8);
+            if (!f.seek(f.pos() + (size - 16) + (size & 1)))
+                return -1;
+        }
+        else if (id == "data")
+        {
+            if (byteRate == 0)
+                return -1;
+            // A streamed WAV may leave the size open; trust the file length
+            qint64 dataBytes = size;
+            if (size == 0 || size == 0xFFFFFFFFu)
+                dataBytes = f.size() - f.pos();
+            return dataBytes * 1000 / byteRate;
+        }
+        else
+        {
+            // Chunks are word aligned
+            if (!f.seek(f.pos() + size + (size & 1)))
+                return -1;
+        }
+    }
+    return -1;
+}
+
+bool isWav(const QString &fileName)
+{
+    const QString ext = QFileInfo(fileName).suffix().toLower();
+    return ext == QLatin1String("wav") || ext == QLatin1String("wave");
+}
+
+// Audio inside a show package: the mapped index has the size
+MediaProbe::Result probeEntry(const QString &path)
+{
+    MediaProbe::Result r;
+    QString packagePath, name;
+    ShowPackage::splitEntryPath(path, &packagePath, &name);
+
+    const QSharedPointer<const ShowPackage> pkg = ShowPackage::shared(packagePath);
+    const ShowPackage::Entry e = pkg ? pkg->entry(name) : ShowPackage::Entry();
+    if (!e.isValid())
+        return r;
+
+    r.exists = true;
+    r.sizeBytes = e.size;
+
+    static const QMimeDatabase db;   // thread-safe
+    r.mimeType = db.mimeTypeForFile(name, QMimeDatabase::MatchExtension).name();
+
+    if (isWav(name))
+    {
+        QScopedPointer<QIODevice> dev(pkg->openEntry(name));
+        if (dev)
+            r.durationMs = wavDurationMs(*dev);
+    }
+    return r;
+}
+
+} // namespace
+
+MediaProbe::Result MediaProbe::probe(const QString &path)
+{
+    if (ShowPackage::isEntryPath(path))
+        return probeEntry(path);
+
+    Result r;
+    const QFileInfo fi(path);
+    if (!fi.exists() || !fi.isFile())
+        return r;
+
+    r.exists = true;
+    r.sizeBytes = fi.size();
+
+    static const QMimeDatabase db;   // thread-safe
+    r.mimeType = db.mimeTypeForFile(fi, QMimeDatabase::MatchExtension).name();
+
+    if (isWav(fi.fileName()))
+    {
+        QFile f(path);
+        if (f.open(QIODevice::ReadOnly))
+            r.durationMs = wavDurationMs(f);
+    }
+
+    return r;
+}
+
+bool MediaProbe::exists(const QString &path)
+{
+    if (ShowPackage::isEntryPath(path))
+    {
+        QString packagePath, name;
+        ShowPackage::splitEntryPath(path, &packagePath, &name);
+        const QSharedPointer<const ShowPackage> pkg = ShowPackage::shared(packagePath);
+        return pkg && pkg->entry(name).isValid();
+    }
+    return QFileInfo(path).isFile();
+}
@@ -0,0 +1,37 @@
+#ifndef MEDIAPROBE_H
+#define MEDIAPROBE_H
+
+#include <QString>
+
+/*
+============================================================
+ MediaProbe
+------------------------------------------------------------
+ - Cheap, thread-safe look at an audio file before a cue is
+   built for it: does it exist, how big is it, what format
+ - Duration comes straight from the header for RIFF/WAVE
+   (fmt byte rate + data size); other formats report -1 and
+   get their duration from QMediaPlayer as before
+ - No decoding and no multimedia objects, so any number of
+   probes can run on worker threads at once
+ - Paths into a show package ("<package>#media/...") are
+   probed through the package index
+============================================================
+*/
+
+namespace MediaProbe
+{
+    struct Result {
+        bool exists = false;
+        qint64 sizeBytes = 0;
+        QString mimeType;         // from the file name, e.g. "audio/x-wav"
+        qint64 durationMs = -1;   // -1 = unknown without decoding
+    };
+
+    Result probe(const QString &path);
+
+    // File on disk, or entry inside a show package (ShowPackage)
+    bool exists(const QString &path);
+}
+
+#endif // MEDIAPROBE_H
@@ -0,0 +1,202 @@
+#include "mediarelink.h"
+#include "mediahash.h"
+
+#include <QAtomicInt>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentMap>
+#include <functional>
+
+namespace {
+
+struct FileEntry {
+    QString path;
+    qint64 size = 0;
+};
+
+// Everything under `dir` whose suffix is one the missing cues use
+QVector<FileEntry> listFiles(const QString &dir, bool recursive,
+                             const QSet<QString> &suffixes,
+                             const std::function<bool()> &canceled)
+{
+    QVector<FileEntry> out;
+    QDirIterator it(dir, QDir::Files | QDir::Hidden,
+                    recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+    while (it.hasNext())
+    {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+        if (!suffixes.contains(fi.suffix().toLower()))
+            continue;
+        out.append(FileEntry{fi.absoluteFilePath(), fi.size()});
+
+        if ((out.size() & 255) == 0 && canceled())
+            break;
+    }
+    return out;
+}
+
+} // namespace
+
+void MediaRelink::resolve(QPromise<Result> &promise,
+                          const QVector<Wanted> &wanted,
+                          const QStringList &roots)
+{
+    Result result;
+    promise.setProgressRange(0, 1000);
+    auto canceled = [&promise]() { return promise.isCanceled(); };
+
+    QSet<QString> suffixes;
+    for (const Wanted &w : wanted)
+        suffixes.insert(QFileInfo(w.fileName).suffix().toLower());
+
+    /* ------------------------------------------------------------
+     * SCAN: one task per top-level folder, all roots at once
+     * ------------------------------------------------------------ */
+    promise.setProgressValueAndText(0, QObject::tr("Scanning folders…"));
+
+    struct Task { QString dir; bool recursive; };
+    QVector<Task> tasks;
+    for (const QString &root : roots)
+    {
+        tasks.append(Task{root, false});
+        const QStringList subdirs = QDir(root).entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden);
+        for (const QString &sub : subdirs)
+            tasks.append(Task{QDir(root).filePath(sub), true});
+    }
+
+    QAtomicInt tasksDone = 0;
+    const QVector<QVector<FileEntry>> listings =
+        QtConcurrent::blockingMapped<QVector<QVector<FileEntry>>>(tasks, [&](const Task &t) {
+            QVector<FileEntry> files;
+            if (!promise.isCanceled())
+                files = listFiles(t.dir, t.recursive, suffixes, canceled);
+            const int done = tasksDone.fetchAndAddRelaxed(1) + 1;
+            promise.setProgressValue(int(qint64(done) * 300 / qMax(1, int(tasks.size()))));
+            return files;
+        });
+
+    if (promise.isCanceled())
+    {
+        result.canceled = true;
+        promise.addResult(result);
+        return;
+    }
+
+    // Index by name and by size; overlapping roots list a file twice
+    QVector<FileEntry> files;
+    QHash<QString, QVector<int>> byName;
+    QHash<qint64, QVector<int>> bySize;
+    QSet<QString> seen;
+    for (const QVector<FileEntry> &listing : listings)
+    {
+        for (const FileEntry &e : listing)
+        {
+            if (seen.contains(e.path))
+                continue;
+            seen.insert(e.path);
+
+            const int i = files.size();
+            files.append(e);
+            byName[QFileInfo(e.path).fileName().toLower()].append(i);
+            bySize[e.size].append(i);
+        }
+    }
+    result.scannedFiles = files.size();
+
+    /* ------------------------------------------------------------
+     * RESOLVE 1: names (and sizes), and which files need hashing
+     * ------------------------------------------------------------ */
+    promise.setProgressValueAndText(300, QObject::tr("Matching %1 files…").arg(files.size()));
+
+    QVector<QVector<int>> nameCandidates(wanted.size());
+    QVector<QVector<int>> contentCandidates(wanted.size());
+    QSet<int> needHash;
+
+    for (int w = 0; w < wanted.size(); ++w)
+    {
+        const Wanted &want = wanted[w];
+
+        QVector<int> cands;
+        for (int i : byName.value(want.fileName.toLower()))
+            if (want.size < 0 || files[i].size == want.size)
+                cands.append(i);
+
+        if (want.hash.isEmpty())
+        {
+            // Nothing better to go on than the name
+            if (!cands.isEmpty())
+                result.found.insert(want.cueId, files[cands.first()].path);
+            continue;
+        }
+
+        nameCandidates[w] = cands;
+        for (int i : cands)
+            needHash.insert(i);
+
+        // Renamed: same size is the only cheap filter there is
+        if (want.size >= 0)
+        {
+            contentCandidates[w] = bySize.value(want.size);
+            for (int i : contentCandidates[w])
+                needHash.insert(i);
+        }
+    }
+
+    /* ------------------------------------------------------------
+     * HASH: each candidate once, in parallel
+     * ------------------------------------------------------------ */
+    const QList<int> toHash = needHash.values();
+    QVector<QString> hashes(files.size());
+    QString *hashSlots = hashes.data();   // one slot per file, no sharing
+    QAtomicInt hashed = 0;
+
+    QtConcurrent::blockingMap(toHash, [&](int i) {
+        if (!promise.isCanceled())
+            hashSlots[i] = MediaHash::ofFile(files[i].path, [&](qint64) { return !promise.isCanceled(); });
+
+        const int done = hashed.fetchAndAddRelaxed(1) + 1;
+        promise.setProgressValue(300 + int(qint64(done) * 700 / qMax(1, int(toHash.size()))));
+    });
+
+    if (promise.isCanceled())
+    {
+        result.canceled = true;
+        promise.addResult(result);
+        return;
+    }
+
+    /* ------------------------------------------------------------
+     * RESOLVE 2: by content
+     * ------------------------------------------------------------ */
+    for (int w = 0; w < wanted.size(); ++w)
+    {
+        const Wanted &want = wanted[w];
+        if (result.found.contains(want.cueId) || want.hash.isEmpty())
+            continue;
+
+        int match = -1;
+        for (int i : nameCandidates[w])
+            if (hashes[i] == want.hash) { match = i; break; }
+
+        if (match < 0)
+        {
+            for (int i : contentCandidates[w])
+                if (hashes[i] == want.hash) { match = i; break; }
+            if (match >= 0)
+                result.byHash.append(want.cueId);
+        }
+
+        if (match >= 0)
+            result.found.insert(want.cueId, files[match].path);
+    }
+
+    for (const Wanted &want : wanted)
+        if (!result.found.contains(want.cueId))
+            result.missing.append(want.cueId);
+
+    promise.setProgressValue(1000);
+    promise.addResult(result);
+}
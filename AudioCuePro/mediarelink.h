@@ -0,0 +1,52 @@
+#ifndef MEDIARELINK_H
+#define MEDIARELINK_H
+
+#include <QHash>
+#include <QPromise>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*
+============================================================
+ MediaRelink
+------------------------------------------------------------
+ - Finds the audio of cues whose file is gone (show opened
+   on another machine, drive letter changed, files moved)
+ - Scan: every chosen root is walked in parallel, one task
+   per top-level folder, into one index of audio files by
+   lower-case name and by size
+ - Resolve, one pass over all missing cues:
+     1. same name (+ same size / hash when the show knows
+        them, to tell apart files that share a name)
+     2. renamed files: same size, then same content hash.
+        Only candidates of the right size are ever hashed,
+        and each file at most once
+ - Runs on a worker thread (QtConcurrent + QPromise),
+   progress range 0..1000, cancellable
+============================================================
+*/
+
+namespace MediaRelink
+{
+    struct Wanted {
+        quint64 cueId = 0;
+        QString fileName;      // original file name
+        qint64 size = -1;      // -1 = not recorded in the show
+        QString hash;          // BLAKE2b hex, "" = unknown
+    };
+
+    struct Result {
+        QHash<quint64, QString> found;   // cue ID → new path
+        QVector<quint64> byHash;         // cues found under another name
+        QVector<quint64> missing;
+        int scannedFiles = 0;
+        bool canceled = false;
+    };
+
+    void resolve(QPromise<Result> &promise,
+                 const QVector<Wanted> &wanted,
+                 const QStringList &roots);
+}
+
+#endif // MEDIARELINK_H
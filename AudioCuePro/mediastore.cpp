@@ -0,0 +1,305 @@
+#include "mediastore.h"
+#include "mediacopy.h"
+#include "mediahash.h"
+#include "showpackage.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QScopedPointer>
+
+/* ============================================================
+ * STORE INDEX (store.json)
+ * ============================================================ */
+namespace {
+
+struct Index {
+    QHash<QString, MediaHash::FileStamp> objects;   // object name → stamp on disk
+    MediaCopy::SourceHashes sources;                // source path → last known hash
+};
+
+QString indexPath(const QString &storeRoot)
+{
+    return QDir(storeRoot).filePath(QStringLiteral("store.json"));
+}
+
+MediaHash::FileStamp stampFromJson(const QJsonObject &o)
+{
+    MediaHash::FileStamp st;
+    st.size    = qint64(o["size"].toDouble(-1));
+    st.mtimeMs = qint64(o["mtime"].toDouble());
+    return st;
+}
+
+QJsonObject stampToJson(const MediaHash::FileStamp &st)
+{
+    QJsonObject o;
+    o["size"]  = double(st.size);
+    o["mtime"] = double(st.mtimeMs);
+    return o;
+}
+
+Index loadIndex(const QString &storeRoot)
+{
+    Index idx;
+    QFile f(indexPath(storeRoot));
+    if (!f.open(QIODevice::ReadOnly))
+        return idx;
+
+    const QJsonObject root = QJsonDocument::fromJson(f.readAll()).object();
+
+    const QJsonObject objects = root["objects"].toObject();
+    for (auto it = objects.begin(); it != objects.end(); ++it)
+        idx.objects.insert(it.key(), stampFromJson(it.value().toObject()));
+
+    idx.sources.load(root["sources"].toObject());
+    return idx;
+}
+
+bool saveIndex(const QString &storeRoot, const Index &idx)
+{
+    QJsonObject objects;
+    for (auto it = idx.objects.begin(); it != idx.objects.end(); ++it)
+        objects[it.key()] = stampToJson(it.value());
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["objects"] = objects;
+    root["sources"] = idx.sources.toJson();
+
+    QSaveFile f(indexPath(storeRoot));
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return f.commit();
+}
+
+// "<hash>.<ext>" → "<hash>"
+QString hashOfObject(const QString &objectName)
+{
+    return objectName.section(QLatin1Char('.'), 0, 0);
+}
+
+// Audio inside a show package is stored under its object name
+// already: size from the package index, hash from the name
+MediaHash::FileStamp packagedStamp(const QString &entryPath, QString *objectName)
+{
+    MediaHash::FileStamp st;
+    QString packagePath, entryName;
+    if (!ShowPackage::splitEntryPath(entryPath, &packagePath, &entryName))
+        return st;
+
+    const QSharedPointer<const ShowPackage> pkg = ShowPackage::shared(packagePath);
+    const ShowPackage::Entry e = pkg ? pkg->entry(entryName) : ShowPackage::Entry();
+    if (e.isValid())
+    {
+        st.size = e.size;
+        *objectName = entryName.section(QLatin1Char('/'), -1);
+    }
+    return st;
+}
+
+} // namespace
+
+/* ============================================================
+ * PATHS
+ * ============================================================ */
+QString MediaStore::objectPath(const QString &storeRoot, const QString &objectName)
+{
+    // Shard by the first two hex digits so no folder gets huge
+    return QDir(storeRoot).filePath(QStringLiteral("objects/%1/%2")
+                                        .arg(objectName.left(2), objectName));
+}
+
+bool MediaStore::isObjectPath(const QString &storeRoot, const QString &path)
+{
+    const QString objectsDir = QDir(storeRoot).absoluteFilePath(QStringLiteral("objects")) + '/';
+    return QFileInfo(path).absoluteFilePath().startsWith(objectsDir);
+}
+
+/* ============================================================
+ * INGEST (worker)
+ * ============================================================ */
+void MediaStore::ingest(QPromise<IngestResult> &promise,
+                        const QStringList &sourcePaths,
+                        const QString &storeRoot)
+{
+    IngestResult result;
+    promise.setProgressRange(0, 1000);
+
+    Index idx = loadIndex(storeRoot);
+
+    // Progress in bytes: each source is read at most once to hash
+    // it and once to copy it
+    qint64 totalBytes = 0;
+    for (const QString &src : sourcePaths)
+    {
+        QString object;
+        const qint64 size = ShowPackage::isEntryPath(src) ? packagedStamp(src, &object).size
+                                                          : QFileInfo(src).size();
+        totalBytes += qMax<qint64>(0, size) * 2;
+    }
+    totalBytes = qMax<qint64>(1, totalBytes);
+
+    qint64 doneBytes = 0;
+    int progress = 0;
+    auto advance = [&](qint64 n) {
+        doneBytes += n;
+        progress = int(qMin<qint64>(1000, doneBytes * 1000 / totalBytes));
+        promise.setProgressValue(progress);
+        return !promise.isCanceled();
+    };
+
+    for (const QString &src : sourcePaths)
+    {
+        if (promise.isCanceled())
+            break;
+
+        const QFileInfo srcInfo(src);
+        const QString absSrc = srcInfo.absoluteFilePath();
+        QString packagedObject;
+        const bool packaged = ShowPackage::isEntryPath(src);
+        const MediaHash::FileStamp st = packaged ? packagedStamp(src, &packagedObject)
+                                                 : MediaHash::stampOf(absSrc);
+        if (!st.isValid())
+        {
+            result.errors << QObject::tr("Missing file: %1").arg(src);
+            continue;
+        }
+
+        promise.setProgressValueAndText(progress,
+                                        QObject::tr("Checking %1").arg(srcInfo.fileName()));
+
+        // Find the content hash without reading, when we can
+        QString hash;
+        if (packaged)
+            hash = hashOfObject(packagedObject);            // cue played from a package
+        else if (isObjectPath(storeRoot, absSrc)
+                 && idx.objects.value(srcInfo.fileName()) == st)
+            hash = hashOfObject(srcInfo.fileName());        // cue loaded from this store
+        else
+            hash = idx.sources.cached(absSrc, st);          // unchanged since last save
+
+        if (hash.isEmpty())
+        {
+            hash = idx.sources.hashOf(absSrc, st, advance);
+            if (hash.isEmpty())
+            {
+                if (promise.isCanceled())
+                    break;
+                result.errors << QObject::tr("Cannot read: %1").arg(src);
+                continue;
+            }
+        }
+        else
+        {
+            advance(st.size);
+        }
+
+        const QString ext = srcInfo.suffix().toLower();
+        const QString name = hash + '.' + (ext.isEmpty() ? QStringLiteral("bin") : ext);
+        const QString target = objectPath(storeRoot, name);
+
+        // Already stored (by this show or any other): metadata only
+        const MediaHash::FileStamp targetStamp = MediaHash::stampOf(target);
+        if (targetStamp.isValid() && targetStamp.size == st.size)
+        {
+            idx.objects.insert(name, targetStamp);
+            result.objectNames.insert(src, name);
+            ++result.reused;
+            advance(st.size);
+            continue;
+        }
+
+        // New content: MediaCopy never leaves a truncated object
+        // behind, whether the copy fails or is canceled
+        promise.setProgressValueAndText(progress,
+                                        QObject::tr("Copying %1").arg(srcInfo.fileName()));
+
+        QDir().mkpath(QFileInfo(target).absolutePath());
+        QFile::remove(target);   // wrong size: damaged earlier copy
+
+        QScopedPointer<QIODevice> in(packaged ? ShowPackage::openEntryPath(src)
+                                              : new QFile(absSrc));
+        if (!MediaCopy::copy(in.data(), target, advance, &result.bytesCopied))
+        {
+            if (promise.isCanceled())
+                break;
+            result.errors << QObject::tr("Copy failed: %1").arg(src);
+            continue;
+        }
+
+        idx.objects.insert(name, MediaHash::stampOf(target));
+        result.objectNames.insert(src, name);
+        ++result.copied;
+    }
+
+    // Hashes learned so far are worth keeping even after a cancel
+    saveIndex(storeRoot, idx);
+
+    result.canceled = promise.isCanceled();
+    promise.addResult(result);
+}
+
+/* ============================================================
+ * VERIFY (worker)
+ * ============================================================ */
+void MediaStore::verify(QPromise<VerifyResult> &promise, const QString &storeRoot)
+{
+    VerifyResult result;
+    promise.setProgressRange(0, 1000);
+
+    QStringList paths;
+    qint64 totalBytes = 0;
+    QDirIterator it(QDir(storeRoot).filePath(QStringLiteral("objects")),
+                    QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        const QString path = it.next();
+        if (path.endsWith(QStringLiteral(".part")))
+            continue;
+        paths << path;
+        totalBytes += it.fileInfo().size();
+    }
+    totalBytes = qMax<qint64>(1, totalBytes);
+
+    Index idx = loadIndex(storeRoot);
+
+    qint64 doneBytes = 0;
+    auto advance = [&](qint64 n) {
+        doneBytes += n;
+        promise.setProgressValue(int(qMin<qint64>(1000, doneBytes * 1000 / totalBytes)));
+        return !promise.isCanceled();
+    };
+
+    for (const QString &path : paths)
+    {
+        const QString name = QFileInfo(path).fileName();
+        promise.setProgressValueAndText(int(qMin<qint64>(1000, doneBytes * 1000 / totalBytes)),
+                                        QObject::tr("Verifying %1").arg(name));
+
+        const QString hash = MediaHash::ofFile(path, advance);
+        if (promise.isCanceled())
+            break;
+
+        ++result.checked;
+        if (hash != hashOfObject(name))
+        {
+            result.corrupt << name;
+            idx.objects.remove(name);
+        }
+        else
+        {
+            idx.objects.insert(name, MediaHash::stampOf(path));
+        }
+    }
+
+    saveIndex(storeRoot, idx);
+
+    result.canceled = promise.isCanceled();
+    promise.addResult(result);
+}
@@ -0,0 +1,59 @@
+#ifndef MEDIASTORE_H
+#define MEDIASTORE_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QPromise>
+
+/*
+============================================================
+ MediaStore
+------------------------------------------------------------
+ - Content-addressed folder for show audio: every unique
+   file is kept once, as objects/<ab>/<hash>.<ext>
+ - Cues refer to the object name ("<hash>.<ext>"), so the
+   same store can back any number of shows
+ - Ingest runs on a worker thread (QtConcurrent + QPromise)
+   on top of MediaCopy: sources already stored are
+   recognised by size + mtime from the store index without
+   being read again; only new content is hashed and copied.
+   Audio played from a show package is copied out under the
+   name it already has
+ - verify() re-hashes every object against its name
+============================================================
+*/
+
+namespace MediaStore
+{
+    struct IngestResult {
+        QHash<QString, QString> objectNames;   // source path → object name
+        QStringList errors;
+        int copied = 0;
+        int reused = 0;
+        qint64 bytesCopied = 0;
+        bool canceled = false;
+    };
+
+    struct VerifyResult {
+        int checked = 0;
+        QStringList corrupt;     // object names whose content changed
+        bool canceled = false;
+    };
+
+    // Progress range for both jobs is 0..1000 (bytes, scaled)
+    void ingest(QPromise<IngestResult> &promise,
+                const QStringList &sourcePaths,
+                const QString &storeRoot);
+
+    void verify(QPromise<VerifyResult> &promise,
+                const QString &storeRoot);
+
+    // Absolute path of an object inside a store
+    QString objectPath(const QString &storeRoot, const QString &objectName);
+
+    // True if `path` is a file inside the store's objects folder
+    bool isObjectPath(const QString &storeRoot, const QString &path);
+}
+
+#endif // MEDIASTORE_H
@@ -0,0 +1,154 @@
+#include "meterbar.h"
+
+#include <QPainter>
+#include <QtMath>
+#include <cmath>
+
+static const double kFloorDb = -60.0;
+static const double kTopDb = 0.0;
+static const double kAmberDb = -18.0;
+static const double kRedDb = -6.0;
+static const qint64 kPeakHoldMs = 1500;
+static const double kPeakFallDbPerSec = 20.0;
+static const qint64 kClipHoldMs = 2000;
+
+namespace {
+
+double toDb(float linear)
+{
+    return linear > 0.0f ? 20.0 * std::log10(double(linear)) : -100.0;
+}
+
+} // namespace
+
+MeterBar::MeterBar(QWidget *parent)
+    : QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+    setToolTip(tr("Output level: RMS bar, peak line, short-term loudness"));
+}
+
+QSize MeterBar::sizeHint() const
+{
+    return QSize(160, 14);
+}
+
+QSize MeterBar::minimumSizeHint() const
+{
+    return QSize(60, 10);
+}
+
+/* ============================================================
+ * BALLISTICS – one display frame
+ * ============================================================ */
+void MeterBar::setReading(const LevelMeter::Reading &reading, qint64 nowMs)
+{
+    const qint64 dt = m_lastMs > 0 ? qMax<qint64>(0, nowMs - m_lastMs) : 0;
+    m_lastMs = nowMs;
+    m_nowMs = nowMs;
+    m_active = reading.active;
+
+    m_rmsDb = toDb(reading.rms);
+    m_lufs = reading.shortTermLufs;
+
+    const double peakDb = toDb(reading.peak);
+    if (peakDb >= m_peakDb)
+    {
+        m_peakDb = peakDb;
+        m_peakHoldUntil = nowMs + kPeakHoldMs;
+    }
+    else if (nowMs > m_peakHoldUntil)
+    {
+        m_peakDb = qMax(peakDb, m_peakDb - kPeakFallDbPerSec * dt / 1000.0);
+    }
+
+    if (reading.peak >= 1.0f)
+        m_clipUntil = nowMs + kClipHoldMs;
+
+    refresh();
+}
+
+void MeterBar::clear()
+{
+    m_rmsDb = m_peakDb = -100.0;
+    m_lufs = -70.0f;
+    m_active = false;
+    m_clipUntil = 0;
+    m_lastMs = 0;
+    refresh();
+}
+
+bool MeterBar::atRest() const
+{
+    return !m_active && m_peakDb <= kFloorDb && m_nowMs >= m_clipUntil;
+}
+
+/* ============================================================
+ * DRAWING
+ * ============================================================ */
+int MeterBar::dbToX(double db, int width) const
+{
+    const double t = (qBound(kFloorDb, db, kTopDb) - kFloorDb) / (kTopDb - kFloorDb);
+    return int(std::lround(t * width));
+}
+
+void MeterBar::refresh()
+{
+    Picture p;
+    p.rmsX = dbToX(m_rmsDb, width());
+    p.peakX = m_peakDb > kFloorDb ? dbToX(m_peakDb, width()) : 0;
+    p.clip = m_nowMs < m_clipUntil;
+    if (m_active && m_lufs > -70.0f)
+        p.text = QString::number(m_lufs, 'f', 0) + QStringLiteral(" LUFS");
+
+    if (p == m_shown)
+        return;
+    m_shown = p;
+    update();
+}
+
+void MeterBar::resizeEvent(QResizeEvent *)
+{
+    // Pixel positions depend on the width; Qt repaints anyway
+    m_shown = Picture();
+    refresh();
+}
+
+void MeterBar::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    const int w = width(), h = height();
+    painter.fillRect(rect(), QColor("#181818"));
+
+    // RMS bar in three zones
+    const int amberX = dbToX(kAmberDb, w);
+    const int redX = dbToX(kRedDb, w);
+    const int x = m_shown.rmsX;
+    if (x > 0)
+        painter.fillRect(0, 0, qMin(x, amberX), h, QColor("#2fa84f"));
+    if (x > amberX)
+        painter.fillRect(amberX, 0, qMin(x, redX) - amberX, h, QColor("#d0a020"));
+    if (x > redX)
+        painter.fillRect(redX, 0, x - redX, h, QColor("#d03030"));
+
+    // Peak line
+    if (m_shown.peakX > 0)
+    {
+        const int px = qMin(m_shown.peakX, w - 2);
+        painter.fillRect(px, 0, 2, h, m_shown.peakX > redX ? QColor("#ff5050") : QColor("#e0e0e0"));
+    }
+
+    // Clip tip
+    if (m_shown.clip)
+        painter.fillRect(w - 4, 0, 4, h, QColor("#ff2020"));
+
+    if (!m_shown.text.isEmpty())
+    {
+        QFont f = font();
+        f.setPixelSize(qMax(8, h - 3));
+        painter.setFont(f);
+        painter.setPen(QColor("#f0f0f0"));
+        painter.drawText(rect().adjusted(0, 0, -6, 0), Qt::AlignRight | Qt::AlignVCenter, m_shown.text);
+    }
+}
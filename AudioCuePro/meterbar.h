@@ -0,0 +1,70 @@
+#ifndef METERBAR_H
+#define METERBAR_H
+
+#include <QWidget>
+
+#include "levelmeter.h"
+
+/*
+============================================================
+ MeterBar
+------------------------------------------------------------
+ - Horizontal level meter for one LevelMeter reading:
+     bar        RMS, green / amber / red zones
+     thin line  peak, held 1.5 s, then falling 20 dB/s
+     text       short-term loudness (LUFS)
+     red tip    clip (peak at 0 dBFS), latched 2 s
+ - Fed by its owner's display tick (setReading), so it
+   needs no timer of its own; painted directly and only
+   repainted when the picture changes
+ - atRest(): nothing left to animate, the owner may stop
+   ticking it
+============================================================
+*/
+
+class MeterBar : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MeterBar(QWidget *parent = nullptr);
+
+    void setReading(const LevelMeter::Reading &reading, qint64 nowMs);
+    void clear();
+    bool atRest() const;
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *) override;
+    void resizeEvent(QResizeEvent *) override;
+
+private:
+    // What is drawn, in pixels / text; repaint only on change
+    struct Picture {
+        int rmsX = 0;
+        int peakX = 0;
+        bool clip = false;
+        QString text;
+        bool operator==(const Picture &o) const
+        {
+            return rmsX == o.rmsX && peakX == o.peakX && clip == o.clip && text == o.text;
+        }
+    };
+
+    int dbToX(double db, int width) const;
+    void refresh();
+
+    double m_rmsDb = -100.0;
+    double m_peakDb = -100.0;       // after hold / fall-off
+    qint64 m_peakHoldUntil = 0;
+    qint64 m_lastMs = 0;
+    qint64 m_clipUntil = 0;
+    qint64 m_nowMs = 0;
+    float m_lufs = -70.0f;
+    bool m_active = false;
+    Picture m_shown;
+};
+
+#endif // METERBAR_H
@@ -0,0 +1,67 @@
+#include "nullaudiosink.h"
+#include "audioengine.h"
+
+#include <QIODevice>
+
+static const int kPeriodMs = 5;             // Realtime: timer period
+static const int kMaxCatchUpMs = 100;       // Realtime: a stalled thread does not burst more than this
+
+NullAudioSink::NullAudioSink(QIODevice *source, const QAudioFormat &format, Clock clock)
+    : m_source(source),
+      m_format(format),
+      m_clock(clock)
+{
+    m_scratch.resize(AudioEngine::kBlockFrames * format.bytesPerFrame());
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(kPeriodMs);
+    QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this] { onTimer(); });
+}
+
+/* ============================================================
+ * CLOCK
+ * ============================================================ */
+void NullAudioSink::start()
+{
+    if (m_clock != Clock::Realtime)
+        return;
+    m_wall.start();
+    // A device starts by filling its buffer
+    pull(qint64(m_format.sampleRate()) * kBufferMs / 1000);
+    m_timer.start();
+}
+
+void NullAudioSink::stop()
+{
+    m_timer.stop();
+}
+
+void NullAudioSink::advance(qint64 frames)
+{
+    if (m_clock == Clock::Manual && frames > 0)
+        pull(frames);
+}
+
+// Wall time plus the buffer is what a device would have taken
+void NullAudioSink::onTimer()
+{
+    const qint64 rate = m_format.sampleRate();
+    const qint64 due = (m_wall.elapsed() + kBufferMs) * rate / 1000 - framesPlayed();
+    pull(qMin(due, rate * kMaxCatchUpMs / 1000));
+}
+
+/* ============================================================
+ * PULL – one engine block at a time
+ * ============================================================ */
+void NullAudioSink::pull(qint64 frames)
+{
+    const int bytesPerFrame = m_format.bytesPerFrame();
+    while (frames > 0)
+    {
+        const qint64 n = qMin<qint64>(frames, AudioEngine::kBlockFrames);
+        const qint64 got = m_source->read(m_scratch.data(), n * bytesPerFrame) / bytesPerFrame;
+        if (got <= 0)
+            return;
+        m_played.fetch_add(got, std::memory_order_acq_rel);
+        frames -= got;
+    }
+}
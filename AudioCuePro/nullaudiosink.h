@@ -0,0 +1,73 @@
+#ifndef NULLAUDIOSINK_H
+#define NULLAUDIOSINK_H
+
+#include <QAudioFormat>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+
+class QIODevice;
+
+/*
+============================================================
+ NullAudioSink
+------------------------------------------------------------
+ - Stands in for QAudioSink where there is no sound hardware
+   (CI, a server, a headless benchmark): pulls the engine's
+   render device like a device would and throws the audio
+   away
+ - Its clock is a sample count, not wall time. framesPlayed()
+   is the position of everything the engine has rendered, to
+   the sample; what the GUI sees of it (FrameTicker time,
+   AudioEngine::advanceClock) is whole ms, once per display
+   frame
+ - Two clocks:
+     Realtime  a timer on the owning thread keeps the count
+               in step with wall time, one device buffer
+               ahead (kBufferMs), like a sound card would
+     Manual    nothing moves until advance() is called, then
+               exactly that many frames are rendered on the
+               caller's thread, as fast as the CPU allows
+ - Chosen by AudioEngine (ACP_AUDIO_OUTPUT=null / virtual, or
+   no output device at all), see EngineOutput
+============================================================
+*/
+
+class NullAudioSink
+{
+public:
+    enum class Clock { Realtime, Manual };
+    static constexpr int kBufferMs = 20;
+
+    NullAudioSink(QIODevice *source, const QAudioFormat &format, Clock clock);
+    NullAudioSink(const NullAudioSink &) = delete;
+    NullAudioSink &operator=(const NullAudioSink &) = delete;
+
+    Clock clock() const { return m_clock; }
+    double bufferMs() const { return m_clock == Clock::Realtime ? kBufferMs : 0.0; }
+
+    // Realtime: from the thread the sink lives on
+    void start();
+    void stop();
+
+    // Manual: render `frames` frames now
+    void advance(qint64 frames);
+
+    // Frames rendered so far (the virtual sample clock); any thread
+    qint64 framesPlayed() const { return m_played.load(std::memory_order_acquire); }
+
+private:
+    void pull(qint64 frames);
+    void onTimer();
+
+    QIODevice *m_source;
+    const QAudioFormat m_format;
+    const Clock m_clock;
+    QTimer m_timer;
+    QElapsedTimer m_wall;
+    QVector<char> m_scratch;
+    std::atomic<qint64> m_played { 0 };
+};
+
+#endif // NULLAUDIOSINK_H
@@ -0,0 +1,164 @@
+#include "regionstream.h"
+#include "showpackage.h"
+
+#include <QAudioDecoder>
+#include <QUrl>
+#include <cmath>
+#include <limits>
+
+static const int kChunkFrames = 4096;           // per piece: well inside a voice's ring at any speed
+static const int kReadAheadMs = 2000;           // decoded ahead of the reader
+static const int kWaitMs = 50;                  // cancel checks while the decoder catches up
+
+RegionStream::RegionStream(const QString &path, double startSeconds, double endSeconds)
+    : m_path(path), m_start(startSeconds), m_end(endSeconds), m_context(new QObject)
+{
+    m_context->moveToThread(&m_thread);
+    QObject::connect(&m_thread, &QThread::finished, m_context, &QObject::deleteLater);
+    m_thread.start();
+    QMetaObject::invokeMethod(m_context, [this]() { open(); });
+}
+
+RegionStream::~RegionStream()
+{
+    // The decoder is deleted on the thread it runs on
+    QMetaObject::invokeMethod(m_context, [this]() {
+        delete m_decoder;
+        m_decoder = nullptr;
+        delete m_entry;
+        m_entry = nullptr;
+    }, Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+/* ============================================================
+ * READER
+ * ============================================================ */
+bool RegionStream::next(QAudioBuffer *buffer, const std::function<bool()> &canceled)
+{
+    QMutexLocker lock(&m_mutex);
+    while (m_queue.isEmpty() && !m_done)
+    {
+        if (canceled())
+            return false;
+        m_changed.wait(&m_mutex, kWaitMs);
+    }
+    if (m_queue.isEmpty() || !m_error.isEmpty())
+        return false;
+
+    *buffer = m_queue.dequeue();
+    m_queuedFrames -= buffer->frameCount();
+    if (m_waiting)
+    {
+        m_waiting = false;
+        QMetaObject::invokeMethod(m_context, [this]() { read(); });
+    }
+    return true;
+}
+
+QString RegionStream::error() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_error;
+}
+
+/* ============================================================
+ * DECODING THREAD
+ * ============================================================ */
+void RegionStream::open()
+{
+    m_decoder = new QAudioDecoder;
+    if (ShowPackage::isEntryPath(m_path))
+    {
+        m_entry = ShowPackage::openEntryPath(m_path);
+        if (!m_entry)
+        {
+            end(QObject::tr("Not found in the show package"));
+            return;
+        }
+        m_decoder->setSourceDevice(m_entry);
+    }
+    else
+    {
+        m_decoder->setSource(QUrl::fromLocalFile(m_path));
+    }
+
+    QObject::connect(m_decoder, &QAudioDecoder::bufferReady, m_context, [this]() { read(); });
+    QObject::connect(m_decoder, &QAudioDecoder::finished, m_context, [this]() {
+        m_finished = true;
+        read();
+    });
+    QObject::connect(m_decoder, qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), m_context,
+                     [this](QAudioDecoder::Error) { end(m_decoder->errorString()); });
+
+    m_decoder->start();
+    if (m_decoder->error() != QAudioDecoder::NoError)
+        end(m_decoder->errorString());
+}
+
+void RegionStream::read()
+{
+    while (m_decoder && m_decoder->bufferAvailable())
+    {
+        {
+            QMutexLocker lock(&m_mutex);
+            if (m_done)
+                return;
+            if (m_sampleRate > 0 && m_queuedFrames * 1000 >= qint64(m_sampleRate) * kReadAheadMs)
+            {
+                m_waiting = true;
+                return;
+            }
+        }
+
+        const QAudioBuffer buf = m_decoder->read();
+        const QAudioFormat fmt = buf.format();
+        const qint64 frames = buf.frameCount();
+        if (!fmt.isValid() || frames <= 0)
+            continue;
+
+        const qint64 first = std::llround(m_start * fmt.sampleRate());
+        const qint64 last = m_end > m_start ? std::llround(m_end * fmt.sampleRate())
+                                            : std::numeric_limits<qint64>::max();
+        const qint64 from = qMax(first, m_position);
+        const qint64 to = qMin(last, m_position + frames);
+        const int bytesPerFrame = fmt.bytesPerFrame();
+        {
+            QMutexLocker lock(&m_mutex);
+            m_sampleRate = fmt.sampleRate();
+            for (qint64 at = from; at < to; at += kChunkFrames)
+            {
+                const qint64 n = qMin<qint64>(kChunkFrames, to - at);
+                if (n == frames)
+                    m_queue.enqueue(buf);
+                else
+                    m_queue.enqueue(QAudioBuffer(QByteArray(buf.constData<char>() + (at - m_position) * bytesPerFrame,
+                                                            n * bytesPerFrame),
+                                                 fmt));
+                m_queuedFrames += n;
+            }
+            m_changed.wakeAll();
+        }
+
+        m_position += frames;
+        if (m_position >= last)
+        {
+            m_decoder->stop();
+            end(QString());
+            return;
+        }
+    }
+    if (m_finished)
+        end(QString());
+}
+
+void RegionStream::end(const QString &error)
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_done)
+        return;
+    m_done = true;
+    m_error = error;
+    m_changed.wakeAll();
+}
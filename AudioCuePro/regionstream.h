@@ -0,0 +1,76 @@
+#ifndef REGIONSTREAM_H
+#define REGIONSTREAM_H
+
+#include <QAudioBuffer>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <functional>
+
+class QAudioDecoder;
+class QIODevice;
+
+/*
+============================================================
+ RegionStream
+------------------------------------------------------------
+ - A cue's region (start / end) of an audio file or package
+   entry, decoded on a thread of its own and read from
+   another one, as fast as the reader wants it
+ - Used where audio follows a sample clock instead of a
+   player's: ShowRender, and cues on the virtual clock
+   (VirtualPlayer)
+ - Decodes at most 2 s ahead of the reader. The decoder
+   hands over one buffer at a time and goes on only after
+   read(), so reading while the queue has room is all the
+   flow control there is; the decoding thread never blocks
+ - Buffers are cut to the region by frame count, not by
+   their time stamps, so the same file always streams the
+   same; pieces are at most 4096 frames
+============================================================
+*/
+
+class RegionStream
+{
+public:
+    // endSeconds <= startSeconds: to the end of the file
+    RegionStream(const QString &path, double startSeconds, double endSeconds);
+    ~RegionStream();
+    RegionStream(const RegionStream &) = delete;
+    RegionStream &operator=(const RegionStream &) = delete;
+
+    // The next piece of the region, waiting for the decoder while
+    // it is behind. False at the end of the region, on cancel, or
+    // on an error (see error())
+    bool next(QAudioBuffer *buffer, const std::function<bool()> &canceled);
+    QString error() const;
+
+private:
+    // Decoding thread
+    void open();
+    void read();
+    void end(const QString &error);
+
+    const QString m_path;
+    const double m_start;
+    const double m_end;
+    QThread m_thread;
+    QObject *m_context;                 // lives on m_thread
+    QAudioDecoder *m_decoder = nullptr;
+    QIODevice *m_entry = nullptr;       // package entry: outlives the decoder reading it
+    qint64 m_position = 0;              // source frames delivered
+    bool m_finished = false;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_changed;
+    QQueue<QAudioBuffer> m_queue;
+    qint64 m_queuedFrames = 0;
+    int m_sampleRate = 0;
+    bool m_waiting = false;             // read-ahead full, decoder held back
+    bool m_done = false;
+    QString m_error;
+};
+
+#endif // REGIONSTREAM_H
@@ -0,0 +1,364 @@
+#include "resampler.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QtMath>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#  include <immintrin.h>
+#  define ACP_RESAMPLER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ACP_RESAMPLER_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define ACP_RESAMPLER_NEON
+#endif
+
+static const int kStepUnits = 16;           // steps are designed for in 1/16ths
+static const int kMaxStepKey = 32 * kStepUnits;
+static const int kMaxTaps = 1024;
+
+struct Resampler::Kernel
+{
+    int taps = 0;                       // a multiple of 8
+    int phases = 0;
+    QVector<float> coeffs;              // phases + 1 rows of taps
+    const float *row(int phase) const { return coeffs.constData() + phase * taps; }
+};
+
+namespace {
+
+// Band edges are fractions of the lower of the two rates, so the
+// transition sits across that rate's Nyquist: flat to `passband`,
+// `stopbandDb` down from `stopband` on. The taps follow from them
+struct Preset {
+    double passband;
+    double stopband;
+    double stopbandDb;
+    int phases;                         // linear interpolation between them stays under the stopband
+};
+
+Preset presetFor(Resampler::Quality quality)
+{
+    switch (quality)
+    {
+    case Resampler::Quality::Fast:     return { 0.40, 0.60, 60.0, 128 };
+    case Resampler::Quality::High:     return { 0.47, 0.53, 120.0, 1024 };
+    case Resampler::Quality::Standard: break;
+    }
+    return { 0.45, 0.55, 96.0, 512 };
+}
+
+// Modified Bessel function of the first kind, order 0
+double besselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    const double q = x * x / 4.0;
+    for (int k = 1; k < 64 && term > sum * 1e-12; ++k)
+    {
+        term *= q / (double(k) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+/* ============================================================
+ * INNER PRODUCT – two phases against both channels:
+ *   acc = { a.l, a.r, b.l, b.r }, n a multiple of 8
+ * ============================================================ */
+void dotScalar(const float *a, const float *b, const float *l, const float *r, int n, float *acc)
+{
+    float al = 0.0f, ar = 0.0f, bl = 0.0f, br = 0.0f;
+    for (int k = 0; k < n; ++k)
+    {
+        al += a[k] * l[k];
+        ar += a[k] * r[k];
+        bl += b[k] * l[k];
+        br += b[k] * r[k];
+    }
+    acc[0] = al; acc[1] = ar; acc[2] = bl; acc[3] = br;
+}
+
+#if defined(ACP_RESAMPLER_AVX2)
+
+float horizontalSum(__m256 v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+void dot(const float *a, const float *b, const float *l, const float *r, int n, float *acc)
+{
+    __m256 al = _mm256_setzero_ps(), ar = al, bl = al, br = al;
+    for (int k = 0; k < n; k += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(l + k);
+        const __m256 y = _mm256_loadu_ps(r + k);
+        const __m256 ha = _mm256_loadu_ps(a + k);
+        const __m256 hb = _mm256_loadu_ps(b + k);
+        al = _mm256_fmadd_ps(ha, x, al);
+        ar = _mm256_fmadd_ps(ha, y, ar);
+        bl = _mm256_fmadd_ps(hb, x, bl);
+        br = _mm256_fmadd_ps(hb, y, br);
+    }
+    acc[0] = horizontalSum(al);
+    acc[1] = horizontalSum(ar);
+    acc[2] = horizontalSum(bl);
+    acc[3] = horizontalSum(br);
+}
+
+#elif defined(ACP_RESAMPLER_SSE2)
+
+void dot(const float *a, const float *b, const float *l, const float *r, int n, float *acc)
+{
+    __m128 al = _mm_setzero_ps(), ar = al, bl = al, br = al;
+    for (int k = 0; k < n; k += 4)
+    {
+        const __m128 x = _mm_loadu_ps(l + k);
+        const __m128 y = _mm_loadu_ps(r + k);
+        const __m128 ha = _mm_loadu_ps(a + k);
+        const __m128 hb = _mm_loadu_ps(b + k);
+        al = _mm_add_ps(al, _mm_mul_ps(ha, x));
+        ar = _mm_add_ps(ar, _mm_mul_ps(ha, y));
+        bl = _mm_add_ps(bl, _mm_mul_ps(hb, x));
+        br = _mm_add_ps(br, _mm_mul_ps(hb, y));
+    }
+    // Transpose-and-add: lane i of the result is the sum of vector i
+    _MM_TRANSPOSE4_PS(al, ar, bl, br);
+    _mm_storeu_ps(acc, _mm_add_ps(_mm_add_ps(al, ar), _mm_add_ps(bl, br)));
+}
+
+#elif defined(ACP_RESAMPLER_NEON)
+
+void dot(const float *a, const float *b, const float *l, const float *r, int n, float *acc)
+{
+    float32x4_t al = vdupq_n_f32(0.0f), ar = al, bl = al, br = al;
+    for (int k = 0; k < n; k += 4)
+    {
+        const float32x4_t x = vld1q_f32(l + k);
+        const float32x4_t y = vld1q_f32(r + k);
+        const float32x4_t ha = vld1q_f32(a + k);
+        const float32x4_t hb = vld1q_f32(b + k);
+        al = vmlaq_f32(al, ha, x);
+        ar = vmlaq_f32(ar, ha, y);
+        bl = vmlaq_f32(bl, hb, x);
+        br = vmlaq_f32(br, hb, y);
+    }
+    const float32x2_t s0 = vpadd_f32(vget_low_f32(al), vget_high_f32(al));
+    const float32x2_t s1 = vpadd_f32(vget_low_f32(ar), vget_high_f32(ar));
+    const float32x2_t s2 = vpadd_f32(vget_low_f32(bl), vget_high_f32(bl));
+    const float32x2_t s3 = vpadd_f32(vget_low_f32(br), vget_high_f32(br));
+    vst1q_f32(acc, vcombine_f32(vpadd_f32(s0, s1), vpadd_f32(s2, s3)));
+}
+
+#else
+
+void dot(const float *a, const float *b, const float *l, const float *r, int n, float *acc)
+{
+    dotScalar(a, b, l, r, n, acc);
+}
+
+#endif
+
+} // namespace
+
+/* ============================================================
+ * KERNELS – designed once per quality and step, shared
+ * ============================================================ */
+std::shared_ptr<const Resampler::Kernel> Resampler::kernelFor(Quality quality, int stepKey)
+{
+    static QMutex mutex;
+    static QHash<int, std::weak_ptr<const Kernel>> cache;
+    QMutexLocker lock(&mutex);
+
+    const int id = int(quality) << 16 | stepKey;
+    if (std::shared_ptr<const Kernel> kernel = cache.value(id).lock())
+        return kernel;
+
+    const Preset preset = presetFor(quality);
+    const double step = double(stepKey) / kStepUnits;
+
+    // Kaiser: the transition width and stopband fix the length.
+    // Edges in input cycles per frame; going down in rate the
+    // lower rate is the output's, 1 / step of the input's
+    const double lower = step > 1.0 ? 1.0 / step : 1.0;
+    const double transition = (preset.stopband - preset.passband) * lower;
+    const double cutoff = (preset.passband + preset.stopband) / 2.0 * lower;
+    const int order = int(std::ceil((preset.stopbandDb - 7.95) / (14.36 * transition)));
+
+    auto kernel = std::make_shared<Kernel>();
+    kernel->taps = qMin(kMaxTaps, (order + 1 + 7) & ~7);
+    kernel->phases = preset.phases;
+
+    // Capped taps widen the transition about the same centre
+    const int taps = kernel->taps;
+    const double beta = 0.1102 * (preset.stopbandDb - 8.7);
+    const double norm = besselI0(beta);
+    const int half = taps / 2;
+
+    kernel->coeffs.resize((preset.phases + 1) * taps);
+    for (int p = 0; p <= preset.phases; ++p)
+    {
+        float *row = kernel->coeffs.data() + p * taps;
+        const double frac = double(p) / preset.phases;
+        double sum = 0.0;
+        for (int k = 0; k < taps; ++k)
+        {
+            // Distance of tap k from the output frame's centre
+            const double d = k - (half - 1) - frac;
+            const double x = d / half;
+            const double window = besselI0(beta * std::sqrt(qMax(0.0, 1.0 - x * x))) / norm;
+            const double arg = 2.0 * cutoff * d;
+            const double sinc = std::fabs(arg) < 1e-9 ? 1.0 : std::sin(M_PI * arg) / (M_PI * arg);
+            const double h = 2.0 * cutoff * sinc * window;
+            row[k] = float(h);
+            sum += h;
+        }
+        // Unity gain at DC for every phase: no ripple as it moves
+        for (int k = 0; k < taps; ++k)
+            row[k] = float(row[k] / sum);
+    }
+
+    cache.insert(id, kernel);
+    return kernel;
+}
+
+/* ============================================================
+ * RESAMPLER
+ * ============================================================ */
+Resampler::Resampler(Quality quality)
+    : m_quality(quality)
+{
+}
+
+QString Resampler::qualityName(Quality quality)
+{
+    switch (quality)
+    {
+    case Quality::Fast:     return QStringLiteral("Fast");
+    case Quality::Standard: return QStringLiteral("Standard");
+    case Quality::High:     return QStringLiteral("High");
+    }
+    return QString();
+}
+
+void Resampler::setQuality(Quality quality)
+{
+    if (quality == m_quality)
+        return;
+    m_quality = quality;
+    m_kernelKey = -1;                   // redesigned at the next process()
+}
+
+void Resampler::reset()
+{
+    m_frames = 0;
+    m_pos = 0.0;
+    if (m_kernel)
+    {
+        // Zeros ahead of the first frame, so the first output is
+        // centred on it
+        const int lead = m_kernel->taps / 2 - 1;
+        if (m_left.size() < lead)
+        {
+            m_left.resize(lead);
+            m_right.resize(lead);
+        }
+        std::memset(m_left.data(), 0, sizeof(float) * lead);
+        std::memset(m_right.data(), 0, sizeof(float) * lead);
+        m_frames = lead;
+        m_pos = lead;
+    }
+}
+
+int Resampler::outputFrames(int frames, double step)
+{
+    return int(std::ceil(frames / step)) + 2;
+}
+
+int Resampler::latencyFrames() const
+{
+    return m_kernel ? m_kernel->taps / 2 : 0;
+}
+
+void Resampler::prepare(double step)
+{
+    const int key = step <= 1.0 ? kStepUnits
+                                : qMin(kMaxStepKey, int(std::ceil(step * kStepUnits)));
+    if (key == m_kernelKey)
+        return;
+    m_kernel = kernelFor(m_quality, key);
+    m_kernelKey = key;
+
+    // A wider kernel reaches further back than the history kept
+    // for the old one: the frames before it are silence
+    const int missing = m_kernel->taps / 2 - 1 - int(std::floor(m_pos));
+    if (missing > 0)
+    {
+        m_left.insert(0, missing, 0.0f);
+        m_right.insert(0, missing, 0.0f);
+        m_frames += missing;
+        m_pos += missing;
+    }
+}
+
+int Resampler::process(const float *in, int frames, double step, float *out, int maxFrames)
+{
+    if (step <= 0.0)
+        return 0;
+    prepare(step);
+    const Kernel &kernel = *m_kernel;
+    const int taps = kernel.taps;
+    const int half = taps / 2;
+
+    // Append, one channel each
+    if (m_left.size() < m_frames + frames)
+    {
+        m_left.resize(m_frames + frames);
+        m_right.resize(m_frames + frames);
+    }
+    float *left = m_left.data();
+    float *right = m_right.data();
+    for (int f = 0; f < frames; ++f)
+    {
+        left[m_frames + f] = in[2 * f];
+        right[m_frames + f] = in[2 * f + 1];
+    }
+    m_frames += frames;
+
+    int produced = 0;
+    float acc[4];
+    while (produced < maxFrames)
+    {
+        const int centre = int(m_pos);
+        const int start = centre - half + 1;
+        if (start + taps > m_frames)
+            break;
+        const double phase = (m_pos - centre) * kernel.phases;
+        const int p = int(phase);
+        const float t = float(phase - p);
+        dot(kernel.row(p), kernel.row(p + 1), left + start, right + start, taps, acc);
+        out[2 * produced]     = acc[0] + (acc[2] - acc[0]) * t;
+        out[2 * produced + 1] = acc[1] + (acc[3] - acc[1]) * t;
+        ++produced;
+        m_pos += step;
+    }
+
+    // Drop what no later output reaches back to
+    const int drop = qBound(0, int(m_pos) - half + 1, m_frames);
+    if (drop > 0)
+    {
+        std::memmove(left, left + drop, sizeof(float) * (m_frames - drop));
+        std::memmove(right, right + drop, sizeof(float) * (m_frames - drop));
+        m_frames -= drop;
+        m_pos -= drop;
+    }
+    return produced;
+}
@@ -0,0 +1,226 @@
+#include "routingdialog.h"
+
+#include <QAudioDevice>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMediaDevices>
+#include <QPushButton>
+#include <QSet>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+#include "frameticker.h"
+#include "meterbar.h"
+
+namespace {
+
+enum Column { ColName, ColDevice, ColChannels, ColGain, ColMute, ColLevel, ColumnCount };
+
+// Row of a cell widget; rows move when buses are removed
+int rowOf(const QTableWidget *table, int column, const QObject *widget)
+{
+    for (int row = 0; row < table->rowCount(); ++row)
+        if (table->cellWidget(row, column) == widget)
+            return row;
+    return -1;
+}
+
+} // namespace
+
+RoutingDialog::RoutingDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle(tr("Output Routing"));
+    resize(760, 320);
+
+    auto *layout = new QVBoxLayout(this);
+    layout->addWidget(new QLabel(tr("Each bus plays on one channel pair of one device. "
+                                    "Pick a cue's buses with its \"Out:\" menu.")));
+
+    table = new QTableWidget(0, ColumnCount, this);
+    table->setHorizontalHeaderLabels({ tr("Bus"), tr("Device"), tr("Channels"),
+                                       tr("Gain"), tr("Mute"), tr("Level") });
+    table->verticalHeader()->hide();
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setSelectionMode(QAbstractItemView::SingleSelection);
+    table->horizontalHeader()->setSectionResizeMode(ColDevice, QHeaderView::Stretch);
+    layout->addWidget(table);
+
+    auto *rowButtons = new QHBoxLayout;
+    btnAdd = new QPushButton(tr("Add Bus"), this);
+    btnRemove = new QPushButton(tr("Remove Bus"), this);
+    rowButtons->addWidget(btnAdd);
+    rowButtons->addWidget(btnRemove);
+    rowButtons->addStretch();
+    layout->addLayout(rowButtons);
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+    connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    layout->addWidget(buttons);
+
+    AudioEngine *engine = AudioEngine::instance();
+    original = engine->routing();
+    for (int bus = 0; bus < original.size(); ++bus)
+        addRow(original[bus], bus);
+
+    connect(btnAdd, &QPushButton::clicked, this, [this]() {
+        AudioEngine::BusConfig bus;
+        bus.name = tr("Bus %1").arg(table->rowCount() + 1);
+        addRow(bus, -1);
+        updateButtons();
+    });
+    connect(btnRemove, &QPushButton::clicked, this, &RoutingDialog::removeSelected);
+    connect(table, &QTableWidget::itemSelectionChanged, this, &RoutingDialog::updateButtons);
+    updateButtons();
+
+    // Meters of the buses as they run now; rows added here have
+    // nothing to show until OK
+    FrameTicker::instance()->subscribe(this, [this, engine](qint64 now, qint64) {
+        for (int row = 0; row < table->rowCount(); ++row)
+        {
+            const int bus = table->item(row, ColName)->data(Qt::UserRole).toInt();
+            if (bus >= 0)
+                static_cast<MeterBar *>(table->cellWidget(row, ColLevel))
+                    ->setReading(engine->busMeter(bus).reading(), now);
+        }
+    });
+}
+
+void RoutingDialog::addRow(const AudioEngine::BusConfig &bus, int engineBus)
+{
+    const int row = table->rowCount();
+    table->insertRow(row);
+
+    auto *name = new QTableWidgetItem(bus.name);
+    name->setData(Qt::UserRole, engineBus);
+    table->setItem(row, ColName, name);
+
+    // Devices by id; one that is gone stays listed, so the routing
+    // survives a show being opened on another machine
+    auto *device = new QComboBox(table);
+    device->addItem(tr("System default"), QByteArray());
+    for (const QAudioDevice &d : QMediaDevices::audioOutputs())
+        device->addItem(d.description(), d.id());
+    int index = device->findData(bus.deviceId);
+    if (index < 0)
+    {
+        device->addItem(tr("Unavailable: %1").arg(QString::fromUtf8(bus.deviceId)), bus.deviceId);
+        index = device->count() - 1;
+    }
+    device->setCurrentIndex(index);
+    table->setCellWidget(row, ColDevice, device);
+
+    table->setCellWidget(row, ColChannels, new QComboBox(table));
+    fillChannels(row, bus.firstChannel);
+    connect(device, &QComboBox::currentIndexChanged, this, [this, device]() {
+        const int r = rowOf(table, ColDevice, device);
+        auto *channels = static_cast<QComboBox *>(table->cellWidget(r, ColChannels));
+        fillChannels(r, channels->currentData().toInt());
+    });
+
+    auto *gain = new QDoubleSpinBox(table);
+    gain->setRange(-60.0, 12.0);
+    gain->setDecimals(1);
+    gain->setSuffix(tr(" dB"));
+    gain->setValue(bus.gainDb);
+    table->setCellWidget(row, ColGain, gain);
+
+    auto *mute = new QCheckBox(table);
+    mute->setChecked(bus.muted);
+    table->setCellWidget(row, ColMute, mute);
+
+    // Live on the running bus
+    if (engineBus >= 0)
+    {
+        connect(gain, &QDoubleSpinBox::valueChanged, this, [engineBus](double db) {
+            AudioEngine::instance()->setBusGain(engineBus, float(db));
+        });
+        connect(mute, &QCheckBox::toggled, this, [engineBus](bool on) {
+            AudioEngine::instance()->setBusMuted(engineBus, on);
+        });
+    }
+
+    auto *meter = new MeterBar(table);
+    meter->setFixedHeight(14);
+    table->setCellWidget(row, ColLevel, meter);
+}
+
+// Channel pairs the row's device has (at least 1-2)
+void RoutingDialog::fillChannels(int row, int firstChannel)
+{
+    auto *device = static_cast<QComboBox *>(table->cellWidget(row, ColDevice));
+    auto *channels = static_cast<QComboBox *>(table->cellWidget(row, ColChannels));
+
+    const QByteArray id = device->currentData().toByteArray();
+    QAudioDevice d = QMediaDevices::defaultAudioOutput();
+    for (const QAudioDevice &o : QMediaDevices::audioOutputs())
+        if (!id.isEmpty() && o.id() == id)
+            d = o;
+    const int count = qMax(d.isNull() ? 2 : d.maximumChannelCount(), firstChannel + 2);
+
+    channels->clear();
+    for (int c = 0; c + 1 < count; c += 2)
+        channels->addItem(QStringLiteral("%1-%2").arg(c + 1).arg(c + 2), c);
+    channels->setCurrentIndex(qMax(0, channels->findData(firstChannel)));
+}
+
+void RoutingDialog::removeSelected()
+{
+    const int row = table->currentRow();
+    if (row <= 0)
+        return;
+    table->removeRow(row);
+    updateButtons();
+}
+
+void RoutingDialog::updateButtons()
+{
+    btnAdd->setEnabled(table->rowCount() < AudioEngine::kMaxBuses);
+    btnRemove->setEnabled(table->currentRow() > 0);
+}
+
+AudioEngine::Routing RoutingDialog::routing() const
+{
+    AudioEngine::Routing routing;
+    QSet<QString> used;
+    for (int row = 0; row < table->rowCount(); ++row)
+    {
+        AudioEngine::BusConfig bus;
+        QString name = table->item(row, ColName)->text().trimmed();
+        if (name.isEmpty())
+            name = row == 0 ? QStringLiteral("Main") : tr("Bus %1").arg(row + 1);
+        const QString base = name;
+        for (int n = 2; used.contains(name); ++n)
+            name = QStringLiteral("%1 %2").arg(base).arg(n);
+        used.insert(name);
+        bus.name = name;
+
+        bus.deviceId = static_cast<QComboBox *>(table->cellWidget(row, ColDevice))->currentData().toByteArray();
+        bus.firstChannel = static_cast<QComboBox *>(table->cellWidget(row, ColChannels))->currentData().toInt();
+        bus.gainDb = float(static_cast<QDoubleSpinBox *>(table->cellWidget(row, ColGain))->value());
+        bus.muted = static_cast<QCheckBox *>(table->cellWidget(row, ColMute))->isChecked();
+        routing.append(bus);
+    }
+    return routing;
+}
+
+void RoutingDialog::done(int result)
+{
+    // Cancel: the live gain / mute moves are undone
+    if (result != QDialog::Accepted)
+    {
+        AudioEngine *engine = AudioEngine::instance();
+        for (int bus = 0; bus < original.size(); ++bus)
+        {
+            engine->setBusGain(bus, original[bus].gainDb);
+            engine->setBusMuted(bus, original[bus].muted);
+        }
+    }
+    QDialog::done(result);
+}
@@ -0,0 +1,53 @@
+#ifndef ROUTINGDIALOG_H
+#define ROUTINGDIALOG_H
+
+#include <QDialog>
+
+#include "audioengine.h"
+
+class QTableWidget;
+class QPushButton;
+
+/*
+============================================================
+ RoutingDialog
+------------------------------------------------------------
+ - Settings > Output Routing: one row per bus of the
+   AudioEngine — name, device, channel pair, gain, mute and a
+   live meter
+ - Gain and mute act at once (and are put back on Cancel);
+   names, devices and channels take effect on OK, when the
+   engine reopens its devices
+ - Bus 0 ("Main") cannot be removed: cues that name no bus,
+   or only buses that no longer exist, play there
+ - Cues refer to buses by name, so renaming a bus here moves
+   no cue onto it; the cue's "Out:" menu does
+============================================================
+*/
+
+class RoutingDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit RoutingDialog(QWidget *parent = nullptr);
+
+    // What the table says, names made unique and non-empty
+    AudioEngine::Routing routing() const;
+
+protected:
+    void done(int result) override;
+
+private:
+    void addRow(const AudioEngine::BusConfig &bus, int engineBus);
+    void fillChannels(int row, int firstChannel);
+    void removeSelected();
+    void updateButtons();
+
+    QTableWidget *table = nullptr;
+    QPushButton *btnAdd = nullptr;
+    QPushButton *btnRemove = nullptr;
+    AudioEngine::Routing original;      // restored on Cancel
+};
+
+#endif // ROUTINGDIALOG_H
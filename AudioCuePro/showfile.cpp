@@ -0,0 +1,257 @@
+#include "showfile.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtEndian>
+
+static const char kMagic[4] = { 'A', 'C', 'P', 'S' };
+static const quint32 kVersion = 1;
+static const qint64 kPreambleSize = 12;   // magic + version + header size
+
+/* ============================================================
+ * FORMAT DETECTION
+ * ============================================================ */
+bool ShowFile::isBinary(const QString &path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+    return f.read(4) == QByteArray(kMagic, 4);
+}
+
+bool ShowFile::isBinaryPath(const QString &path)
+{
+    return QFileInfo(path).suffix().compare(QStringLiteral("acps"), Qt::CaseInsensitive) == 0;
+}
+
+/* ============================================================
+ * WRITE
+ * ============================================================ */
+QByteArray ShowFile::encode(const QJsonObject &root)
+{
+    // Sections first, so the header can carry their offsets
+    QByteArray sections;
+    QCborArray index;
+
+    const QJsonArray scenes = root["scenes"].toArray();
+    for (const QJsonValue &sv : scenes)
+    {
+        const QJsonObject sobj = sv.toObject();
+        const QJsonArray tracks = sobj["tracks"].toArray();
+
+        QCborArray cues;
+        for (const QJsonValue &tv : tracks)
+            cues.append(QCborMap::fromJsonObject(tv.toObject()));
+
+        const QByteArray section = QCborValue(cues).toCbor();
+
+        QCborMap entry;
+        entry[QStringLiteral("name")]   = sobj["name"].toString();
+        entry[QStringLiteral("offset")] = qint64(sections.size());
+        entry[QStringLiteral("size")]   = qint64(section.size());
+        entry[QStringLiteral("tracks")] = qint64(tracks.size());
+        index.append(entry);
+
+        sections += section;
+    }
+
+    QCborMap header;
+    header[QStringLiteral("audioFolder")] = root["audioFolder"].toString();
+    header[QStringLiteral("mediaStore")]  = root["mediaStore"].toInt();
+    header[QStringLiteral("scenes")]      = index;
+    const QByteArray headerBytes = QCborValue(header).toCbor();
+
+    QByteArray out;
+    out.reserve(kPreambleSize + headerBytes.size() + sections.size());
+    out.append(kMagic, 4);
+
+    char word[4];
+    qToBigEndian<quint32>(kVersion, word);
+    out.append(word, 4);
+    qToBigEndian<quint32>(quint32(headerBytes.size()), word);
+    out.append(word, 4);
+
+    out += headerBytes;
+    out += sections;
+    return out;
+}
+
+ShowFile::SaveResult ShowFile::save(const QString &path, const QJsonObject &root)
+{
+    SaveResult r;
+    QElapsedTimer t;
+    t.start();
+
+    const QByteArray data = isBinaryPath(path) ? encode(root)
+                                               : QJsonDocument(root).toJson();
+    r.encodeMs = t.restart();
+    r.bytes = data.size();
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+    {
+        r.error = f.errorString();
+        return r;
+    }
+
+    f.write(data);
+    r.ok = f.commit();
+    if (!r.ok)
+        r.error = f.errorString();
+    r.commitMs = t.elapsed();
+    return r;
+}
+
+/* ============================================================
+ * READER – header now, scenes on demand
+ * ============================================================ */
+bool ShowFile::Reader::open(const QString &path)
+{
+    m_file.close();
+    m_file.setFileName(path);
+
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        m_sections.clear();
+        m_device = nullptr;
+        m_error = QObject::tr("Cannot read file.");
+        return false;
+    }
+
+    return open(&m_file);
+}
+
+bool ShowFile::Reader::open(QIODevice *device)
+{
+    m_sections.clear();
+    m_device = device;
+
+    if (!m_device->seek(0))
+    {
+        m_error = QObject::tr("Cannot read file.");
+        return false;
+    }
+
+    const QByteArray preamble = m_device->read(kPreambleSize);
+    if (preamble.size() != kPreambleSize || !preamble.startsWith(QByteArray(kMagic, 4)))
+    {
+        m_error = QObject::tr("Not an AudioCuePro show file.");
+        return false;
+    }
+
+    const quint32 version = qFromBigEndian<quint32>(preamble.constData() + 4);
+    const quint32 headerSize = qFromBigEndian<quint32>(preamble.constData() + 8);
+    if (version > kVersion)
+    {
+        m_error = QObject::tr("The show was saved by a newer version of AudioCuePro.");
+        return false;
+    }
+
+    QCborParserError err;
+    const QCborMap header = QCborValue::fromCbor(m_device->read(headerSize), &err).toMap();
+    if (err.error != QCborError::NoError)
+    {
+        m_error = QObject::tr("Damaged show header: %1").arg(err.errorString());
+        return false;
+    }
+
+    m_dataStart = kPreambleSize + headerSize;
+    m_audioFolder = header[QStringLiteral("audioFolder")].toString();
+    m_mediaStore = int(header[QStringLiteral("mediaStore")].toInteger());
+
+    const qint64 dataSize = m_device->size() - m_dataStart;
+    const QCborArray index = header[QStringLiteral("scenes")].toArray();
+    for (const QCborValue &v : index)
+    {
+        const QCborMap entry = v.toMap();
+        Section s;
+        s.name   = entry[QStringLiteral("name")].toString(QStringLiteral("Scene"));
+        s.offset = entry[QStringLiteral("offset")].toInteger();
+        s.size   = entry[QStringLiteral("size")].toInteger();
+        s.tracks = int(entry[QStringLiteral("tracks")].toInteger());
+
+        if (s.offset < 0 || s.size < 0 || s.offset + s.size > dataSize)
+        {
+            m_error = QObject::tr("The show file is truncated.");
+            m_sections.clear();
+            return false;
+        }
+        m_sections.append(s);
+    }
+
+    return true;
+}
+
+QVector<QJsonObject> ShowFile::Reader::readScene(int i)
+{
+    QVector<QJsonObject> cues;
+    if (i < 0 || i >= m_sections.size())
+        return cues;
+
+    const Section &s = m_sections[i];
+    if (!m_device->seek(m_dataStart + s.offset))
+        return cues;
+
+    const QCborArray arr = QCborValue::fromCbor(m_device->read(s.size)).toArray();
+    cues.reserve(arr.size());
+    for (const QCborValue &v : arr)
+        cues.append(v.toMap().toJsonObject());
+    return cues;
+}
+
+/* ============================================================
+ * WHOLE SHOW (import / export / benchmark)
+ * ============================================================ */
+QJsonObject ShowFile::readRoot(const QString &path, QString *error)
+{
+    if (isBinary(path))
+    {
+        Reader reader;
+        if (!reader.open(path))
+        {
+            if (error) *error = reader.errorString();
+            return QJsonObject();
+        }
+
+        QJsonArray scenesArr;
+        for (int i = 0; i < reader.sceneCount(); ++i)
+        {
+            QJsonArray tracksArr;
+            for (const QJsonObject &cue : reader.readScene(i))
+                tracksArr.append(cue);
+
+            QJsonObject sobj;
+            sobj["name"] = reader.sceneName(i);
+            sobj["tracks"] = tracksArr;
+            scenesArr.append(sobj);
+        }
+
+        QJsonObject root;
+        root["audioFolder"] = reader.audioFolder();
+        root["mediaStore"] = reader.mediaStore();
+        root["scenes"] = scenesArr;
+        return root;
+    }
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        if (error) *error = QObject::tr("Cannot read file.");
+        return QJsonObject();
+    }
+
+    QJsonParseError err;
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &err);
+    if (err.error != QJsonParseError::NoError)
+    {
+        if (error) *error = err.errorString();
+        return QJsonObject();
+    }
+    return doc.object();
+}
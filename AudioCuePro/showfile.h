@@ -0,0 +1,98 @@
+#ifndef SHOWFILE_H
+#define SHOWFILE_H
+
+#include <QFile>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+/*
+============================================================
+ ShowFile
+------------------------------------------------------------
+ - Binary show format (.acps): a small CBOR header with the
+   show settings and a scene index, followed by one CBOR
+   section per scene
+
+     "ACPS"  u32 version  u32 headerSize
+     header  { audioFolder, mediaStore,
+               scenes: [ { name, offset, size, tracks } ] }
+     section per scene: [ cue, cue, ... ]   (offsets count
+                                             from the end of
+                                             the header)
+
+ - Cues are the same objects TrackWidget::toJson() writes,
+   stored as CBOR maps, so both formats carry the same data
+ - Reader parses only the header on open(); each scene is
+   read and decoded on demand, so the first scene can be on
+   screen before the rest of the file has been touched
+ - JSON (.acp.json) stays as the import/export format:
+   readRoot() loads either format into the JSON layout
+ - save() writes either format through QSaveFile, so a show
+   on disk is always the old version or the new one
+============================================================
+*/
+
+namespace ShowFile
+{
+    // True if the file starts with the binary magic
+    bool isBinary(const QString &path);
+    // True if a save path asks for the binary format
+    bool isBinaryPath(const QString &path);
+
+    // JSON show root ({ audioFolder, mediaStore, scenes }) → .acps bytes
+    QByteArray encode(const QJsonObject &root);
+
+    // Encode by suffix (.acps binary, anything else JSON) and replace
+    // `path` atomically via QSaveFile: a crash or a full disk leaves
+    // the previous file intact. Safe to call from a worker thread.
+    struct SaveResult {
+        bool ok = false;
+        QString error;
+        qint64 bytes = 0;
+        qint64 encodeMs = 0;
+        qint64 commitMs = 0;    // write + flush to disk + rename
+    };
+    SaveResult save(const QString &path, const QJsonObject &root);
+
+    // Whole show in the JSON layout, from either format
+    QJsonObject readRoot(const QString &path, QString *error = nullptr);
+
+    class Reader
+    {
+    public:
+        bool open(const QString &path);
+        // Show stored inside another file (a show package entry); the
+        // device must stay open while scenes are read
+        bool open(QIODevice *device);
+        QString errorString() const { return m_error; }
+
+        QString audioFolder() const { return m_audioFolder; }
+        int mediaStore() const { return m_mediaStore; }
+
+        int sceneCount() const { return m_sections.size(); }
+        QString sceneName(int i) const { return m_sections[i].name; }
+        int trackCount(int i) const { return m_sections[i].tracks; }
+
+        // Reads and decodes one scene's section
+        QVector<QJsonObject> readScene(int i);
+
+    private:
+        struct Section {
+            QString name;
+            qint64 offset = 0;
+            qint64 size = 0;
+            int tracks = 0;
+        };
+
+        QFile m_file;
+        QIODevice *m_device = nullptr;
+        QString m_error;
+        QString m_audioFolder;
+        int m_mediaStore = 0;
+        qint64 m_dataStart = 0;
+        QVector<Section> m_sections;
+    };
+}
+
+#endif // SHOWFILE_H
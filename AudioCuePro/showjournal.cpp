@@ -0,0 +1,360 @@
+#include "showjournal.h"
+#include "showfile.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QSaveFile>
+#include <QTimer>
+#include <QtEndian>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char kMagic[4] = { 'A', 'C', 'P', 'J' };
+static const quint32 kVersion = 1;
+static const int kHeaderSize = 8;
+static const int kFlushIntervalMs = 200;
+static const qint64 kCompactBytes = 1024 * 1024;
+
+namespace {
+
+enum RecordType : quint8 {
+    CueRecord        = 1,
+    CueRemovedRecord = 2,
+    LayoutRecord     = 3
+};
+
+QString journalPath(const QString &dir)  { return QDir(dir).filePath(QStringLiteral("journal.acpj")); }
+QString snapshotPath(const QString &dir) { return QDir(dir).filePath(QStringLiteral("snapshot.acps")); }
+
+bool syncToDisk(QFile &f)
+{
+#ifdef Q_OS_WIN
+    return _commit(f.handle()) == 0;
+#else
+    return ::fsync(f.handle()) == 0;
+#endif
+}
+
+QByteArray encodeRecord(quint8 type, const QByteArray &payload)
+{
+    QByteArray rec;
+    rec.reserve(4 + 1 + payload.size() + 2);
+
+    char word[4];
+    qToBigEndian<quint32>(quint32(payload.size()), word);
+    rec.append(word, 4);
+    rec.append(char(type));
+    rec.append(payload);
+
+    char sum[2];
+    qToBigEndian<quint16>(qChecksum(QByteArrayView(rec.constData() + 4, rec.size() - 4)), sum);
+    rec.append(sum, 2);
+    return rec;
+}
+
+quint64 idOf(const QCborMap &cue)
+{
+    return cue[QStringLiteral("id")].toString().toULongLong();
+}
+
+/* ============================================================
+ * STATE – what replaying snapshot + journal amounts to
+ * ============================================================ */
+struct State
+{
+    QHash<quint64, QCborMap> cues;
+    QCborMap layout;
+
+    void apply(quint8 type, const QByteArray &payload)
+    {
+        switch (type)
+        {
+        case CueRecord: {
+            const QCborMap cue = QCborValue::fromCbor(payload).toMap();
+            if (idOf(cue) != 0)
+                cues.insert(idOf(cue), cue);
+            break;
+        }
+        case CueRemovedRecord:
+            if (payload.size() == 8)
+                cues.remove(qFromBigEndian<quint64>(payload.constData()));
+            break;
+        case LayoutRecord:
+            layout = QCborValue::fromCbor(payload).toMap();
+            break;
+        default:
+            break;
+        }
+    }
+
+    void loadSnapshot(const QJsonObject &root)
+    {
+        QCborArray sceneList;
+        for (const QJsonValue &sv : root["scenes"].toArray())
+        {
+            const QJsonObject sobj = sv.toObject();
+            QCborArray ids;
+            for (const QJsonValue &tv : sobj["tracks"].toArray())
+            {
+                const QCborMap cue = QCborMap::fromJsonObject(tv.toObject());
+                cues.insert(idOf(cue), cue);
+                ids.append(cue[QStringLiteral("id")]);
+            }
+
+            QCborMap scene;
+            scene[QStringLiteral("name")] = sobj["name"].toString();
+            scene[QStringLiteral("cues")] = ids;
+            sceneList.append(scene);
+        }
+
+        layout = QCborMap();
+        layout[QStringLiteral("audioFolder")] = root["audioFolder"].toString();
+        layout[QStringLiteral("scenes")] = sceneList;
+    }
+
+    // Show root in the JSON layout; cues not placed in a scene are left out
+    QJsonObject toRoot() const
+    {
+        QJsonArray scenesArr;
+        for (const QCborValue &sv : layout[QStringLiteral("scenes")].toArray())
+        {
+            const QCborMap scene = sv.toMap();
+            QJsonArray tracksArr;
+            for (const QCborValue &id : scene[QStringLiteral("cues")].toArray())
+            {
+                const auto it = cues.constFind(id.toString().toULongLong());
+                if (it != cues.constEnd())
+                    tracksArr.append(it.value().toJsonObject());
+            }
+
+            QJsonObject sobj;
+            sobj["name"] = scene[QStringLiteral("name")].toString();
+            sobj["tracks"] = tracksArr;
+            scenesArr.append(sobj);
+        }
+
+        QJsonObject root;
+        root["audioFolder"] = layout[QStringLiteral("audioFolder")].toString();
+        root["scenes"] = scenesArr;
+        return root;
+    }
+};
+
+// Replays records until the end or the first torn/damaged one
+void replayJournal(const QString &path, State &state)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return;
+
+    const QByteArray header = f.read(kHeaderSize);
+    if (header.size() != kHeaderSize || !header.startsWith(QByteArray(kMagic, 4)))
+        return;
+
+    for (;;)
+    {
+        const QByteArray head = f.read(5);
+        if (head.size() != 5)
+            return;
+
+        const quint32 size = qFromBigEndian<quint32>(head.constData());
+        if (size > f.size())
+            return;
+
+        const QByteArray body = f.read(qint64(size) + 2);
+        if (body.size() != qint64(size) + 2)
+            return;
+
+        const QByteArray checked = head.mid(4) + body.left(size);
+        if (qChecksum(QByteArrayView(checked)) != qFromBigEndian<quint16>(body.constData() + size))
+            return;
+
+        state.apply(quint8(head[4]), body.left(size));
+    }
+}
+
+} // namespace
+
+/* ============================================================
+ * WRITER (own thread)
+ * ============================================================ */
+class ShowJournal::Writer : public QObject
+{
+public:
+    explicit Writer(const QString &dir) : m_dir(dir), m_file(this) {}
+
+    void start()
+    {
+        QFile::remove(snapshotPath(m_dir));
+        openFreshJournal();
+
+        m_timer = new QTimer(this);
+        m_timer->setInterval(kFlushIntervalMs);
+        connect(m_timer, &QTimer::timeout, this, [this]() { flush(); });
+        m_timer->start();
+    }
+
+    void append(quint8 type, const QByteArray &payload)
+    {
+        if (m_closed)
+            return;
+        m_pending += encodeRecord(type, payload);
+        m_state.apply(type, payload);
+    }
+
+    // One write + one fsync for everything since the last batch
+    void flush()
+    {
+        if (m_closed || m_pending.isEmpty() || !m_file.isOpen())
+            return;
+
+        m_file.write(m_pending);
+        m_file.flush();
+        syncToDisk(m_file);
+        m_pending.clear();
+
+        if (m_file.size() > kCompactBytes)
+            compact();
+    }
+
+    void finishClean()
+    {
+        flush();
+        m_closed = true;
+        if (m_timer)
+            m_timer->stop();
+        m_file.close();
+        QFile::remove(journalPath(m_dir));
+        QFile::remove(snapshotPath(m_dir));
+    }
+
+private:
+    // Snapshot first, then truncate: a crash in between only
+    // replays records the snapshot already contains
+    void compact()
+    {
+        QSaveFile snap(snapshotPath(m_dir));
+        if (!snap.open(QIODevice::WriteOnly))
+            return;
+        snap.write(ShowFile::encode(m_state.toRoot()));
+        if (!snap.commit())
+            return;
+
+        openFreshJournal();
+    }
+
+    void openFreshJournal()
+    {
+        m_file.close();
+        m_file.setFileName(journalPath(m_dir));
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return;
+
+        char word[4];
+        m_file.write(kMagic, 4);
+        qToBigEndian<quint32>(kVersion, word);
+        m_file.write(word, 4);
+        m_file.flush();
+        syncToDisk(m_file);
+    }
+
+    QString m_dir;
+    QFile m_file;
+    QByteArray m_pending;
+    QTimer *m_timer = nullptr;
+    State m_state;
+    bool m_closed = false;
+};
+
+/* ============================================================
+ * GUI SIDE
+ * ============================================================ */
+ShowJournal::ShowJournal(const QString &dir, QObject *parent)
+    : QObject(parent)
+{
+    QDir().mkpath(dir);
+
+    m_writer = new Writer(dir);
+    m_writer->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_writer, &QObject::deleteLater);
+    m_thread.setObjectName(QStringLiteral("ShowJournal"));
+    m_thread.start(QThread::LowPriority);
+
+    QMetaObject::invokeMethod(m_writer, [w = m_writer]() { w->start(); });
+}
+
+ShowJournal::~ShowJournal()
+{
+    QMetaObject::invokeMethod(m_writer, [w = m_writer]() { w->flush(); },
+                              Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void ShowJournal::post(quint8 type, const QByteArray &payload)
+{
+    QMetaObject::invokeMethod(m_writer, [w = m_writer, type, payload]() {
+        w->append(type, payload);
+    });
+}
+
+void ShowJournal::recordCue(const QJsonObject &cue)
+{
+    post(CueRecord, QCborValue(QCborMap::fromJsonObject(cue)).toCbor());
+}
+
+void ShowJournal::recordCueRemoved(quint64 cueId)
+{
+    char id[8];
+    qToBigEndian<quint64>(cueId, id);
+    post(CueRemovedRecord, QByteArray(id, 8));
+}
+
+void ShowJournal::recordLayout(const QJsonObject &layout)
+{
+    post(LayoutRecord, QCborValue(QCborMap::fromJsonObject(layout)).toCbor());
+}
+
+void ShowJournal::markClean()
+{
+    QMetaObject::invokeMethod(m_writer, [w = m_writer]() { w->finishClean(); },
+                              Qt::BlockingQueuedConnection);
+}
+
+/* ============================================================
+ * RECOVERY
+ * ============================================================ */
+bool ShowJournal::hasRecovery(const QString &dir)
+{
+    return QFile::exists(snapshotPath(dir))
+           || QFileInfo(journalPath(dir)).size() > kHeaderSize;
+}
+
+QJsonObject ShowJournal::recover(const QString &dir)
+{
+    State state;
+    if (QFile::exists(snapshotPath(dir)))
+        state.loadSnapshot(ShowFile::readRoot(snapshotPath(dir)));
+    replayJournal(journalPath(dir), state);
+
+    const QJsonObject root = state.toRoot();
+    if (root["scenes"].toArray().isEmpty())
+        return QJsonObject();
+    return root;
+}
+
+void ShowJournal::discard(const QString &dir)
+{
+    QFile::remove(journalPath(dir));
+    QFile::remove(snapshotPath(dir));
+}
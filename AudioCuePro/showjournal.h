@@ -0,0 +1,66 @@
+#ifndef SHOWJOURNAL_H
+#define SHOWJOURNAL_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QString>
+#include <QThread>
+
+/*
+============================================================
+ ShowJournal
+------------------------------------------------------------
+ - Crash-safe autosave: every cue/scene edit is appended to
+   journal.acpj as a small binary record
+
+     file:    "ACPJ"  u32 version
+     record:  u32 size  u8 type  CBOR payload  u16 checksum
+
+   record types: cue (full cue settings), cue removed,
+   layout (scene names + cue IDs in order)
+ - Records are handed to a writer thread and never touch
+   the disk on the GUI thread. The writer appends in
+   batches and fsyncs once per batch (every 200 ms), so a
+   crash loses well under a second of edits
+ - The writer keeps the replayed state in memory and
+   compacts it into snapshot.acps (binary show format) once
+   the journal grows, then starts a fresh journal
+ - A clean shutdown removes both files; finding them at
+   startup means the last session crashed, and recover()
+   rebuilds the show (snapshot + journal, up to the first
+   torn record)
+============================================================
+*/
+
+class ShowJournal : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ShowJournal(const QString &dir, QObject *parent = nullptr);
+    ~ShowJournal() override;
+
+    // GUI thread, non-blocking
+    void recordCue(const QJsonObject &cue);       // TrackWidget::toJson() + "path"
+    void recordCueRemoved(quint64 cueId);
+    void recordLayout(const QJsonObject &layout); // { audioFolder, scenes: [{ name, cues }] }
+
+    // Normal exit: flush, then drop the journal and snapshot
+    void markClean();
+
+    // Leftovers of a session that did not exit cleanly
+    static bool hasRecovery(const QString &dir);
+    // Show root in the JSON layout (see ShowFile), or empty
+    static QJsonObject recover(const QString &dir);
+    static void discard(const QString &dir);
+
+private:
+    class Writer;
+
+    void post(quint8 type, const QByteArray &payload);
+
+    QThread m_thread;
+    Writer *m_writer = nullptr;
+};
+
+#endif // SHOWJOURNAL_H
@@ -0,0 +1,182 @@
+#include "showloader.h"
+#include "showfile.h"
+#include "showpackage.h"
+#include "trackwidget.h"
+
+#include <QAtomicInt>
+#include <QJsonArray>
+#include <QScopedPointer>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <functional>
+
+namespace {
+
+// Probes mostly wait on the disk (or a network share): more threads
+// than cores, and kept off the global pool the loader itself runs on
+QThreadPool *probePool()
+{
+    static QThreadPool *pool = [] {
+        auto *p = new QThreadPool;
+        p->setMaxThreadCount(qMax(4, QThread::idealThreadCount() * 2));
+        return p;
+    }();
+    return pool;
+}
+
+} // namespace
+
+void ShowLoader::load(QPromise<Scene> &promise, const QString &path)
+{
+    promise.setProgressRange(0, 1000);
+    promise.setProgressValueAndText(0, QObject::tr("Reading show…"));
+
+    auto fail = [&promise](const QString &message) {
+        Scene s;
+        s.index = -1;
+        s.error = message;
+        promise.addResult(s);
+    };
+
+    /* ------------------------------------------------------------
+     * PARSE: scene names up front, cues per scene on demand
+     * ------------------------------------------------------------ */
+    QString audioFolder;
+    QStringList names;
+    QVector<int> cueCounts;
+    std::function<QVector<QJsonObject>(int)> readScene;
+
+    ShowFile::Reader reader;
+    QScopedPointer<QIODevice> packaged;
+    QVector<QJsonArray> jsonScenes;
+
+    if (ShowPackage::isPackagePath(path))
+    {
+        // Read the show straight out of the package; its audio is
+        // addressed inside the same file
+        QString error;
+        const QSharedPointer<const ShowPackage> pkg = ShowPackage::shared(path, &error);
+        if (!pkg)
+            return fail(error);
+
+        packaged.reset(pkg->openEntry(ShowPackage::kShowEntry));
+        if (!packaged)
+            return fail(QObject::tr("The package contains no show."));
+        if (!reader.open(packaged.data()))
+            return fail(reader.errorString());
+
+        audioFolder = pkg->path();
+        for (int i = 0; i < reader.sceneCount(); ++i)
+        {
+            names << reader.sceneName(i);
+            cueCounts << reader.trackCount(i);
+        }
+        readScene = [&reader](int i) { return reader.readScene(i); };
+    }
+    else if (ShowFile::isBinary(path))
+    {
+        if (!reader.open(path))
+            return fail(reader.errorString());
+
+        audioFolder = reader.audioFolder();
+        for (int i = 0; i < reader.sceneCount(); ++i)
+        {
+            names << reader.sceneName(i);
+            cueCounts << reader.trackCount(i);
+        }
+        readScene = [&reader](int i) { return reader.readScene(i); };
+    }
+    else
+    {
+        QString error;
+        const QJsonObject root = ShowFile::readRoot(path, &error);
+        if (root.isEmpty())
+            return fail(error.isEmpty() ? QObject::tr("Cannot read file.") : error);
+
+        audioFolder = root["audioFolder"].toString();
+
+        if (root.contains("scenes"))
+        {
+            for (const QJsonValue &sv : root["scenes"].toArray())
+            {
+                const QJsonObject sobj = sv.toObject();
+                names << sobj["name"].toString("Scene");
+                jsonScenes << sobj["tracks"].toArray();
+            }
+        }
+        // Backwards compatibility: old format with a flat "tracks" array
+        else if (root.contains("tracks"))
+        {
+            names << QStringLiteral("Scene 1");
+            jsonScenes << root["tracks"].toArray();
+        }
+
+        for (const QJsonArray &arr : jsonScenes)
+            cueCounts << arr.size();
+        readScene = [&jsonScenes](int i) {
+            QVector<QJsonObject> cues;
+            for (const QJsonValue &v : jsonScenes[i])
+                cues.append(v.toObject());
+            return cues;
+        };
+    }
+
+    if (audioFolder.isEmpty())
+        return fail(QObject::tr("Invalid set file (no audio folder)."));
+
+    // A show always has at least one scene
+    if (names.isEmpty())
+    {
+        names << QStringLiteral("Scene 1");
+        cueCounts << 0;
+        readScene = [](int) { return QVector<QJsonObject>(); };
+    }
+
+    /* ------------------------------------------------------------
+     * PROBE: one scene at a time, its cues in parallel
+     * ------------------------------------------------------------ */
+    int totalCues = 0;
+    for (int n : cueCounts)
+        totalCues += n;
+    totalCues = qMax(1, totalCues);
+
+    QAtomicInt probed = 0;
+    auto progressAt = [&probed, totalCues]() {
+        return 100 + int(qint64(probed.loadRelaxed()) * 900 / totalCues);
+    };
+
+    for (int i = 0; i < names.size(); ++i)
+    {
+        if (promise.isCanceled())
+            break;
+
+        promise.setProgressValueAndText(progressAt(),
+                                        QObject::tr("Loading %1…").arg(names[i]));
+
+        Scene scene;
+        scene.index = i;
+        scene.sceneCount = names.size();
+        scene.name = names[i];
+        scene.audioFolder = audioFolder;
+
+        for (const QJsonObject &obj : readScene(i))
+            scene.cues.append(Cue{obj, MediaProbe::Result()});
+
+        QtConcurrent::blockingMap(probePool(), scene.cues, [&](Cue &cue) {
+            if (!promise.isCanceled())
+            {
+                const QString audio = TrackWidget::audioPathFromJson(cue.settings, audioFolder);
+                if (!audio.isEmpty())
+                    cue.probe = MediaProbe::probe(audio);
+            }
+            probed.fetchAndAddRelaxed(1);
+            promise.setProgressValue(progressAt());
+        });
+
+        if (promise.isCanceled())
+            break;
+
+        promise.addResult(scene);
+    }
+}
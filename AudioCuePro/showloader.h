@@ -0,0 +1,50 @@
+#ifndef SHOWLOADER_H
+#define SHOWLOADER_H
+
+#include <QJsonObject>
+#include <QPromise>
+#include <QString>
+#include <QVector>
+
+#include "mediaprobe.h"
+
+/*
+============================================================
+ ShowLoader
+------------------------------------------------------------
+ - Worker side of loading a show, in two phases per scene:
+     parse  – read the scene's cues (binary .acps sections
+              one at a time, the show inside a .acppkg
+              package, or the JSON document)
+     probe  – check every cue's audio in parallel on a
+              small I/O pool (exists, size, format, WAV
+              duration), see MediaProbe
+ - Each scene is reported as its own QFuture result as soon
+   as it is probed, first scene first, so the GUI can build
+   cues scene by scene (QFutureWatcher::resultReadyAt)
+ - Progress range is 0..1000; cancel stops after the cue in
+   flight. A show that cannot be read gives one result with
+   `error` set
+============================================================
+*/
+
+namespace ShowLoader
+{
+    struct Cue {
+        QJsonObject settings;       // as written by TrackWidget::toJson()
+        MediaProbe::Result probe;   // not probed for Spotify cues
+    };
+
+    struct Scene {
+        int index = 0;
+        int sceneCount = 0;
+        QString name;
+        QString audioFolder;
+        QVector<Cue> cues;
+        QString error;
+    };
+
+    void load(QPromise<Scene> &promise, const QString &path);
+}
+
+#endif // SHOWLOADER_H
@@ -0,0 +1,445 @@
+#include "showpackage.h"
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QHash>
+#include <QIODevice>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScopedPointer>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+static const char kMagic[4] = { 'A', 'C', 'P', 'K' };
+static const quint32 kVersion = 1;
+static const qint64 kPreambleSize = 8;     // magic + version
+static const qint64 kRecordSize = 32;
+static const qint64 kTrailerSize = 24;
+static const qint64 kCopyChunk = 4 * 1024 * 1024;
+
+const QString ShowPackage::kShowEntry = QStringLiteral("show.acps");
+
+namespace {
+
+/* ============================================================
+ * ENTRY DEVICE – read-only window onto one entry
+ * ============================================================ */
+class EntryDevice : public QIODevice
+{
+public:
+    EntryDevice(const QString &packagePath, qint64 offset, qint64 size, QObject *parent)
+        : QIODevice(parent), m_file(packagePath), m_offset(offset), m_size(size)
+    {
+    }
+
+    bool open(OpenMode mode) override
+    {
+        if ((mode & WriteOnly) || !m_file.open(QIODevice::ReadOnly) || !m_file.seek(m_offset))
+            return false;
+        // Unbuffered: pos() is then always our own file position
+        return QIODevice::open(mode | Unbuffered);
+    }
+
+    void close() override
+    {
+        QIODevice::close();
+        m_file.close();
+    }
+
+    bool isSequential() const override { return false; }
+    qint64 size() const override { return m_size; }
+
+    bool seek(qint64 pos) override
+    {
+        if (pos < 0 || pos > m_size || !m_file.seek(m_offset + pos))
+            return false;
+        return QIODevice::seek(pos);
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 left = m_offset + m_size - m_file.pos();
+        if (left <= 0)
+            return 0;
+        return m_file.read(data, qMin(maxSize, left));
+    }
+
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QFile m_file;
+    qint64 m_offset;
+    qint64 m_size;
+};
+
+QIODevice *openSource(const QString &path)
+{
+    if (ShowPackage::isEntryPath(path))
+        return ShowPackage::openEntryPath(path);
+
+    auto *f = new QFile(path);
+    if (!f->open(QIODevice::ReadOnly))
+    {
+        delete f;
+        return nullptr;
+    }
+    return f;
+}
+
+int compareName(const char *a, qsizetype aSize, const QByteArray &b)
+{
+    const int c = std::memcmp(a, b.constData(), size_t(qMin(aSize, b.size())));
+    if (c != 0)
+        return c;
+    return aSize < b.size() ? -1 : (aSize > b.size() ? 1 : 0);
+}
+
+} // namespace
+
+/* ============================================================
+ * PATHS
+ * ============================================================ */
+bool ShowPackage::isPackagePath(const QString &path)
+{
+    return QFileInfo(path).suffix().compare(QStringLiteral("acppkg"), Qt::CaseInsensitive) == 0;
+}
+
+QString ShowPackage::entryPath(const QString &packagePath, const QString &entryName)
+{
+    return packagePath + QLatin1Char('#') + entryName;
+}
+
+bool ShowPackage::splitEntryPath(const QString &path, QString *packagePath, QString *entryName)
+{
+    // Entry names never contain '#'; the package path might
+    const qsizetype hash = path.lastIndexOf(QLatin1Char('#'));
+    if (hash < 0 || !isPackagePath(path.left(hash)))
+        return false;
+
+    if (packagePath) *packagePath = path.left(hash);
+    if (entryName)   *entryName = path.mid(hash + 1);
+    return true;
+}
+
+bool ShowPackage::isEntryPath(const QString &path)
+{
+    return splitEntryPath(path, nullptr, nullptr);
+}
+
+QIODevice *ShowPackage::openEntryPath(const QString &path, QObject *parent)
+{
+    QString packagePath, name;
+    if (!splitEntryPath(path, &packagePath, &name))
+        return nullptr;
+
+    const QSharedPointer<const ShowPackage> pkg = shared(packagePath);
+    return pkg ? pkg->openEntry(name, parent) : nullptr;
+}
+
+/* ============================================================
+ * OPEN – trailer, then map the index
+ * ============================================================ */
+QSharedPointer<const ShowPackage> ShowPackage::shared(const QString &path, QString *error)
+{
+    static QMutex mutex;
+    static QHash<QString, QSharedPointer<const ShowPackage>> packages;
+
+    const QString key = QFileInfo(path).absoluteFilePath();
+    const MediaHash::FileStamp stamp = MediaHash::stampOf(key);
+
+    QMutexLocker lock(&mutex);
+    QSharedPointer<const ShowPackage> pkg = packages.value(key);
+    if (pkg && pkg->m_stamp == stamp)
+        return pkg;
+
+    // Saved again since: devices already handed out keep the old
+    // file; new lookups see the new one
+    packages.remove(key);
+
+    QSharedPointer<ShowPackage> fresh(new ShowPackage);
+    if (!fresh->open(key, error))
+        return {};
+
+    fresh->m_stamp = stamp;
+    packages.insert(key, fresh);
+    return fresh;
+}
+
+bool ShowPackage::open(const QString &path, QString *error)
+{
+    auto fail = [error](const QString &message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    m_path = path;
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return fail(QObject::tr("Cannot read file."));
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < kPreambleSize + kTrailerSize || m_file.read(4) != QByteArray(kMagic, 4))
+        return fail(QObject::tr("Not an AudioCuePro show package."));
+
+    if (!m_file.seek(fileSize - kTrailerSize))
+        return fail(QObject::tr("Cannot read file."));
+    const QByteArray trailer = m_file.read(kTrailerSize);
+    if (trailer.size() != kTrailerSize || !trailer.endsWith(QByteArray(kMagic, 4)))
+        return fail(QObject::tr("The show package is truncated."));
+
+    const char *t = trailer.constData();
+    const qint64 indexOffset = qint64(qFromLittleEndian<quint64>(t));
+    m_count                  = qFromLittleEndian<quint32>(t + 8);
+    m_namesSize              = qFromLittleEndian<quint32>(t + 12);
+    const quint32 version    = qFromLittleEndian<quint32>(t + 16);
+
+    if (version > kVersion)
+        return fail(QObject::tr("The package was saved by a newer version of AudioCuePro."));
+
+    const qint64 indexSize = qint64(m_count) * kRecordSize + m_namesSize;
+    if (indexOffset < kPreambleSize || indexOffset + indexSize + kTrailerSize != fileSize)
+        return fail(QObject::tr("The show package index is damaged."));
+
+    if (indexSize > 0)
+    {
+        m_index = m_file.map(indexOffset, indexSize);
+        if (!m_index)
+            return fail(QObject::tr("Cannot map the show package index."));
+    }
+    return true;
+}
+
+ShowPackage::~ShowPackage()
+{
+    // m_file unmaps on close
+}
+
+/* ============================================================
+ * LOOKUP – binary search in the mapped records
+ * ============================================================ */
+ShowPackage::Entry ShowPackage::entry(const QString &name) const
+{
+    const QByteArray key = name.toUtf8();
+    const char *names = reinterpret_cast<const char *>(m_index) + qint64(m_count) * kRecordSize;
+
+    qint64 lo = 0, hi = qint64(m_count) - 1;
+    while (lo <= hi)
+    {
+        const qint64 mid = (lo + hi) / 2;
+        const uchar *r = m_index + mid * kRecordSize;
+
+        const quint32 nameOffset = qFromLittleEndian<quint32>(r + 16);
+        const quint32 nameSize   = qFromLittleEndian<quint32>(r + 20);
+        if (quint64(nameOffset) + nameSize > m_namesSize)
+            return Entry();   // damaged record
+
+        const int c = compareName(names + nameOffset, nameSize, key);
+        if (c < 0)      lo = mid + 1;
+        else if (c > 0) hi = mid - 1;
+        else
+        {
+            Entry e;
+            e.offset = qint64(qFromLittleEndian<quint64>(r));
+            e.size   = qint64(qFromLittleEndian<quint64>(r + 8));
+            e.kind   = Kind(qFromLittleEndian<quint32>(r + 24));
+            return e;
+        }
+    }
+    return Entry();
+}
+
+QByteArray ShowPackage::read(const QString &name) const
+{
+    QScopedPointer<QIODevice> dev(openEntry(name));
+    return dev ? dev->readAll() : QByteArray();
+}
+
+QIODevice *ShowPackage::openEntry(const QString &name, QObject *parent) const
+{
+    const Entry e = entry(name);
+    if (!e.isValid())
+        return nullptr;
+
+    auto *dev = new EntryDevice(m_path, e.offset, e.size, parent);
+    if (!dev->open(QIODevice::ReadOnly))
+    {
+        delete dev;
+        return nullptr;
+    }
+    return dev;
+}
+
+/* ============================================================
+ * WRITER
+ * ============================================================ */
+ShowPackage::Writer::Writer(const QString &path)
+    : m_file(path)
+{
+}
+
+bool ShowPackage::Writer::open()
+{
+    if (!m_file.open(QIODevice::WriteOnly))
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    char word[4];
+    qToLittleEndian<quint32>(kVersion, word);
+    if (m_file.write(kMagic, 4) != 4 || m_file.write(word, 4) != 4)
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool ShowPackage::Writer::alignTo8()
+{
+    static const char zeros[8] = {};
+    const qint64 pad = (8 - m_file.pos() % 8) % 8;
+    return m_file.write(zeros, pad) == pad;
+}
+
+bool ShowPackage::Writer::contains(const QString &name) const
+{
+    const QByteArray key = name.toUtf8();
+    for (const Pending &p : m_entries)
+        if (p.name == key)
+            return true;
+    return false;
+}
+
+QString ShowPackage::Writer::addAudio(const QString &sourcePath,
+                                      const MediaHash::ChunkCallback &onChunk)
+{
+    QScopedPointer<QIODevice> in(openSource(sourcePath));
+    if (!in)
+    {
+        m_error = QObject::tr("Cannot read: %1").arg(sourcePath);
+        return QString();
+    }
+
+    if (!alignTo8())
+    {
+        m_error = m_file.errorString();
+        return QString();
+    }
+
+    // The name is the content hash, known only once the bytes are
+    // in: copy and hash in one pass
+    const qint64 start = m_file.pos();
+    QCryptographicHash hash(QCryptographicHash::Blake2b_256);
+    QByteArray buffer(kCopyChunk, Qt::Uninitialized);
+
+    for (;;)
+    {
+        const qint64 n = in->read(buffer.data(), buffer.size());
+        if (n < 0)
+        {
+            m_error = QObject::tr("Cannot read: %1").arg(sourcePath);
+            return QString();
+        }
+        if (n == 0)
+            break;
+
+        hash.addData(QByteArrayView(buffer.constData(), n));
+        if (m_file.write(buffer.constData(), n) != n)
+        {
+            m_error = m_file.errorString();
+            return QString();
+        }
+        if (onChunk && !onChunk(n))
+            return QString();
+    }
+
+    // Source file name for the extension; an entry path ends in one too
+    const QString ext = QFileInfo(sourcePath).suffix().toLower();
+    const QString object = QString::fromLatin1(hash.result().toHex()) + '.'
+                         + (ext.isEmpty() ? QStringLiteral("bin") : ext);
+    const QString name = QStringLiteral("media/") + object;
+
+    if (contains(name))
+    {
+        // Same content under another path: drop the second copy
+        m_file.seek(start);
+        m_file.resize(start);
+        return object;
+    }
+
+    m_entries.append(Pending{name.toUtf8(), start, m_file.pos() - start, Audio});
+    return object;
+}
+
+bool ShowPackage::Writer::addData(const QString &name, Kind kind, const QByteArray &data)
+{
+    if (contains(name))
+        return true;
+
+    if (!alignTo8())
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    const qint64 start = m_file.pos();
+    if (m_file.write(data) != data.size())
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    m_entries.append(Pending{name.toUtf8(), start, data.size(), kind});
+    return true;
+}
+
+bool ShowPackage::Writer::commit()
+{
+    std::sort(m_entries.begin(), m_entries.end(),
+              [](const Pending &a, const Pending &b) {
+                  return compareName(a.name.constData(), a.name.size(), b.name) < 0;
+              });
+
+    QByteArray records;
+    QByteArray names;
+    records.reserve(m_entries.size() * kRecordSize);
+
+    for (const Pending &p : m_entries)
+    {
+        char r[kRecordSize] = {};
+        qToLittleEndian<quint64>(quint64(p.offset), r);
+        qToLittleEndian<quint64>(quint64(p.size), r + 8);
+        qToLittleEndian<quint32>(quint32(names.size()), r + 16);
+        qToLittleEndian<quint32>(quint32(p.name.size()), r + 20);
+        qToLittleEndian<quint32>(quint32(p.kind), r + 24);
+        records.append(r, kRecordSize);
+        names += p.name;
+    }
+
+    if (!alignTo8())
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    char trailer[kTrailerSize];
+    qToLittleEndian<quint64>(quint64(m_file.pos()), trailer);
+    qToLittleEndian<quint32>(quint32(m_entries.size()), trailer + 8);
+    qToLittleEndian<quint32>(quint32(names.size()), trailer + 12);
+    qToLittleEndian<quint32>(kVersion, trailer + 16);
+    std::memcpy(trailer + 20, kMagic, 4);
+
+    m_file.write(records);
+    m_file.write(names);
+    m_file.write(trailer, kTrailerSize);
+
+    if (!m_file.commit())
+    {
+        m_error = m_file.errorString();
+        return false;
+    }
+    return true;
+}
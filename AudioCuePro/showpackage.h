@@ -0,0 +1,144 @@
+#ifndef SHOWPACKAGE_H
+#define SHOWPACKAGE_H
+
+#include "mediahash.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+class QIODevice;
+class QObject;
+
+/*
+============================================================
+ ShowPackage
+------------------------------------------------------------
+ - One file per show for touring (.acppkg): the show itself,
+   every audio file it plays and their waveform peaks, with
+   a trailing index. Moving a show is one file copy.
+
+     "ACPK"  u32 version
+     entry data ...               (each entry 8-byte aligned)
+     index   one 32-byte record per entry, sorted by name:
+               u64 offset  u64 size
+               u32 nameOffset  u32 nameSize  u32 kind  u32 0
+     names   UTF-8 string table for the records
+     trailer u64 indexOffset  u32 entryCount  u32 namesSize
+             u32 version  "ACPK"                   (24 bytes)
+
+   Integers are little-endian.
+ - Entries:
+     show.acps         the show in the binary show format
+     media/<object>    audio, named "<hash>.<ext>" like the
+                       media store, so each file is in once
+     peaks/<object>    WaveformPeaks of that audio
+ - Opening reads the trailer and memory-maps the index; a
+   lookup is a binary search in the mapping. Nothing is
+   extracted: cues play "<package>#media/<object>" paths
+   through openEntryPath(), a read-only window onto the
+   entry's bytes in the package file
+ - shared() keeps one open package per path (re-opened if
+   the file on disk changes); lookups are thread-safe
+============================================================
+*/
+
+class ShowPackage
+{
+public:
+    enum Kind : quint32 { Show = 1, Audio = 2, Peaks = 3 };
+
+    struct Entry {
+        qint64 offset = -1;     // from the start of the package
+        qint64 size = 0;
+        Kind kind = Show;
+
+        bool isValid() const { return offset >= 0; }
+    };
+
+    static const QString kShowEntry;   // "show.acps"
+
+    // Open package for `path`, shared with every other user of it;
+    // null (and *error set) if the file is not a readable package
+    static QSharedPointer<const ShowPackage> shared(const QString &path,
+                                                    QString *error = nullptr);
+
+    // True if a path names a package by its suffix
+    static bool isPackagePath(const QString &path);
+
+    // "<package>#<entry>": how cues refer to audio inside a package
+    static QString entryPath(const QString &packagePath, const QString &entryName);
+    static bool isEntryPath(const QString &path);
+    static bool splitEntryPath(const QString &path, QString *packagePath, QString *entryName);
+
+    // The entry behind an entry path, opened read-only; nullptr if the
+    // package or the entry is missing. The caller owns the device.
+    static QIODevice *openEntryPath(const QString &path, QObject *parent = nullptr);
+
+    ~ShowPackage();
+
+    QString path() const { return m_path; }
+    int entryCount() const { return int(m_count); }
+    Entry entry(const QString &name) const;
+
+    // Whole entry in memory (show, peaks); audio goes through openEntry()
+    QByteArray read(const QString &name) const;
+    QIODevice *openEntry(const QString &name, QObject *parent = nullptr) const;
+
+    /* --------------------------------------------------------
+     * Writer – builds a package through QSaveFile, so the old
+     * package stays intact until commit() succeeds. Meant to
+     * run on a worker thread.
+     * -------------------------------------------------------- */
+    class Writer
+    {
+    public:
+        explicit Writer(const QString &path);
+
+        bool open();
+        QString errorString() const { return m_error; }
+        qint64 bytesWritten() const { return m_file.pos(); }
+
+        // Streams an audio file (or a package entry) in, hashing it on
+        // the way. Returns its object name "<hash>.<ext>"; content that
+        // is already in the package is only stored once. Empty on error
+        // or when the callback returns false.
+        QString addAudio(const QString &sourcePath,
+                         const MediaHash::ChunkCallback &onChunk = {});
+
+        bool addData(const QString &name, Kind kind, const QByteArray &data);
+        bool contains(const QString &name) const;
+
+        // Writes index + trailer and replaces the target file
+        bool commit();
+
+    private:
+        struct Pending {
+            QByteArray name;   // UTF-8
+            qint64 offset;
+            qint64 size;
+            Kind kind;
+        };
+
+        bool alignTo8();
+
+        QSaveFile m_file;
+        QVector<Pending> m_entries;
+        QString m_error;
+    };
+
+private:
+    ShowPackage() = default;
+    bool open(const QString &path, QString *error);
+
+    QString m_path;
+    MediaHash::FileStamp m_stamp;       // file as it was when opened
+    QFile m_file;                       // kept open: it owns the mapping
+    const uchar *m_index = nullptr;     // records, then the name table
+    quint32 m_count = 0;
+    quint32 m_namesSize = 0;
+};
+
+#endif // SHOWPACKAGE_H
@@ -0,0 +1,842 @@
+#include "showrender.h"
+#include "audioanalysis.h"
+#include "audioengine.h"
+#include "audiofilewriter.h"
+#include "loudness.h"
+#include "regionstream.h"
+#include "showfile.h"
+#include "showpackage.h"
+#include "trackwidget.h"
+
+#include <QAtomicInt>
+#include <QAudioBuffer>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QJsonArray>
+#include <QPair>
+#include <QScopedPointer>
+#include <QTextStream>
+#include <QThread>
+#include <QTemporaryFile>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+static const int kBlock = AudioEngine::kBlockFrames;
+static const int kFeedFrames = 8 * kBlock;      // queued ahead of the mix, above the voice's prime
+static const int kTailFrames = kBlock;          // silence after a cue: drains the resampler
+static const int kCopyFrames = 65536;           // scene file -> output file, per read
+static const int kReplayMs = 10000;             // a loop this short replays from memory
+static const double kMaxCueGain = 4.0;          // as TrackWidget
+
+namespace {
+
+/* ============================================================
+ * CUE – what the render needs from a cue's settings
+ * ============================================================ */
+struct Cue {
+    QString title;
+    QString path;
+    double start = 0.0;
+    double end = 0.0;                   // 0: to the end of the file
+    double fadeIn = 0.0;
+    double fadeOut = 0.0;
+    int passes = 1;
+    double level = 1.0;                 // gain x normalisation
+    double rate = 1.0;                  // speed x pitch
+    bool endless = false;               // "infinite": ends at the next GO, with its fade out
+};
+
+// False (with the reason) for a cue the render leaves out
+bool parseCue(const QJsonObject &obj, const ShowRender::Options &options,
+              Cue *cue, QString *skipped, QString *note)
+{
+    cue->title = obj["altname"].toString();
+    if (cue->title.isEmpty())
+        cue->title = obj["filename"].toString();
+    if (cue->title.isEmpty())
+        cue->title = obj["url"].toString();
+
+    if (obj["spotify"].toBool())
+    {
+        *skipped = QObject::tr("Spotify cue");
+        return false;
+    }
+    cue->path = obj["path"].toString();
+    if (cue->path.isEmpty())
+    {
+        *skipped = QObject::tr("no audio file");
+        return false;
+    }
+
+    cue->start = qMax(0.0, obj["start"].toDouble());
+    cue->end = obj["end"].toDouble();
+    cue->fadeIn = qMax(0.0, obj["fadeIn"].toDouble());
+    cue->fadeOut = qMax(0.0, obj["fadeOut"].toDouble());
+
+    const QString loop = obj["loopMode"].toString();
+    if (loop == "count")
+        cue->passes = qMax(1, obj["loopCount"].toInt(1));
+    else if (loop == "infinite")
+    {
+        cue->endless = true;
+        *note = QObject::tr("loops forever, rendered once and faded out as the next GO would");
+    }
+
+    double level = obj["gain"].toDouble(1.0);
+    if (options.normalize)
+        level *= Loudness::normalizationGain(Loudness::Stats::fromJson(obj["loudness"].toObject()),
+                                             options.targetLufs);
+    cue->level = qBound(0.0, level, kMaxCueGain);
+
+    cue->rate = obj["speed"].toDouble(1.0) * std::pow(2.0, obj["pitch"].toDouble() / 12.0);
+    if (!(cue->rate > 0.0))
+        cue->rate = 1.0;
+    return true;
+}
+
+/* ============================================================
+ * CUE PLAYER – one cue's voice, fed from its stream
+ * ============================================================ */
+// Plays the region pass after pass without a seek, so a loop is
+// seamless. A region short enough is kept from the first pass and
+// replayed from memory; a longer one is decoded again per pass.
+// Frames count at the engine rate from the cue's start
+class CuePlayer
+{
+public:
+    CuePlayer(AudioEngine &engine, const Cue &cue, const QString &where)
+        : m_engine(engine), m_cue(cue), m_where(where), m_rate(engine.sampleRate()),
+          m_stream(new RegionStream(cue.path, cue.start, cue.end))
+    {
+        if (cue.end > cue.start)
+            m_passFrames = (cue.end - cue.start) * m_rate / cue.rate;
+    }
+    ~CuePlayer()
+    {
+        if (m_voice)
+            m_engine.removeVoice(m_voice);
+    }
+
+    // Waits for the first audio: false, with the reason, if the cue
+    // has none (nothing, and no reason, on cancel)
+    bool open(const std::function<bool()> &canceled, QString *error);
+    void start();
+
+    // Tops the voice up and sets its gain for the next block; false
+    // on cancel
+    bool feed(const std::function<bool()> &canceled);
+    void advance() { m_played += kBlock; }
+    qint64 played() const { return m_played; }
+
+    // A cue that does not loop forever has played every pass
+    bool ended() const;
+    bool endless() const { return m_cue.endless; }
+
+    // When the GO for the next cue comes: when this one has ended,
+    // or `earlyFrames` before it would; an endless loop after its
+    // first pass
+    bool goReached(double earlyFrames) const;
+
+    // From the current level down over the cue's fade out, as
+    // TrackWidget::stopWithFade(); the cue keeps looping meanwhile.
+    // On a cue that has ended the fade still takes its time
+    void fadeOut();
+    bool fadeDone() const { return m_played >= m_fadeStart + m_fadeFrames; }
+
+    // The player stops: the voice ramps out what it has queued
+    void stop();
+    // Nothing left to sound: the cue can leave the engine
+    bool silent() const;
+
+    QString where() const { return m_where; }
+    QString error() const { return m_error; }
+
+private:
+    bool nextBuffer(QAudioBuffer *buffer, const std::function<bool()> &canceled);
+    void remember(const QAudioBuffer &buffer);
+    double envelopeAt(double frame) const;
+
+    AudioEngine &m_engine;
+    const Cue m_cue;
+    const QString m_where;
+    const int m_rate;
+    AudioEngine::Voice *m_voice = nullptr;
+    std::unique_ptr<RegionStream> m_stream;
+    QAudioBuffer m_first;               // taken by open()
+    QAudioFormat m_sourceFormat;
+
+    int m_pass = 0;
+    int m_passBuffers = 0;
+    qint64 m_regionFrames = 0;          // first pass, source frames
+    double m_passFrames = 0.0;
+    QVector<QAudioBuffer> m_replay;
+    bool m_replayable = true;           // the whole region is in m_replay
+    bool m_replaying = false;
+    int m_replayAt = 0;
+    bool m_fed = false;                 // every pass pushed, and the tail
+    bool m_stopped = false;
+
+    qint64 m_played = 0;
+    bool m_fading = false;
+    double m_fadeFrom = 1.0;
+    qint64 m_fadeStart = 0;
+    qint64 m_fadeFrames = 0;
+    QString m_error;
+};
+
+bool CuePlayer::open(const std::function<bool()> &canceled, QString *error)
+{
+    if (m_stream->next(&m_first, canceled))
+    {
+        remember(m_first);
+        return true;
+    }
+    if (!canceled())
+        *error = m_stream->error().isEmpty() ? QObject::tr("nothing to play between start and end")
+                                             : m_stream->error();
+    return false;
+}
+
+void CuePlayer::start()
+{
+    m_voice = m_engine.createVoice();
+    m_voice->setRate(m_cue.rate);
+    m_voice->arm();
+}
+
+void CuePlayer::remember(const QAudioBuffer &buffer)
+{
+    m_sourceFormat = buffer.format();
+    m_regionFrames += buffer.frameCount();
+    if (!m_replayable)
+        return;
+    if (m_regionFrames * 1000 <= qint64(m_sourceFormat.sampleRate()) * kReplayMs)
+    {
+        m_replay.append(buffer);
+    }
+    else
+    {
+        m_replayable = false;
+        m_replay.clear();
+    }
+}
+
+bool CuePlayer::nextBuffer(QAudioBuffer *buffer, const std::function<bool()> &canceled)
+{
+    for (;;)
+    {
+        bool got = false;
+        if (m_first.isValid())
+        {
+            *buffer = m_first;
+            m_first = QAudioBuffer();
+            got = true;
+        }
+        else if (m_replaying)
+        {
+            got = m_replayAt < m_replay.size();
+            if (got)
+                *buffer = m_replay[m_replayAt++];
+        }
+        else if (m_stream->next(buffer, canceled))
+        {
+            got = true;
+            if (m_pass == 0)
+                remember(*buffer);
+        }
+
+        if (got)
+        {
+            ++m_passBuffers;
+            return true;
+        }
+        if (canceled())
+            return false;
+        if (!m_replaying && !m_stream->error().isEmpty())
+        {
+            m_error = m_stream->error();
+            return false;
+        }
+
+        // End of a pass; one that found nothing ends the cue
+        if (m_pass == 0 && m_passFrames <= 0.0)
+            m_passFrames = double(m_regionFrames) * m_rate / (m_sourceFormat.sampleRate() * m_cue.rate);
+        if (m_passBuffers == 0 || (!m_cue.endless && m_pass + 1 >= m_cue.passes))
+            return false;
+        ++m_pass;
+        m_passBuffers = 0;
+        if (m_replayable)
+        {
+            m_replaying = true;
+            m_replayAt = 0;
+        }
+        else
+        {
+            m_stream.reset(new RegionStream(m_cue.path, m_cue.start, m_cue.end));
+        }
+    }
+}
+
+bool CuePlayer::feed(const std::function<bool()> &canceled)
+{
+    if (m_stopped)
+        return true;
+
+    while (!m_fed && m_voice->queuedFrames() < kFeedFrames)
+    {
+        QAudioBuffer buffer;
+        if (nextBuffer(&buffer, canceled))
+        {
+            m_voice->push(buffer);
+            continue;
+        }
+        if (canceled())
+            return false;
+
+        // Silence after the last pass pushes the filter's delay out
+        QAudioFormat format;
+        format.setSampleFormat(QAudioFormat::Float);
+        format.setChannelCount(2);
+        format.setSampleRate(m_sourceFormat.sampleRate());
+        m_voice->push(QAudioBuffer(QByteArray(kTailFrames * format.bytesPerFrame(), 0), format));
+        m_fed = true;
+    }
+
+    // The voice ramps to this across the block
+    m_voice->setGain(float(envelopeAt(double(m_played + kBlock)) * m_cue.level));
+    return true;
+}
+
+bool CuePlayer::ended() const
+{
+    // A region too short to prime the voice never sounds: stop
+    // waiting for it a second past its length
+    return m_fed && (m_voice->queuedFrames() == 0
+                     || m_played > m_cue.passes * m_passFrames + m_rate);
+}
+
+double CuePlayer::envelopeAt(double frame) const
+{
+    // The fade in starts the cue (cubic, as TrackWidget); a fade out
+    // takes over from whatever level it finds
+    if (m_fading)
+        return m_fadeFrom * qMax(0.0, 1.0 - (frame - m_fadeStart) / double(m_fadeFrames));
+
+    const double fadeIn = m_cue.fadeIn * m_rate;
+    if (frame < fadeIn)
+    {
+        const double t = frame / fadeIn;
+        return t * t * t;
+    }
+    return 1.0;
+}
+
+bool CuePlayer::goReached(double earlyFrames) const
+{
+    if (ended())
+        return true;
+    if (m_passFrames <= 0.0)
+        return false;                   // not known before the first pass is read
+    if (m_cue.endless)
+        return m_played >= m_passFrames - earlyFrames;
+    return earlyFrames > 0.0 && m_played >= m_cue.passes * m_passFrames - earlyFrames;
+}
+
+void CuePlayer::fadeOut()
+{
+    m_fadeFrom = envelopeAt(double(m_played));
+    m_fadeStart = m_played;
+    m_fadeFrames = std::llround(m_cue.fadeOut * m_rate);
+    m_fading = m_fadeFrames > 0;
+}
+
+void CuePlayer::stop()
+{
+    m_stopped = true;
+    m_voice->flush();
+}
+
+bool CuePlayer::silent() const
+{
+    return m_stopped ? m_voice->queuedFrames() == 0 : ended();
+}
+
+/* ============================================================
+ * SCENE – one offline engine, cues in order, into a temp file
+ * ============================================================ */
+struct SceneOutput {
+    QTemporaryFile file;                // stereo float
+    qint64 frames = 0;
+    int cues = 0;
+    QStringList warnings;
+    QString error;
+};
+
+class SceneRenderer
+{
+public:
+    SceneRenderer(const ShowRender::Options &options, SceneOutput &out,
+                  const std::function<bool()> &canceled)
+        : m_engine(options.sampleRate), m_out(out), m_canceled(canceled),
+          m_goEarlyFrames(options.goEarlySeconds * options.sampleRate)
+    {
+        m_engine.setLimiter(options.limiterCeilingDb, options.limiterReleaseMs);
+        m_engine.setResamplerQuality(options.quality);
+        m_block.resize(2 * kBlock);
+    }
+
+    AudioEngine &engine() { return m_engine; }
+
+    // GO on `next`, as the live show runs it: the cue playing fades
+    // out (TrackWidget::stopWithFade()) and `next` starts when that
+    // fade has run (MainWindow::onTrackFadeOutFinished()), while
+    // the outgoing voice ramps out what it still has queued. False
+    // on cancel or a write error
+    bool go(std::unique_ptr<CuePlayer> next);
+
+    // The last cue plays to its end, or, looping forever, to a
+    // closing GO; then every voice drains and the limiter's
+    // look-ahead gives back its last few ms
+    bool finish();
+
+private:
+    bool renderBlock();
+    bool renderUntil(const std::function<bool()> &done);
+
+    AudioEngine m_engine;
+    SceneOutput &m_out;
+    std::function<bool()> m_canceled;
+    const double m_goEarlyFrames;
+    QVector<float> m_block;
+    std::vector<std::unique_ptr<CuePlayer>> m_players;  // every cue still sounding
+    CuePlayer *m_current = nullptr;                     // the one the next GO fades
+};
+
+bool SceneRenderer::go(std::unique_ptr<CuePlayer> next)
+{
+    if (CuePlayer *outgoing = m_current)
+    {
+        if (!renderUntil([&]() { return outgoing->goReached(m_goEarlyFrames); }))
+            return false;
+        outgoing->fadeOut();
+        if (!renderUntil([&]() { return outgoing->fadeDone(); }))
+            return false;
+        outgoing->stop();
+        m_current = nullptr;
+    }
+
+    if (next)
+    {
+        next->start();
+        m_current = next.get();
+        m_players.push_back(std::move(next));
+    }
+    return true;
+}
+
+bool SceneRenderer::finish()
+{
+    if (m_current && m_current->endless() && !go(nullptr))
+        return false;
+    m_current = nullptr;
+    if (!renderUntil([this]() { return m_players.empty(); }))
+        return false;
+
+    const qint64 latency = std::llround(m_engine.stats().limiterMs * m_engine.sampleRate() / 1000.0);
+    for (qint64 done = 0; done <= latency; done += kBlock)
+        if (!renderBlock())
+            return false;
+    return m_out.file.flush();
+}
+
+bool SceneRenderer::renderUntil(const std::function<bool()> &done)
+{
+    while (!done())
+        if (!renderBlock())
+            return false;
+    return true;
+}
+
+bool SceneRenderer::renderBlock()
+{
+    for (const auto &player : m_players)
+        if (!player->feed(m_canceled))
+            return false;
+    if (m_canceled())
+        return false;
+
+    m_engine.render(m_block.data(), kBlock, 2);
+    const qint64 bytes = qint64(sizeof(float)) * 2 * kBlock;
+    if (m_out.file.write(reinterpret_cast<const char *>(m_block.constData()), bytes) != bytes)
+    {
+        m_out.error = m_out.file.errorString();
+        return false;
+    }
+    m_out.frames += kBlock;
+
+    // Cues with nothing left to sound leave the engine; the current
+    // one stays until the next GO, which may still wait on its fade
+    for (auto it = m_players.begin(); it != m_players.end(); )
+    {
+        CuePlayer *player = it->get();
+        player->advance();
+        if (player != m_current && player->silent())
+        {
+            if (!player->error().isEmpty())
+                m_out.warnings << player->where() + QObject::tr("cut short (%1)").arg(player->error());
+            it = m_players.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return true;
+}
+
+void renderScene(const ShowRender::Scene &scene, const ShowRender::Options &options,
+                 SceneOutput &out, const std::function<bool()> &canceled,
+                 const std::function<void()> &cueDone)
+{
+    if (!out.file.open())
+    {
+        out.error = QObject::tr("Cannot create a temporary file: %1").arg(out.file.errorString());
+        return;
+    }
+
+    SceneRenderer renderer(options, out, canceled);
+    bool playing = false;
+    for (const QJsonObject &obj : scene.cues)
+    {
+        Cue cue;
+        QString skipped, note;
+        const bool playable = parseCue(obj, options, &cue, &skipped, &note);
+        const QString where = QStringLiteral("%1 / %2: ").arg(scene.name, cue.title);
+        if (!note.isEmpty())
+            out.warnings << where + note;
+        if (!playable)
+        {
+            out.warnings << where + QObject::tr("skipped (%1)").arg(skipped);
+            cueDone();
+            continue;
+        }
+
+        // Opened ahead of its GO, so its decoder is already running
+        QString error;
+        std::unique_ptr<CuePlayer> player(new CuePlayer(renderer.engine(), cue, where));
+        if (!player->open(canceled, &error))
+        {
+            if (canceled())
+                return;
+            out.warnings << where + QObject::tr("skipped (%1)").arg(error);
+            cueDone();
+            continue;
+        }
+
+        if (!renderer.go(std::move(player)))
+            return;
+        if (playing)
+            cueDone();                  // the previous cue is through its GO
+        playing = true;
+        ++out.cues;
+    }
+
+    if (out.cues > 0 && !renderer.finish() && out.error.isEmpty())
+        out.error = out.file.errorString();
+    if (playing)
+        cueDone();
+}
+
+} // namespace
+
+/* ============================================================
+ * LOAD – any show file, audio resolved per cue
+ * ============================================================ */
+QVector<ShowRender::Scene> ShowRender::loadShow(const QString &path, QString *error)
+{
+    QVector<Scene> scenes;
+    QString audioFolder;
+    QString failure;
+
+    if (ShowPackage::isPackagePath(path))
+    {
+        const QSharedPointer<const ShowPackage> pkg = ShowPackage::shared(path, &failure);
+        QScopedPointer<QIODevice> packaged(pkg ? pkg->openEntry(ShowPackage::kShowEntry) : nullptr);
+        ShowFile::Reader reader;
+        if (pkg && !packaged)
+            failure = QObject::tr("The package contains no show.");
+        else if (packaged && !reader.open(packaged.data()))
+            failure = reader.errorString();
+        else if (packaged)
+        {
+            audioFolder = pkg->path();
+            for (int i = 0; i < reader.sceneCount(); ++i)
+                scenes.append({ reader.sceneName(i), reader.readScene(i) });
+        }
+    }
+    else
+    {
+        const QJsonObject root = ShowFile::readRoot(path, &failure);
+        if (!root.isEmpty())
+        {
+            audioFolder = root["audioFolder"].toString();
+            QVector<QPair<QString, QJsonArray>> arrays;
+            if (root.contains("scenes"))
+            {
+                for (const QJsonValue &sv : root["scenes"].toArray())
+                {
+                    const QJsonObject sobj = sv.toObject();
+                    arrays.append({ sobj["name"].toString("Scene"), sobj["tracks"].toArray() });
+                }
+            }
+            // Backwards compatibility: old format with a flat "tracks" array
+            else if (root.contains("tracks"))
+            {
+                arrays.append({ QStringLiteral("Scene 1"), root["tracks"].toArray() });
+            }
+            for (const auto &a : arrays)
+            {
+                Scene scene;
+                scene.name = a.first;
+                for (const QJsonValue &v : a.second)
+                    scene.cues.append(v.toObject());
+                scenes.append(scene);
+            }
+        }
+        else if (failure.isEmpty())
+        {
+            failure = QObject::tr("Cannot read file.");
+        }
+    }
+
+    if (failure.isEmpty() && audioFolder.isEmpty())
+        failure = QObject::tr("Invalid set file (no audio folder).");
+    if (!failure.isEmpty())
+    {
+        if (error)
+            *error = failure;
+        return {};
+    }
+
+    for (Scene &scene : scenes)
+        for (QJsonObject &cue : scene.cues)
+            cue["path"] = TrackWidget::audioPathFromJson(cue, audioFolder);
+    return scenes;
+}
+
+/* ============================================================
+ * RENDER (background job)
+ * ============================================================ */
+void ShowRender::render(QPromise<Result> &promise, const QVector<Scene> &scenes,
+                        const QString &outputPath, const Options &options)
+{
+    promise.setProgressRange(0, 1000);
+    QElapsedTimer clock;
+    clock.start();
+    Result result;
+
+    int total = 0;
+    for (const Scene &scene : scenes)
+        total += scene.cues.size();
+    total = qMax(1, total);
+
+    // Rendering is 0..900, writing the file the rest
+    QAtomicInt done = 0;
+    auto canceled = [&promise]() { return promise.isCanceled(); };
+    auto cueDone = [&]() {
+        const int n = done.fetchAndAddRelaxed(1) + 1;
+        promise.setProgressValueAndText(int(qint64(n) * 900 / total),
+                                        QObject::tr("Rendered %1 of %2 cues…").arg(n).arg(total));
+    };
+
+    std::vector<SceneOutput> outputs(scenes.size());
+    QVector<int> order(scenes.size());
+    std::iota(order.begin(), order.end(), 0);
+    QtConcurrent::blockingMap(AudioAnalysis::threadPool(), order, [&](int i) {
+        if (!promise.isCanceled())
+            renderScene(scenes[i], options, outputs[i], canceled, cueDone);
+    });
+    if (promise.isCanceled())
+        return;
+
+    for (const SceneOutput &out : outputs)
+    {
+        result.warnings << out.warnings;
+        result.cues += out.cues;
+        if (result.error.isEmpty() && !out.error.isEmpty())
+            result.error = out.error;
+    }
+    if (!result.error.isEmpty())
+    {
+        promise.addResult(result);
+        return;
+    }
+
+    // Show order, a gap between scenes that have audio
+    promise.setProgressValueAndText(900, QObject::tr("Writing %1…").arg(outputPath));
+    AudioFileWriter writer;
+    if (!writer.open(outputPath, options.sampleRate, 2))
+    {
+        result.error = writer.errorString();
+        promise.addResult(result);
+        return;
+    }
+
+    qint64 written = 0, toWrite = 0;
+    for (const SceneOutput &out : outputs)
+        toWrite += out.frames;
+    toWrite = qMax<qint64>(1, toWrite);
+
+    const qint64 gap = std::llround(options.sceneGapSeconds * options.sampleRate);
+    QVector<float> buffer(2 * kCopyFrames);
+    bool first = true;
+    bool ok = true;
+    for (SceneOutput &out : outputs)
+    {
+        if (!ok)
+            break;
+        if (out.frames == 0)
+            continue;
+        if (!first)
+        {
+            buffer.fill(0.0f);
+            for (qint64 left = gap; ok && left > 0; left -= kCopyFrames)
+                ok = writer.write(buffer.constData(), qMin<qint64>(left, kCopyFrames));
+        }
+        first = false;
+
+        out.file.seek(0);
+        for (qint64 left = out.frames; ok && left > 0; left -= kCopyFrames)
+        {
+            if (promise.isCanceled())
+                return;
+            const qint64 n = qMin<qint64>(left, kCopyFrames);
+            const qint64 bytes = qint64(sizeof(float)) * 2 * n;
+            if (out.file.read(reinterpret_cast<char *>(buffer.data()), bytes) != bytes)
+            {
+                result.error = QObject::tr("Cannot read back a rendered scene: %1").arg(out.file.errorString());
+                ok = false;
+                break;
+            }
+            ok = writer.write(buffer.constData(), n);
+            written += n;
+            promise.setProgressValue(900 + int(written * 100 / toWrite));
+        }
+        out.file.close();
+    }
+
+    if (ok && writer.close())
+    {
+        result.ok = true;
+        result.frames = writer.framesWritten();
+    }
+    else if (result.error.isEmpty())
+    {
+        result.error = writer.errorString();
+    }
+    result.renderMs = clock.elapsed();
+    promise.addResult(result);
+}
+
+/* ============================================================
+ * COMMAND LINE – AudioCuePro --render <show> <out> [options]
+ * ============================================================ */
+int ShowRender::run(const QStringList &args)
+{
+    QTextStream out(stdout);
+    const auto usage = [&out]() {
+        out << "usage: --render <show> <out.wav|out.flac> [--rate Hz]"
+               " [--quality fast|standard|high] [--gap seconds] [--normalize LUFS]"
+               " [--go-early seconds]\n";
+        return 2;
+    };
+
+    QStringList files;
+    Options options;
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const QString &arg = args[i];
+        if (!arg.startsWith(QStringLiteral("--")))
+        {
+            files << arg;
+            continue;
+        }
+        if (i + 1 >= args.size())
+            return usage();
+        const QString value = args[++i];
+        bool ok = true;
+        if (arg == QStringLiteral("--rate"))
+            options.sampleRate = value.toInt(&ok);
+        else if (arg == QStringLiteral("--gap"))
+            options.sceneGapSeconds = value.toDouble(&ok);
+        else if (arg == QStringLiteral("--go-early"))
+            options.goEarlySeconds = value.toDouble(&ok);
+        else if (arg == QStringLiteral("--normalize"))
+        {
+            options.normalize = true;
+            options.targetLufs = value.toDouble(&ok);
+        }
+        else if (arg == QStringLiteral("--quality"))
+        {
+            ok = false;
+            for (Resampler::Quality q : { Resampler::Quality::Fast, Resampler::Quality::Standard,
+                                          Resampler::Quality::High })
+            {
+                if (value.compare(Resampler::qualityName(q), Qt::CaseInsensitive) == 0)
+                {
+                    options.quality = q;
+                    ok = true;
+                }
+            }
+        }
+        else
+            ok = false;
+        if (!ok || options.sampleRate < 8000 || options.sampleRate > 192000 || options.sceneGapSeconds < 0.0
+            || options.goEarlySeconds < 0.0)
+            return usage();
+    }
+    if (files.size() != 2)
+        return usage();
+
+    QString error;
+    const QVector<Scene> scenes = loadShow(files[0], &error);
+    if (scenes.isEmpty())
+    {
+        out << "cannot read " << files[0] << ": " << (error.isEmpty() ? QStringLiteral("no scenes") : error) << "\n";
+        return 1;
+    }
+
+    QFuture<Result> future = QtConcurrent::run(&ShowRender::render, scenes, files[1], options);
+    int reported = -10;
+    while (!future.isFinished())
+    {
+        const int percent = future.progressValue() / 10;
+        if (percent / 10 != reported / 10)
+        {
+            out << "  " << percent << " %\n";
+            out.flush();
+            reported = percent;
+        }
+        QThread::msleep(100);
+    }
+
+    const Result r = future.resultCount() > 0 ? future.result() : Result();
+    for (const QString &w : r.warnings)
+        out << "  warning: " << w << "\n";
+    if (!r.ok)
+    {
+        out << "render failed: " << r.error << "\n";
+        return 1;
+    }
+    const double seconds = double(r.frames) / options.sampleRate;
+    out << "rendered " << r.cues << " cues, " << QString::number(seconds, 'f', 1) << " s of audio in "
+        << QString::number(r.renderMs / 1000.0, 'f', 1) << " s ("
+        << QString::number(seconds * 1000.0 / qMax<qint64>(1, r.renderMs), 'f', 0) << "x real time) -> "
+        << files[1] << "\n";
+    return 0;
+}
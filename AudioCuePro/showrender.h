@@ -0,0 +1,98 @@
+#ifndef SHOWRENDER_H
+#define SHOWRENDER_H
+
+#include <QJsonObject>
+#include <QPromise>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "brickwalllimiter.h"
+#include "resampler.h"
+
+/*
+============================================================
+ ShowRender
+------------------------------------------------------------
+ - Plays a whole show into a 24-bit WAV or FLAC file as fast
+   as the CPU allows: the backup "show on a stick", and a way
+   to listen to every transition without running the show
+ - Runs the show through the live mixing code: each scene
+   gets an offline AudioEngine (voices, resampler, varispeed,
+   gain ramps, limiter) and is rendered block by block,
+   nothing waits on a clock
+ - Scenes are independent, so they render side by side on
+   AudioAnalysis::threadPool(), each into a temporary file;
+   the file is then written in show order with a gap of
+   silence between scenes
+ - Inside a scene the cues play in order on one timeline:
+     region (start / end), loops ("count": loopCount passes),
+     fade in (cubic, as TrackWidget), gain, loudness
+     normalisation, speed / pitch
+ - Each GO comes when the cue playing has ended (an
+   "infinite" loop: after its first pass), or --go-early
+   seconds before that. It runs as in the live show: the
+   outgoing cue fades out from its current level, looping
+   on meanwhile, and the next one starts when that fade has
+   run, the outgoing voice ramping out of what it still has
+   queued. A cue that ended by itself still makes the GO
+   wait out its fade length, as live
+ - After the last cue only an endless loop gets a GO (its
+   fade out). Ducking acts on whatever overlaps
+ - Spotify cues and audio that cannot be decoded are
+   skipped and listed in `warnings`
+ - Audio is streamed: each playing cue decodes its region on
+   a thread of its own (RegionStream), at most 2 s ahead of
+   the mix; a loop of 10 s or less replays from memory, a
+   longer one is decoded again each pass
+ - Progress range is 0..1000; cancel stops after the block
+   in flight and writes nothing
+ - Headless: AudioCuePro --render <show> <out.wav|.flac>
+     [--rate Hz] [--quality fast|standard|high]
+     [--gap seconds] [--normalize LUFS] [--go-early seconds]
+============================================================
+*/
+
+namespace ShowRender
+{
+    struct Scene {
+        QString name;
+        // As TrackWidget::toJson() writes them, with the audio
+        // file resolved into "path" (see loadShow())
+        QVector<QJsonObject> cues;
+    };
+
+    struct Options {
+        int sampleRate = 48000;
+        double sceneGapSeconds = 2.0;
+        double goEarlySeconds = 0.0;    // each GO this long before the cue playing would end
+        bool normalize = false;
+        double targetLufs = -23.0;
+        float limiterCeilingDb = BrickwallLimiter::kDefaultCeilingDb;
+        float limiterReleaseMs = BrickwallLimiter::kDefaultReleaseMs;
+        Resampler::Quality quality = Resampler::Quality::High;
+    };
+
+    struct Result {
+        bool ok = false;
+        QString error;
+        QStringList warnings;       // cues left out, and why
+        int cues = 0;               // rendered
+        qint64 frames = 0;
+        qint64 renderMs = 0;        // wall time
+    };
+
+    // Any show file or package, scenes in order and every cue's
+    // audio resolved; empty (and `error` set) if it cannot be read
+    QVector<Scene> loadShow(const QString &path, QString *error = nullptr);
+
+    // Background job: renders `scenes` into `outputPath` (.flac is
+    // FLAC, anything else WAV) and adds one Result
+    void render(QPromise<Result> &promise, const QVector<Scene> &scenes,
+                const QString &outputPath, const Options &options);
+
+    // args: everything after "--render". Returns the exit code.
+    int run(const QStringList &args);
+}
+
+#endif // SHOWRENDER_H
@@ -0,0 +1,149 @@
+#include "silencescan.h"
+
+#include <QtAlgorithms>
+#include <QtMath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define ACP_SCAN_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define ACP_SCAN_NEON
+#endif
+
+/* ============================================================
+ * SCALAR REFERENCE
+ * ============================================================ */
+qsizetype SilenceScan::firstAboveScalar(const float *samples, qsizetype count, float threshold)
+{
+    for (qsizetype i = 0; i < count; ++i)
+        if (qAbs(samples[i]) > threshold)
+            return i;
+    return -1;
+}
+
+qsizetype SilenceScan::lastAboveScalar(const float *samples, qsizetype count, float threshold)
+{
+    for (qsizetype i = count - 1; i >= 0; --i)
+        if (qAbs(samples[i]) > threshold)
+            return i;
+    return -1;
+}
+
+float SilenceScan::thresholdFromDb(double db)
+{
+    return float(qPow(10.0, db / 20.0));
+}
+
+/* ============================================================
+ * VECTOR SCAN – 16 samples per step
+ * ============================================================ */
+#if defined(ACP_SCAN_SSE2)
+
+namespace {
+
+// Bit i set if |p[i]| > threshold, i in 0..15
+inline int loudMask16(const float *p, __m128 thr)
+{
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 a = _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p),      absMask), thr);
+    const __m128 b = _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p + 4),  absMask), thr);
+    const __m128 c = _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p + 8),  absMask), thr);
+    const __m128 d = _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(p + 12), absMask), thr);
+    return _mm_movemask_ps(a) | (_mm_movemask_ps(b) << 4)
+         | (_mm_movemask_ps(c) << 8) | (_mm_movemask_ps(d) << 12);
+}
+
+} // namespace
+
+qsizetype SilenceScan::firstAbove(const float *samples, qsizetype count, float threshold)
+{
+    const __m128 thr = _mm_set1_ps(threshold);
+    qsizetype i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        if (const int m = loudMask16(samples + i, thr))
+            return i + qCountTrailingZeroBits(quint32(m));
+    }
+    const qsizetype tail = firstAboveScalar(samples + i, count - i, threshold);
+    return tail < 0 ? -1 : i + tail;
+}
+
+qsizetype SilenceScan::lastAbove(const float *samples, qsizetype count, float threshold)
+{
+    const __m128 thr = _mm_set1_ps(threshold);
+
+    // Tail that does not fill a block, then whole blocks backwards
+    const qsizetype blocks = count / 16 * 16;
+    const qsizetype tail = lastAboveScalar(samples + blocks, count - blocks, threshold);
+    if (tail >= 0)
+        return blocks + tail;
+
+    for (qsizetype i = blocks - 16; i >= 0; i -= 16)
+    {
+        if (const int m = loudMask16(samples + i, thr))
+            return i + 31 - qCountLeadingZeroBits(quint32(m));
+    }
+    return -1;
+}
+
+#elif defined(ACP_SCAN_NEON)
+
+namespace {
+
+// True if any of p[0..15] is above the threshold
+inline bool anyLoud16(const float *p, float32x4_t thr)
+{
+    const uint32x4_t a = vcgtq_f32(vabsq_f32(vld1q_f32(p)),      thr);
+    const uint32x4_t b = vcgtq_f32(vabsq_f32(vld1q_f32(p + 4)),  thr);
+    const uint32x4_t c = vcgtq_f32(vabsq_f32(vld1q_f32(p + 8)),  thr);
+    const uint32x4_t d = vcgtq_f32(vabsq_f32(vld1q_f32(p + 12)), thr);
+    return vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) != 0;
+}
+
+} // namespace
+
+qsizetype SilenceScan::firstAbove(const float *samples, qsizetype count, float threshold)
+{
+    const float32x4_t thr = vdupq_n_f32(threshold);
+    qsizetype i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // Found the block: pin the sample down with the scalar loop
+        if (anyLoud16(samples + i, thr))
+            return i + firstAboveScalar(samples + i, 16, threshold);
+    }
+    const qsizetype tail = firstAboveScalar(samples + i, count - i, threshold);
+    return tail < 0 ? -1 : i + tail;
+}
+
+qsizetype SilenceScan::lastAbove(const float *samples, qsizetype count, float threshold)
+{
+    const float32x4_t thr = vdupq_n_f32(threshold);
+
+    const qsizetype blocks = count / 16 * 16;
+    const qsizetype tail = lastAboveScalar(samples + blocks, count - blocks, threshold);
+    if (tail >= 0)
+        return blocks + tail;
+
+    for (qsizetype i = blocks - 16; i >= 0; i -= 16)
+    {
+        if (anyLoud16(samples + i, thr))
+            return i + lastAboveScalar(samples + i, 16, threshold);
+    }
+    return -1;
+}
+
+#else
+
+qsizetype SilenceScan::firstAbove(const float *samples, qsizetype count, float threshold)
+{
+    return firstAboveScalar(samples, count, threshold);
+}
+
+qsizetype SilenceScan::lastAbove(const float *samples, qsizetype count, float threshold)
+{
+    return lastAboveScalar(samples, count, threshold);
+}
+
+#endif
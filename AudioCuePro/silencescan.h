@@ -0,0 +1,37 @@
+#ifndef SILENCESCAN_H
+#define SILENCESCAN_H
+
+#include <QtGlobal>
+
+/*
+============================================================
+ SilenceScan
+------------------------------------------------------------
+ - Finds where the sound starts and ends in float PCM:
+   the first / last sample whose magnitude is above a
+   linear threshold (channels interleaved or not – the
+   caller turns a sample index into a frame)
+ - Vectorised: SSE2 on x86-64, NEON on ARM64, 16 samples
+   per step with one compare-and-mask; a scalar loop for
+   the tail and for other targets. Leading silence is
+   skipped at memory speed, and the backward scan stops at
+   the first loud block from the end
+ - The scalar versions are kept for the benchmark and as
+   the reference the vector code must match
+============================================================
+*/
+
+namespace SilenceScan
+{
+    // Index of the first / last sample with |x| > threshold, -1 if none
+    qsizetype firstAbove(const float *samples, qsizetype count, float threshold);
+    qsizetype lastAbove(const float *samples, qsizetype count, float threshold);
+
+    qsizetype firstAboveScalar(const float *samples, qsizetype count, float threshold);
+    qsizetype lastAboveScalar(const float *samples, qsizetype count, float threshold);
+
+    // dBFS → linear amplitude (-60 dB → 0.001)
+    float thresholdFromDb(double db);
+}
+
+#endif // SILENCESCAN_H
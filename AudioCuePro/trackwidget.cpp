@@ -16,6 +16,21 @@
 #include <QUrl>
 #include <QDesktopServices>
 #include <QStringList>
+#include <QAudioBuffer>
+#include <QAudioBufferOutput>
+#include <QMenu>
+#include <QSignalBlocker>
+
+#include "frameticker.h"
+#include "latencyprobe.h"
+#include "cueindex.h"
+#include "mediastore.h"
+#include "showpackage.h"
+#include "virtualplayer.h"
+
+// Voice gain cap: trackGain (up to 2x) on top of normalisation;
+// anything past this is a runaway, not a mix
+static const double kMaxVoiceGain = 4.0;
 
 // ------------------------------------------------------------
 // Helper: create icon buttons
@@ -64,11 +79,19 @@ static QString normalizeSpotifyUri(const QString &input)
     return trimmed;
 }
 
+// Skip QLabel::setText (and the relayout it triggers) when nothing changed.
+static void setLabelText(QLabel *label, const QString &text)
+{
+    if (label && label->text() != text)
+        label->setText(text);
+}
+
 // ============================================================
 // Constructor – from audio path OR Spotify URL
 // ============================================================
 TrackWidget::TrackWidget(const QString &audioPath, QWidget *parent)
     : QWidget(parent),
+      m_cueId(CueIndex::allocateId()),
       m_audioPath(audioPath)
 {
     // ------------------------------------------
@@ -90,6 +113,18 @@ TrackWidget::TrackWidget(const QString &audioPath, QWidget *parent)
     updateStatusIdle();
 }
 
+TrackWidget::~TrackWidget()
+{
+    // Stop the buffer tap before the voice goes. A buffer already
+    // on its way holds a Feed, so the engine keeps the voice until
+    // that call returns
+    if (m_player)
+        m_player->setAudioBufferOutput(nullptr);
+    if (m_bufferOutput)
+        m_bufferOutput->disconnect(this);
+    AudioEngine::instance()->removeVoice(m_voice);
+}
+
 // ============================================================
 // Constructor – load from JSON (supports Spotify)
 // ============================================================
@@ -98,6 +133,13 @@ TrackWidget::TrackWidget(const QJsonObject &obj,
                          QWidget *parent)
     : QWidget(parent)
 {
+    // Keep the saved cue ID; stored as a string (JSON numbers are doubles)
+    m_cueId = obj["id"].toString().toULongLong();
+    if (m_cueId != 0)
+        CueIndex::reserveId(m_cueId);
+    else
+        m_cueId = CueIndex::allocateId();
+
     // ------------------------------------------
     // LOAD SPOTIFY TRACK
     // ------------------------------------------
@@ -139,8 +181,11 @@ TrackWidget::TrackWidget(const QJsonObject &obj,
     // ------------------------------------------
     // LOAD NORMAL AUDIO TRACK
     // ------------------------------------------
-    QString fname = obj["filename"].toString();
-    m_audioPath = audioFolder + "/" + fname;
+    m_audioPath = audioPathFromJson(obj, audioFolder);
+    if (obj.contains("media") || obj.contains("path"))
+        m_fileName = obj["filename"].toString();   // store name is a hash
+    if (obj.contains("size"))
+        m_recordedSize = qint64(obj["size"].toDouble(-1));
 
     initUI();
     connectSignals();
@@ -157,6 +202,11 @@ TrackWidget::TrackWidget(const QJsonObject &obj,
     loopModeCombo->setCurrentText(obj["loopMode"].toString());
     loopCountSpin->setValue(obj["loopCount"].toInt());
     gainSlider->setValue(int(obj["gain"].toDouble(1.0) * 100));
+    if (obj.contains("loudness"))
+    {
+        m_loudness = Loudness::Stats::fromJson(obj["loudness"].toObject());
+        updateNormalizationGain();
+    }
 
     if (obj.contains("speed"))
         speedSpin->setValue(obj["speed"].toDouble());
@@ -169,6 +219,28 @@ TrackWidget::TrackWidget(const QJsonObject &obj,
         effectCombo->setCurrentIndex(idx);
     }
 
+    if (obj.contains("duckRole"))
+    {
+        const QString role = obj["duckRole"].toString();
+        const QString busName = obj["duckBus"].toString().toUpper();
+        const int bus = busName.isEmpty() ? 0
+            : qBound(0, busName.at(0).unicode() - 'A', AudioEngine::kDuckBuses - 1);
+        const AudioEngine::DuckRole r = role == "ducker" ? AudioEngine::DuckRole::Ducker
+                                      : role == "ducked" ? AudioEngine::DuckRole::Ducked
+                                                         : AudioEngine::DuckRole::None;
+        const int idx = duckCombo->findData(r == AudioEngine::DuckRole::None ? 0 : int(r) << 8 | bus);
+        duckCombo->setCurrentIndex(qMax(0, idx));
+    }
+
+    if (obj.contains("buses"))
+    {
+        m_outputBuses.clear();
+        for (const QJsonValue &v : obj["buses"].toArray())
+            m_outputBuses << v.toString();
+        rebuildOutputMenu();
+        applyOutputBuses();
+    }
+
     if (obj.contains("color"))
     {
         QColor c(obj["color"].toString());
@@ -179,12 +251,35 @@ TrackWidget::TrackWidget(const QJsonObject &obj,
     updateStatusIdle();
 }
 
+QString TrackWidget::audioPathFromJson(const QJsonObject &obj, const QString &audioFolder)
+{
+    if (obj["spotify"].toBool())
+        return QString();
+
+    // Autosave journal: the cue's file where it was, not yet stored
+    if (obj.contains("path"))
+        return obj["path"].toString();
+
+    // Content-addressed store: audio lives under its hash,
+    // the original file name is kept for display. A show package
+    // holds the same objects inside itself.
+    if (obj.contains("media"))
+    {
+        if (ShowPackage::isPackagePath(audioFolder))
+            return ShowPackage::entryPath(audioFolder, "media/" + obj["media"].toString());
+        return MediaStore::objectPath(audioFolder, obj["media"].toString());
+    }
+
+    return audioFolder + "/" + obj["filename"].toString();
+}
+
 // ============================================================
 // Export JSON (supports minimal Spotify format)
 // ============================================================
-QJsonObject TrackWidget::toJson(const QString &copyFolder) const
+QJsonObject TrackWidget::toJson(const QString &mediaObject) const
 {
     QJsonObject obj;
+    obj["id"] = QString::number(m_cueId);
 
     // ------------------------------------------
     // SAVE SPOTIFY TRACK
@@ -210,12 +305,11 @@ QJsonObject TrackWidget::toJson(const QString &copyFolder) const
     // ------------------------------------------
     // SAVE NORMAL AUDIO TRACK
     // ------------------------------------------
-    QFileInfo fi(m_audioPath);
-    QString baseName = fi.fileName();
-
-    QFile::copy(m_audioPath, copyFolder + "/" + baseName);
-
-    obj["filename"] = baseName;
+    // "filename" stays the original name (shown in the UI, and the
+    // lookup key for shows saved before the media store existed)
+    obj["filename"] = m_fileName;
+    if (!mediaObject.isEmpty())
+        obj["media"] = mediaObject;
     obj["altname"]  = altNameEdit->text();
     obj["hotkey"]   = keyEdit->text();
     obj["notes"]    = notesEdit->toPlainText();
@@ -227,10 +321,20 @@ QJsonObject TrackWidget::toJson(const QString &copyFolder) const
     obj["loopMode"] = loopModeCombo->currentText();
     obj["loopCount"] = loopCountSpin->value();
     obj["gain"] = trackGain;
+    if (m_loudness.valid)
+        obj["loudness"] = m_loudness.toJson();
 
     obj["speed"] = speedSpin->value();
     obj["pitch"] = pitchSpin->value();
     obj["effect"] = effectCombo->currentText();
+    if (const int duck = duckCombo->currentData().toInt())
+    {
+        obj["duckRole"] = AudioEngine::DuckRole(duck >> 8) == AudioEngine::DuckRole::Ducker
+                              ? "ducker" : "ducked";
+        obj["duckBus"] = QString(QChar('A' + (duck & 0xff)));
+    }
+    if (!m_outputBuses.isEmpty())
+        obj["buses"] = QJsonArray::fromStringList(m_outputBuses);
 
     if (m_trackColor.isValid())
         obj["color"] = m_trackColor.name(QColor::HexArgb);
@@ -244,6 +348,8 @@ QJsonObject TrackWidget::toJson(const QString &copyFolder) const
 void TrackWidget::initUI()
 {
     setObjectName("trackCard");
+    if (m_fileName.isEmpty())
+        m_fileName = QFileInfo(m_audioPath).fileName();
 
     root = new QVBoxLayout(this);
     root->setContentsMargins(10, 10, 10, 10);
@@ -260,7 +366,7 @@ void TrackWidget::initUI()
     colorButton->setFixedSize(20, 20);
     connect(colorButton, &QPushButton::clicked, this, &TrackWidget::onChooseColorTag);
 
-    nameLabel = new QLabel(QFileInfo(m_audioPath).fileName());
+    nameLabel = new QLabel(m_fileName);
     nameLabel->setMinimumWidth(200);
 
     dragHandle = new QLabel("☰");
@@ -270,7 +376,7 @@ void TrackWidget::initUI()
 
     altNameEdit = new QLineEdit();
     connect(altNameEdit, &QLineEdit::textChanged, this, [this](QString t){
-        nameLabel->setText(t.isEmpty() ? QFileInfo(m_audioPath).fileName() : t);
+        nameLabel->setText(t.isEmpty() ? m_fileName : t);
     });
 	connect(altNameEdit, &QLineEdit::editingFinished, this, [this]() {
     emit altNameEdited(this);
@@ -298,6 +404,14 @@ void TrackWidget::initUI()
 
     root->addLayout(header);
 
+    // ---------------- LEVEL METER ----------------
+    if (!m_isSpotify)
+    {
+        meterBar = new MeterBar(this);
+        meterBar->setFixedHeight(10);
+        root->addWidget(meterBar);
+    }
+
     // ---------------- DETAILS PANEL ----------------
     detailsPanel = new QWidget();
     QVBoxLayout *details = new QVBoxLayout(detailsPanel);
@@ -397,6 +511,25 @@ void TrackWidget::initUI()
     effectCombo = new QComboBox();
     effectCombo->addItems({"None", "Light reverb", "Big reverb", "Echo"});
 
+    // Item data: role << 8 | bus, as AudioEngine::Voice::setDucking takes it
+    duckCombo = new QComboBox();
+    duckCombo->addItem("Off", 0);
+    for (int bus = 0; bus < AudioEngine::kDuckBuses; ++bus)
+        duckCombo->addItem(QString("Ducks %1").arg(QChar('A' + bus)),
+                           int(AudioEngine::DuckRole::Ducker) << 8 | bus);
+    for (int bus = 0; bus < AudioEngine::kDuckBuses; ++bus)
+        duckCombo->addItem(QString("Ducked by %1").arg(QChar('A' + bus)),
+                           int(AudioEngine::DuckRole::Ducked) << 8 | bus);
+    duckCombo->setToolTip("Ducking: a \"Ducks\" cue lowers every \"Ducked by\" cue\n"
+                          "on the same bus while it sounds (Settings > Ducking...)");
+
+    // Output buses by name (Settings > Output Routing...); filled
+    // from the engine's routing, see rebuildOutputMenu()
+    outputButton = new QToolButton();
+    outputButton->setPopupMode(QToolButton::InstantPopup);
+    outputButton->setMenu(new QMenu(outputButton));
+    outputButton->setToolTip("Output buses this cue plays on");
+
     row2->addWidget(new QLabel("Loop:"));
     row2->addWidget(loopModeCombo);
     row2->addWidget(loopCountSpin);
@@ -417,6 +550,14 @@ void TrackWidget::initUI()
     row2->addWidget(new QLabel("Effect:"));
     row2->addWidget(effectCombo);
 
+    row2->addSpacing(10);
+    row2->addWidget(new QLabel("Duck:"));
+    row2->addWidget(duckCombo);
+
+    row2->addSpacing(10);
+    row2->addWidget(new QLabel("Out:"));
+    row2->addWidget(outputButton);
+
     details->addWidget(row2Widget);
 
     // ---------------- PLAY CONTROLS ----------------
@@ -439,24 +580,62 @@ void TrackWidget::initUI()
     // ============================================================
     if (!m_isSpotify)
     {
-        m_audio  = new QAudioOutput(this);
         m_player = new QMediaPlayer(this);
+        m_voice = AudioEngine::instance()->createVoice();
 
-        m_player->setAudioOutput(m_audio);
-        m_player->setSource(QUrl::fromLocalFile(m_audioPath));
-
-        connect(m_player, &QMediaPlayer::positionChanged,
-                this, &TrackWidget::onPlayerPositionChanged);
-        connect(m_player, &QMediaPlayer::playbackStateChanged,
-                this, &TrackWidget::onPlaybackStateChanged);
+        if (AudioEngine::instance()->hasVirtualClock())
+        {
+            // Virtual clock: the cue plays from a decoder fed with
+            // the samples, m_player only loads the media. Passes end
+            // where the voice has played them
+            m_clockPlayer = new VirtualPlayer(m_voice, this);
+            m_clockPlayer->setLoop([this](int queued) {
+                const QString mode = loopModeCombo->currentText();
+                return mode == "infinite" || (mode == "count" && loopRemaining > queued);
+            });
+            connect(m_clockPlayer, &VirtualPlayer::passEnded, this, [this]() {
+                if (!stopFlag && !manualStop)
+                    applyLoopLogic();
+            });
+            connect(m_clockPlayer, &VirtualPlayer::playbackStateChanged,
+                    this, &TrackWidget::onPlaybackStateChanged);
+        }
+        else
+        {
+            // No QAudioOutput: the player's buffers are mixed on the
+            // master bus, handed over on the thread that delivers them
+            m_bufferOutput = new QAudioBufferOutput(this);
+            m_player->setAudioBufferOutput(m_bufferOutput);
+            // Through a Feed, not `this`: a buffer still being delivered
+            // while the widget goes keeps the voice alive until it lands
+            connect(m_bufferOutput, &QAudioBufferOutput::audioBufferReceived,
+                    this, [feed = AudioEngine::Feed(m_voice)](const QAudioBuffer &buffer) {
+                        feed.push(buffer);
+                    },
+                    Qt::DirectConnection);
+
+            connect(m_player, &QMediaPlayer::positionChanged,
+                    this, &TrackWidget::onPlayerPositionChanged);
+            connect(m_player, &QMediaPlayer::playbackStateChanged,
+                    this, &TrackWidget::onPlaybackStateChanged);
+        }
+        setPlayerSource();
+        connect(m_player, &QMediaPlayer::mediaStatusChanged,
+                this, [this](QMediaPlayer::MediaStatus status) {
+                    if (status == QMediaPlayer::LoadedMedia
+                        || status == QMediaPlayer::BufferedMedia)
+                        setMediaState(MediaState::Armed);
+                    else if (status == QMediaPlayer::InvalidMedia)
+                        setMediaState(MediaState::Failed);
+                });
 
         updatePlaybackRate();
         updateOutputVolume();
     }
     else
     {
-        m_audio = nullptr;
         m_player = nullptr;
+        m_mediaState = MediaState::Armed;   // nothing to load locally
     }
 
     // ============================================================
@@ -524,7 +703,8 @@ void TrackWidget::connectSignals()
                 this, [this](qint64 ms){
                     if (m_player)
                     {
-                        m_player->setPosition(ms);
+                        m_voice->flush();
+                        seekPlayer(ms);
                         pausedPos = ms;
                     }
                 });
@@ -533,6 +713,14 @@ void TrackWidget::connectSignals()
             setTrackGain(val / 100.0);
         });
 
+        // Envelope from a show package or the importer: it may carry
+        // the loudness this cue has not got yet
+        connect(wave, &WaveformView::peaksReady, this, [this](){
+            const WaveformPeaksPtr p = wave->peakData();
+            if (!m_loudness.valid && p && p->loudness.valid)
+                setLoudness(p->loudness);
+        });
+
         connect(speedSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
                 this, [this](double){
                     updatePlaybackRate();
@@ -542,15 +730,31 @@ void TrackWidget::connectSignals()
                 this, [this](double){
                     updatePlaybackRate();
                 });
+    }
+
+    // Anything toJson() saves → settingsEdited (autosave journal)
+    auto edited = [this]() { emit settingsEdited(this); };
+    connect(altNameEdit, &QLineEdit::textChanged, this, edited);
+    connect(keyEdit, &QLineEdit::textChanged, this, edited);
+    connect(notesEdit, &QTextEdit::textChanged, this, edited);
+    for (QDoubleSpinBox *spin : {startSpin, endSpin, fadeInSpin, fadeOutSpin, speedSpin, pitchSpin})
+        connect(spin, &QDoubleSpinBox::valueChanged, this, edited);
+    connect(loopCountSpin, &QSpinBox::valueChanged, this, edited);
+    connect(gainSlider, &QSlider::valueChanged, this, edited);
+    connect(loopModeCombo, &QComboBox::currentIndexChanged, this, edited);
+    connect(effectCombo, &QComboBox::currentIndexChanged, this, edited);
+    connect(duckCombo, &QComboBox::currentIndexChanged, this, edited);
+    connect(duckCombo, &QComboBox::currentIndexChanged, this, &TrackWidget::applyDucking);
+
+    // Buses renamed, added or removed: show and apply them anew
+    connect(AudioEngine::instance(), &AudioEngine::routingChanged, this, [this]() {
+        rebuildOutputMenu();
+        applyOutputBuses();
+    });
+    rebuildOutputMenu();
 
-        connect(&fadeTimer, &QTimer::timeout, this, &TrackWidget::onFadeTick);
-		}
-        connect(&pauseBlinkTimer, &QTimer::timeout, this, &TrackWidget::onPauseBlink);
-		 // NEW: smooth time labels (both local + Spotify)
-    m_timeLabelTimer.setInterval(50);  // ~20 FPS
-    connect(&m_timeLabelTimer, &QTimer::timeout,
-            this, &TrackWidget::onTimeLabelTick);
-    
+    // Fades, pause blinking and time labels are driven by the shared
+    // FrameTicker (see startFadeTicks() / updateDisplayTicks()).
 }
 
 // ============================================================
@@ -572,6 +776,156 @@ void TrackWidget::loadAudioMetadata()
     });
 }
 
+void TrackWidget::applyProbe(const MediaProbe::Result &probe)
+{
+    if (m_isSpotify)
+        return;
+
+    if (!probe.exists)
+    {
+        statusLabel->setToolTip(tr("Audio file not found:\n%1").arg(m_audioPath));
+        setMediaState(MediaState::Failed);
+        return;
+    }
+
+    // Length known from the header: fill the end point now instead
+    // of waiting for the player
+    if (probe.durationMs > 0 && endSpin->value() <= 0)
+        endSpin->setValue(probe.durationMs / 1000.0);
+}
+
+void TrackWidget::applySoundBounds(qint64 startMs, qint64 endMs)
+{
+    if (m_isSpotify || startMs < 0 || endMs <= startMs)
+        return;
+
+    startSpin->setValue(startMs / 1000.0);
+    endSpin->setValue(endMs / 1000.0);
+}
+
+void TrackWidget::relink(const QString &audioPath)
+{
+    if (m_isSpotify || audioPath == m_audioPath)
+        return;
+
+    m_audioPath = audioPath;
+    // Found by content under another name: the cue shows (and
+    // saves) the file it now plays. A package entry keeps its name
+    if (!ShowPackage::isEntryPath(audioPath))
+    {
+        m_fileName = QFileInfo(audioPath).fileName();
+        if (altNameEdit && altNameEdit->text().isEmpty())
+            nameLabel->setText(m_fileName);
+    }
+    statusLabel->setToolTip(QString());
+    setMediaState(MediaState::Loading);
+
+    if (m_player)
+        setPlayerSource();
+    if (wave)
+        wave->setSource(m_audioPath);
+}
+
+void TrackWidget::setPlayerSource()
+{
+    // Let go of the previous package entry only once the player has
+    QIODevice *previous = m_sourceDevice;
+    m_sourceDevice = nullptr;
+
+    if (ShowPackage::isEntryPath(m_audioPath))
+    {
+        // Cue inside a show package: stream the entry in place. The
+        // URL only carries the file name as a format hint.
+        m_sourceDevice = ShowPackage::openEntryPath(m_audioPath, this);
+        if (m_sourceDevice)
+            m_player->setSourceDevice(m_sourceDevice, QUrl(QFileInfo(m_audioPath).fileName()));
+        else
+            m_player->setSource(QUrl());
+    }
+    else
+    {
+        m_player->setSource(QUrl::fromLocalFile(m_audioPath));
+    }
+    if (m_clockPlayer)
+        m_clockPlayer->setSource(m_audioPath);
+
+    delete previous;
+}
+
+// ============================================================
+// PLAYER – QMediaPlayer, or the VirtualPlayer on the virtual
+// clock (the same transport, fed with the samples)
+// ============================================================
+QMediaPlayer::PlaybackState TrackWidget::playerState() const
+{
+    if (m_clockPlayer)
+        return m_clockPlayer->playbackState();
+    return m_player ? m_player->playbackState() : QMediaPlayer::StoppedState;
+}
+
+qint64 TrackWidget::playerPosition() const
+{
+    if (m_clockPlayer)
+        return m_clockPlayer->position();
+    return m_player ? m_player->position() : 0;
+}
+
+void TrackWidget::seekPlayer(qint64 ms)
+{
+    if (m_clockPlayer)
+        m_clockPlayer->setPosition(ms);
+    else
+        m_player->setPosition(ms);
+}
+
+void TrackWidget::startPlayer(qint64 fromMs)
+{
+    if (m_clockPlayer)
+    {
+        m_clockPlayer->setRegion(qint64(startSpin->value() * 1000.0),
+                                 qint64(endSpin->value() * 1000.0));
+        m_clockPlayer->setPosition(fromMs);
+        m_clockPlayer->play();
+        return;
+    }
+    m_player->setPosition(fromMs);
+    m_player->play();
+}
+
+void TrackWidget::pausePlayer()
+{
+    if (m_clockPlayer)
+        m_clockPlayer->pause();
+    else
+        m_player->pause();
+}
+
+void TrackWidget::stopPlayer()
+{
+    if (m_clockPlayer)
+        m_clockPlayer->stop();
+    else
+        m_player->stop();
+}
+
+// Next loop pass. The VirtualPlayer has queued it already, unless
+// the loop was turned down when it was due
+void TrackWidget::loopToStart()
+{
+    if (m_clockPlayer)
+        m_clockPlayer->restartIfEnded();
+    else
+        m_player->setPosition(startSpin->value() * 1000.0);
+}
+
+void TrackWidget::setMediaState(MediaState state)
+{
+    if (m_mediaState == state)
+        return;
+    m_mediaState = state;
+    emit mediaStateChanged(this);
+}
+
 // ============================================================
 // UPDATE TIME LABELS
 // ============================================================
@@ -602,31 +956,31 @@ void TrackWidget::updateTimeLabels()
 
         if (endMs <= startMs)
         {
-            totalTimeLabel->setText("Total: --:--.---");
-            remainingTimeLabel->setText("Remaining: --:--.---");
+            setLabelText(totalTimeLabel, "Total: --:--.---");
+            setLabelText(remainingTimeLabel, "Remaining: --:--.---");
             return;
         }
 
         qint64 totalMs = endMs - startMs;
-        qint64 played = qBound<qint64>(0, m_spotifyPositionMs - startMs, totalMs);
+        qint64 played = qBound<qint64>(0, spotifyPositionNowMs() - startMs, totalMs);
         qint64 remaining = totalMs - played;
 
-        totalTimeLabel->setText("Total: " + fmt(totalMs));
-        remainingTimeLabel->setText("Remaining: " + fmt(remaining));
+        setLabelText(totalTimeLabel, "Total: " + fmt(totalMs));
+        setLabelText(remainingTimeLabel, "Remaining: " + fmt(remaining));
         return;
     }
 
     if (!m_player)
         return;
 
-    qint64 pos = m_player->position();
+    qint64 pos = playerPosition();
     double startSec = startSpin->value();
     double endSec   = endSpin->value();
 
     if (endSec <= startSec)
     {
-        totalTimeLabel->setText("Total: --:--.---");
-        remainingTimeLabel->setText("Remaining: --:--.---");
+        setLabelText(totalTimeLabel, "Total: --:--.---");
+        setLabelText(remainingTimeLabel, "Remaining: --:--.---");
         return;
     }
 
@@ -634,31 +988,96 @@ void TrackWidget::updateTimeLabels()
     qint64 endMs   = endSec   * 1000.0;
     qint64 totalMs = endMs - startMs;
 
-    totalTimeLabel->setText("Total: " + fmt(totalMs));
+    setLabelText(totalTimeLabel, "Total: " + fmt(totalMs));
 
     qint64 played = qBound<qint64>(0, pos - startMs, totalMs);
     qint64 remaining = totalMs - played;
-    remainingTimeLabel->setText("Remaining: " + fmt(remaining));
+    setLabelText(remainingTimeLabel, "Remaining: " + fmt(remaining));
+}
+
+// ============================================================
+// SPOTIFY POSITION (extrapolated between API polls)
+// ============================================================
+qint64 TrackWidget::spotifyPositionNowMs() const
+{
+    qint64 pos = m_spotifyPositionMs;
+
+    if (m_spotifyPlaying)
+        pos += FrameTicker::instance()->now() - m_spotifyAnchorMs;
+
+    if (m_spotifyDurationMs > 0 && pos > m_spotifyDurationMs)
+        pos = m_spotifyDurationMs;
+
+    return pos;
 }
-void TrackWidget::onTimeLabelTick()
+
+// ============================================================
+// FRAME TICKS
+// ------------------------------------------------------------
+// Fades subscribe in Always mode (audio must keep fading even
+// when the card is in a hidden scene). Labels, playhead and the
+// pause blink share one WhenVisible subscription, so a hidden
+// card costs nothing per frame.
+// ============================================================
+void TrackWidget::startFadeTicks()
 {
-    if (m_isSpotify)
+    FrameTicker *ticker = FrameTicker::instance();
+    if (ticker->isSubscribed(m_fadeTickId))
+        return;
+
+    m_fadeTickId = ticker->subscribe(this, [this](qint64, qint64) {
+        onFadeTick();
+    }, FrameTicker::Always);
+}
+
+void TrackWidget::stopFadeTicks()
+{
+    FrameTicker::instance()->unsubscribe(m_fadeTickId);
+    m_fadeTickId = 0;
+}
+
+void TrackWidget::updateDisplayTicks()
+{
+    FrameTicker *ticker = FrameTicker::instance();
+    const bool wanted = pauseBlinking || isPlaying();
+
+    if (wanted && !ticker->isSubscribed(m_displayTickId))
+    {
+        m_displayTickId = ticker->subscribe(this, [this](qint64 now, qint64) {
+            onDisplayTick(now);
+        }, FrameTicker::WhenVisible);
+    }
+    else if (!wanted && m_displayTickId)
+    {
+        ticker->unsubscribe(m_displayTickId);
+        m_displayTickId = 0;
+        if (meterBar)
+            meterBar->clear();
+    }
+}
+
+void TrackWidget::onDisplayTick(qint64 nowMs)
+{
+    if (pauseBlinking)
     {
-        if (m_spotifyPlaying)
+        const bool on = ((nowMs - pauseBlinkStartMs) / 400) % 2 == 0;
+        if (on != pauseBlinkOn)
         {
-            const qint64 step = m_timeLabelTimer.interval();
-            m_spotifyPositionMs += step;
-
-            if (m_spotifyDurationMs > 0 &&
-                m_spotifyPositionMs > m_spotifyDurationMs)
-            {
-                m_spotifyPositionMs = m_spotifyDurationMs;
-            }
+            pauseBlinkOn = on;
+            updateStatusPaused(pauseBlinkOn);
         }
     }
 
-    // For local audio we just re-read the player position
-    updateTimeLabels();
+    if (isPlaying())
+    {
+        if (wave && m_player)
+            wave->setPlayhead(playerPosition());
+
+        updateTimeLabels();
+    }
+
+    if (meterBar)
+        meterBar->setReading(m_voice->meter().reading(), nowMs);
 }
 
 // ============================================================
@@ -672,8 +1091,7 @@ void TrackWidget::onPlayClicked()
         return;
     }
 
-    if (m_player &&
-        m_player->playbackState() == QMediaPlayer::PausedState)
+    if (m_player && playerState() == QMediaPlayer::PausedState)
     {
         playFromUI();
     }
@@ -688,9 +1106,11 @@ void TrackWidget::onPlayClicked()
 // ============================================================
 void TrackWidget::playFromUI()
 {
+    LatencyProbe::mark(LatencyProbe::PlayFromUI);
     if (m_isSpotify) {
         if (m_spotifyPaused) {
             // Resume from paused position
+            m_spotifyAnchorMs = FrameTicker::instance()->now();
             m_spotifyPaused = false;
             m_spotifyPlaying = true;
             emit spotifyResumeRequested(this);
@@ -704,20 +1124,18 @@ void TrackWidget::playFromUI()
                 : 0;
 
             m_spotifyPositionMs = posMs;
+            m_spotifyAnchorMs = FrameTicker::instance()->now();
             m_spotifyPaused = false;
             m_spotifyPlaying = true;
 
             emit spotifyPlayRequested(this, uri, posMs);
         }
 
-        pauseBlinkTimer.stop();
-        pauseBlinkOn = false;
+        stopPauseBlink();
         updateStatusPlaying();
         emit statePlaying(this);
         updateTimeLabels();
-
-        if (!m_timeLabelTimer.isActive())
-            m_timeLabelTimer.start();
+        updateDisplayTicks();
 
         return;
     }
@@ -725,10 +1143,12 @@ void TrackWidget::playFromUI()
     manualStop = false;
     stopFlag = false;
 
-    if (m_player->playbackState() == QMediaPlayer::PausedState)
+    // A PANIC since the last start left the voice released
+    m_voice->arm();
+
+    if (playerState() == QMediaPlayer::PausedState)
     {
-        m_player->setPosition(pausedPos);
-        m_player->play();
+        startPlayer(pausedPos);
 
         if (fadeInSpin->value() > 0)
             beginFadeIn();
@@ -738,16 +1158,13 @@ void TrackWidget::playFromUI()
         }
 
         updateStatusPlaying();
-
-        if (!m_timeLabelTimer.isActive())
-            m_timeLabelTimer.start();
+        updateDisplayTicks();
 
         return;
     }
 
     // Normal start
-    m_player->setPosition(startSpin->value() * 1000.0);
-    m_player->play();
+    startPlayer(startSpin->value() * 1000.0);
 
     if (fadeInSpin->value() > 0)
         beginFadeIn();
@@ -761,9 +1178,8 @@ void TrackWidget::playFromUI()
         loopRemaining = loopCountSpin->value() - 1;
 
     updateStatusPlaying();
-
-    if (!m_timeLabelTimer.isActive())
-        m_timeLabelTimer.start();
+    updateDisplayTicks();
+    LatencyProbe::mark(LatencyProbe::PlayIssued);
 }
 
 
@@ -783,32 +1199,48 @@ void TrackWidget::pauseFromUI()
     if (m_isSpotify)
     {
         // Mirror the Spotify branch of onPauseClicked()
+        m_spotifyPositionMs = spotifyPositionNowMs();
+        m_spotifyAnchorMs = FrameTicker::instance()->now();
         m_spotifyPaused  = true;
         m_spotifyPlaying = false;
         emit spotifyPauseRequested(this);
 
-        pauseBlinkOn = true;
-        pauseBlinkTimer.start(400);
-        updateStatusPaused(true);
+        startPauseBlink(true);
         emit statePaused(this);
         updateTimeLabels();
-        m_timeLabelTimer.stop();
         return;
     }
 
     if (!m_player)
         return;
 
-    pausedPos = m_player->position();
-    m_player->pause();
-    m_timeLabelTimer.stop();
+    pausedPos = playerPosition();
+    pausePlayer();
 
-    pauseBlinkOn = true;
-    pauseBlinkTimer.start(400);
-    updateStatusPaused(true);
+    startPauseBlink(true);
     emit statePaused(this);
 }
 
+// ============================================================
+// PAUSE BLINK (phase derived from the ticker clock)
+// ============================================================
+void TrackWidget::startPauseBlink(bool initialOn)
+{
+    // Offset the phase origin so the first 400 ms show initialOn
+    pauseBlinkStartMs = FrameTicker::instance()->now() - (initialOn ? 0 : 400);
+    pauseBlinking = true;
+    pauseBlinkOn = initialOn;
+    updateStatusPaused(initialOn);
+    updateDisplayTicks();
+}
+
+void TrackWidget::stopPauseBlink()
+{
+    pauseBlinking = false;
+    pauseBlinkOn = false;
+    updateDisplayTicks();
+}
+
 
 // ============================================================
 // STOP IMMEDIATELY
@@ -821,11 +1253,10 @@ void TrackWidget::onStopClicked()
         m_spotifyPlaying = false;
         emit spotifyStopRequested(this);
 
-        pauseBlinkTimer.stop();
-        pauseBlinkOn = false;
-        m_timeLabelTimer.stop();   // NEW
+        stopPauseBlink();
 
         m_spotifyPositionMs = startSpin ? qint64(startSpin->value() * 1000.0) : 0;
+        m_spotifyAnchorMs = FrameTicker::instance()->now();
         updateTimeLabels();
         updateStatusIdle();
         emit stateStopped(this);
@@ -845,7 +1276,7 @@ void TrackWidget::stopImmediately()
         m_spotifyPlaying = false;
         emit spotifyStopRequested(this);
 
-        fadeTimer.stop();
+        stopFadeTicks();
         fadingIn = false;
         fadingOut = false;
 
@@ -853,11 +1284,10 @@ void TrackWidget::stopImmediately()
         manualStop = true;
         stopFlag = true;
 
-        pauseBlinkTimer.stop();
-        pauseBlinkOn = false;
-        m_timeLabelTimer.stop();   // NEW
+        stopPauseBlink();
 
         m_spotifyPositionMs = startSpin ? qint64(startSpin->value() * 1000.0) : 0;
+        m_spotifyAnchorMs = FrameTicker::instance()->now();
         updateTimeLabels();
 
         updateStatusIdle();
@@ -868,22 +1298,19 @@ void TrackWidget::stopImmediately()
     manualStop = true;
     stopFlag = true;
 
-    fadeTimer.stop();
+    stopFadeTicks();
     fadingIn = false;
     fadingOut = false;
 
     if (m_player)
-        m_player->stop();
+        stopPlayer();
 
     pausedPos = 0;
 
     envelopeVolume = 0.0;
     updateOutputVolume();
 
-    pauseBlinkTimer.stop();
-    pauseBlinkOn = false;
-
-    m_timeLabelTimer.stop();   // NEW
+    stopPauseBlink();
 
     updateStatusIdle();
 }
@@ -917,8 +1344,8 @@ void TrackWidget::stopWithFade()
     fadeDurationSec = dur;
     fadeStartEnvelope = envelopeVolume > 0 ? envelopeVolume : 1.0;
 
-    fadeClock.restart();
-    fadeTimer.start(20);
+    fadeStartMs = FrameTicker::instance()->now();
+    startFadeTicks();
 }
 
 // ============================================================
@@ -939,22 +1366,22 @@ void TrackWidget::beginFadeIn()
     fadeDurationSec = dur;
     fadeStartEnvelope = envelopeVolume;
 
-    fadeClock.restart();
-    fadeTimer.start(20);
+    fadeStartMs = FrameTicker::instance()->now();
+    startFadeTicks();
 }
 
 // ============================================================
-// FADE TIMER
+// FADE TICK
 // ============================================================
 void TrackWidget::onFadeTick()
 {
     if (!fadingIn && !fadingOut)
     {
-        fadeTimer.stop();
+        stopFadeTicks();
         return;
     }
 
-    double t = fadeClock.elapsed() / 1000.0 / fadeDurationSec;
+    double t = (FrameTicker::instance()->now() - fadeStartMs) / 1000.0 / fadeDurationSec;
     t = qBound(0.0, t, 1.0);
 
     if (fadingIn)
@@ -965,7 +1392,7 @@ void TrackWidget::onFadeTick()
         if (t >= 1.0)
         {
             fadingIn = false;
-            fadeTimer.stop();
+            stopFadeTicks();
         }
     }
     else if (fadingOut)
@@ -975,7 +1402,7 @@ void TrackWidget::onFadeTick()
         if (t >= 1.0)
         {
             envelopeVolume = 0.0;
-            fadeTimer.stop();
+            stopFadeTicks();
             stopImmediately();
             emit fadeOutFinished();
         }
@@ -992,11 +1419,8 @@ void TrackWidget::onPlayerPositionChanged(qint64 pos)
     if (m_isSpotify || stopFlag)
         return;
 
-    if (wave)
-        wave->setPlayhead(pos);
-
-    updateTimeLabels();
-
+    // Playhead and labels are refreshed once per frame in onDisplayTick();
+    // here we only need the end-of-region check.
     if (!manualStop && pos >= endSpin->value() * 1000.0)
         applyLoopLogic();
 }
@@ -1017,7 +1441,7 @@ void TrackWidget::applyLoopLogic()
 
     if (mode == "infinite")
     {
-        m_player->setPosition(startSpin->value() * 1000.0);
+        loopToStart();
         updateStatusPlaying();
         return;
     }
@@ -1027,7 +1451,7 @@ void TrackWidget::applyLoopLogic()
         if (loopRemaining > 0)
         {
             loopRemaining--;
-            m_player->setPosition(startSpin->value() * 1000.0);
+            loopToStart();
       
             updateStatusPlaying();
         }
@@ -1050,24 +1474,29 @@ void TrackWidget::onPlaybackStateChanged(QMediaPlayer::PlaybackState st)
     switch (st)
     {
     case QMediaPlayer::PlayingState:
-        pauseBlinkTimer.stop();
+        stopPauseBlink();
         updateStatusPlaying();
         emit statePlaying(this);
         break;
 
     case QMediaPlayer::PausedState:
-        pauseBlinkTimer.start(400);
-        updateStatusPaused(false);
+        // Resuming seeks back to the pause point: what is still
+        // queued would play twice
+        m_voice->flush();
+        startPauseBlink(false);
         emit statePaused(this);
         break;
 
     case QMediaPlayer::StoppedState:
     default:
-        pauseBlinkTimer.stop();
+        m_voice->flush();
+        stopPauseBlink();
         updateStatusIdle();
         emit stateStopped(this);
         break;
     }
+
+    updateDisplayTicks();
 }
 // ============================================================
 // WAVEFORM MARKER CHANGES (normal audio only)
@@ -1090,15 +1519,6 @@ void TrackWidget::onWaveEndChanged(qint64 e)
     updateTimeLabels();
 }
 
-// ============================================================
-// PAUSE BLINK
-// ============================================================
-void TrackWidget::onPauseBlink()
-{
-    pauseBlinkOn = !pauseBlinkOn;
-    updateStatusPaused(pauseBlinkOn);
-}
-
 // ============================================================
 // STATUS DOTS
 // ============================================================
@@ -1128,12 +1548,127 @@ void TrackWidget::updateStatusPaused(bool blink)
 // ============================================================
 void TrackWidget::updateOutputVolume()
 {
-    if (m_isSpotify || !m_audio)
+    if (m_isSpotify || !m_voice)
+        return;
+
+    // Above unity is allowed: the master bus limiter keeps the
+    // mix under its ceiling, so gain x normalisation x master
+    // stacks without clipping
+    double vol = envelopeVolume * trackGain * normalizeGain * masterVolume;
+    vol = qBound(0.0, vol, kMaxVoiceGain);
+    m_voice->setGain(float(vol));
+}
+
+// ============================================================
+// DUCKING (normal audio only; the engine does the work)
+// ============================================================
+void TrackWidget::applyDucking()
+{
+    if (!m_voice || !duckCombo)
+        return;
+    const int duck = duckCombo->currentData().toInt();
+    m_voice->setDucking(AudioEngine::DuckRole(duck >> 8), duck & 0xff);
+}
+
+// ============================================================
+// OUTPUT BUSES (by name, so a cue keeps its routing when buses
+// are reordered; none left that exist: the first bus, "Main")
+// ============================================================
+void TrackWidget::rebuildOutputMenu()
+{
+    if (!outputButton)
         return;
 
-    double vol = envelopeVolume * trackGain * masterVolume;
-    vol = qBound(0.0, vol, 1.0);
-    m_audio->setVolume(vol);
+    const QStringList names = AudioEngine::instance()->busNames();
+    QMenu *menu = outputButton->menu();
+    menu->clear();
+    QStringList shown;
+    for (const QString &name : names)
+    {
+        QAction *action = menu->addAction(name);
+        action->setCheckable(true);
+        action->setChecked(m_outputBuses.contains(name));
+        if (action->isChecked())
+            shown << name;
+        connect(action, &QAction::toggled, this, [this, name](bool on) {
+            if (on && !m_outputBuses.contains(name))
+                m_outputBuses << name;
+            else if (!on)
+                m_outputBuses.removeAll(name);
+            // Not from inside the action's own signal: it is deleted
+            QMetaObject::invokeMethod(this, &TrackWidget::rebuildOutputMenu, Qt::QueuedConnection);
+            applyOutputBuses();
+            emit settingsEdited(this);
+        });
+    }
+    // None of the cue's buses exist (any more): it plays on the
+    // first bus (applyOutputBuses()), shown checked but not written
+    // into the cue, so a bus restored under its name gets it back
+    if (shown.isEmpty() && !names.isEmpty())
+    {
+        QAction *fallback = menu->actions().first();
+        QSignalBlocker blocker(fallback);
+        fallback->setChecked(true);
+        shown << names.first();
+    }
+    outputButton->setText(shown.join(", "));
+}
+
+void TrackWidget::applyOutputBuses()
+{
+    if (!m_voice)
+        return;
+    const QStringList names = AudioEngine::instance()->busNames();
+    quint32 mask = 0;
+    for (const QString &name : std::as_const(m_outputBuses))
+    {
+        const int bus = names.indexOf(name);
+        if (bus >= 0)
+            mask |= 1u << bus;
+    }
+    m_voice->setBuses(mask ? mask : 1u);
+}
+
+// ============================================================
+// LOUDNESS NORMALISATION
+// ============================================================
+void TrackWidget::setLoudness(const Loudness::Stats &stats)
+{
+    if (m_isSpotify)
+        return;
+
+    m_loudness = stats;
+    updateNormalizationGain();
+    emit settingsEdited(this);
+}
+
+void TrackWidget::setNormalization(bool enabled, double targetLufs)
+{
+    m_normalize = enabled;
+    m_targetLufs = targetLufs;
+    updateNormalizationGain();
+}
+
+void TrackWidget::updateNormalizationGain()
+{
+    normalizeGain = m_normalize ? Loudness::normalizationGain(m_loudness, m_targetLufs) : 1.0;
+
+    if (gainSlider)
+    {
+        QString tip = tr("Gain (operator trim)");
+        if (m_loudness.valid)
+        {
+            tip += tr("\n%1 LUFS, range %2 LU, true peak %3 dBTP")
+                       .arg(m_loudness.integratedLufs, 0, 'f', 1)
+                       .arg(m_loudness.rangeLu, 0, 'f', 1)
+                       .arg(m_loudness.truePeakDbtp, 0, 'f', 1);
+            if (m_normalize)
+                tip += tr("\nNormalised by %1 dB").arg(20.0 * std::log10(normalizeGain), 0, 'f', 1);
+        }
+        gainSlider->setToolTip(tip);
+    }
+
+    updateOutputVolume();
 }
 
 // ============================================================
@@ -1168,7 +1703,11 @@ void TrackWidget::updatePlaybackRate()
     // Pitch shifts playback rate by 2^(semitones/12)
     double rate = speed * std::pow(2.0, pitch / 12.0);
 
+    // The player decodes at the rate, the voice's resampler plays
+    // it back (varispeed: pitch follows speed)
     m_player->setPlaybackRate(rate);
+    if (m_voice)
+        m_voice->setRate(rate);
 }
 
 void TrackWidget::updateSpotifyPlayback(qint64 positionMs,
@@ -1185,19 +1724,19 @@ void TrackWidget::updateSpotifyPlayback(qint64 positionMs,
             endSpin->setValue(durationMs / 1000.0);
     }
 
-    if (positionMs >= 0)
-    {
-        m_spotifyPositionMs = positionMs;
-        if (m_spotifyDurationMs > 0 && m_spotifyPositionMs > m_spotifyDurationMs)
-            m_spotifyPositionMs = m_spotifyDurationMs;
-    }
+    // Re-anchor the extrapolated position: either to the value Spotify
+    // reported, or (no position given) to where we think we are now.
+    m_spotifyPositionMs = (positionMs >= 0) ? positionMs : spotifyPositionNowMs();
+    if (m_spotifyDurationMs > 0 && m_spotifyPositionMs > m_spotifyDurationMs)
+        m_spotifyPositionMs = m_spotifyDurationMs;
+    m_spotifyAnchorMs = FrameTicker::instance()->now();
 
-    // Keep flags in sync with Spotify,
-    // but do NOT touch m_timeLabelTimer here.
+    // Keep flags in sync with Spotify
     m_spotifyPaused  = !isPlaying;
     m_spotifyPlaying = isPlaying;
 
     updateTimeLabels();
+    updateDisplayTicks();
 }
 
 
@@ -1229,6 +1768,8 @@ void TrackWidget::setTrackColor(const QColor &c)
                         .arg(c.name(QColor::HexArgb));
         colorButton->setStyleSheet(css);
     }
+
+    emit settingsEdited(this);
 }
 
 // ============================================================
@@ -1277,6 +1818,12 @@ QString TrackWidget::altName() const
     return altNameEdit->text();
 }
 
+QString TrackWidget::displayName() const
+{
+    const QString alt = altNameEdit ? altNameEdit->text().trimmed() : QString();
+    return alt.isEmpty() ? m_fileName : alt;
+}
+
 QString TrackWidget::notesText() const
 {
     return notesEdit ? notesEdit->toPlainText() : QString();
@@ -1338,9 +1885,39 @@ double TrackWidget::durationSeconds() const
 double TrackWidget::currentPositionSeconds() const
 {
     if (m_isSpotify)
-        return m_spotifyPositionMs / 1000.0;
+        return spotifyPositionNowMs() / 1000.0;
+
+    return m_player ? (playerPosition() / 1000.0) : 0.0;
+}
 
-    return m_player ? (m_player->position() / 1000.0) : 0.0;
+double TrackWidget::fadeInSeconds() const
+{
+    return fadeInSpin ? fadeInSpin->value() : 0.0;
+}
+
+double TrackWidget::fadeOutSeconds() const
+{
+    return fadeOutSpin ? fadeOutSpin->value() : 0.0;
+}
+
+QString TrackWidget::loopModeText() const
+{
+    return loopModeCombo ? loopModeCombo->currentText() : QStringLiteral("none");
+}
+
+int TrackWidget::loopCount() const
+{
+    return loopCountSpin ? loopCountSpin->value() : 0;
+}
+
+double TrackWidget::speed() const
+{
+    return speedSpin ? speedSpin->value() : 1.0;
+}
+
+WaveformPeaksPtr TrackWidget::peakData() const
+{
+    return wave ? wave->peakData() : WaveformPeaksPtr();
 }
 
 // ============================================================
@@ -1370,8 +1947,8 @@ void TrackWidget::mouseMoveEvent(QMouseEvent *ev)
     QMimeData *mime = new QMimeData();
     QByteArray data;
     QDataStream ds(&data, QIODevice::WriteOnly);
-    ds << quintptr(this);
-    mime->setData("application/x-audiocuepro-trackptr", data);
+    ds << m_cueId;
+    mime->setData("application/x-audiocuepro-cueid", data);
 
     QDrag *drag = new QDrag(this);
     drag->setMimeData(mime);
@@ -1386,7 +1963,7 @@ bool TrackWidget::isPaused() const
     }
 
     if (m_player) {
-        return m_player->playbackState() == QMediaPlayer::PausedState;
+        return playerState() == QMediaPlayer::PausedState;
     }
 
     return false;
@@ -1398,5 +1975,5 @@ bool TrackWidget::isPlaying() const
         return m_spotifyPlaying;
 
     return m_player &&
-           m_player->playbackState() == QMediaPlayer::PlayingState;
+           playerState() == QMediaPlayer::PlayingState;
 }
@@ -3,7 +3,6 @@
 
 #include <QWidget>
 #include <QMediaPlayer>
-#include <QAudioOutput>
 #include <QPushButton>
 #include <QLineEdit>
 #include <QDoubleSpinBox>
@@ -17,10 +16,18 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QSlider>
+#include <QToolButton>
 #include <QColor>
 #include <QMimeData>
 
 #include "waveformview.h"
+#include "mediaprobe.h"
+#include "loudness.h"
+#include "audioengine.h"
+#include "meterbar.h"
+
+class QAudioBufferOutput;
+class VirtualPlayer;
 
 class TrackWidget : public QWidget
 {
@@ -34,13 +41,50 @@ public:
                          const QString &audioFolder,
                          QWidget *parent = nullptr);
 
-    QJsonObject toJson(const QString &copyFolder) const;
+    ~TrackWidget() override;
+
+    // Settings only; storing the audio is the caller's job (MediaStore).
+    // mediaObject = content address of the audio in the show's store.
+    QJsonObject toJson(const QString &mediaObject = QString()) const;
+
+    // Audio file a saved cue refers to ("" for Spotify). Pure, so
+    // loaders can resolve paths on worker threads.
+    static QString audioPathFromJson(const QJsonObject &obj, const QString &audioFolder);
+
+    // Armed = the player has the media loaded and can start at once.
+    // Failed = missing or unreadable file. Spotify cues are always armed.
+    enum class MediaState { Loading, Armed, Failed };
+    MediaState mediaState() const { return m_mediaState; }
+
+    // Results of a background MediaProbe, applied before the player is done
+    void applyProbe(const MediaProbe::Result &probe);
+    // Import-time silence trim: start/end markers where the sound is
+    void applySoundBounds(qint64 startMs, qint64 endMs);
+
+    // R128 measurement of the cue's audio (import, Analyze Loudness,
+    // or saved with the show); persisted in the show file
+    Loudness::Stats loudness() const { return m_loudness; }
+    void setLoudness(const Loudness::Stats &stats);
+    // Normalise to a target loudness: a fixed gain folded into the
+    // output volume, recomputed only when the measurement or target changes
+    void setNormalization(bool enabled, double targetLufs);
 
     QString assignedKey() const;
     void setAssignedKey(const QString &k);
 
+    // Stable cue ID (see CueIndex); persisted in the show file
+    quint64 cueId() const { return m_cueId; }
+    void setCueId(quint64 id) { m_cueId = id; }
+
     QString audioPath() const { return m_audioPath; }
+    QString fileName() const { return m_fileName; }
+    // Size of the audio when the show was saved (-1 = not recorded)
+    qint64 recordedSize() const { return m_recordedSize; }
+    // Point the cue at another copy of its audio (media relink)
+    void relink(const QString &audioPath);
     QString altName() const;
+    // Alt name if set, otherwise the file name (cached, no QFileInfo per call)
+    QString displayName() const;
     QString notesText() const;
     bool isSpotify() const { return m_isSpotify; }
     QString spotifyUri() const;
@@ -57,6 +101,15 @@ public:
 
     double currentPositionSeconds() const;
 
+    // Read-only cue parameters for the Live Mode monitor
+    double fadeInSeconds() const;
+    double fadeOutSeconds() const;
+    QString loopModeText() const;
+    int loopCount() const;
+    double gain() const { return trackGain; }
+    double speed() const;
+    WaveformPeaksPtr peakData() const;
+
     bool detailsVisible() const;
     void setDetailsVisible(bool v);
 
@@ -91,23 +144,22 @@ signals:
 void spotifyPauseRequested(TrackWidget *tw);
     void spotifyResumeRequested(TrackWidget *tw);
     void spotifyStopRequested(TrackWidget *tw);
+    void mediaStateChanged(TrackWidget *tw);
+    void settingsEdited(TrackWidget *tw);     // any saved setting changed
 
 private slots:
     void onPlayClicked();
     void onPauseClicked();
     void onStopClicked();
 
-    void onFadeTick();
     void onPlayerPositionChanged(qint64 pos);
     void onPlaybackStateChanged(QMediaPlayer::PlaybackState state);
 
     void onWaveStartChanged(qint64);
     void onWaveEndChanged(qint64);
 
-    void onPauseBlink();
     void onChooseColorTag();
     void onInfoClicked();
-	    void onTimeLabelTick();
 
 
 private:
@@ -117,27 +169,54 @@ private:
 
     void updateTimeLabels();
     void updateOutputVolume();
+    void updateNormalizationGain();
+    void applyDucking();
+    void rebuildOutputMenu();
+    void applyOutputBuses();
     void updatePlaybackRate();
     void beginFadeIn();
     void applyLoopLogic();
 
     void updateStatusIdle();
+    void setMediaState(MediaState state);
+    void setPlayerSource();
+    QMediaPlayer::PlaybackState playerState() const;
+    qint64 playerPosition() const;
+    void seekPlayer(qint64 ms);
+    void startPlayer(qint64 fromMs);
+    void pausePlayer();
+    void stopPlayer();
+    void loopToStart();
     void updateStatusPlaying();
     void updateStatusPaused(bool blinkOn);
 
+    // Shared frame ticker (replaces per-track QTimers)
+    void onFadeTick();
+    void onDisplayTick(qint64 nowMs);
+    void startFadeTicks();
+    void stopFadeTicks();
+    void updateDisplayTicks();
+    void startPauseBlink(bool initialOn);
+    void stopPauseBlink();
+    qint64 spotifyPositionNowMs() const;
+
 protected:
     void mousePressEvent(QMouseEvent *ev) override;
     void mouseMoveEvent(QMouseEvent *ev) override;
 
 private:
     // Core paths
+    quint64 m_cueId = 0;
     QString m_audioPath;
+    QString m_fileName;       // QFileInfo(m_audioPath).fileName(), cached
+    qint64 m_recordedSize = -1;
     bool m_isSpotify = false;
 	bool m_spotifyPaused = false;      // NEW: remember paused state
 
     QString m_spotifyUrl;
     qint64 m_spotifyDurationMs = 0;
-    qint64 m_spotifyPositionMs = 0;
+    qint64 m_spotifyPositionMs = 0;   // position at m_spotifyAnchorMs
+    qint64 m_spotifyAnchorMs = 0;     // FrameTicker clock of last sync
     bool m_spotifyPlaying = false;
 
     QColor m_trackColor;
@@ -176,22 +255,41 @@ private:
     QDoubleSpinBox *speedSpin = nullptr;
     QDoubleSpinBox *pitchSpin = nullptr;
     QComboBox *effectCombo = nullptr;
+    QComboBox *duckCombo = nullptr;     // ducking role and bus (AudioEngine)
+    QToolButton *outputButton = nullptr;
+    QStringList m_outputBuses;          // bus names; empty: "Main" only
 
     QPushButton *btnPlay = nullptr;
     QPushButton *btnPause = nullptr;
     QPushButton *btnStop = nullptr;
 
+    MeterBar *meterBar = nullptr;
+
     // Audio backend (disabled for Spotify)
     QMediaPlayer *m_player = nullptr;
-    QAudioOutput *m_audio = nullptr;
+    QIODevice *m_sourceDevice = nullptr;    // package entry being played
+    // Decoded buffers go to this cue's voice on the master bus
+    // (AudioEngine), which applies the volume and meters it
+    QAudioBufferOutput *m_bufferOutput = nullptr;
+    AudioEngine::Voice *m_voice = nullptr;
+    // Virtual clock (AudioEngine::hasVirtualClock()): plays the cue
+    // in m_player's place, which then only loads the media
+    VirtualPlayer *m_clockPlayer = nullptr;
+    MediaState m_mediaState = MediaState::Loading;
 
     // Fades & volume envelope
     double envelopeVolume = 1.0;
     double trackGain = 1.0;
     double masterVolume = 1.0;
 
-    QTimer fadeTimer;
-    QElapsedTimer fadeClock;
+    // Loudness normalisation (1.0 when off or not measured)
+    Loudness::Stats m_loudness;
+    bool m_normalize = false;
+    double m_targetLufs = -23.0;
+    double normalizeGain = 1.0;
+
+    int m_fadeTickId = 0;
+    qint64 fadeStartMs = 0;             // FrameTicker time, so fades follow a virtual clock
     bool fadingIn = false;
     bool fadingOut = false;
     double fadeDurationSec = 0.0;
@@ -202,10 +300,11 @@ private:
     bool manualStop = false;
     bool stopFlag = false;
 
-    // Pause blinking
-    QTimer pauseBlinkTimer;
+    // Pause blinking + time labels run on the display tick
+    int m_displayTickId = 0;
+    bool pauseBlinking = false;
     bool pauseBlinkOn = false;
-    QTimer m_timeLabelTimer;   // NEW
+    qint64 pauseBlinkStartMs = 0;
 
     // Drag & Drop
     bool dragFromHandle = false;
@@ -0,0 +1,205 @@
+#include "virtualplayer.h"
+#include "regionstream.h"
+
+#include <QAudioBuffer>
+#include <QDebug>
+#include <QElapsedTimer>
+
+static const int kFeedFrames = 8 * AudioEngine::kBlockFrames;  // queued beyond each step, above the voice's prime
+static const int kTailMs = 50;              // silence after the last pass: drains the resampler, primes a tiny region
+static const int kStallMs = 10000;          // a decoder this late is given up on
+
+VirtualPlayer::VirtualPlayer(AudioEngine::Voice *voice, QObject *parent)
+    : QObject(parent), m_voice(voice)
+{
+    AudioEngine *engine = AudioEngine::instance();
+    connect(engine, &AudioEngine::aboutToAdvanceClock, this, &VirtualPlayer::feed);
+    connect(engine, &AudioEngine::clockAdvanced, this, &VirtualPlayer::advanced);
+}
+
+VirtualPlayer::~VirtualPlayer() = default;
+
+/* ============================================================
+ * TRANSPORT – as QMediaPlayer
+ * ============================================================ */
+void VirtualPlayer::setSource(const QString &path)
+{
+    stop();
+    m_path = path;
+}
+
+void VirtualPlayer::setRegion(qint64 startMs, qint64 endMs)
+{
+    m_startMs = qMax<qint64>(0, startMs);
+    m_endMs = endMs;
+}
+
+void VirtualPlayer::play()
+{
+    if (m_state == QMediaPlayer::PlayingState)
+        return;
+    m_firstFrame = -1;
+    restart(m_positionMs);
+    setState(QMediaPlayer::PlayingState);
+}
+
+void VirtualPlayer::pause()
+{
+    m_positionMs = position();
+    drop();
+    setState(QMediaPlayer::PausedState);
+}
+
+void VirtualPlayer::stop()
+{
+    drop();
+    m_positionMs = 0;
+    setState(QMediaPlayer::StoppedState);
+}
+
+void VirtualPlayer::setPosition(qint64 ms)
+{
+    m_positionMs = qMax<qint64>(0, ms);
+    if (m_state != QMediaPlayer::PlayingState)
+        return;
+    // What is queued fades out, the new position follows it
+    m_voice->flush();
+    restart(m_positionMs);
+}
+
+qint64 VirtualPlayer::position() const
+{
+    if (m_state != QMediaPlayer::PlayingState || m_spans.isEmpty())
+        return m_positionMs;
+    const qint64 played = m_voice->playedFrames();
+    const Span &span = m_spans.head();
+    if (played <= span.from)
+        return m_positionMs;
+    const double f = qMin(1.0, double(played - span.from) / double(span.to - span.from));
+    return qint64(span.fromMs + f * (span.toMs - span.fromMs));
+}
+
+void VirtualPlayer::restartIfEnded()
+{
+    if (m_state == QMediaPlayer::PlayingState && m_fed && m_passEnds.isEmpty())
+        setPosition(m_startMs);
+}
+
+void VirtualPlayer::setState(QMediaPlayer::PlaybackState state)
+{
+    if (m_state == state)
+        return;
+    m_state = state;
+    emit playbackStateChanged(state);
+}
+
+// A stream from `fromMs` to the end of the region; none if that
+// is past it
+void VirtualPlayer::restart(qint64 fromMs)
+{
+    drop();
+    m_streamMs = double(fromMs);
+    const bool bounded = m_endMs > m_startMs;
+    if (!bounded || fromMs < m_endMs)
+        m_stream.reset(new RegionStream(m_path, fromMs / 1000.0, bounded ? m_endMs / 1000.0 : 0.0));
+}
+
+void VirtualPlayer::drop()
+{
+    m_stream.reset();
+    m_passBuffers = 0;
+    m_fed = false;
+    m_spans.clear();
+    m_passEnds.clear();
+    m_firstRing = -1;
+}
+
+qint64 VirtualPlayer::writtenFrames() const
+{
+    return m_voice->playedFrames() + m_voice->queuedFrames();
+}
+
+/* ============================================================
+ * SAMPLE CLOCK – AudioEngine::advanceClock()
+ * ============================================================ */
+// Enough for the step and the voice's prime: whatever the wall
+// clock does, the voice never runs dry before the region ends
+void VirtualPlayer::feed(qint64 frames)
+{
+    if (m_state != QMediaPlayer::PlayingState)
+        return;
+
+    QElapsedTimer waited;
+    waited.start();
+    const auto stalled = [&waited]() { return waited.elapsed() > kStallMs; };
+
+    while (!m_fed && m_voice->queuedFrames() < frames + kFeedFrames)
+    {
+        QAudioBuffer buffer;
+        if (m_stream && m_stream->next(&buffer, stalled))
+        {
+            const qint64 from = writtenFrames();
+            m_voice->push(buffer);
+            const qint64 to = writtenFrames();
+            const double ms = buffer.frameCount() * 1000.0 / buffer.format().sampleRate();
+            if (to > from)
+                m_spans.enqueue({ from, to, m_streamMs, m_streamMs + ms });
+            if (m_firstRing < 0)
+                m_firstRing = from;
+            m_streamMs += ms;
+            m_format = buffer.format();
+            ++m_passBuffers;
+            continue;
+        }
+
+        QString error = m_stream ? m_stream->error() : QString();
+        if (error.isEmpty() && stalled())
+            error = tr("the decoder stalled");
+        if (!error.isEmpty())
+            qWarning() << "VirtualPlayer:" << m_path << error;
+
+        // End of a pass: the next one right behind it, or the end
+        const int queued = m_passEnds.size();
+        m_passEnds.enqueue(writtenFrames());
+        if (error.isEmpty() && m_passBuffers > 0 && m_loop && m_loop(queued))
+        {
+            m_stream.reset(new RegionStream(m_path, m_startMs / 1000.0,
+                                            m_endMs > m_startMs ? m_endMs / 1000.0 : 0.0));
+            m_streamMs = double(m_startMs);
+            m_passBuffers = 0;
+            continue;
+        }
+
+        if (m_format.isValid())
+        {
+            QAudioFormat format;
+            format.setSampleFormat(QAudioFormat::Float);
+            format.setChannelCount(2);
+            format.setSampleRate(m_format.sampleRate());
+            const qint64 tail = qint64(format.sampleRate()) * kTailMs / 1000;
+            m_voice->push(QAudioBuffer(QByteArray(tail * format.bytesPerFrame(), 0), format));
+        }
+        m_stream.reset();
+        m_fed = true;
+    }
+}
+
+void VirtualPlayer::advanced()
+{
+    if (m_state != QMediaPlayer::PlayingState)
+        return;
+
+    const qint64 played = m_voice->playedFrames();
+    if (m_firstFrame < 0 && m_firstRing >= 0 && played > m_firstRing)
+        m_firstFrame = AudioEngine::instance()->clockFrames() - (played - m_firstRing);
+    while (!m_spans.isEmpty() && m_spans.head().to <= played)
+        m_positionMs = qint64(m_spans.dequeue().toMs);
+
+    while (!m_passEnds.isEmpty() && m_passEnds.head() <= played)
+    {
+        m_passEnds.dequeue();
+        emit passEnded();
+        if (m_state != QMediaPlayer::PlayingState)
+            return;                     // the cue stopped there
+    }
+}
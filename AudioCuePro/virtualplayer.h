@@ -0,0 +1,109 @@
+#ifndef VIRTUALPLAYER_H
+#define VIRTUALPLAYER_H
+
+#include <QAudioFormat>
+#include <QMediaPlayer>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <functional>
+#include <memory>
+
+#include "audioengine.h"
+
+class RegionStream;
+
+/*
+============================================================
+ VirtualPlayer
+------------------------------------------------------------
+ - Plays a cue into its voice on the virtual clock
+   (ACP_AUDIO_OUTPUT=virtual), where TrackWidget uses it
+   instead of QMediaPlayer: the same play / pause / stop /
+   seek and playback states, but no clock of its own
+ - Before each step of AudioEngine::advanceClock() it tops
+   the voice up from a RegionStream, waiting for the decoder
+   if it has to, so a run goes as fast as decoding and
+   mixing allow and always plays the same samples
+ - Position is that of the samples the voice has mixed, to
+   the frame, whatever the speed
+ - Loops are fed without a seek: at the end of each pass the
+   loop callback says whether another one follows, and the
+   next pass is queued right behind it. passEnded() comes
+   when the voice has played a pass through, after the step
+   in which it did (one display frame at most)
+ - The region is taken when playback starts
+============================================================
+*/
+
+class VirtualPlayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Whether another pass follows the one whose end was just fed,
+    // `queued` pass ends being queued ahead of it and not yet played
+    using LoopCallback = std::function<bool(int queued)>;
+
+    explicit VirtualPlayer(AudioEngine::Voice *voice, QObject *parent = nullptr);
+    ~VirtualPlayer() override;
+
+    // Audio file or package entry path
+    void setSource(const QString &path);
+    // endMs <= startMs: to the end of the file
+    void setRegion(qint64 startMs, qint64 endMs);
+    void setLoop(const LoopCallback &loop) { m_loop = loop; }
+
+    void play();
+    void pause();
+    void stop();
+    void setPosition(qint64 ms);
+    qint64 position() const;
+    QMediaPlayer::PlaybackState playbackState() const { return m_state; }
+
+    // From passEnded(): if that was the last pass queued, start the
+    // region over (a loop the callback turned down when it was due)
+    void restartIfEnded();
+
+    // Clock frame (AudioEngine::clockFrames()) of the first sample
+    // heard since play(); -1 until then
+    qint64 firstSampleFrame() const { return m_firstFrame; }
+
+signals:
+    void playbackStateChanged(QMediaPlayer::PlaybackState state);
+    void passEnded();
+
+private:
+    void setState(QMediaPlayer::PlaybackState state);
+    void restart(qint64 fromMs);
+    void drop();
+    void feed(qint64 frames);
+    void advanced();
+    qint64 writtenFrames() const;
+
+    AudioEngine::Voice *const m_voice;
+    QString m_path;
+    qint64 m_startMs = 0;
+    qint64 m_endMs = 0;
+    LoopCallback m_loop;
+    QMediaPlayer::PlaybackState m_state = QMediaPlayer::StoppedState;
+
+    std::unique_ptr<RegionStream> m_stream;
+    double m_streamMs = 0.0;            // media time of the stream's next buffer
+    int m_passBuffers = 0;
+    bool m_fed = false;                 // no pass follows, tail pushed
+    QAudioFormat m_format;              // last buffer's, for the tail
+
+    // Ring frames each pushed buffer went to, against media time
+    struct Span {
+        qint64 from, to;
+        double fromMs, toMs;
+    };
+    QQueue<Span> m_spans;
+    QQueue<qint64> m_passEnds;          // ring frame after each pass
+    qint64 m_positionMs = 0;
+    qint64 m_firstRing = -1;            // ring frame of the first sample since play()
+    qint64 m_firstFrame = -1;
+};
+
+#endif // VIRTUALPLAYER_H
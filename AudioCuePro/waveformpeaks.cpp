@@ -0,0 +1,155 @@
+#include "waveformpeaks.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtEndian>
+#include <QtMath>
+#include <cstring>
+
+static const char kMagic[4] = { 'A', 'C', 'P', 'W' };
+static const quint32 kVersion = 2;
+static const int kHeaderSize = 20;
+static const int kLoudnessSize = 32;    // version 2 trailer
+
+/* ============================================================
+ * BUILD FROM MONO SAMPLES
+ * ============================================================ */
+QSharedPointer<const WaveformPeaks> WaveformPeaks::build(const QVector<float> &mono,
+                                                         qint64 durationMs,
+                                                         int buckets)
+{
+    auto result = QSharedPointer<WaveformPeaks>::create();
+    result->durationMs = durationMs;
+
+    const qsizetype n = mono.size();
+    if (n <= 0 || buckets <= 0)
+        return result;
+
+    // Short files: one bucket per sample
+    if (n < buckets)
+        buckets = int(n);
+
+    result->peaks.resize(buckets);
+
+    const float *src = mono.constData();
+    for (int b = 0; b < buckets; ++b)
+    {
+        const qsizetype from = n * b / buckets;
+        const qsizetype to   = n * (b + 1) / buckets;
+
+        float peak = 0.0f;
+        for (qsizetype i = from; i < to; ++i)
+            peak = qMax(peak, qAbs(src[i]));
+
+        result->peaks[b] = qMin(peak, 1.0f);
+    }
+
+    return result;
+}
+
+/* ============================================================
+ * RESAMPLE TO A PIXEL WIDTH
+ * ============================================================ */
+QVector<float> WaveformPeaks::resampled(int columns) const
+{
+    QVector<float> out;
+    if (columns <= 0 || peaks.isEmpty())
+        return out;
+
+    out.resize(columns);
+
+    const qsizetype n = peaks.size();
+    for (int x = 0; x < columns; ++x)
+    {
+        qsizetype from = n * x / columns;
+        qsizetype to   = n * (x + 1) / columns;
+        if (to <= from)
+            to = from + 1;   // more pixels than buckets: repeat
+        if (to > n)
+            to = n;
+
+        float peak = 0.0f;
+        for (qsizetype i = from; i < to; ++i)
+            peak = qMax(peak, peaks[i]);
+
+        out[x] = peak;
+    }
+
+    return out;
+}
+
+/* ============================================================
+ * STORED FORM
+ * ============================================================ */
+QByteArray WaveformPeaks::toBytes() const
+{
+    const qsizetype body = kHeaderSize + peaks.size() * 4;
+    QByteArray out(body + kLoudnessSize, Qt::Uninitialized);
+    char *p = out.data();
+
+    std::memcpy(p, kMagic, 4);
+    qToLittleEndian<quint32>(kVersion, p + 4);
+    qToLittleEndian<qint64>(durationMs, p + 8);
+    qToLittleEndian<quint32>(quint32(peaks.size()), p + 16);
+    qToLittleEndian<float>(peaks.constData(), peaks.size(), p + kHeaderSize);
+
+    char *l = p + body;
+    qToLittleEndian<quint32>(loudness.valid ? 1 : 0, l);
+    qToLittleEndian<quint32>(0, l + 4);
+    qToLittleEndian<double>(loudness.integratedLufs, l + 8);
+    qToLittleEndian<double>(loudness.rangeLu, l + 16);
+    qToLittleEndian<double>(loudness.truePeakDbtp, l + 24);
+    return out;
+}
+
+QSharedPointer<const WaveformPeaks> WaveformPeaks::fromBytes(const QByteArray &data)
+{
+    if (data.size() < kHeaderSize || !data.startsWith(QByteArray(kMagic, 4)))
+        return {};
+
+    const char *p = data.constData();
+    const quint32 version = qFromLittleEndian<quint32>(p + 4);
+    if (version > kVersion)
+        return {};
+
+    const quint32 count = qFromLittleEndian<quint32>(p + 16);
+    const qint64 body = kHeaderSize + qint64(count) * 4;
+    if (body + (version >= 2 ? kLoudnessSize : 0) != data.size())
+        return {};
+
+    auto result = QSharedPointer<WaveformPeaks>::create();
+    result->durationMs = qFromLittleEndian<qint64>(p + 8);
+    result->peaks.resize(count);
+    qFromLittleEndian<float>(p + kHeaderSize, count, result->peaks.data());
+
+    if (version >= 2)
+    {
+        const char *l = p + body;
+        result->loudness.valid = qFromLittleEndian<quint32>(l) != 0;
+        result->loudness.integratedLufs = qFromLittleEndian<double>(l + 8);
+        result->loudness.rangeLu = qFromLittleEndian<double>(l + 16);
+        result->loudness.truePeakDbtp = qFromLittleEndian<double>(l + 24);
+    }
+    return result;
+}
+
+/* ============================================================
+ * IMPORT HAND-OVER
+ * ============================================================ */
+namespace {
+QMutex stashMutex;
+QHash<QString, QSharedPointer<const WaveformPeaks>> stashed;
+}
+
+void WaveformPeaks::stash(const QString &audioPath, const QSharedPointer<const WaveformPeaks> &peaks)
+{
+    QMutexLocker lock(&stashMutex);
+    stashed.insert(audioPath, peaks);
+}
+
+QSharedPointer<const WaveformPeaks> WaveformPeaks::takeStashed(const QString &audioPath)
+{
+    QMutexLocker lock(&stashMutex);
+    return stashed.take(audioPath);
+}
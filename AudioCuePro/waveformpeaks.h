@@ -0,0 +1,59 @@
+#ifndef WAVEFORMPEAKS_H
+#define WAVEFORMPEAKS_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "loudness.h"
+
+/*
+============================================================
+ WaveformPeaks
+------------------------------------------------------------
+ - Fixed-resolution peak envelope of one audio file
+ - Built once after decoding, then shared (read-only) by
+   every view that draws the file: the track card's
+   WaveformView and the Live Mode monitor
+ - Views resample it to their own pixel width
+ - Serialisable, so a show package can ship the envelope
+   and its cues never need to be decoded for drawing
+ - Carries the file's R128 loudness when it was measured
+   (import, Analyze Loudness), so it is cached alongside
+ - stash()/takeStashed() pass envelopes built during import
+   to the views, so imported files are decoded only once
+============================================================
+*/
+
+struct WaveformPeaks
+{
+    QVector<float> peaks;    // max |sample| per bucket, 0..1
+    qint64 durationMs = 0;
+    Loudness::Stats loudness;    // valid = false if not measured
+
+    bool isEmpty() const { return peaks.isEmpty(); }
+
+    // Reduce (or stretch) the envelope to `columns` values for drawing
+    QVector<float> resampled(int columns) const;
+
+    // Build from a mono sample stream
+    static QSharedPointer<const WaveformPeaks> build(const QVector<float> &mono,
+                                                     qint64 durationMs,
+                                                     int buckets = 8192);
+
+    // Stored form (show packages): "ACPW" u32 version i64 duration
+    // u32 count, then `count` float32; version 2 appends u32 valid,
+    // u32 0, f64 integrated, range, true peak. All little-endian
+    QByteArray toBytes() const;
+    static QSharedPointer<const WaveformPeaks> fromBytes(const QByteArray &data);
+
+    // Hand-over from the importer: envelopes measured on a worker,
+    // picked up (once) by the WaveformView created for that file
+    static void stash(const QString &audioPath, const QSharedPointer<const WaveformPeaks> &peaks);
+    static QSharedPointer<const WaveformPeaks> takeStashed(const QString &audioPath);
+};
+
+using WaveformPeaksPtr = QSharedPointer<const WaveformPeaks>;
+
+#endif // WAVEFORMPEAKS_H
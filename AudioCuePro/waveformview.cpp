@@ -1,9 +1,11 @@
 #include "waveformview.h"
+#include "showpackage.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QtMath>
 #include <QDebug>
+#include <QTimer>
 
 /* ============================================================
  * CONSTRUCTOR
@@ -16,7 +18,6 @@ WaveformView::WaveformView(const QString &audioPath, QWidget *parent)
     setMouseTracking(true);
 
     decoder = new QAudioDecoder(this);
-    decoder->setSource(QUrl::fromLocalFile(audioPath));
 
     connect(decoder, &QAudioDecoder::bufferReady,
             this, &WaveformView::onBufferReady);
@@ -24,6 +25,72 @@ WaveformView::WaveformView(const QString &audioPath, QWidget *parent)
     connect(decoder, &QAudioDecoder::finished,
             this, &WaveformView::onDecodeFinished);
 
+    openSource();
+}
+
+void WaveformView::setSource(const QString &audioPath)
+{
+    decoder->stop();
+    m_audioPath = audioPath;
+    m_peaks.reset();
+    cached.clear();
+    durationMs = 0;
+    openSource();
+    update();
+}
+
+/* ============================================================
+ * OPEN SOURCE (file, or entry inside a show package)
+ * ============================================================ */
+void WaveformView::openSource()
+{
+    QIODevice *previous = m_sourceDevice;
+    m_sourceDevice = nullptr;
+
+    // Measured by the importer already
+    if (const WaveformPeaksPtr imported = WaveformPeaks::takeStashed(m_audioPath))
+    {
+        delete previous;
+        m_peaks = imported;
+        durationMs = imported->durationMs;
+        rebuildCachedWaveform();
+        QTimer::singleShot(0, this, &WaveformView::peaksReady);
+        return;
+    }
+
+    QString packagePath, entryName;
+    if (ShowPackage::splitEntryPath(m_audioPath, &packagePath, &entryName))
+    {
+        const QSharedPointer<const ShowPackage> pkg = ShowPackage::shared(packagePath);
+
+        // The package ships the envelope: nothing to decode
+        const QString object = entryName.section(QLatin1Char('/'), -1);
+        const WaveformPeaksPtr stored =
+            pkg ? WaveformPeaks::fromBytes(pkg->read(QStringLiteral("peaks/") + object))
+                : WaveformPeaksPtr();
+        if (stored && !stored->isEmpty())
+        {
+            delete previous;
+            m_peaks = stored;
+            durationMs = stored->durationMs;
+            rebuildCachedWaveform();
+            // Queued, so the owner has connected by then
+            QTimer::singleShot(0, this, &WaveformView::peaksReady);
+            return;
+        }
+
+        m_sourceDevice = pkg ? pkg->openEntry(entryName, this) : nullptr;
+        if (m_sourceDevice)
+            decoder->setSourceDevice(m_sourceDevice);
+        else
+            decoder->setSource(QUrl());
+    }
+    else
+    {
+        decoder->setSource(QUrl::fromLocalFile(m_audioPath));
+    }
+
+    delete previous;
     decodeAudio();
 }
 
@@ -101,8 +168,15 @@ void WaveformView::onBufferReady()
  * ============================================================ */
 void WaveformView::onDecodeFinished()
 {
+    // Keep only the envelope: the full-resolution mono copy is
+    // not needed for drawing and can be tens of MB per file.
+    m_peaks = WaveformPeaks::build(samples, durationMs);
+    samples.clear();
+    samples.squeeze();
+
     rebuildCachedWaveform();
     update();
+    emit peaksReady();
 }
 
 /* ============================================================
@@ -110,7 +184,7 @@ void WaveformView::onDecodeFinished()
  * ============================================================ */
 void WaveformView::rebuildCachedWaveform()
 {
-    if (samples.isEmpty())
+    if (!m_peaks || m_peaks->isEmpty())
         return;
 
     int W = width() - 2;
@@ -118,23 +192,7 @@ void WaveformView::rebuildCachedWaveform()
         return;
 
     cachedWidth = W;
-    cached.resize(W);
-
-    int step = samples.size() / W;
-    if (step < 1)
-        step = 1;
-
-    for (int x = 0; x < W; x++)
-    {
-        int start = x * step;
-        int end = qMin(start + step, samples.size());
-
-        float peak = 0;
-        for (int i = start; i < end; i++)
-            peak = qMax(peak, qAbs(samples[i]));
-
-        cached[x] = peak;
-    }
+    cached = m_peaks->resampled(W);
 }
 
 /* ============================================================
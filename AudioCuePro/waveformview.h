@@ -5,11 +5,15 @@
 #include <QAudioDecoder>
 #include <QVector>
 
+#include "waveformpeaks.h"
+
 /*
 ============================================================
  WaveformView
 ------------------------------------------------------------
- - Decodes PCM using QAudioDecoder (FFmpeg backend)
+ - Decodes PCM using QAudioDecoder (FFmpeg backend), or
+   takes the stored envelope of a show package cue
+ - Reduces it to a shared WaveformPeaks envelope
  - Renders real waveform
  - Draggable start and end markers
  - Click to seek
@@ -24,6 +28,9 @@ class WaveformView : public QWidget
 public:
     explicit WaveformView(const QString &audioPath, QWidget *parent = nullptr);
 
+    // Decode another file (cue relinked to a new path)
+    void setSource(const QString &audioPath);
+
     // Playhead and markers (ms)
     void setPlayhead(qint64 ms);
     void setStart(qint64 ms);
@@ -36,10 +43,14 @@ public:
     void zoomOut();
     void resetZoom();
 
+    // Shared peak envelope (null until decoding has finished)
+    WaveformPeaksPtr peakData() const { return m_peaks; }
+
 signals:
     void startChanged(qint64 newStartMs);
     void endChanged(qint64 newEndMs);
     void requestSeek(qint64 newPosMs);
+    void peaksReady();
 
 protected:
     void paintEvent(QPaintEvent *event) override;
@@ -54,6 +65,7 @@ private slots:
     void onDecodeFinished();
 
 private:
+    void openSource();
     void decodeAudio();
     void rebuildCachedWaveform();
     int msToX(qint64 ms) const;
@@ -69,9 +81,12 @@ private:
 private:
     QString m_audioPath;
 
-    // Raw PCM waveform (mono float array)
+    // Raw PCM waveform (mono float array), only kept while decoding
     QVector<float> samples;
 
+    // Peak envelope built from `samples` once decoding is done
+    WaveformPeaksPtr m_peaks;
+
     // Cached simplified waveform for drawing
     QVector<float> cached;
 
@@ -80,6 +95,7 @@ private:
 
     // Decoder
     QAudioDecoder *decoder;
+    QIODevice *m_sourceDevice = nullptr;   // package entry being decoded
 
     // Audio duration in ms
     qint64 durationMs = 0;